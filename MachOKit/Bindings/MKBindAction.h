@@ -42,6 +42,8 @@ NS_ASSUME_NONNULL_BEGIN
 @interface MKBindAction : MKAddressedNode {
 @package
 	mk_vm_offset_t _nodeOffset;
+    mk_vm_address_t _nodeContextAddress;
+    mk_vm_address_t _nodeVMAddress;
     MKSegment *_segment;
     MKResult<MKSection*> *_section;
     mk_vm_offset_t _offset;
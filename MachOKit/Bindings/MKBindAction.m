@@ -86,6 +86,10 @@
 	
 	_nodeOffset = bindContext->actionStartOffset;
 	
+	// SAFE - _nodeOffset comes from the bind commands, which are within the MKBindingsInfo.
+	_nodeContextAddress = [bindContext->info nodeAddress:MKNodeContextAddress] + _nodeOffset;
+	_nodeVMAddress = [bindContext->info nodeAddress:MKNodeVMAddress] + _nodeOffset;
+	
 	_type = bindContext->type;
     
     if (bindContext->segment == nil) {
@@ -152,12 +156,18 @@
 //|++++++++++++++++++++++++++++++++++++|//
 - (mk_vm_address_t)nodeAddress:(MKNodeAddressType)type
 {
-	// SAFE - _nodeOffset comes from the bind commands, which are within the MKBindingsInfo.
-	return [(MKBackedNode*)self.parent nodeAddress:type] + _nodeOffset;
+    switch (type) {
+        case MKNodeContextAddress:
+            return _nodeContextAddress;
+        case MKNodeVMAddress:
+            return _nodeVMAddress;
+        default:
+            @throw [NSException exceptionWithName:NSInvalidArgumentException reason:@"Unsupported node address type." userInfo:nil];
+    }
 }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
 	MKNodeFieldBuilder *type = [MKNodeFieldBuilder
 		builderWithProperty:MK_PROPERTY(type)
@@ -187,7 +197,7 @@
 	address.description = @"Address";
 	address.options = MKNodeFieldOptionDisplayAsDetail;
 	
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         type.build,
         segment.build,
         section.build,
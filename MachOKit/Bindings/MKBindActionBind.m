@@ -101,7 +101,7 @@
 //◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     MKNodeFieldBuilder *sourceLibraryOrdinal = [MKNodeFieldBuilder
         builderWithProperty:MK_PROPERTY(sourceLibraryOrdinal)
@@ -138,7 +138,7 @@
     addend.description = @"Addend";
     addend.options = MKNodeFieldOptionDisplayAsDetail;
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         sourceLibraryOrdinal.build,
         sourceLibrary.build,
         symbolName.build,
@@ -124,7 +124,7 @@
 }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     MKNodeFieldBuilder *offset = [MKNodeFieldBuilder
         builderWithProperty:MK_PROPERTY(offset)
@@ -134,7 +134,7 @@
     offset.dataRecipe = MKNodeFieldDataOperationExtractDynamicSubrange.sharedInstance;
     offset.options = MKNodeFieldOptionDisplayAsDetail;
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         offset.build
     ]];
 }
@@ -36,6 +36,19 @@
 + (id*)_subclassesCache
 { static NSSet *subclasses; return &subclasses; }
 
+//|++++++++++++++++++++++++++++++++++++|//
++ (id*)_dispatchTableCache
+{ static id table; return &table; }
+
+//|++++++++++++++++++++++++++++++++++++|//
++ (BOOL)rankingIsDeterminedByDispatchKeyForSubclass:(Class)subclass
+{
+#pragma unused (subclass)
+    // The opcode and immediate are the only inputs to
+    // +canInstantiateWithOpcode:immediate:.
+    return YES;
+}
+
 //|++++++++++++++++++++++++++++++++++++|//
 + (uint32_t)canInstantiateWithOpcode:(uint8_t)opcode immediate:(uint8_t)immediate
 {
@@ -49,7 +62,7 @@
 {
     // If we have one or more compatible subclasses, return the best match.
     {
-        Class subclass = [self bestSubclassWithRanking:^uint32_t(Class cls) {
+        Class subclass = [self bestSubclassForDispatchKey:@((opcode << 8) | immediate) withRanking:^uint32_t(Class cls) {
             return [cls canInstantiateWithOpcode:opcode immediate:immediate];
         }];
         
@@ -167,7 +180,7 @@
 //◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     MKNodeFieldBuilder *opcode = [MKNodeFieldBuilder
         builderWithProperty:MK_PROPERTY(opcode)
@@ -178,7 +191,7 @@
     opcode.description = @"Opcode";
     opcode.options = MKNodeFieldOptionDisplayAsDetail;
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         opcode.build
     ]];
 }
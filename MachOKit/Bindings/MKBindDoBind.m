@@ -107,9 +107,9 @@
 { return 1; }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
     ]];
 }
 
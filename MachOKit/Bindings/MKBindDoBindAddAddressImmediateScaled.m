@@ -109,7 +109,7 @@
 { return 1; }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     MKNodeFieldBuilder *scale = [MKNodeFieldBuilder
         builderWithProperty:MK_PROPERTY(scale)
@@ -120,7 +120,7 @@
     scale.description = @"Scale";
     scale.options = MKNodeFieldOptionDisplayAsDetail;
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         scale.build
     ]];
 }
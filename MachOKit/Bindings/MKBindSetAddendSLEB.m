@@ -114,7 +114,7 @@
 }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     MKNodeFieldBuilder *addend = [MKNodeFieldBuilder
         builderWithProperty:MK_PROPERTY(addend)
@@ -124,7 +124,7 @@
     addend.dataRecipe = MKNodeFieldDataOperationExtractDynamicSubrange.sharedInstance;
     addend.options = MKNodeFieldOptionDisplayAsDetail;
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         addend.build
     ]];
 }
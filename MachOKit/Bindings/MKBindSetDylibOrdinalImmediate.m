@@ -96,7 +96,7 @@
 { return 1; }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     MKNodeFieldBuilder *ordinal = [MKNodeFieldBuilder
         builderWithProperty:MK_PROPERTY(ordinal)
@@ -107,7 +107,7 @@
     ordinal.description = @"Dylib Ordinal";
     ordinal.options = MKNodeFieldOptionDisplayAsDetail;
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         ordinal.build
     ]];
 }
@@ -122,7 +122,7 @@
 }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     MKNodeFieldBuilder *ordinal = [MKNodeFieldBuilder
         builderWithProperty:MK_PROPERTY(ordinal)
@@ -132,7 +132,7 @@
     ordinal.dataRecipe = MKNodeFieldDataOperationExtractDynamicSubrange.sharedInstance;
     ordinal.options = MKNodeFieldOptionDisplayAsDetail;
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         ordinal.build
     ]];
 }
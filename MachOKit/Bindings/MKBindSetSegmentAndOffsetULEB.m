@@ -137,7 +137,7 @@
 }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     MKNodeFieldBuilder *segmentIndex = [MKNodeFieldBuilder
         builderWithProperty:MK_PROPERTY(segmentIndex)
@@ -156,7 +156,7 @@
     offset.dataRecipe = MKNodeFieldDataOperationExtractDynamicSubrange.sharedInstance;
     offset.options = MKNodeFieldOptionDisplayAsDetail;
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         segmentIndex.build,
         offset.build
     ]];
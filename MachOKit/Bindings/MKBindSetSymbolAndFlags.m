@@ -128,7 +128,7 @@
 }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     MKNodeFieldBuilder *symbolFlags = [MKNodeFieldBuilder
         builderWithProperty:MK_PROPERTY(symbolFlags)
@@ -151,7 +151,7 @@
     symbolName.dataRecipe = MKNodeFieldDataOperationExtractDynamicSubrange.sharedInstance;
     symbolName.options = MKNodeFieldOptionDisplayAsDetail | MKNodeFieldOptionIgnoreContainerContents;
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         symbolFlags.build,
         symbolName.build
     ]];
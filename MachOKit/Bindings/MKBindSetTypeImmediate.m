@@ -88,7 +88,7 @@
 { return 1; }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     MKNodeFieldBuilder *type = [MKNodeFieldBuilder
         builderWithProperty:MK_PROPERTY(type)
@@ -102,7 +102,7 @@
                                              rawValueFormatter:MKNodeFieldTypeUnsignedByte.sharedInstance.formatter
                                          refinedValueFormatter:type.formatter];
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         type.build
     ]];
 }
@@ -110,7 +110,7 @@
 }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     MKNodeFieldBuilder *count = [MKNodeFieldBuilder
         builderWithProperty:MK_PROPERTY(count)
@@ -120,7 +120,7 @@
     count.dataRecipe = MKNodeFieldDataOperationExtractDynamicSubrange.sharedInstance;
     count.options = MKNodeFieldOptionDisplayAsDetail;
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         count.build
     ]];
 }
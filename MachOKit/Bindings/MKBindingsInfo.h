@@ -29,9 +29,11 @@
 #import <Foundation/Foundation.h>
 
 #import <MachOKit/MKLinkEditNode.h>
+#import <MachOKit/MKBindingsFieldType.h>
 
 @class MKBindCommand;
 @class MKBindAction;
+struct MKFixupTable;
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -40,15 +42,18 @@ NS_ASSUME_NONNULL_BEGIN
 @package
     NSArray<__kindof MKBindCommand*> *_commands;
     NSArray<__kindof MKBindAction*> *_actions;
+    struct MKFixupTable *_actionTable;
 }
 
 //! Initializes the receiver with the provided Mach-O.
 - (nullable instancetype)initWithImage:(MKMachOImage*)image error:(NSError**)error;
 
-//! An array of bind commands.
+//! An array of bind commands.  The commands are instantiated on first
+//! access.
 @property (nonatomic, readonly) NSArray<__kindof MKBindCommand*> *commands;
 
-//! An array of bind actions derived from the bind commands.
+//! An array of bind actions derived from the bind commands.  The actions
+//! are instantiated on first access.
 //!
 //! @note
 //! For binaries that use threaded binds (i.e, arm64e), this array will
@@ -57,6 +62,48 @@ NS_ASSUME_NONNULL_BEGIN
 //! \ref MKBindActionBind if you are only interested in the bindings.
 @property (nonatomic, readonly) NSArray<__kindof MKBindAction*> *actions;
 
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+#pragma mark -  Looking Up Actions
+//! @name       Looking Up Actions
+//!
+//! The bind opcodes are decoded once, when the receiver is initialized,
+//! into a compact table.  These methods read the table without
+//! instantiating any \ref MKBindCommand or \ref MKBindAction.  The action
+//! at a given index in the table is the action at the same index in
+//! \ref actions.
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+
+//! The number of bind actions.
+@property (nonatomic, readonly) NSUInteger actionCount;
+
+//! Returns the VM address of the bind location of the action at \a index.
+- (mk_vm_address_t)addressOfActionAtIndex:(NSUInteger)index;
+
+//! Returns the type of the action at \a index.
+- (MKBindType)typeOfActionAtIndex:(NSUInteger)index;
+
+//! Returns the library ordinal of the action at \a index.  Threaded
+//! rebase actions have a library ordinal of \c 0.
+- (int64_t)libraryOrdinalOfActionAtIndex:(NSUInteger)index;
+
+//! Returns the name of the symbol bound by the action at \a index, or
+//! \c nil if the action does not reference a symbol.
+- (nullable NSString*)symbolNameOfActionAtIndex:(NSUInteger)index;
+
+//! Returns the symbol flags of the action at \a index.
+- (MKBindSymbolFlags)symbolFlagsOfActionAtIndex:(NSUInteger)index;
+
+//! Returns the addend of the action at \a index.
+- (int64_t)addendOfActionAtIndex:(NSUInteger)index;
+
+//! Returns the index of the first action at \a address, or \c NSNotFound
+//! if no action applies to \a address.
+- (NSUInteger)indexOfActionAtAddress:(mk_vm_address_t)address;
+
+//! Returns the first action at \a address, or \c nil if no action applies
+//! to \a address.
+- (nullable __kindof MKBindAction*)actionAtAddress:(mk_vm_address_t)address;
+
 @end
 
 NS_ASSUME_NONNULL_END
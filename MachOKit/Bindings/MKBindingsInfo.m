@@ -31,13 +31,76 @@
 #import "MKLCDyldInfo.h"
 #import "MKBindCommand.h"
 #import "MKBindAction.h"
+#import "MKMachO+Segments.h"
+#import "MKSegment.h"
+#import "_MKFixupTable.h"
+
+#include "_mach_trie.h"
+
+//! An entry in the ordinal table of a threaded bind.  See
+//! \ref MKBindThreadedData.
+struct MKBindingsInfoThreadedEntry {
+    uint32_t info;
+    uint32_t symbolOffset;
+    int64_t addend;
+};
+
+//! Walks the elements of a threaded chain that lie within a single mapped
+//! window of a segment, appending an entry to \a table for each one.
+//! \a bytes holds the segment contents from \a windowStart to \a windowEnd.
+//! On return, \a *offset is the segment offset of the next element in the
+//! chain and \a *finished is \c true if the chain has ended.
+static mk_error_t
+MKBindingsInfoWalkThreadedChain(struct MKFixupTable *table, const uint8_t *bytes, uint64_t windowStart, uint64_t windowEnd, mk_vm_address_t segmentAddress, mk_vm_size_t segmentSize, const mk_byteorder_t *byteOrder, const struct MKBindingsInfoThreadedEntry *entries, NSUInteger entryCount, uint64_t *offset, bool *finished)
+{
+    uint64_t elementOffset = *offset;
+    
+    while (elementOffset < segmentSize && elementOffset < windowEnd && windowEnd - elementOffset >= sizeof(uint64_t))
+    {
+        uint64_t value;
+        memcpy(&value, bytes + (elementOffset - windowStart), sizeof(value));
+        value = byteOrder->swap64(value);
+        
+        bool appended;
+        if ((value >> 62) & 0x1) {
+            // The ordinal is bits [0..15]
+            uint16_t ordinal = value & 0xFFFF;
+            if (ordinal >= entryCount) {
+                *offset = elementOffset;
+                return MK_EOUT_OF_RANGE;
+            }
+            appended = MKFixupTableAppend(table, segmentAddress + elementOffset, entries[ordinal].info, entries[ordinal].symbolOffset, entries[ordinal].addend);
+        } else {
+            appended = MKFixupTableAppend(table, segmentAddress + elementOffset, MKFixupTableMakeInfo(BIND_TYPE_THREADED_REBASE, 0, 0), MKFixupTableNoSymbol, 0);
+        }
+        
+        if (!appended) {
+            *offset = elementOffset;
+            return MK_EINTERNAL_ERROR;
+        }
+        
+        // The distance to the next element, in pointer sized units, is
+        // bits [51..61].
+        uint64_t delta = ((value >> 51) & 0x7FF) * sizeof(uint64_t);
+        if (delta == 0) {
+            *offset = elementOffset;
+            *finished = true;
+            return MK_ESUCCESS;
+        }
+        if (UINT64_MAX - delta < elementOffset) {
+            *offset = elementOffset;
+            return MK_EOVERFLOW;
+        }
+        elementOffset += delta;
+    }
+    
+    *offset = elementOffset;
+    return MK_ESUCCESS;
+}
 
 //----------------------------------------------------------------------------//
 @implementation MKBindingsInfo
 
-@synthesize commands = _commands;
-@synthesize actions = _actions;
-
 //|++++++++++++++++++++++++++++++++++++|//
 - (instancetype)initWithSize:(mk_vm_size_t)size offset:(mk_vm_offset_t)offset inImage:(MKMachOImage*)image error:(NSError**)error
 {
@@ -50,19 +113,19 @@
         [self release]; return nil;
     }
     
-    // A size of 0 is strange but valid.
-    if (self.nodeSize == 0) {
-        // Still need to assign a value to the commands and actions array.
-        _commands = [@[] retain];
-        _actions = [@[] retain];
-        return self;
+    // Most of the opcode stream is symbol names, so there are far fewer
+    // actions than bytes.  Start small and let the table grow.
+    _actionTable = calloc(1, sizeof(*_actionTable));
+    if (_actionTable == NULL || !MKFixupTableInit(_actionTable, MIN((NSUInteger)self.nodeSize, 64), true)) {
+        MK_ERROR_OUT = [NSError mk_errorWithDomain:MKErrorDomain code:MK_EINTERNAL_ERROR description:@"Could not allocate the bind action table."];
+        [self release]; return nil;
     }
     
-    // Load Bind Commands
-    [self _parseCommands];
+    // A size of 0 is strange but valid.
+    if (self.nodeSize > 0)
+        [self _decodeActions];
     
-    // Determine the Bind Actions
-    [self _parseActions];
+    MKFixupTableFinalize(_actionTable);
     
     return self;
 }
@@ -110,6 +173,11 @@
 //|++++++++++++++++++++++++++++++++++++|//
 - (void)dealloc
 {
+    if (_actionTable) {
+        MKFixupTableFree(_actionTable);
+        free(_actionTable);
+    }
+    
     [_actions release];
     [_commands release];
     
@@ -120,10 +188,272 @@
 #pragma mark -  Parsing
 //◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
 
+//|++++++++++++++++++++++++++++++++++++|//
+- (BOOL)_decodeActionsAsLazyBindings
+{ return NO; }
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)_decodeActions
+{
+    NSError *memoryMapError = nil;
+    
+    [self.memoryMap adviseAccessPattern:MKMemoryMapAccessPatternSequential atOffset:0 fromAddress:self.nodeContextAddress length:self.nodeSize];
+    
+    MKMemorySpan span = [self.memoryMap spanAtOffset:0 fromAddress:self.nodeContextAddress length:self.nodeSize requireFull:YES error:&memoryMapError];
+    if (span.bytes == NULL) {
+        MK_PUSH_WARNING_WITH_ERROR(actionCount, MK_EINTERNAL_ERROR, memoryMapError, @"Could not map the binding info.");
+        return;
+    }
+    
+    const uint8_t *start = span.bytes;
+    const uint8_t *end = start + span.length;
+    const uint8_t *p = start;
+    const uint8_t *command = p;
+    
+    MKDataModel *dataModel = self.dataModel;
+    uint64_t pointerSize = dataModel.pointerSize;
+    BOOL stopAtDone = self._parseCommandsStopAtDone;
+    BOOL lazy = self._decodeActionsAsLazyBindings;
+    mk_error_t err = MK_ESUCCESS;
+    bool done = false;
+    
+    // See the MKBindCommand subclasses for the behavior of each opcode.
+    unsigned segmentIndex = 0;
+    MKSegment *segment = nil;
+    mk_vm_address_t segmentAddress = 0;
+    mk_vm_size_t segmentSize = 0;
+    uint64_t segmentOffset = 0;
+    uint64_t derivedOffset = 0;
+    int64_t libraryOrdinal = 0;
+    int64_t addend = 0;
+    uint8_t type = lazy ? BIND_TYPE_POINTER : 0;
+    uint8_t symbolFlags = 0;
+    uint32_t symbolOffset = MKFixupTableNoSymbol;
+    
+    bool useThreadedRebaseBind = false;
+    struct MKBindingsInfoThreadedEntry *ordinalTable = NULL;
+    NSUInteger ordinalTableCount = 0;
+    NSUInteger ordinalTableCapacity = 0;
+    
+    while (!done && err == MK_ESUCCESS && p < end)
+    {
+        command = p;
+        uint8_t opcode = *p & BIND_OPCODE_MASK;
+        uint8_t immediate = *p & BIND_IMMEDIATE_MASK;
+        uint64_t count = 0;
+        uint64_t skip = 0;
+        uint64_t value;
+        int64_t signedValue;
+        size_t size;
+        p++;
+        
+        switch (opcode) {
+            case BIND_OPCODE_DONE:
+                done = stopAtDone;
+                break;
+            case BIND_OPCODE_SET_DYLIB_ORDINAL_IMM:
+                libraryOrdinal = immediate;
+                break;
+            case BIND_OPCODE_SET_DYLIB_ORDINAL_ULEB:
+                if ((err = _mk_mach_trie_copy_uleb128(p, end, &value, &size)))
+                    break;
+                p += size;
+                libraryOrdinal = (int64_t)value;
+                break;
+            case BIND_OPCODE_SET_DYLIB_SPECIAL_IMM:
+                libraryOrdinal = (immediate == 0) ? 0 : (int8_t)(BIND_OPCODE_MASK | immediate);
+                break;
+            case BIND_OPCODE_SET_SYMBOL_TRAILING_FLAGS_IMM:
+            {
+                symbolFlags = immediate;
+                symbolOffset = (uint32_t)(p - start);
+                // An unterminated symbol name runs to the end of the
+                // binding info.  See MKCString.
+                const uint8_t *nul = memchr(p, 0, (size_t)(end - p));
+                p = nul ? nul + 1 : end;
+                break;
+            }
+            case BIND_OPCODE_SET_TYPE_IMM:
+                type = immediate;
+                break;
+            case BIND_OPCODE_SET_ADDEND_SLEB:
+                if ((err = _mk_mach_trie_copy_sleb128(p, end, &signedValue, &size)))
+                    break;
+                p += size;
+                addend = signedValue;
+                break;
+            case BIND_OPCODE_SET_SEGMENT_AND_OFFSET_ULEB:
+                if ((err = _mk_mach_trie_copy_uleb128(p, end, &value, &size)))
+                    break;
+                p += size;
+                segmentIndex = immediate;
+                segmentOffset = derivedOffset = value;
+                segment = [self.macho segmentAtIndex:segmentIndex].value;
+                if (segment == nil) {
+                    err = MK_ENOT_FOUND;
+                    break;
+                }
+                segmentAddress = segment.vmAddress;
+                segmentSize = segment.vmSize;
+                break;
+            case BIND_OPCODE_ADD_ADDR_ULEB:
+                if ((err = _mk_mach_trie_copy_uleb128(p, end, &value, &size)))
+                    break;
+                p += size;
+                err = mk_vm_address_apply_slide(derivedOffset, (mk_vm_slide_t)value, &derivedOffset);
+                break;
+            case BIND_OPCODE_DO_BIND:
+                if (useThreadedRebaseBind) {
+                    if (!MKFixupTableCanPackOrdinal(libraryOrdinal)) {
+                        err = MK_EOUT_OF_RANGE;
+                        break;
+                    }
+                    if (ordinalTableCount == ordinalTableCapacity) {
+                        ordinalTableCapacity = MAX(ordinalTableCapacity * 2, (NSUInteger)16);
+                        if ((ordinalTable = reallocf(ordinalTable, ordinalTableCapacity * sizeof(*ordinalTable))) == NULL) {
+                            err = MK_EINTERNAL_ERROR;
+                            break;
+                        }
+                    }
+                    ordinalTable[ordinalTableCount++] = (struct MKBindingsInfoThreadedEntry){ MKFixupTableMakeInfo(BIND_TYPE_THREADED_BIND, symbolFlags, libraryOrdinal), symbolOffset, addend };
+                } else {
+                    count = 1;
+                }
+                break;
+            case BIND_OPCODE_DO_BIND_ADD_ADDR_ULEB:
+                if (lazy) { err = MK_EINVALID_DATA; break; }
+                if ((err = _mk_mach_trie_copy_uleb128(p, end, &skip, &size)))
+                    break;
+                p += size;
+                count = 1;
+                break;
+            case BIND_OPCODE_DO_BIND_ADD_ADDR_IMM_SCALED:
+                if (lazy) { err = MK_EINVALID_DATA; break; }
+                skip = immediate * pointerSize;
+                count = 1;
+                break;
+            case BIND_OPCODE_DO_BIND_ULEB_TIMES_SKIPPING_ULEB:
+                if (lazy) { err = MK_EINVALID_DATA; break; }
+                if ((err = _mk_mach_trie_copy_uleb128(p, end, &count, &size)))
+                    break;
+                p += size;
+                if ((err = _mk_mach_trie_copy_uleb128(p, end, &skip, &size)))
+                    break;
+                p += size;
+                break;
+            case BIND_OPCODE_THREADED:
+                if (lazy) { err = MK_EINVALID_DATA; break; }
+                
+                if (immediate == BIND_SUBOPCODE_THREADED_SET_BIND_ORDINAL_TABLE_SIZE_ULEB) {
+                    if ((err = _mk_mach_trie_copy_uleb128(p, end, &value, &size)))
+                        break;
+                    p += size;
+                    ordinalTableCount = 0;
+                    useThreadedRebaseBind = true;
+                } else if (immediate == BIND_SUBOPCODE_THREADED_APPLY) {
+                    err = [self _decodeThreadedChainInSegment:segment offset:&segmentOffset ordinalTable:ordinalTable count:ordinalTableCount];
+                    derivedOffset = segmentOffset;
+                } else {
+                    err = MK_EINVALID_DATA;
+                }
+                break;
+            default:
+                err = MK_EINVALID_DATA;
+                break;
+        }
+        
+        // Perform the binds.  See -[MKBindAction initWithContext:error:] for
+        // the checks.
+        for (uint64_t i = 0; i < count && err == MK_ESUCCESS; i++)
+        {
+            if (segment == nil)
+                err = MK_ENOT_FOUND;
+            else if (derivedOffset >= segmentSize)
+                err = MK_EOUT_OF_RANGE;
+            else if (!MKFixupTableCanPackOrdinal(libraryOrdinal))
+                err = MK_EOUT_OF_RANGE;
+            else if (!MKFixupTableAppend(_actionTable, segmentAddress + derivedOffset, MKFixupTableMakeInfo(type, symbolFlags, libraryOrdinal), symbolOffset, addend))
+                err = MK_EINTERNAL_ERROR;
+            else if (skip > UINT64_MAX - pointerSize)
+                err = MK_EOVERFLOW;
+            else
+                err = mk_vm_offset_add(derivedOffset, skip + pointerSize, &derivedOffset);
+        }
+    }
+    
+    free(ordinalTable);
+    
+    if (err != MK_ESUCCESS)
+        MK_PUSH_WARNING(actionCount, err, @"Could not decode bind opcode at offset [%td] (segment index %u): %s.  Stopping after %lu actions.", command - start, segmentIndex, mk_error_string(err), (unsigned long)_actionTable->count);
+    else if (!done && span.length < self.nodeSize)
+        MK_PUSH_WARNING(actionCount, MK_EINVALID_DATA, @"Only [%" MK_VM_PRIuSIZE "] of [%" MK_VM_PRIuSIZE "] bytes of the binding info could be mapped.", span.length, self.nodeSize);
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (mk_error_t)_decodeThreadedChainInSegment:(MKSegment*)segment offset:(uint64_t*)segmentOffset ordinalTable:(const struct MKBindingsInfoThreadedEntry*)entries count:(NSUInteger)ordinalTableCount
+{
+    MKDataModel *dataModel = self.dataModel;
+    
+    // Threaded bind opcodes should only appear in 64-bit binaries
+    if (dataModel.pointerSize != 8)
+        return MK_EUNAVAILABLE;
+    if (segment == nil)
+        return MK_ENOT_FOUND;
+    
+    MKMemoryMap *memoryMap = segment.memoryMap;
+    mk_vm_address_t contextAddress = segment.nodeContextAddress;
+    mk_vm_address_t segmentAddress = segment.vmAddress;
+    mk_vm_size_t segmentSize = segment.vmSize;
+    const mk_byteorder_t *byteOrder = dataModel.byteOrder;
+    struct MKFixupTable *table = _actionTable;
+    
+    __block mk_error_t err = MK_ESUCCESS;
+    __block bool finished = false;
+    
+    // The elements of a chain only ever move forward, so each page the chain
+    // passes through is mapped once and all of its elements are decoded
+    // before moving on to the next page.
+    while (err == MK_ESUCCESS && !finished)
+    {
+        uint64_t offset = *segmentOffset;
+        if (offset >= segmentSize)
+            return MK_EOUT_OF_RANGE;
+        
+        // Map the rest of the page that holds the next element, or the
+        // whole element if it straddles a page boundary.
+        mk_vm_size_t length = vm_page_size - ((contextAddress + offset) & vm_page_mask);
+        length = MIN(length, segmentSize - offset);
+        length = MAX(length, (mk_vm_size_t)sizeof(uint64_t));
+        
+        __block bool mapped = false;
+        [memoryMap remapBytesAtOffset:offset fromAddress:contextAddress length:length requireFull:YES withHandler:^(vm_address_t address, vm_size_t mappedLength, NSError *error) {
+            if (error || address == 0 || mappedLength < sizeof(uint64_t))
+                return;
+            
+            mapped = true;
+            err = MKBindingsInfoWalkThreadedChain(table, (const uint8_t*)address, offset, offset + mappedLength, segmentAddress, segmentSize, byteOrder, entries, ordinalTableCount, segmentOffset, &finished);
+        }];
+        
+        if (!mapped)
+            return MK_EBAD_ACCESS;
+    }
+    
+    return err;
+}
+
 //|++++++++++++++++++++++++++++++++++++|//
 - (BOOL)_parseCommandsStopAtDone
 { return YES; }
 
+//|++++++++++++++++++++++++++++++++++++|//
+- (NSArray*)commands
+{
+    if (_commands == nil)
+        [self _parseCommands];
+    
+    return _commands;
+}
+
 //|++++++++++++++++++++++++++++++++++++|//
 - (void)_parseCommands
 {
@@ -158,6 +488,15 @@
     }
 }
 
+//|++++++++++++++++++++++++++++++++++++|//
+- (NSArray*)actions
+{
+    if (_actions == nil)
+        [self _parseActions];
+    
+    return _actions;
+}
+
 //|++++++++++++++++++++++++++++++++++++|//
 - (void)_parseActions
 {
@@ -178,7 +517,7 @@
                 keepGoing = NO;
         };
         
-        for (MKBindCommand *command in _commands) {
+        for (MKBindCommand *command in self.commands) {
             if (context.command == nil) {
                 context.actionStartOffset = command.nodeOffset;
                 context.actionSize = 0;
@@ -204,12 +543,100 @@
     }
 }
 
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+#pragma mark -  Looking Up Actions
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (NSUInteger)actionCount
+{ return _actionTable->count; }
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)_checkActionIndex:(NSUInteger)index
+{
+    if (index >= _actionTable->count) {
+        NSString *reason = [NSString stringWithFormat:@"Index [%lu] is beyond the bounds of the action table [0 .. %lu).", (unsigned long)index, (unsigned long)_actionTable->count];
+        @throw [NSException exceptionWithName:NSRangeException reason:reason userInfo:nil];
+    }
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (mk_vm_address_t)addressOfActionAtIndex:(NSUInteger)index
+{
+    [self _checkActionIndex:index];
+    return _actionTable->addresses[index];
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (MKBindType)typeOfActionAtIndex:(NSUInteger)index
+{
+    [self _checkActionIndex:index];
+    return MKFixupTableInfoType(_actionTable->info[index]);
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (int64_t)libraryOrdinalOfActionAtIndex:(NSUInteger)index
+{
+    [self _checkActionIndex:index];
+    return MKFixupTableInfoLibraryOrdinal(_actionTable->info[index]);
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (NSString*)symbolNameOfActionAtIndex:(NSUInteger)index
+{
+    [self _checkActionIndex:index];
+    
+    uint32_t symbolOffset = _actionTable->symbolOffsets[index];
+    if (symbolOffset == MKFixupTableNoSymbol)
+        return nil;
+    
+    // SAFE - The symbol offset was within the node when it was decoded.
+    MKMemorySpan span = [self.memoryMap spanAtOffset:symbolOffset fromAddress:self.nodeContextAddress length:self.nodeSize - symbolOffset requireFull:NO error:NULL];
+    if (span.bytes == NULL)
+        return nil;
+    
+    size_t length = strnlen((const char*)span.bytes, (size_t)span.length);
+    return [[[NSString alloc] initWithBytes:span.bytes length:length encoding:NSUTF8StringEncoding] autorelease];
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (MKBindSymbolFlags)symbolFlagsOfActionAtIndex:(NSUInteger)index
+{
+    [self _checkActionIndex:index];
+    return MKFixupTableInfoSymbolFlags(_actionTable->info[index]);
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (int64_t)addendOfActionAtIndex:(NSUInteger)index
+{
+    [self _checkActionIndex:index];
+    return _actionTable->addends ? _actionTable->addends[index] : 0;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (NSUInteger)indexOfActionAtAddress:(mk_vm_address_t)address
+{ return MKFixupTableIndexOfAddress(_actionTable, address); }
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (MKBindAction*)actionAtAddress:(mk_vm_address_t)address
+{
+    NSUInteger index = [self indexOfActionAtAddress:address];
+    if (index == NSNotFound)
+        return nil;
+    
+    NSArray<MKBindAction*> *actions = self.actions;
+    if (index >= actions.count)
+        return nil;
+    
+    return actions[index];
+}
+
 //◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
 #pragma mark -  MKNode
 //◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     MKNodeFieldBuilder *commands = [MKNodeFieldBuilder
         builderWithProperty:MK_PROPERTY(commands)
@@ -225,7 +652,7 @@
     actions.description = @"Actions";
     actions.options = MKNodeFieldOptionDisplayAsChild | MKNodeFieldOptionDisplayCollectionContentsAsDetail;
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         commands.build,
         actions.build
     ]];
@@ -51,6 +51,10 @@
     return NO;
 }
 
+//|++++++++++++++++++++++++++++++++++++|//
+- (BOOL)_decodeActionsAsLazyBindings
+{ return YES; }
+
 //|++++++++++++++++++++++++++++++++++++|//
 - (void)_parseActions
 {
@@ -75,7 +79,7 @@
             [action release];
         };
         
-        for (MKBindCommand *command in _commands) {
+        for (MKBindCommand *command in self.commands) {
             if (context.command == nil) {
                 context.actionStartOffset = command.nodeOffset;
                 context.actionSize = 0;
@@ -69,7 +69,7 @@
             [action release];
         };
         
-        for (MKBindCommand *command in _commands) {
+        for (MKBindCommand *command in self.commands) {
             if (context.command == nil) {
                 context.actionStartOffset = command.nodeOffset;
                 context.actionSize = 0;
@@ -122,7 +122,7 @@ struct cf_string_32 {
 { return (self.dataModel.pointerSize == 8) ? sizeof(struct cf_string_64) : sizeof(struct cf_string_32); }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     struct cf_string_64 cf64;
     struct cf_string_32 cf32;
@@ -174,7 +174,7 @@ struct cf_string_32 {
 #undef FIELD_OFFSET
 #undef FIELD_TYPE
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         isa.build,
         flags.build,
         string.build,
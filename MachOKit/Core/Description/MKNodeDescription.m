@@ -28,6 +28,8 @@
 #import "MKNodeDescription.h"
 #import "MKInternal.h"
 #import "MKBackedNode.h"
+#import "MKNodeSerializer.h"
+#import "MKNodeTextSink.h"
 
 //----------------------------------------------------------------------------//
 @implementation MKNodeDescription
@@ -104,95 +106,19 @@
 //|++++++++++++++++++++++++++++++++++++|//
 - (NSString*)textualDescriptionForNode:(MKNode*)node traversalDepth:(NSUInteger)traversalDepth
 {
-    NSMutableString *retValue = nil;
+    NSOutputStream *stream = [NSOutputStream outputStreamToMemory];
+    MKNodeTextSink *sink = [[MKNodeTextSink alloc] initWithOutputStream:stream];
+    MKNodeSerializer *serializer = [[MKNodeSerializer alloc] initWithSink:sink];
     
-    // HACK HACK - Special case for MKBackedNode and MKAddressedNode
-    if ([node respondsToSelector:@selector(nodeContextAddress)] && [node respondsToSelector:@selector(nodeSize)])
-        retValue = [NSMutableString stringWithFormat:@"<%@ %p; contextAddress = 0x%" MK_VM_PRIxADDR "; size = %" MK_VM_PRIiSIZE ">",
-                    node.class, self, [(MKBackedNode*)node nodeContextAddress], [(MKBackedNode*)node nodeSize]];
-    else if ([node respondsToSelector:@selector(nodeContextAddress)])
-        retValue = [NSMutableString stringWithFormat:@"<%@ %p; contextAddress = 0x%" MK_VM_PRIxADDR ">",
-                    node.class, self, [(MKAddressedNode*)node nodeContextAddress]];
-    else
-        retValue = [NSMutableString stringWithFormat:@"<%@ %p>", node.class, self];
+    [serializer serializeNode:node description:self traversalDepth:traversalDepth error:NULL];
     
-    NSArray *fields = self.allFields;
-    if (fields.count)
-    {
-        [retValue appendString:@" {\n"];
-        
-        __block NSString* (^describeValue)(id, MKNodeField*) = ^(id value, MKNodeField *field) {
-            // We want to format nodes a specific way, regardless of what the field says.
-            if ([value isKindOfClass:MKNode.class]) {
-                // Only recurse on the node if we have not reached the traversal depth
-                if (traversalDepth > 0 && (field.options & MKNodeFieldOptionIgnoreContainerContents) == 0) {
-                    return (NSString*)[[value layout] textualDescriptionForNode:value traversalDepth:traversalDepth-1];
-                }
-                /* else, fallthrough */
-            }
-            // We want to format collections a specific way, regardless of what the field says.
-            else if ([value isKindOfClass:NSDictionary.class]) {
-                NSMutableString *collectionDescription = [NSMutableString string];
-                MKNodeField *childField = nil;
-                if (field.options & MKNodeFieldOptionFormatCollectionValues)
-                    childField = field;
-                
-                [collectionDescription appendString:@"("];
-                for (id item in value) {
-                    [collectionDescription appendFormat:@"\n\t%@", [describeValue([value objectForKey:item], childField) stringByReplacingOccurrencesOfString:@"\n" withString:@"\n\t"]];
-                }
-                [collectionDescription appendString:@"\n)"];
-                
-                return (NSString*)collectionDescription;
-            }
-            else if ([value conformsToProtocol:@protocol(NSFastEnumeration)]) {
-                NSMutableString *collectionDescription = [NSMutableString string];
-                MKNodeField *childField = nil;
-                if (field.options & MKNodeFieldOptionFormatCollectionValues)
-                    childField = field;
-                
-                [collectionDescription appendString:@"("];
-                for (id item in value) {
-                    [collectionDescription appendFormat:@"\n\t%@", [describeValue(item, childField) stringByReplacingOccurrencesOfString:@"\n" withString:@"\n\t"]];
-                }
-                [collectionDescription appendString:@"\n)"];
-                
-                return (NSString*)collectionDescription;
-            }
-            
-            NSFormatter *formatter = field.valueFormatter;
-            if (formatter)
-                return [formatter stringForObjectValue:value];
-            else
-                return [value description];
-        };
-        
-        for (MKNodeField *field in fields)
-        @autoreleasepool {
-            id value = [field.valueRecipe valueForField:field ofNode:node].value;
-            
-            [retValue appendFormat:@"\t%@ = %@\n", field.name, [describeValue(value, field) stringByReplacingOccurrencesOfString:@"\n" withString:@"\n\t"]];
-        }
-        
-        if (node.warnings.count)
-        {
-            [retValue appendFormat:@"\twarnings = {\n"];
-            for (NSError *warning in node.warnings)
-            @autoreleasepool {
-				[retValue appendFormat:@"\t\t%@: %@", warning.mk_property, warning.localizedDescription];
-				
-				for (NSError *w = warning.userInfo[NSUnderlyingErrorKey]; w != nil; w = w.userInfo[NSUnderlyingErrorKey])
-					[retValue appendFormat:@" -> %@", w.localizedDescription];
-				
-				[retValue appendFormat:@"\n"];
-            }
-            [retValue appendFormat:@"\t}\n"];
-        }
-        
-        [retValue appendString:@"}"];
-    }
+    [serializer release];
+    [sink release];
     
-    return retValue;
+    NSData *data = [stream propertyForKey:NSStreamDataWrittenToMemoryStreamKey];
+    [stream close];
+    
+    return [[[NSString alloc] initWithData:data encoding:NSUTF8StringEncoding] autorelease];
 }
 
 @end
@@ -33,6 +33,8 @@ NS_ASSUME_NONNULL_BEGIN
 @interface MKNodeFieldOperationReadKeyPath : NSObject <MKNodeFieldValueRecipe> {
 @package
     NSString *_keyPath;
+    // The accessor most recently used to read the key path.
+    __unsafe_unretained id _accessor;
 }
 
 - (instancetype)initWithKeyPath:(nullable NSString*)keyPath NS_DESIGNATED_INITIALIZER;
@@ -29,6 +29,7 @@
 #import "MKInternal.h"
 #import "MKResult.h"
 #import "MKNode.h"
+#import "_MKNodeFieldAccessor.h"
 
 //----------------------------------------------------------------------------//
 @implementation MKNodeFieldOperationReadKeyPath
@@ -66,10 +67,22 @@
 - (MKResult*)valueForField:(MKNodeField*)field ofNode:(MKNode*)input
 {
     NSString *keyPath = _keyPath ?: field.name;
+    Class cls = object_getClass(input);
     
-    id value = [input valueForKeyPath:keyPath];
+    // A recipe almost always reads nodes of a single class.  Remember the
+    // accessor for that class rather than looking it up on every read.
+    // Accessors are never deallocated, so an unretained reference is safe.
+    _MKNodeFieldAccessor *accessor = __atomic_load_n(&_accessor, __ATOMIC_ACQUIRE);
+    if (accessor == nil || accessor->_targetClass != cls || (accessor->_keyPath != keyPath && ![accessor->_keyPath isEqualToString:keyPath])) {
+        accessor = [_MKNodeFieldAccessor accessorForClass:cls keyPath:keyPath];
+        __atomic_store_n(&_accessor, accessor, __ATOMIC_RELEASE);
+    }
     
-    if ([value isKindOfClass:MKResult.class])
+    id value = [accessor valueForObject:input];
+    
+    if (value == nil)
+        return [MKResult result];
+    else if ([value isKindOfClass:MKResult.class])
         return value;
     else
         return [MKResult resultWithValue:value];
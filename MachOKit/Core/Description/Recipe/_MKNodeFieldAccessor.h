@@ -0,0 +1,89 @@
+//----------------------------------------------------------------------------//
+//|
+//|             MachOKit - A Lightweight Mach-O Parsing Library
+//! @file       _MKNodeFieldAccessor.h
+//!
+//! @author     D.V.
+//! @copyright  Copyright (c) 2014-2015 D.V. All rights reserved.
+//|
+//| Permission is hereby granted, free of charge, to any person obtaining a
+//| copy of this software and associated documentation files (the "Software"),
+//| to deal in the Software without restriction, including without limitation
+//| the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//| and/or sell copies of the Software, and to permit persons to whom the
+//| Software is furnished to do so, subject to the following conditions:
+//|
+//| The above copyright notice and this permission notice shall be included
+//| in all copies or substantial portions of the Software.
+//|
+//| THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//| OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//| MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//| IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//| CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//| TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//| SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//----------------------------------------------------------------------------//
+
+
+#import <MachOKit/MKBase.h>
+#include <objc/runtime.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+//! The strategy used by an accessor to read its key path.
+typedef NS_ENUM(uint8_t, _MKNodeFieldAccessorKind) {
+    //! Defer to -valueForKeyPath:.
+    _MKNodeFieldAccessorKindKeyValueCoding,
+    //! Invoke the cached implementation of a getter.
+    _MKNodeFieldAccessorKindMethod,
+    //! Read an instance variable.
+    _MKNodeFieldAccessorKindInstanceVariable,
+    //! Read the first key, then the remainder of the key path from the
+    //! resulting value.
+    _MKNodeFieldAccessorKindKeyPath
+};
+
+//----------------------------------------------------------------------------//
+//! A key path compiled for instances of a single class.  Compiling resolves
+//! the getter or instance variable that key-value coding would use, so that
+//! reading the value does not repeat the key path parsing and method lookup
+//! that -valueForKeyPath: performs on every call.  Scalar values are boxed
+//! according to their type encoding, as key-value coding would.
+//!
+//! Accessors are created once per class and key path, and are never
+//! deallocated.
+//
+@interface _MKNodeFieldAccessor : NSObject {
+@package
+    Class _targetClass;
+    NSString *_keyPath;
+    _MKNodeFieldAccessorKind _kind;
+    char _valueType;
+    SEL _selector;
+    IMP _implementation;
+    Ivar _ivar;
+    ptrdiff_t _ivarOffset;
+    // Key paths
+    _MKNodeFieldAccessor *_keyAccessor;
+    NSString *_remainingKeyPath;
+    __unsafe_unretained _MKNodeFieldAccessor *_remainingKeyPathAccessor;
+}
+
+//! Returns the accessor for \a keyPath on instances of \a cls, compiling
+//! it if this is the first request for the pair.  Thread safe.
++ (_MKNodeFieldAccessor*)accessorForClass:(Class)cls keyPath:(NSString*)keyPath;
+
+//! The class the accessor was compiled for.
+@property (nonatomic, readonly) Class targetClass;
+
+//! The key path the accessor reads.
+@property (nonatomic, readonly) NSString *keyPath;
+
+//! Returns the value of the key path for \a object, which must be an
+//! instance of \c targetClass.
+- (nullable id)valueForObject:(id)object;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,308 @@
+//----------------------------------------------------------------------------//
+//|
+//|             MachOKit - A Lightweight Mach-O Parsing Library
+//|             _MKNodeFieldAccessor.m
+//|
+//|             D.V.
+//|             Copyright (c) 2014-2015 D.V. All rights reserved.
+//|
+//| Permission is hereby granted, free of charge, to any person obtaining a
+//| copy of this software and associated documentation files (the "Software"),
+//| to deal in the Software without restriction, including without limitation
+//| the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//| and/or sell copies of the Software, and to permit persons to whom the
+//| Software is furnished to do so, subject to the following conditions:
+//|
+//| The above copyright notice and this permission notice shall be included
+//| in all copies or substantial portions of the Software.
+//|
+//| THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//| OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//| MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//| IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//| CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//| TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//| SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//----------------------------------------------------------------------------//
+
+
+#import "_MKNodeFieldAccessor.h"
+#import "MKInternal.h"
+
+#include <pthread.h>
+
+//! The scalar type encodings that an accessor can box, with the C type of
+//! the value and the NSNumber factory that key-value coding uses for it.
+#define _MK_NODE_FIELD_ACCESSOR_SCALAR_TYPES(X) \
+    X('c', char, Char) \
+    X('C', unsigned char, UnsignedChar) \
+    X('s', short, Short) \
+    X('S', unsigned short, UnsignedShort) \
+    X('i', int, Int) \
+    X('I', unsigned int, UnsignedInt) \
+    X('l', long, Long) \
+    X('L', unsigned long, UnsignedLong) \
+    X('q', long long, LongLong) \
+    X('Q', unsigned long long, UnsignedLongLong) \
+    X('f', float, Float) \
+    X('d', double, Double) \
+    X('B', bool, Bool)
+
+//! Maps each class to a dictionary of the accessors compiled for it, keyed
+//! by key path.
+static CFMutableDictionaryRef s_accessors = NULL;
+static pthread_mutex_t s_accessorsLock = PTHREAD_MUTEX_INITIALIZER;
+
+//|++++++++++++++++++++++++++++++++++++|//
+//! Returns the type encoding character of a value, skipping any qualifiers,
+//! or \c '\0' if values of the type can not be read by an accessor.
+static char
+_MKNodeFieldAccessorValueType(const char *typeEncoding)
+{
+    if (typeEncoding == NULL)
+        return '\0';
+    
+    while (*typeEncoding && strchr("rnNoORV", *typeEncoding))
+        typeEncoding++;
+    
+    switch (*typeEncoding) {
+        case '@':
+        case '#':
+#define X(ENCODING, TYPE, NAME) case ENCODING:
+        _MK_NODE_FIELD_ACCESSOR_SCALAR_TYPES(X)
+#undef X
+            return *typeEncoding;
+        default:
+            return '\0';
+    }
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+//! Returns \c YES if instances of \a cls implement -valueForKey: and
+//! -valueForKeyPath: the way NSObject does.
+static BOOL
+_MKNodeFieldAccessorUsesDefaultKeyValueCoding(Class cls)
+{
+    Class root = cls;
+    while (class_getSuperclass(root))
+        root = class_getSuperclass(root);
+    if (root != NSObject.class)
+        return NO;
+    
+    SEL selectors[] = { @selector(valueForKey:), @selector(valueForKeyPath:) };
+    for (size_t i = 0; i < sizeof(selectors)/sizeof(*selectors); i++) {
+        if (class_getMethodImplementation(cls, selectors[i]) != class_getMethodImplementation(NSObject.class, selectors[i]))
+            return NO;
+    }
+    
+    return YES;
+}
+
+static _MKNodeFieldAccessor* _MKNodeFieldAccessorLookup(Class cls, NSString *keyPath);
+
+//----------------------------------------------------------------------------//
+@implementation _MKNodeFieldAccessor
+
+@synthesize targetClass = _targetClass;
+@synthesize keyPath = _keyPath;
+
+//|++++++++++++++++++++++++++++++++++++|//
++ (_MKNodeFieldAccessor*)accessorForClass:(Class)cls keyPath:(NSString*)keyPath
+{
+    NSParameterAssert(cls != Nil);
+    NSParameterAssert(keyPath != nil);
+    
+    pthread_mutex_lock(&s_accessorsLock);
+    _MKNodeFieldAccessor *accessor = _MKNodeFieldAccessorLookup(cls, keyPath);
+    pthread_mutex_unlock(&s_accessorsLock);
+    
+    return accessor;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+//! Resolves \a keyPath the way -valueForKeyPath: would for instances of
+//! \a cls.  Anything that can not be resolved ahead of time is left to
+//! key-value coding.  Must be called with \c s_accessorsLock held.
+- (instancetype)_initWithClass:(Class)cls keyPath:(NSString*)keyPath
+{
+    self = [super init];
+    if (self == nil) return nil;
+    
+    _targetClass = cls;
+    _keyPath = [keyPath copy];
+    _kind = _MKNodeFieldAccessorKindKeyValueCoding;
+    
+    // Collection operators and classes that customize key-value coding
+    // are not compiled.
+    if (keyPath.length == 0 || [keyPath rangeOfString:@"@"].location != NSNotFound || !_MKNodeFieldAccessorUsesDefaultKeyValueCoding(cls))
+        return self;
+    
+    NSRange separator = [keyPath rangeOfString:@"."];
+    if (separator.location != NSNotFound) {
+        NSString *key = [keyPath substringToIndex:separator.location];
+        NSString *remainingKeyPath = [keyPath substringFromIndex:NSMaxRange(separator)];
+        if (key.length == 0 || remainingKeyPath.length == 0)
+            return self;
+        
+        _keyAccessor = [_MKNodeFieldAccessorLookup(cls, key) retain];
+        _remainingKeyPath = [remainingKeyPath copy];
+        _kind = _MKNodeFieldAccessorKindKeyPath;
+        return self;
+    }
+    
+    NSString *key = keyPath;
+    NSString *capitalizedKey = [[key substringToIndex:1].uppercaseString stringByAppendingString:[key substringFromIndex:1]];
+    
+    // The getters searched by -valueForKey:, in order.
+    NSString *getterNames[] = {
+        [@"get" stringByAppendingString:capitalizedKey],
+        key,
+        [@"is" stringByAppendingString:capitalizedKey],
+        [@"_" stringByAppendingString:key]
+    };
+    for (size_t i = 0; i < sizeof(getterNames)/sizeof(*getterNames); i++) {
+        SEL selector = NSSelectorFromString(getterNames[i]);
+        Method method = class_getInstanceMethod(cls, selector);
+        if (method == NULL)
+            continue;
+        
+        char returnType[32];
+        method_getReturnType(method, returnType, sizeof(returnType));
+        
+        _valueType = _MKNodeFieldAccessorValueType(returnType);
+        if (_valueType && method_getNumberOfArguments(method) == 2) {
+            _selector = selector;
+            _implementation = method_getImplementation(method);
+            _kind = _MKNodeFieldAccessorKindMethod;
+        }
+        
+        // Values of other types are boxed by key-value coding.
+        return self;
+    }
+    
+    // -valueForKey: considers the collection accessor patterns before the
+    // instance variables.
+    if (class_getInstanceMethod(cls, NSSelectorFromString([@"countOf" stringByAppendingString:capitalizedKey])))
+        return self;
+    
+    if ([cls accessInstanceVariablesDirectly] == NO)
+        return self;
+    
+    // The instance variables searched by -valueForKey:, in order.
+    NSString *ivarNames[] = {
+        [@"_" stringByAppendingString:key],
+        [@"_is" stringByAppendingString:capitalizedKey],
+        key,
+        [@"is" stringByAppendingString:capitalizedKey]
+    };
+    for (size_t i = 0; i < sizeof(ivarNames)/sizeof(*ivarNames); i++) {
+        Ivar ivar = class_getInstanceVariable(cls, ivarNames[i].UTF8String);
+        if (ivar == NULL)
+            continue;
+        
+        _valueType = _MKNodeFieldAccessorValueType(ivar_getTypeEncoding(ivar));
+        if (_valueType) {
+            _ivar = ivar;
+            _ivarOffset = ivar_getOffset(ivar);
+            _kind = _MKNodeFieldAccessorKindInstanceVariable;
+        }
+        
+        return self;
+    }
+    
+    // -valueForUndefinedKey:
+    return self;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)dealloc
+{
+    [_remainingKeyPath release];
+    [_keyAccessor release];
+    [_keyPath release];
+    
+    [super dealloc];
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (id)valueForObject:(id)object
+{
+    switch (_kind) {
+        case _MKNodeFieldAccessorKindMethod:
+        {
+#define CALL(TYPE) ((TYPE (*)(id, SEL))_implementation)(object, _selector)
+            switch (_valueType) {
+                case '@':
+                case '#':
+                    return CALL(id);
+#define X(ENCODING, TYPE, NAME) case ENCODING: return [NSNumber numberWith##NAME:CALL(TYPE)];
+                _MK_NODE_FIELD_ACCESSOR_SCALAR_TYPES(X)
+#undef X
+            }
+#undef CALL
+            break;
+        }
+        case _MKNodeFieldAccessorKindInstanceVariable:
+        {
+#define READ(TYPE) (*(TYPE*)((uint8_t*)object + _ivarOffset))
+            switch (_valueType) {
+                case '@':
+                case '#':
+                    return object_getIvar(object, _ivar);
+#define X(ENCODING, TYPE, NAME) case ENCODING: return [NSNumber numberWith##NAME:READ(TYPE)];
+                _MK_NODE_FIELD_ACCESSOR_SCALAR_TYPES(X)
+#undef X
+            }
+#undef READ
+            break;
+        }
+        case _MKNodeFieldAccessorKindKeyPath:
+        {
+            id value = [_keyAccessor valueForObject:object];
+            if (value == nil)
+                return nil;
+            
+            // Remember the accessor for the class of the most recent
+            // intermediate value.  Accessors are never deallocated, so an
+            // unretained reference is safe.
+            Class cls = object_getClass(value);
+            _MKNodeFieldAccessor *accessor = __atomic_load_n(&_remainingKeyPathAccessor, __ATOMIC_ACQUIRE);
+            if (accessor == nil || accessor->_targetClass != cls) {
+                accessor = [_MKNodeFieldAccessor accessorForClass:cls keyPath:_remainingKeyPath];
+                __atomic_store_n(&_remainingKeyPathAccessor, accessor, __ATOMIC_RELEASE);
+            }
+            
+            return [accessor valueForObject:value];
+        }
+        case _MKNodeFieldAccessorKindKeyValueCoding:
+            break;
+    }
+    
+    return [object valueForKeyPath:_keyPath];
+}
+
+@end
+
+//|++++++++++++++++++++++++++++++++++++|//
+static _MKNodeFieldAccessor*
+_MKNodeFieldAccessorLookup(Class cls, NSString *keyPath)
+{
+    if (s_accessors == NULL)
+        s_accessors = CFDictionaryCreateMutable(NULL, 0, NULL, &kCFTypeDictionaryValueCallBacks);
+    
+    CFMutableDictionaryRef accessors = (CFMutableDictionaryRef)CFDictionaryGetValue(s_accessors, (const void*)cls);
+    if (accessors == NULL) {
+        accessors = CFDictionaryCreateMutable(NULL, 0, &kCFTypeDictionaryKeyCallBacks, &kCFTypeDictionaryValueCallBacks);
+        CFDictionarySetValue(s_accessors, (const void*)cls, accessors);
+        CFRelease(accessors);
+    }
+    
+    _MKNodeFieldAccessor *accessor = (_MKNodeFieldAccessor*)CFDictionaryGetValue(accessors, (CFStringRef)keyPath);
+    if (accessor == nil) {
+        accessor = [[_MKNodeFieldAccessor alloc] _initWithClass:cls keyPath:keyPath];
+        CFDictionarySetValue(accessors, (CFStringRef)accessor->_keyPath, accessor);
+        [accessor release];
+    }
+    
+    return accessor;
+}
@@ -0,0 +1,227 @@
+//----------------------------------------------------------------------------//
+//|
+//|             MachOKit - A Lightweight Mach-O Parsing Library
+//|             MKNodeCBORSink.m
+//|
+//|             D.V.
+//|             Copyright (c) 2014-2015 D.V. All rights reserved.
+//|
+//| Permission is hereby granted, free of charge, to any person obtaining a
+//| copy of this software and associated documentation files (the "Software"),
+//| to deal in the Software without restriction, including without limitation
+//| the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//| and/or sell copies of the Software, and to permit persons to whom the
+//| Software is furnished to do so, subject to the following conditions:
+//|
+//| The above copyright notice and this permission notice shall be included
+//| in all copies or substantial portions of the Software.
+//|
+//| THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//| OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//| MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//| IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//| CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//| TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//| SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//----------------------------------------------------------------------------//
+
+
+#import "MKNodeCBORSink.h"
+#import "MKInternal.h"
+#import "MKNode.h"
+#import "MKNodeField.h"
+
+#include <libkern/OSByteOrder.h>
+
+//! CBOR major types.
+enum {
+    MKNodeCBORMajorTypeUnsignedInteger      = 0,
+    MKNodeCBORMajorTypeNegativeInteger      = 1,
+    MKNodeCBORMajorTypeByteString           = 2,
+    MKNodeCBORMajorTypeTextString           = 3,
+    MKNodeCBORMajorTypeArray                = 4,
+    MKNodeCBORMajorTypeMap                  = 5,
+    MKNodeCBORMajorTypeSimple               = 7
+};
+
+//! CBOR initial bytes that are not followed by an argument.
+enum {
+    MKNodeCBORFalse                         = 0xF4,
+    MKNodeCBORTrue                          = 0xF5,
+    MKNodeCBORNull                          = 0xF6,
+    MKNodeCBORDouble                        = 0xFB,
+    MKNodeCBORIndefiniteArray               = 0x9F,
+    MKNodeCBORIndefiniteMap                 = 0xBF,
+    MKNodeCBORBreak                         = 0xFF
+};
+
+//----------------------------------------------------------------------------//
+@implementation MKNodeCBORSink
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)_writeByte:(uint8_t)byte
+{ [self writeBytes:&byte length:1]; }
+
+//|++++++++++++++++++++++++++++++++++++|//
+//! Writes the initial byte of a data item of \a majorType, followed by its
+//! argument in the shortest encoding.
+- (void)_writeHeadWithMajorType:(uint8_t)majorType argument:(uint64_t)argument
+{
+    uint8_t head[9];
+    size_t length;
+    
+    majorType = (uint8_t)(majorType << 5);
+    
+    if (argument < 24) {
+        head[0] = majorType | (uint8_t)argument;
+        length = 1;
+    } else if (argument <= UINT8_MAX) {
+        head[0] = majorType | 24;
+        head[1] = (uint8_t)argument;
+        length = 2;
+    } else if (argument <= UINT16_MAX) {
+        head[0] = majorType | 25;
+        OSWriteBigInt16(head, 1, (uint16_t)argument);
+        length = 3;
+    } else if (argument <= UINT32_MAX) {
+        head[0] = majorType | 26;
+        OSWriteBigInt32(head, 1, (uint32_t)argument);
+        length = 5;
+    } else {
+        head[0] = majorType | 27;
+        OSWriteBigInt64(head, 1, argument);
+        length = 9;
+    }
+    
+    [self writeBytes:head length:length];
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)_writeTextString:(NSString*)string
+{
+    size_t length;
+    const char *utf8 = [self UTF8StringForString:string length:&length];
+    
+    [self _writeHeadWithMajorType:MKNodeCBORMajorTypeTextString argument:length];
+    [self writeBytes:utf8 length:length];
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)_writeNumber:(NSNumber*)number
+{
+    if (CFGetTypeID((CFTypeRef)number) == CFBooleanGetTypeID()) {
+        [self _writeByte:number.boolValue ? MKNodeCBORTrue : MKNodeCBORFalse];
+        return;
+    }
+    
+    switch (number.objCType[0]) {
+        case 'f':
+        case 'd':
+        {
+            uint8_t item[9] = { MKNodeCBORDouble };
+            double value = number.doubleValue;
+            uint64_t bits;
+            memcpy(&bits, &value, sizeof(bits));
+            OSWriteBigInt64(item, 1, bits);
+            [self writeBytes:item length:sizeof(item)];
+            break;
+        }
+        case 'C':
+        case 'S':
+        case 'I':
+        case 'L':
+        case 'Q':
+            [self _writeHeadWithMajorType:MKNodeCBORMajorTypeUnsignedInteger argument:number.unsignedLongLongValue];
+            break;
+        default:
+        {
+            int64_t value = number.longLongValue;
+            if (value < 0)
+                [self _writeHeadWithMajorType:MKNodeCBORMajorTypeNegativeInteger argument:(uint64_t)(-1 - value)];
+            else
+                [self _writeHeadWithMajorType:MKNodeCBORMajorTypeUnsignedInteger argument:(uint64_t)value];
+            break;
+        }
+    }
+}
+
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+#pragma mark -  MKNodeSerializerSink
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)beginNode:(MKNode*)node fieldCount:(NSUInteger)fieldCount
+{
+#pragma unused (fieldCount)
+    [self _writeByte:MKNodeCBORIndefiniteMap];
+    [self _writeTextString:@"$class"];
+    [self _writeTextString:NSStringFromClass(node.class)];
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)endNode:(MKNode*)node
+{
+#pragma unused (node)
+    [self _writeByte:MKNodeCBORBreak];
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)beginField:(MKNodeField*)field
+{ [self _writeTextString:field.name]; }
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)endField:(MKNodeField*)field
+{
+#pragma unused (field)
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)beginCollection
+{ [self _writeByte:MKNodeCBORIndefiniteArray]; }
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)beginElement
+{ }
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)endElement
+{ }
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)endCollection
+{ [self _writeByte:MKNodeCBORBreak]; }
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)writeValue:(id)value formatter:(NSFormatter*)formatter
+{
+    if (value == nil || value == [NSNull null])
+        [self _writeByte:MKNodeCBORNull];
+    else if ([value isKindOfClass:NSNumber.class])
+        [self _writeNumber:value];
+    else if ([value isKindOfClass:NSString.class])
+        [self _writeTextString:value];
+    else if ([value isKindOfClass:NSData.class]) {
+        [self _writeHeadWithMajorType:MKNodeCBORMajorTypeByteString argument:[value length]];
+        [self writeBytes:[value bytes] length:[value length]];
+    } else {
+        NSString *string = formatter ? [formatter stringForObjectValue:value] : [value description];
+        if (string) [self _writeTextString:string];
+        else [self _writeByte:MKNodeCBORNull];
+    }
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)writeWarnings:(NSArray<NSError*> *)warnings
+{
+    [self _writeTextString:@"$warnings"];
+    [self _writeHeadWithMajorType:MKNodeCBORMajorTypeArray argument:warnings.count];
+    
+    for (NSError *warning in warnings)
+    @autoreleasepool {
+        NSString *description = [self descriptionForWarning:warning];
+        
+        [self _writeTextString:description];
+    }
+}
+
+@end
@@ -0,0 +1,51 @@
+//----------------------------------------------------------------------------//
+//|
+//|             MachOKit - A Lightweight Mach-O Parsing Library
+//! @file       MKNodeJSONSink.h
+//!
+//! @author     D.V.
+//! @copyright  Copyright (c) 2014-2015 D.V. All rights reserved.
+//|
+//| Permission is hereby granted, free of charge, to any person obtaining a
+//| copy of this software and associated documentation files (the "Software"),
+//| to deal in the Software without restriction, including without limitation
+//| the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//| and/or sell copies of the Software, and to permit persons to whom the
+//| Software is furnished to do so, subject to the following conditions:
+//|
+//| The above copyright notice and this permission notice shall be included
+//| in all copies or substantial portions of the Software.
+//|
+//| THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//| OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//| MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//| IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//| CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//| TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//| SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//----------------------------------------------------------------------------//
+
+
+#import <MachOKit/MKBase.h>
+#import <MachOKit/MKNodeOutputStreamSink.h>
+#import <MachOKit/MKNodeSerializerSink.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+//----------------------------------------------------------------------------//
+//! Writes nodes as JSON.
+//!
+//! Each node is written as an object.  The \c "$class" member is the name of
+//! the node's class, followed by a member for each field, followed by a
+//! \c "$warnings" array if the node has any warnings.  Collections are
+//! written as arrays.  Numbers, strings and \c nil are written as JSON
+//! values; all other values are written as their formatted description.
+//! Each top level node is followed by a newline.
+//
+@interface MKNodeJSONSink : MKNodeOutputStreamSink <MKNodeSerializerSink> {
+@package
+    NSMutableData *_containerHasMembers;
+}
+@end
+
+NS_ASSUME_NONNULL_END
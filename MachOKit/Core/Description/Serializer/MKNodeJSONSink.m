@@ -0,0 +1,250 @@
+//----------------------------------------------------------------------------//
+//|
+//|             MachOKit - A Lightweight Mach-O Parsing Library
+//|             MKNodeJSONSink.m
+//|
+//|             D.V.
+//|             Copyright (c) 2014-2015 D.V. All rights reserved.
+//|
+//| Permission is hereby granted, free of charge, to any person obtaining a
+//| copy of this software and associated documentation files (the "Software"),
+//| to deal in the Software without restriction, including without limitation
+//| the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//| and/or sell copies of the Software, and to permit persons to whom the
+//| Software is furnished to do so, subject to the following conditions:
+//|
+//| The above copyright notice and this permission notice shall be included
+//| in all copies or substantial portions of the Software.
+//|
+//| THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//| OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//| MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//| IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//| CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//| TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//| SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//----------------------------------------------------------------------------//
+
+
+#import "MKNodeJSONSink.h"
+#import "MKInternal.h"
+#import "MKNode.h"
+#import "MKNodeField.h"
+
+//----------------------------------------------------------------------------//
+@implementation MKNodeJSONSink
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (instancetype)initWithOutputStream:(NSOutputStream*)outputStream
+{
+    self = [super initWithOutputStream:outputStream];
+    if (self == nil) return nil;
+    
+    _containerHasMembers = [[NSMutableData alloc] init];
+    
+    return self;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)dealloc
+{
+    [_containerHasMembers release];
+    
+    [super dealloc];
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)_pushContainer
+{
+    uint8_t hasMembers = 0;
+    [_containerHasMembers appendBytes:&hasMembers length:1];
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)_popContainer
+{ _containerHasMembers.length -= 1; }
+
+//|++++++++++++++++++++++++++++++++++++|//
+//! Writes the separator that precedes each member of an object or array,
+//! other than the first.
+- (void)_writeSeparator
+{
+    uint8_t *hasMembers = (uint8_t*)_containerHasMembers.mutableBytes + _containerHasMembers.length - 1;
+    if (*hasMembers)
+        [self writeBytes:"," length:1];
+    *hasMembers = 1;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)_writeQuotedString:(NSString*)string
+{
+    size_t length;
+    const uint8_t *p = (const uint8_t*)[self UTF8StringForString:string length:&length];
+    const uint8_t *end = p + length;
+    const uint8_t *run = p;
+    
+    [self writeBytes:"\"" length:1];
+    
+    // Copy runs of characters that do not need escaping.
+    for (; p < end; p++)
+    {
+        uint8_t c = *p;
+        if (c >= 0x20 && c != '"' && c != '\\')
+            continue;
+        
+        [self writeBytes:run length:(size_t)(p - run)];
+        run = p + 1;
+        
+        switch (c) {
+            case '"':  [self writeBytes:"\\\"" length:2]; break;
+            case '\\': [self writeBytes:"\\\\" length:2]; break;
+            case '\n': [self writeBytes:"\\n" length:2]; break;
+            case '\r': [self writeBytes:"\\r" length:2]; break;
+            case '\t': [self writeBytes:"\\t" length:2]; break;
+            default: {
+                char escape[7];
+                snprintf(escape, sizeof(escape), "\\u%04x", c);
+                [self writeBytes:escape length:6];
+                break;
+            }
+        }
+    }
+    
+    [self writeBytes:run length:(size_t)(p - run)];
+    [self writeBytes:"\"" length:1];
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)_writeNumber:(NSNumber*)number
+{
+    char string[32];
+    int length;
+    
+    if (CFGetTypeID((CFTypeRef)number) == CFBooleanGetTypeID()) {
+        if (number.boolValue) [self writeBytes:"true" length:4];
+        else [self writeBytes:"false" length:5];
+        return;
+    }
+    
+    switch (number.objCType[0]) {
+        case 'f':
+        case 'd':
+            if (!isfinite(number.doubleValue)) {
+                [self writeBytes:"null" length:4];
+                return;
+            }
+            length = snprintf(string, sizeof(string), "%.17g", number.doubleValue);
+            break;
+        case 'C':
+        case 'S':
+        case 'I':
+        case 'L':
+        case 'Q':
+            length = snprintf(string, sizeof(string), "%llu", number.unsignedLongLongValue);
+            break;
+        default:
+            length = snprintf(string, sizeof(string), "%lld", number.longLongValue);
+            break;
+    }
+    
+    [self writeBytes:string length:(size_t)length];
+}
+
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+#pragma mark -  MKNodeSerializerSink
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)beginNode:(MKNode*)node fieldCount:(NSUInteger)fieldCount
+{
+#pragma unused (fieldCount)
+    [self writeBytes:"{\"$class\":" length:10];
+    [self _writeQuotedString:NSStringFromClass(node.class)];
+    
+    [self _pushContainer];
+    [self _writeSeparator];
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)endNode:(MKNode*)node
+{
+#pragma unused (node)
+    [self _popContainer];
+    [self writeBytes:"}" length:1];
+    
+    if (_containerHasMembers.length == 0)
+        [self writeBytes:"\n" length:1];
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)beginField:(MKNodeField*)field
+{
+    [self _writeSeparator];
+    [self _writeQuotedString:field.name];
+    [self writeBytes:":" length:1];
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)endField:(MKNodeField*)field
+{
+#pragma unused (field)
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)beginCollection
+{
+    [self writeBytes:"[" length:1];
+    [self _pushContainer];
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)beginElement
+{ [self _writeSeparator]; }
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)endElement
+{ }
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)endCollection
+{
+    [self _popContainer];
+    [self writeBytes:"]" length:1];
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)writeValue:(id)value formatter:(NSFormatter*)formatter
+{
+    if (value == nil || value == [NSNull null])
+        [self writeBytes:"null" length:4];
+    else if ([value isKindOfClass:NSNumber.class])
+        [self _writeNumber:value];
+    else if ([value isKindOfClass:NSString.class])
+        [self _writeQuotedString:value];
+    else {
+        NSString *string = formatter ? [formatter stringForObjectValue:value] : [value description];
+        if (string) [self _writeQuotedString:string];
+        else [self writeBytes:"null" length:4];
+    }
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)writeWarnings:(NSArray<NSError*> *)warnings
+{
+    [self _writeSeparator];
+    [self writeBytes:"\"$warnings\":[" length:13];
+    
+    BOOL first = YES;
+    for (NSError *warning in warnings)
+    @autoreleasepool {
+        NSString *description = [self descriptionForWarning:warning];
+        
+        if (!first) [self writeBytes:"," length:1];
+        [self _writeQuotedString:description];
+        first = NO;
+    }
+    
+    [self writeBytes:"]" length:1];
+}
+
+@end
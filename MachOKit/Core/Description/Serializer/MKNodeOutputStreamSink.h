@@ -0,0 +1,83 @@
+//----------------------------------------------------------------------------//
+//|
+//|             MachOKit - A Lightweight Mach-O Parsing Library
+//! @file       MKNodeOutputStreamSink.h
+//!
+//! @author     D.V.
+//! @copyright  Copyright (c) 2014-2015 D.V. All rights reserved.
+//|
+//| Permission is hereby granted, free of charge, to any person obtaining a
+//| copy of this software and associated documentation files (the "Software"),
+//| to deal in the Software without restriction, including without limitation
+//| the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//| and/or sell copies of the Software, and to permit persons to whom the
+//| Software is furnished to do so, subject to the following conditions:
+//|
+//| The above copyright notice and this permission notice shall be included
+//| in all copies or substantial portions of the Software.
+//|
+//| THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//| OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//| MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//| IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//| CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//| TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//| SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//----------------------------------------------------------------------------//
+
+
+#import <MachOKit/MKBase.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+//----------------------------------------------------------------------------//
+//! Base class for serializer sinks that write to an \c NSOutputStream.
+//! Output is accumulated in a fixed size buffer, which is written to the
+//! stream whenever it fills.  If the stream fails, the error is kept and
+//! further output is discarded.
+//!
+//! Subclasses adopt \ref MKNodeSerializerSink.
+//
+@interface MKNodeOutputStreamSink : NSObject {
+@package
+    NSOutputStream *_outputStream;
+    uint8_t *_buffer;
+    size_t _bufferLength;
+    NSError *_error;
+}
+
+//! Initializes the receiver with the provided \a outputStream.  The stream
+//! is opened if it is not already open.
+- (instancetype)initWithOutputStream:(NSOutputStream*)outputStream NS_DESIGNATED_INITIALIZER;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+//! The stream that output is written to.
+@property (nonatomic, readonly) NSOutputStream *outputStream;
+
+//! The first error encountered writing to the stream.
+@property (nonatomic, readonly, nullable) NSError *error;
+
+//! Appends \a length bytes to the output.
+- (void)writeBytes:(const void*)bytes length:(size_t)length;
+
+//! Appends the UTF-8 encoding of \a string to the output.
+- (void)writeString:(NSString*)string;
+
+//! Returns the UTF-8 encoding of \a string, and its length in \a length.
+//! Characters that can not be encoded are replaced.  The returned pointer
+//! is valid until the current autorelease pool is drained.
+- (const char*)UTF8StringForString:(NSString*)string length:(size_t*)length;
+
+//! Returns a single line describing \a warning and its underlying errors.
+- (NSString*)descriptionForWarning:(NSError*)warning;
+
+//! Writes any buffered output to the stream.
+- (BOOL)flushWithError:(NSError**)error;
+
+//! Writes any buffered output to the stream.
+- (BOOL)finishWithError:(NSError**)error;
+
+@end
+
+NS_ASSUME_NONNULL_END
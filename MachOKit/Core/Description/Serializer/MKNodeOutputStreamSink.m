@@ -0,0 +1,180 @@
+//----------------------------------------------------------------------------//
+//|
+//|             MachOKit - A Lightweight Mach-O Parsing Library
+//|             MKNodeOutputStreamSink.m
+//|
+//|             D.V.
+//|             Copyright (c) 2014-2015 D.V. All rights reserved.
+//|
+//| Permission is hereby granted, free of charge, to any person obtaining a
+//| copy of this software and associated documentation files (the "Software"),
+//| to deal in the Software without restriction, including without limitation
+//| the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//| and/or sell copies of the Software, and to permit persons to whom the
+//| Software is furnished to do so, subject to the following conditions:
+//|
+//| The above copyright notice and this permission notice shall be included
+//| in all copies or substantial portions of the Software.
+//|
+//| THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//| OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//| MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//| IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//| CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//| TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//| SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//----------------------------------------------------------------------------//
+
+
+#import "MKNodeOutputStreamSink.h"
+#import "MKInternal.h"
+#import "NSError+MK.h"
+
+//! The size of the buffer that output is accumulated in.
+static const size_t MKNodeOutputStreamSinkBufferSize = 64 * 1024;
+
+//----------------------------------------------------------------------------//
+@implementation MKNodeOutputStreamSink
+
+@synthesize outputStream = _outputStream;
+@synthesize error = _error;
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (instancetype)initWithOutputStream:(NSOutputStream*)outputStream
+{
+    NSParameterAssert(outputStream != nil);
+    
+    self = [super init];
+    if (self == nil) return nil;
+    
+    _buffer = malloc(MKNodeOutputStreamSinkBufferSize);
+    if (_buffer == NULL) {
+        [self release]; return nil;
+    }
+    
+    _outputStream = [outputStream retain];
+    if (_outputStream.streamStatus == NSStreamStatusNotOpen)
+        [_outputStream open];
+    
+    return self;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (instancetype)init
+{ @throw [NSException exceptionWithName:NSInvalidArgumentException reason:@"-init unavailable." userInfo:nil]; }
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)dealloc
+{
+    [self flushWithError:NULL];
+    
+    [_error release];
+    [_outputStream release];
+    free(_buffer);
+    
+    [super dealloc];
+}
+
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+#pragma mark -  Writing Output
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)writeBytes:(const void*)bytes length:(size_t)length
+{
+    while (length > 0)
+    {
+        if (_bufferLength == MKNodeOutputStreamSinkBufferSize && [self flushWithError:NULL] == NO)
+            return;
+        
+        size_t count = MIN(length, MKNodeOutputStreamSinkBufferSize - _bufferLength);
+        memcpy(_buffer + _bufferLength, bytes, count);
+        _bufferLength += count;
+        
+        bytes = (const uint8_t*)bytes + count;
+        length -= count;
+    }
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)writeString:(NSString*)string
+{
+    NSRange remaining = NSMakeRange(0, string.length);
+    
+    // Encode directly into the buffer, flushing whenever it fills.
+    while (remaining.length > 0)
+    {
+        NSUInteger used = 0;
+        BOOL encoded = [string getBytes:_buffer + _bufferLength maxLength:MKNodeOutputStreamSinkBufferSize - _bufferLength usedLength:&used encoding:NSUTF8StringEncoding options:NSStringEncodingConversionAllowLossy range:remaining remainingRange:&remaining];
+        _bufferLength += used;
+        
+        if (remaining.length == 0)
+            break;
+        
+        // Nothing could be encoded into an empty buffer.  Give up rather
+        // than loop forever.
+        if (!encoded && used == 0 && _bufferLength == 0)
+            break;
+        
+        if ([self flushWithError:NULL] == NO)
+            return;
+    }
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (const char*)UTF8StringForString:(NSString*)string length:(size_t*)length
+{
+    const char *utf8 = string.UTF8String;
+    if (utf8) {
+        *length = strlen(utf8);
+        return utf8;
+    }
+    
+    // The string contains characters that can not be encoded, such as an
+    // unpaired surrogate.
+    NSData *data = [string dataUsingEncoding:NSUTF8StringEncoding allowLossyConversion:YES];
+    *length = data.length;
+    return data.bytes ?: "";
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (NSString*)descriptionForWarning:(NSError*)warning
+{
+    NSMutableString *description = [NSMutableString stringWithFormat:@"%@: %@", warning.mk_property, warning.localizedDescription];
+    
+    for (NSError *w = warning.userInfo[NSUnderlyingErrorKey]; w != nil; w = w.userInfo[NSUnderlyingErrorKey])
+        [description appendFormat:@" -> %@", w.localizedDescription];
+    
+    return description;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (BOOL)flushWithError:(NSError**)error
+{
+    size_t offset = 0;
+    
+    while (_error == nil && offset < _bufferLength)
+    {
+        NSInteger written = [_outputStream write:_buffer + offset maxLength:_bufferLength - offset];
+        if (written <= 0)
+            _error = [(_outputStream.streamError ?: [NSError mk_errorWithDomain:MKErrorDomain code:MK_EINTERNAL_ERROR description:@"Could not write to the output stream."]) retain];
+        else
+            offset += (size_t)written;
+    }
+    
+    // Output is discarded once the stream has failed.
+    _bufferLength = 0;
+    
+    if (_error) {
+        MK_ERROR_OUT = _error;
+        return NO;
+    }
+    
+    return YES;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (BOOL)finishWithError:(NSError**)error
+{ return [self flushWithError:error]; }
+
+@end
@@ -0,0 +1,65 @@
+//----------------------------------------------------------------------------//
+//|
+//|             MachOKit - A Lightweight Mach-O Parsing Library
+//! @file       MKNodeSerializer.h
+//!
+//! @author     D.V.
+//! @copyright  Copyright (c) 2014-2015 D.V. All rights reserved.
+//|
+//| Permission is hereby granted, free of charge, to any person obtaining a
+//| copy of this software and associated documentation files (the "Software"),
+//| to deal in the Software without restriction, including without limitation
+//| the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//| and/or sell copies of the Software, and to permit persons to whom the
+//| Software is furnished to do so, subject to the following conditions:
+//|
+//| The above copyright notice and this permission notice shall be included
+//| in all copies or substantial portions of the Software.
+//|
+//| THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//| OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//| MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//| IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//| CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//| TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//| SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//----------------------------------------------------------------------------//
+
+
+#import <MachOKit/MKBase.h>
+#import <MachOKit/MKNodeSerializerSink.h>
+
+@class MKNode;
+@class MKNodeDescription;
+
+NS_ASSUME_NONNULL_BEGIN
+
+//----------------------------------------------------------------------------//
+//! Walks the layout of a node and writes its fields to a sink as they are
+//! read.  Unlike \c -textualDescriptionForNode:traversalDepth:, nothing is
+//! accumulated in memory; output is written to the sink field by field, so
+//! trees of any size can be serialized with bounded memory.
+//
+@interface MKNodeSerializer : NSObject {
+@package
+    id<MKNodeSerializerSink> _sink;
+}
+
+- (instancetype)initWithSink:(id<MKNodeSerializerSink>)sink NS_DESIGNATED_INITIALIZER;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+//! The sink that receives the output of the serializer.
+@property (nonatomic, readonly) id<MKNodeSerializerSink> sink;
+
+//! Serializes \a node using its \c layout.  Child nodes are descended into
+//! until \a traversalDepth is reached.
+- (BOOL)serializeNode:(MKNode*)node traversalDepth:(NSUInteger)traversalDepth error:(NSError**)error;
+
+//! Serializes \a node using the provided \a description, or the node's
+//! \c layout if \a description is \c nil.
+- (BOOL)serializeNode:(MKNode*)node description:(nullable MKNodeDescription*)description traversalDepth:(NSUInteger)traversalDepth error:(NSError**)error;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,139 @@
+//----------------------------------------------------------------------------//
+//|
+//|             MachOKit - A Lightweight Mach-O Parsing Library
+//|             MKNodeSerializer.m
+//|
+//|             D.V.
+//|             Copyright (c) 2014-2015 D.V. All rights reserved.
+//|
+//| Permission is hereby granted, free of charge, to any person obtaining a
+//| copy of this software and associated documentation files (the "Software"),
+//| to deal in the Software without restriction, including without limitation
+//| the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//| and/or sell copies of the Software, and to permit persons to whom the
+//| Software is furnished to do so, subject to the following conditions:
+//|
+//| The above copyright notice and this permission notice shall be included
+//| in all copies or substantial portions of the Software.
+//|
+//| THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//| OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//| MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//| IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//| CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//| TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//| SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//----------------------------------------------------------------------------//
+
+
+#import "MKNodeSerializer.h"
+#import "MKInternal.h"
+#import "MKNode.h"
+#import "MKNodeDescription.h"
+
+//----------------------------------------------------------------------------//
+@implementation MKNodeSerializer
+
+@synthesize sink = _sink;
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (instancetype)initWithSink:(id<MKNodeSerializerSink>)sink
+{
+    NSParameterAssert(sink != nil);
+    
+    self = [super init];
+    if (self == nil) return nil;
+    
+    _sink = [sink retain];
+    
+    return self;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (instancetype)init
+{ @throw [NSException exceptionWithName:NSInvalidArgumentException reason:@"-init unavailable." userInfo:nil]; }
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)dealloc
+{
+    [_sink release];
+    
+    [super dealloc];
+}
+
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+#pragma mark -  Serializing Nodes
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)_serializeValue:(id)value field:(MKNodeField*)field traversalDepth:(NSUInteger)traversalDepth
+{
+    // Nodes and collections are walked a specific way, regardless of what
+    // the field says.
+    if ([value isKindOfClass:MKNode.class]) {
+        // Only recurse on the node if we have not reached the traversal depth
+        if (traversalDepth > 0 && (field.options & MKNodeFieldOptionIgnoreContainerContents) == 0) {
+            [self _serializeNode:value description:[value layout] traversalDepth:traversalDepth-1];
+            return;
+        }
+        /* else, fallthrough */
+    }
+    else if ([value conformsToProtocol:@protocol(NSFastEnumeration)]) {
+        BOOL isDictionary = [value isKindOfClass:NSDictionary.class];
+        MKNodeField *childField = nil;
+        if (field.options & MKNodeFieldOptionFormatCollectionValues)
+            childField = field;
+        
+        [_sink beginCollection];
+        for (id item in value)
+        @autoreleasepool {
+            [_sink beginElement];
+            [self _serializeValue:(isDictionary ? [value objectForKey:item] : item) field:childField traversalDepth:traversalDepth];
+            [_sink endElement];
+        }
+        [_sink endCollection];
+        return;
+    }
+    
+    [_sink writeValue:value formatter:field.valueFormatter];
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)_serializeNode:(MKNode*)node description:(MKNodeDescription*)description traversalDepth:(NSUInteger)traversalDepth
+{
+    NSArray<MKNodeField*> *fields = description.allFields;
+    
+    [_sink beginNode:node fieldCount:fields.count];
+    
+    for (MKNodeField *field in fields)
+    @autoreleasepool {
+        id value = [field.valueRecipe valueForField:field ofNode:node].value;
+        
+        [_sink beginField:field];
+        [self _serializeValue:value field:field traversalDepth:traversalDepth];
+        [_sink endField:field];
+    }
+    
+    if (fields.count && node.warnings.count)
+        [_sink writeWarnings:node.warnings];
+    
+    [_sink endNode:node];
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (BOOL)serializeNode:(MKNode*)node description:(MKNodeDescription*)description traversalDepth:(NSUInteger)traversalDepth error:(NSError**)error
+{
+    NSParameterAssert(node != nil);
+    
+    @autoreleasepool {
+        [self _serializeNode:node description:(description ?: node.layout) traversalDepth:traversalDepth];
+    }
+    
+    return [_sink finishWithError:error];
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (BOOL)serializeNode:(MKNode*)node traversalDepth:(NSUInteger)traversalDepth error:(NSError**)error
+{ return [self serializeNode:node description:nil traversalDepth:traversalDepth error:error]; }
+
+@end
@@ -0,0 +1,83 @@
+//----------------------------------------------------------------------------//
+//|
+//|             MachOKit - A Lightweight Mach-O Parsing Library
+//! @file       MKNodeSerializerSink.h
+//!
+//! @author     D.V.
+//! @copyright  Copyright (c) 2014-2015 D.V. All rights reserved.
+//|
+//| Permission is hereby granted, free of charge, to any person obtaining a
+//| copy of this software and associated documentation files (the "Software"),
+//| to deal in the Software without restriction, including without limitation
+//| the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//| and/or sell copies of the Software, and to permit persons to whom the
+//| Software is furnished to do so, subject to the following conditions:
+//|
+//| The above copyright notice and this permission notice shall be included
+//| in all copies or substantial portions of the Software.
+//|
+//| THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//| OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//| MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//| IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//| CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//| TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//| SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//----------------------------------------------------------------------------//
+
+
+#import <MachOKit/MKBase.h>
+
+@class MKNode;
+@class MKNodeField;
+
+NS_ASSUME_NONNULL_BEGIN
+
+//----------------------------------------------------------------------------//
+//! The events emitted by an \ref MKNodeSerializer as it walks a node.
+//!
+//! Events are always balanced.  Between \c -beginNode:fieldCount: and
+//! \c -endNode:, each field of the node is bracketed by \c -beginField: and
+//! \c -endField:.  Each field, and each collection element, contains exactly
+//! one value, node or collection.
+//
+@protocol MKNodeSerializerSink <NSObject>
+
+//! Begins \a node, which has \a fieldCount fields.
+- (void)beginNode:(MKNode*)node fieldCount:(NSUInteger)fieldCount;
+
+//! Ends \a node.
+- (void)endNode:(MKNode*)node;
+
+//! Begins the value of \a field in the current node.
+- (void)beginField:(MKNodeField*)field;
+
+//! Ends the value of \a field.
+- (void)endField:(MKNodeField*)field;
+
+//! Begins a collection.  For a dictionary, only the values are emitted.
+- (void)beginCollection;
+
+//! Begins the next element of the current collection.
+- (void)beginElement;
+
+//! Ends the current element of the current collection.
+- (void)endElement;
+
+//! Ends the current collection.
+- (void)endCollection;
+
+//! Writes a value that is not descended into.  \a formatter is the formatter
+//! for the value's field, if it has one.
+- (void)writeValue:(nullable id)value formatter:(nullable NSFormatter*)formatter;
+
+//! Writes the warnings of the current node.  Called after the last field of
+//! a node, if the node has any warnings.
+- (void)writeWarnings:(NSArray<NSError*> *)warnings;
+
+//! Called when a serialization is complete.  Writes any buffered output.
+- (BOOL)finishWithError:(NSError**)error;
+
+@end
+
+NS_ASSUME_NONNULL_END
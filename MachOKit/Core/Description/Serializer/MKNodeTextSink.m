@@ -0,0 +1,169 @@
+//----------------------------------------------------------------------------//
+//|
+//|             MachOKit - A Lightweight Mach-O Parsing Library
+//|             MKNodeTextSink.m
+//|
+//|             D.V.
+//|             Copyright (c) 2014-2015 D.V. All rights reserved.
+//|
+//| Permission is hereby granted, free of charge, to any person obtaining a
+//| copy of this software and associated documentation files (the "Software"),
+//| to deal in the Software without restriction, including without limitation
+//| the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//| and/or sell copies of the Software, and to permit persons to whom the
+//| Software is furnished to do so, subject to the following conditions:
+//|
+//| The above copyright notice and this permission notice shall be included
+//| in all copies or substantial portions of the Software.
+//|
+//| THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//| OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//| MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//| IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//| CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//| TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//| SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//----------------------------------------------------------------------------//
+
+
+#import "MKNodeTextSink.h"
+#import "MKInternal.h"
+#import "MKNode.h"
+#import "MKBackedNode.h"
+#import "MKNodeField.h"
+
+//----------------------------------------------------------------------------//
+@implementation MKNodeTextSink
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (instancetype)initWithOutputStream:(NSOutputStream*)outputStream
+{
+    self = [super initWithOutputStream:outputStream];
+    if (self == nil) return nil;
+    
+    _nodeHasFields = [[NSMutableData alloc] init];
+    
+    return self;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)dealloc
+{
+    [_nodeHasFields release];
+    
+    [super dealloc];
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+//! Writes \a text, following each newline with the current indentation.
+- (void)_writeText:(NSString*)text
+{
+    NSRange newline = [text rangeOfString:@"\n"];
+    if (newline.location == NSNotFound) {
+        [self writeString:text];
+        return;
+    }
+    
+    NSUInteger location = 0;
+    while (newline.location != NSNotFound)
+    {
+        [self writeString:[text substringWithRange:NSMakeRange(location, NSMaxRange(newline) - location)]];
+        for (NSUInteger i = 0; i < _indentation; i++)
+            [self writeBytes:"\t" length:1];
+        
+        location = NSMaxRange(newline);
+        newline = [text rangeOfString:@"\n" options:NSLiteralSearch range:NSMakeRange(location, text.length - location)];
+    }
+    
+    if (location < text.length)
+        [self writeString:[text substringFromIndex:location]];
+}
+
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+#pragma mark -  MKNodeSerializerSink
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)beginNode:(MKNode*)node fieldCount:(NSUInteger)fieldCount
+{
+    // HACK HACK - Special case for MKBackedNode and MKAddressedNode
+    if ([node respondsToSelector:@selector(nodeContextAddress)] && [node respondsToSelector:@selector(nodeSize)])
+        [self _writeText:[NSString stringWithFormat:@"<%@ %p; contextAddress = 0x%" MK_VM_PRIxADDR "; size = %" MK_VM_PRIiSIZE ">",
+                          node.class, node, [(MKBackedNode*)node nodeContextAddress], [(MKBackedNode*)node nodeSize]]];
+    else if ([node respondsToSelector:@selector(nodeContextAddress)])
+        [self _writeText:[NSString stringWithFormat:@"<%@ %p; contextAddress = 0x%" MK_VM_PRIxADDR ">",
+                          node.class, node, [(MKAddressedNode*)node nodeContextAddress]]];
+    else
+        [self _writeText:[NSString stringWithFormat:@"<%@ %p>", node.class, node]];
+    
+    uint8_t hasFields = (fieldCount > 0);
+    [_nodeHasFields appendBytes:&hasFields length:1];
+    
+    if (hasFields)
+        [self _writeText:@" {\n"];
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)endNode:(MKNode*)node
+{
+#pragma unused (node)
+    uint8_t hasFields = ((uint8_t*)_nodeHasFields.mutableBytes)[_nodeHasFields.length - 1];
+    _nodeHasFields.length -= 1;
+    
+    if (hasFields)
+        [self _writeText:@"}"];
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)beginField:(MKNodeField*)field
+{
+    [self _writeText:[NSString stringWithFormat:@"\t%@ = ", field.name]];
+    _indentation++;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)endField:(MKNodeField*)field
+{
+#pragma unused (field)
+    _indentation--;
+    [self _writeText:@"\n"];
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)beginCollection
+{ [self _writeText:@"("]; }
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)beginElement
+{
+    [self _writeText:@"\n\t"];
+    _indentation++;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)endElement
+{ _indentation--; }
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)endCollection
+{ [self _writeText:@"\n)"]; }
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)writeValue:(id)value formatter:(NSFormatter*)formatter
+{
+    NSString *string = formatter ? [formatter stringForObjectValue:value] : [value description];
+    [self _writeText:string ?: @"(null)"];
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)writeWarnings:(NSArray<NSError*> *)warnings
+{
+    [self _writeText:@"\twarnings = {\n"];
+    for (NSError *warning in warnings)
+    @autoreleasepool {
+        [self _writeText:[NSString stringWithFormat:@"\t\t%@\n", [self descriptionForWarning:warning]]];
+    }
+    [self _writeText:@"\t}\n"];
+}
+
+@end
@@ -52,6 +52,12 @@ struct MKPtr {
 _mk_internal_extern bool
 MKPtrInitialize(struct MKPtr *ptr, MKBackedNode *node, mk_vm_address_t addr, NSDictionary<NSString*, id> * __nullable ctx, NSError **error);
 
+//! Like \c MKPtrInitialize, but \a addr must already follow
+//! \c MKNodeVMAddress semantics.  The slide of an image that was loaded
+//! from memory is not removed again.
+_mk_internal_extern bool
+MKPtrInitializeWithVMAddress(struct MKPtr *ptr, MKBackedNode *node, mk_vm_address_t addr, NSDictionary<NSString*, id> * __nullable ctx, NSError **error);
+
 //!
 _mk_internal_extern void
 MKPtrDestory(struct MKPtr *ptr);
@@ -64,7 +64,7 @@ NSString * const MKInitializationContextErrorKey = @"MKInitializationContextErro
 
 //|++++++++++++++++++++++++++++++++++++|//
 bool
-MKPtrInitialize(struct MKPtr *ptr, MKBackedNode *node, mk_vm_address_t addr, NSDictionary *ctx, __unused NSError **error)
+MKPtrInitialize(struct MKPtr *ptr, MKBackedNode *node, mk_vm_address_t addr, NSDictionary *ctx, NSError **error)
 {
     NSCParameterAssert([node isKindOfClass:MKBackedNode.class]);
     
@@ -79,6 +79,15 @@ MKPtrInitialize(struct MKPtr *ptr, MKBackedNode *node, mk_vm_address_t addr, NSD
             return false;
     }
     
+    return MKPtrInitializeWithVMAddress(ptr, node, addr, ctx, error);
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+bool
+MKPtrInitializeWithVMAddress(struct MKPtr *ptr, MKBackedNode *node, mk_vm_address_t addr, NSDictionary *ctx, __unused NSError **error)
+{
+    NSCParameterAssert([node isKindOfClass:MKBackedNode.class]);
+    
     ptr->parent = node;
     ptr->address = addr;
     if (ctx)
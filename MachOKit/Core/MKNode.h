@@ -51,6 +51,12 @@ NS_ASSUME_NONNULL_BEGIN
 @interface MKNode : NSObject {
 @package
     /*__weak*/ MKNode *_parent;
+    // The memory map and data model of the parent, captured at
+    // initialization.  The node tree is immutable so these never change.
+    MKMemoryMap *_parentMemoryMap;
+    MKDataModel *_parentDataModel;
+    // Set by the first call to -macho.  See MKNode+MachO.
+    /*__weak*/ MKNode *_macho;
 }
 
 //! Initializes the receiver with the provided \a parent node.  Subclasses
@@ -68,9 +74,25 @@ NS_ASSUME_NONNULL_BEGIN
 //! Returns the layout of this node.
 //!
 //! A layout describes the fields parsed from the range of the data represented
-//! by this node.
+//! by this node.  Layouts are immutable.  The layout is built by
+//! \c -buildLayout the first time it is requested for a node of the
+//! receiver's class with a given \c layoutKey, then shared by every node of
+//! the class with an equal key.  This method is thread safe.
 @property (nonatomic, readonly) MKNodeDescription *layout;
 
+//! The state of the receiver that its layout depends on.  The default is
+//! the receiver's data model, which determines the size of pointer sized
+//! fields.  Subclasses whose layout depends on additional state, such as
+//! a flag that adds or removes fields, must override this property and
+//! combine that state with the value returned by \c super.
+@property (nonatomic, readonly, nullable) id layoutKey;
+
+//! Builds a new layout for the receiver.  Subclasses override this method
+//! to add their fields to the layout returned by \c super.  The layout may
+//! only depend on the receiver's class and \c layoutKey.  Call
+//! \c -layout rather than this method to obtain the layout of a node.
+- (MKNodeDescription*)buildLayout;
+
 //! A description that captures node specific information such as class,
 //! address, and size (for backed nodes).  Useful when forming error messages
 //! where knowng this information is important, even when the node class
@@ -91,8 +113,9 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, assign, nullable) id<MKNodeDelegate> delegate;
 
 //! The memory map for the node.  By default this is the memory map of the
-//! node's parent.  Subclasses should override the getter for this property
-//! to provide the \ref MKMemoryMap that is to be used by their child nodes.
+//! node's parent, captured when the node is initialized.  Subclasses should
+//! override the getter for this property to provide the \ref MKMemoryMap
+//! that is to be used by their child nodes.
 @property (nonatomic, readonly) MKMemoryMap *memoryMap;
 
 //! The data model used for accessing memory in this node.  By default this is
@@ -128,12 +151,59 @@ NS_ASSUME_NONNULL_BEGIN
 //◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
 
 //! Returns a set containing all of the known subclasses of the receiver.
+//!
+//! The known subclasses are the subclasses in MachOKit, any class passed
+//! to \ref registerSubclass:, and any subclass found by the fallback scan
+//! described under \ref bestSubclassWithRanking:.  Unlike earlier versions
+//! of MachOKit, the rest of the classes loaded in the process are not
+//! examined.
 + (NSSet*)subclasses;
 
+//! Makes \a subclass known to \ref subclasses and the subclass dispatch
+//! tables.
+//!
+//! @warning    Earlier versions of MachOKit found subclasses by examining
+//!             every class in the process.  Subclasses defined outside of
+//!             MachOKit should now be registered, typically from their
+//!             \c +load method.  An unregistered subclass is only found
+//!             by the fallback scan, and is only selected for an input
+//!             that none of the known subclasses claim.
++ (void)registerSubclass:(Class)subclass;
+
 //! Returns the subclass with the highest ranking, as determined by the
 //! provided block.
+//!
+//! If none of the known subclasses rank the input, the images loaded
+//! since the last such scan, other than those in the shared cache, are
+//! scanned for unregistered subclasses.  Any that are found are
+//! registered and the subclasses are ranked again.
 + (Class)bestSubclassWithRanking:(uint32_t (^)(Class cls))rank;
 
+//! Returns the subclass with the highest ranking for \a key, as determined
+//! by the provided block.
+//!
+//! \a key must capture every input to the ranking methods consulted by
+//! \a rank for the subclasses in the receiver's dispatch table.  The best
+//! of those subclasses is computed the first time \a key is seen and is
+//! looked up thereafter.  The remaining subclasses are ranked by \a rank
+//! on every call.  Classes that do not provide a dispatch table always
+//! behave like \ref bestSubclassWithRanking:.
++ (Class)bestSubclassForDispatchKey:(id<NSCopying>)key withRanking:(uint32_t (^)(Class cls))rank;
+
+//! Equivalent to \ref bestSubclassForDispatchKey:withRanking: with a key
+//! formed by the \a length bytes at \a bytes.  Keys are compared byte for
+//! byte, so any padding must be zeroed.  Looking up a key that has been
+//! seen before does not allocate.
++ (Class)bestSubclassForDispatchKeyBytes:(const void*)bytes length:(size_t)length withRanking:(uint32_t (^)(Class cls))rank;
+
+//! Returns \c YES if the ranking of \a subclass is fully determined by the
+//! dispatch key passed to \ref bestSubclassForDispatchKey:withRanking:.
+//! The default implementation returns \c YES for subclasses that are
+//! part of MachOKit.  Base classes whose ranking methods receive nothing
+//! beyond the dispatch key may override this method to return \c YES for
+//! all subclasses.
++ (BOOL)rankingIsDeterminedByDispatchKeyForSubclass:(Class)subclass;
+
 @end
 
 NS_ASSUME_NONNULL_END
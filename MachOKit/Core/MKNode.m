@@ -27,13 +27,35 @@
 
 #import "MKNode.h"
 #import "MKInternal.h"
+#import "_MKNodeDispatchTable.h"
 
 #import <objc/runtime.h>
+#include <pthread.h>
+#include <mach-o/dyld.h>
 
 _mk_internal const char * const AssociatedDelegate = "AssociatedDelegate";
 _mk_internal const char * const AssociatedWarnings = "AssociatedWarnings";
 _mk_internal const char * const AssociatedDescription = "AssociatedDescription";
 
+//! The classes that are candidates for +subclasses.  This is seeded with
+//! the classes in the MachOKit image and extended by +registerSubclass:.
+//! Kept as a plain array because adding a class to a collection would send
+//! it -hash, running its +initialize.
+struct _MKRegisteredClasses {
+    unsigned count;
+    Class classes[];
+};
+
+static struct _MKRegisteredClasses *s_registeredClasses = NULL;
+
+//! The number of loaded images that have been scanned for unregistered
+//! subclasses.  See +_registerUnregisteredSubclasses.
+static uint32_t s_scannedImageCount = 0;
+
+//! Maps each node class to a dictionary of its layouts, keyed by layout key.
+static CFMutableDictionaryRef s_layouts = NULL;
+static pthread_mutex_t s_layoutsLock = PTHREAD_MUTEX_INITIALIZER;
+
 //----------------------------------------------------------------------------//
 @implementation MKNode
 
@@ -46,6 +68,11 @@ _mk_internal const char * const AssociatedDescription = "AssociatedDescription";
     
     objc_storeWeak(&_parent, parent);
     
+    // Children are created while their parent is being initialized, so a
+    // parent must settle its memory map and data model first.
+    _parentMemoryMap = [parent.memoryMap retain];
+    _parentDataModel = [parent.dataModel retain];
+    
     return self;
 }
 
@@ -58,6 +85,10 @@ _mk_internal const char * const AssociatedDescription = "AssociatedDescription";
 {
     self.delegate = nil;
     objc_storeWeak(&_parent, nil);
+    objc_storeWeak(&_macho, nil);
+    
+    [_parentDataModel release];
+    [_parentMemoryMap release];
     
     [super dealloc];
 }
@@ -68,6 +99,56 @@ _mk_internal const char * const AssociatedDescription = "AssociatedDescription";
 
 //|++++++++++++++++++++++++++++++++++++|//
 - (MKNodeDescription*)layout
+{
+    Class cls = object_getClass(self);
+    id key = self.layoutKey ?: [NSNull null];
+    MKNodeDescription *layout;
+    
+    pthread_mutex_lock(&s_layoutsLock);
+    {
+        if (s_layouts == NULL)
+            s_layouts = CFDictionaryCreateMutable(NULL, 0, NULL, &kCFTypeDictionaryValueCallBacks);
+        
+        CFMutableDictionaryRef layouts = (CFMutableDictionaryRef)CFDictionaryGetValue(s_layouts, (const void*)cls);
+        if (layouts == NULL) {
+            layouts = CFDictionaryCreateMutable(NULL, 0, &kCFTypeDictionaryKeyCallBacks, &kCFTypeDictionaryValueCallBacks);
+            CFDictionarySetValue(s_layouts, (const void*)cls, layouts);
+            CFRelease(layouts);
+        }
+        
+        layout = [[(MKNodeDescription*)CFDictionaryGetValue(layouts, key) retain] autorelease];
+    }
+    pthread_mutex_unlock(&s_layoutsLock);
+    
+    if (layout)
+        return layout;
+    
+    // Build the layout without holding the lock; building a layout may
+    // request the layout of another node.  If another thread raced us, keep
+    // the layout it built so that every node shares one instance.
+    layout = [self buildLayout];
+    
+    pthread_mutex_lock(&s_layoutsLock);
+    {
+        CFMutableDictionaryRef layouts = (CFMutableDictionaryRef)CFDictionaryGetValue(s_layouts, (const void*)cls);
+        MKNodeDescription *existing = (MKNodeDescription*)CFDictionaryGetValue(layouts, key);
+        
+        if (existing)
+            layout = [[existing retain] autorelease];
+        else
+            CFDictionarySetValue(layouts, key, layout);
+    }
+    pthread_mutex_unlock(&s_layoutsLock);
+    
+    return layout;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (id)layoutKey
+{ return self.dataModel; }
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (MKNodeDescription*)buildLayout
 { return [[MKNodeDescription new] autorelease]; }
 
 //|++++++++++++++++++++++++++++++++++++|//
@@ -102,11 +183,11 @@ _mk_internal const char * const AssociatedDescription = "AssociatedDescription";
 
 //|++++++++++++++++++++++++++++++++++++|//
 - (MKMemoryMap*)memoryMap
-{ return self.parent.memoryMap; }
+{ return _parentMemoryMap ?: self.parent.memoryMap; }
 
 //|++++++++++++++++++++++++++++++++++++|//
 - (MKDataModel*)dataModel
-{ return self.parent.dataModel; }
+{ return _parentDataModel ?: self.parent.dataModel; }
 
 //|++++++++++++++++++++++++++++++++++++|//
 - (NSArray*)warnings
@@ -152,6 +233,147 @@ _mk_internal const char * const AssociatedDescription = "AssociatedDescription";
 + (id*)_subclassesCache
 { return NULL; }
 
+//|++++++++++++++++++++++++++++++++++++|//
++ (const struct _MKRegisteredClasses*)_registeredClasses
+{
+    struct _MKRegisteredClasses *retValue = __atomic_load_n(&s_registeredClasses, __ATOMIC_ACQUIRE);
+    if (retValue)
+        return retValue;
+    
+    @synchronized(MKNode.class)
+    {
+        // Make sure another thread did not beat us.
+        retValue = __atomic_load_n(&s_registeredClasses, __ATOMIC_ACQUIRE);
+        if (retValue)
+            return retValue;
+        
+        // Only the classes in our own image are examined, rather than every
+        // class known to the runtime.  objc_getClass() does not trigger
+        // +initialize.
+        unsigned classCount = 0;
+        const char **classNames = objc_copyClassNamesForImage(class_getImageName(MKNode.class), &classCount);
+        
+        retValue = calloc(1, sizeof(*retValue) + sizeof(Class) * classCount);
+        if (retValue == NULL) {
+            free(classNames);
+            @throw [NSException exceptionWithName:NSMallocException reason:@"Failed to allocate the subclass registry." userInfo:nil];
+        }
+        
+        for (unsigned i = 0; i < classCount; i++) {
+            Class cls = objc_getClass(classNames[i]);
+            if (cls) retValue->classes[retValue->count++] = cls;
+        }
+        free(classNames);
+        
+        __atomic_store_n(&s_registeredClasses, retValue, __ATOMIC_RELEASE);
+    }
+    
+    return retValue;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+static bool
+_MKClassIsRegistered(const struct _MKRegisteredClasses *registered, Class cls)
+{
+    for (unsigned i = 0; i < registered->count; i++) {
+        if (registered->classes[i] == cls)
+            return true;
+    }
+    
+    return false;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
++ (void)registerSubclass:(Class)subclass
+{
+    NSParameterAssert(subclass != nil);
+    
+    @synchronized(MKNode.class)
+    {
+        const struct _MKRegisteredClasses *registered = [MKNode _registeredClasses];
+        if (_MKClassIsRegistered(registered, subclass))
+            return;
+        
+        struct _MKRegisteredClasses *newRegistered = malloc(sizeof(*newRegistered) + sizeof(Class) * (registered->count + 1));
+        if (newRegistered == NULL)
+            @throw [NSException exceptionWithName:NSMallocException reason:@"Failed to allocate the subclass registry." userInfo:nil];
+        
+        memcpy(newRegistered->classes, registered->classes, sizeof(Class) * registered->count);
+        newRegistered->classes[registered->count] = subclass;
+        newRegistered->count = registered->count + 1;
+        
+        // Readers may still be using the previous registry, so it is
+        // intentionally leaked.  Registration is rare.
+        __atomic_store_n(&s_registeredClasses, newRegistered, __ATOMIC_RELEASE);
+        
+        // Invalidate the subclass sets and dispatch tables of the ancestors
+        // of the new subclass.  A replaced dispatch table is leaked for the
+        // same reason as above.
+        for (Class cls = class_getSuperclass(subclass); cls != nil && cls != NSObject.class; cls = class_getSuperclass(cls)) {
+            id* subclassesCache = [cls _subclassesCache];
+            if (subclassesCache)
+                objc_storeWeak(subclassesCache, nil);
+            
+            id* dispatchTableCache = [cls _dispatchTableCache];
+            if (dispatchTableCache)
+                __atomic_store_n(dispatchTableCache, nil, __ATOMIC_RELEASE);
+        }
+    }
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
++ (BOOL)_registerUnregisteredSubclasses
+{
+    // Nothing to do unless an image has been loaded since the last scan.
+    uint32_t imageCount = _dyld_image_count();
+    if (__atomic_load_n(&s_scannedImageCount, __ATOMIC_ACQUIRE) == imageCount)
+        return NO;
+    
+    BOOL retValue = NO;
+    
+    @synchronized(MKNode.class)
+    {
+        const char *machOKitImage = class_getImageName(MKNode.class);
+        
+        for (uint32_t i = s_scannedImageCount; i < imageCount; i++) {
+            const struct mach_header *header = _dyld_get_image_header(i);
+            const char *imageName = _dyld_get_image_name(i);
+            if (header == NULL || imageName == NULL)
+                continue;
+            // Images in the shared cache can not link against MachOKit.
+            // The classes in MachOKit are already known.
+            if ((header->flags & MH_DYLIB_IN_CACHE) || (machOKitImage && strcmp(imageName, machOKitImage) == 0))
+                continue;
+            
+            unsigned classCount = 0;
+            const char **classNames = objc_copyClassNamesForImage(imageName, &classCount);
+            
+            for (unsigned j = 0; j < classCount; j++) {
+                Class cls = objc_getClass(classNames[j]);
+                
+                // Calling +isSubclassOfClass: causes the receiver's
+                // +initialize to run (if it has one).  Avoid that.
+                for (Class s = cls ? class_getSuperclass(cls) : nil; s != nil; s = class_getSuperclass(s)) {
+                    if (s != MKNode.class)
+                        continue;
+                    
+                    if (!_MKClassIsRegistered([MKNode _registeredClasses], cls)) {
+                        [MKNode registerSubclass:cls];
+                        retValue = YES;
+                    }
+                    break;
+                }
+            }
+            
+            free(classNames);
+        }
+        
+        __atomic_store_n(&s_scannedImageCount, imageCount, __ATOMIC_RELEASE);
+    }
+    
+    return retValue;
+}
+
 //|++++++++++++++++++++++++++++++++++++|//
 + (NSSet*)subclasses
 {
@@ -171,28 +393,19 @@ _mk_internal const char * const AssociatedDescription = "AssociatedDescription";
         
         NSMutableSet *subclasses = [[NSMutableSet alloc] init];
         
-        unsigned classCount;
-        Class *classes = objc_copyClassList(&classCount);
-        Class specClass = objc_getClass("SPTSpec");
-
-        for (unsigned int i=0; i<classCount; i++) {
-            Class cls = classes[i];
-
-            // Without this, Specta breaks.  Technically only needed during testing.
-            if (specClass && class_getSuperclass(cls) == specClass)
-                continue;
-
+        const struct _MKRegisteredClasses *registered = [MKNode _registeredClasses];
+        for (unsigned i = 0; i < registered->count; i++) {
+            Class cls = registered->classes[i];
+            
             // Calling +isSubclassOfClass: causes the receiver's +initialize
             // to run (if it has one).  Avoid that.
             for (Class s = cls; s != nil; s = class_getSuperclass(s)) {
                 if (s == self)
-                    [subclasses addObject:classes[i]];
+                    [subclasses addObject:cls];
             }
         }
         
         retValue = [subclasses copy];
-        
-        free(classes);
         [subclasses release];
         
         if (cache)
@@ -203,32 +416,114 @@ _mk_internal const char * const AssociatedDescription = "AssociatedDescription";
     return retValue;
 }
 
+//|++++++++++++++++++++++++++++++++++++|//
++ (Class)_bestKnownSubclassWithRanking:(uint32_t (^)(Class cls))rank
+{
+    // A single pass is sufficient to find the highest ranked subclass.
+    // Each subclass is ranked exactly once.
+    Class retValue = self;
+    uint32_t bestScore = 0;
+    
+    for (Class cls in [self subclasses]) {
+        uint32_t score = rank(cls);
+        if (score > bestScore) {
+            retValue = cls;
+            bestScore = score;
+        }
+    }
+    
+    return retValue;
+}
+
 //|++++++++++++++++++++++++++++++++++++|//
 + (Class)bestSubclassWithRanking:(uint32_t (^)(Class cls))rank
 {
-    // TODO - Don't let anything into the autorelease pool here.
-    NSMutableArray *subclasses = [[[self subclasses] allObjects] mutableCopy];
+    Class retValue = [self _bestKnownSubclassWithRanking:rank];
     
-    if (subclasses.count)
-    {
-        [subclasses sortUsingComparator:^NSComparisonResult(Class obj1, Class obj2) {
-            uint32_t class1Score = rank(obj1);
-            uint32_t class2Score = rank(obj2);
-            if (class1Score > class2Score) return NSOrderedDescending;
-            else if (class1Score < class2Score) return NSOrderedAscending;
-            else return NSOrderedSame;
-        }];
-        
-        Class retValue = [subclasses lastObject];
-        [subclasses release];
-        
-        if (rank(retValue) > 0)
-            return retValue;
-        else
-            return self;
+    // None of the known subclasses ranked the input.  A subclass that was
+    // not registered may.
+    if (retValue == self && [MKNode _registerUnregisteredSubclasses])
+        retValue = [self _bestKnownSubclassWithRanking:rank];
+    
+    return retValue;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
++ (id*)_dispatchTableCache
+{ return NULL; }
+
+//|++++++++++++++++++++++++++++++++++++|//
++ (BOOL)rankingIsDeterminedByDispatchKeyForSubclass:(Class)subclass
+{
+    // Subclasses provided by MachOKit are in the same image as MKNode.
+    const char *subclassImage = class_getImageName(subclass);
+    const char *machOKitImage = class_getImageName(MKNode.class);
+    
+    return subclassImage && machOKitImage && strcmp(subclassImage, machOKitImage) == 0;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
++ (_MKNodeDispatchTable*)_dispatchTable
+{
+    id* cache = [self _dispatchTableCache];
+    _MKNodeDispatchTable *table = cache ? __atomic_load_n(cache, __ATOMIC_ACQUIRE) : nil;
+    
+    if (table == nil && cache) {
+        @synchronized(self)
+        {
+            // Make sure another thread did not beat us.
+            table = __atomic_load_n(cache, __ATOMIC_ACQUIRE);
+            if (table == nil) {
+                table = [[_MKNodeDispatchTable alloc] initWithBaseClass:self subclasses:[self subclasses]];
+                __atomic_store_n(cache, table, __ATOMIC_RELEASE);
+            }
+        }
     }
     
-    [subclasses release];
+    // The cache is shared with subclasses of the class that declared it,
+    // but the table is only valid for the class it was built for.
+    if (table == nil || table.baseClass != self)
+        return nil;
+    
+    return table;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
++ (Class)bestSubclassForDispatchKey:(id<NSCopying>)key withRanking:(uint32_t (^)(Class cls))rank
+{
+    _MKNodeDispatchTable *table = [self _dispatchTable];
+    if (table == nil)
+        return [self bestSubclassWithRanking:rank];
+    
+    Class retValue = [table bestSubclassForKey:key withRanking:rank];
+    if (retValue)
+        return retValue;
+    
+    // None of the known subclasses ranked the input.  Registering a
+    // subclass replaces the dispatch table, so look the key up again.
+    if ([MKNode _registerUnregisteredSubclasses])
+        return [self bestSubclassForDispatchKey:key withRanking:rank];
+    
+    return self;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
++ (Class)bestSubclassForDispatchKeyBytes:(const void*)bytes length:(size_t)length withRanking:(uint32_t (^)(Class cls))rank
+{
+    NSParameterAssert(bytes != NULL || length == 0);
+    
+    _MKNodeDispatchTable *table = [self _dispatchTable];
+    if (table == nil)
+        return [self bestSubclassWithRanking:rank];
+    
+    Class retValue = [table bestSubclassForKeyBytes:bytes length:length withRanking:rank];
+    if (retValue)
+        return retValue;
+    
+    // See +bestSubclassForDispatchKey:withRanking:.
+    if ([MKNode _registerUnregisteredSubclasses])
+        return [self bestSubclassForDispatchKeyBytes:bytes length:length withRanking:rank];
+    
     return self;
 }
 
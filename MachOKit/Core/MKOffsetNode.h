@@ -41,11 +41,23 @@ NS_ASSUME_NONNULL_BEGIN
 @interface MKOffsetNode : MKBackedNode  {
 @package
     mk_vm_offset_t _nodeOffset;
+    mk_vm_address_t _nodeContextAddress;
+    mk_vm_address_t _nodeVMAddress;
+    bool _hasNodeVMAddress;
 }
 
 //! Initializes the receiver with the provided \a offset from a \a parent node.
 - (nullable instancetype)initWithOffset:(mk_vm_offset_t)offset fromParent:(MKBackedNode*)parent error:(NSError**)error NS_DESIGNATED_INITIALIZER;
 
+//! Returns an instance of the receiving class at \a offset from \a parent
+//! for which only the \c MKOffsetNode state is initialized.  The state of
+//! subclasses is left zeroed and \a error is recorded in the
+//! \c warnings of the returned node.
+//!
+//! Lazily populated collections return a placeholder in place of a node
+//! that could not be initialized, rather than throwing.
++ (instancetype)placeholderAtOffset:(mk_vm_offset_t)offset fromParent:(MKBackedNode*)parent error:(nullable NSError*)error;
+
 //◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
 #pragma mark -  Memory Layout
 //! @name       Memory Layout
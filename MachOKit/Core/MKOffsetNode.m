@@ -35,9 +35,10 @@
 - (instancetype)initWithOffset:(mk_vm_offset_t)offset fromParent:(MKBackedNode*)parent error:(NSError**)error
 {
     mk_error_t err;
+    mk_vm_address_t contextAddress = offset;
     
     // Verify that calculating our context address will not overflow.
-    if (parent && (err = mk_vm_address_apply_offset(parent.nodeContextAddress, offset, NULL))) {
+    if (parent && (err = mk_vm_address_apply_offset(parent.nodeContextAddress, offset, &contextAddress))) {
         MK_ERROR_OUT = [NSError mk_errorWithDomain:MKErrorDomain code:err description:@"Arithmetic error [%s] applying offset [%" MK_VM_PRIuOFFSET "] to address [0x%" MK_VM_PRIxADDR "] of parent node %@.", mk_error_string(err), offset, parent.nodeContextAddress, parent.compactDescription];
         [self release]; return nil;
     }
@@ -48,6 +49,7 @@
     if (self == nil) return nil;
     
     _nodeOffset = offset;
+    _nodeContextAddress = contextAddress;
     
     return self;
 }
@@ -56,6 +58,30 @@
 - (instancetype)initWithParent:(MKNode*)parent error:(NSError**)error
 { return [self initWithOffset:0 fromParent:(MKBackedNode*)parent error:error]; }
 
+//|++++++++++++++++++++++++++++++++++++|//
+- (instancetype)_placeholderWithOffset:(mk_vm_offset_t)offset fromParent:(MKBackedNode*)parent
+{
+    // Messaging super bypasses the initializers of subclasses.
+    self = [super initWithParent:parent error:NULL];
+    if (self == nil) return nil;
+    
+    _nodeOffset = offset;
+    // Wraps on overflow.  The placeholder is never read from.
+    _nodeContextAddress = parent.nodeContextAddress + offset;
+    
+    return self;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
++ (instancetype)placeholderAtOffset:(mk_vm_offset_t)offset fromParent:(MKBackedNode*)parent error:(NSError*)error
+{
+    MKOffsetNode *placeholder = [[[self alloc] _placeholderWithOffset:offset fromParent:parent] autorelease];
+    
+    placeholder.warnings = @[[NSError mk_errorWithDomain:MKErrorDomain code:MK_EINVALID_DATA underlyingError:error description:@"Could not initialize %@ at offset [%" MK_VM_PRIuOFFSET "] from %@.", NSStringFromClass(self), offset, parent.compactDescription]];
+    
+    return placeholder;
+}
+
 //◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
 #pragma mark -  Memory Layout
 //◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
@@ -65,6 +91,12 @@
 //|++++++++++++++++++++++++++++++++++++|//
 - (mk_vm_address_t)nodeAddress:(MKNodeAddressType)type
 {
+    // The tree is immutable, so neither address can change once known.
+    if (type == MKNodeContextAddress)
+        return _nodeContextAddress;
+    if (type == MKNodeVMAddress && __atomic_load_n(&_hasNodeVMAddress, __ATOMIC_ACQUIRE))
+        return _nodeVMAddress;
+    
     MKNode *parent = self.parent;
     mk_vm_address_t parentAddress = [(MKBackedNode*)parent nodeAddress:type];
     
@@ -80,6 +112,11 @@
         @throw [NSException exceptionWithName:NSRangeException reason:reason userInfo:nil];
     }
     
+    if (type == MKNodeVMAddress) {
+        _nodeVMAddress = retValue;
+        __atomic_store_n(&_hasNodeVMAddress, true, __ATOMIC_RELEASE);
+    }
+    
     return retValue;
 }
 
@@ -63,6 +63,12 @@ extern NSString * const MKInitializationContextDeferredProvider;
 
 - (nullable instancetype)initWithAddress:(mk_vm_address_t)address node:(MKBackedNode*)sourceNode context:(nullable NSDictionary<NSString*, id>*)context error:(NSError**)error NS_DESIGNATED_INITIALIZER;
 
+//! Like \c -initWithAddress:node:context:error:, but \a address must already
+//! follow \c MKNodeVMAddress semantics, e.g. because it was computed from
+//! the address of a node rather than read from memory.  The slide of an
+//! image that was loaded from memory is not removed.
+- (nullable instancetype)initWithVMAddress:(mk_vm_address_t)address node:(MKBackedNode*)sourceNode context:(nullable NSDictionary<NSString*, id>*)context error:(NSError**)error NS_DESIGNATED_INITIALIZER;
+
 //! The address referenced by the pointer.
 @property (nonatomic, readonly) mk_vm_address_t address;
 
@@ -50,6 +50,18 @@
     return self;
 }
 
+//|++++++++++++++++++++++++++++++++++++|//
+- (instancetype)initWithVMAddress:(mk_vm_address_t)address node:(MKBackedNode*)sourceNode context:(NSDictionary*)context error:(NSError**)error
+{
+    self = [super init];
+    
+    if (MKPtrInitializeWithVMAddress(mk_ptr_struct(self), sourceNode, address, context, error) == false) {
+        [self release]; return nil;
+    }
+    
+    return self;
+}
+
 //|++++++++++++++++++++++++++++++++++++|//
 - (void)dealloc
 {
@@ -30,6 +30,33 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
+//! A range of context memory that is accessible from the current process.
+//! See \ref -[MKMemoryMap spanAtOffset:fromAddress:length:requireFull:error:].
+typedef struct MKMemorySpan {
+    //! The first byte of the span, or \c NULL if the span could not be
+    //! mapped.
+    const void * _Nullable bytes;
+    //! The number of accessible bytes starting at \c bytes.
+    mk_vm_size_t length;
+    //! The object that keeps \c bytes alive.  The span does not retain it;
+    //! retain it to use \c bytes beyond the enclosing autorelease pool.
+    __unsafe_unretained id _Nullable owner;
+} MKMemorySpan;
+
+//! Describes how a range of context memory is going to be accessed.  Used
+//! with \ref -[MKMemoryMap adviseAccessPattern:atOffset:fromAddress:length:].
+typedef NS_ENUM(NSUInteger, MKMemoryMapAccessPattern) {
+    //! No particular access pattern.
+    MKMemoryMapAccessPatternNormal = 0,
+    //! The range will be read from start to end, once (symbol tables,
+    //! string tables).
+    MKMemoryMapAccessPatternSequential,
+    //! The range will be read in no particular order (export tries).
+    MKMemoryMapAccessPatternRandom,
+    //! The range will be read soon.
+    MKMemoryMapAccessPatternWillNeed
+};
+
 //----------------------------------------------------------------------------//
 @interface MKMemoryMap : NSObject
 
@@ -87,6 +114,35 @@ NS_ASSUME_NONNULL_BEGIN
 //! valid for the duration of the handler's execution.
 - (void)remapBytesAtOffset:(mk_vm_offset_t)offset fromAddress:(mk_vm_address_t)contextAddress length:(mk_vm_size_t)length requireFull:(BOOL)requireFull withHandler:(void (^)(vm_address_t address, vm_size_t length, NSError * _Nullable error))handler;
 
+//! Returns a span of the bytes at (\a contextAddress + \a offset).  Unlike
+//! the address passed to the handler of
+//! \ref remapBytesAtOffset:fromAddress:length:requireFull:withHandler:, the
+//! bytes of the span remain valid for as long as the span's \c owner is
+//! alive, and no block is invoked.  The owner is autoreleased, so the bytes
+//! can be used until the enclosing autorelease pool is drained.  Callers
+//! that keep a span for longer must retain its owner.  The parameters have
+//! the same meaning as they do for
+//! \ref remapBytesAtOffset:fromAddress:length:requireFull:withHandler:.
+//!
+//! Subclasses should override this method if they can return a span without
+//! copying.  The default implementation copies the bytes into an
+//! autoreleased buffer.
+//!
+//! @return
+//! A span whose \c bytes are \c NULL if the bytes could not be mapped.
+- (MKMemorySpan)spanAtOffset:(mk_vm_offset_t)offset fromAddress:(mk_vm_address_t)contextAddress length:(mk_vm_size_t)length requireFull:(BOOL)requireFull error:(NSError**)error;
+
+//! Discards any context memory the receiver has cached.  Call this when
+//! the context memory may have changed, e.g. when the target task has been
+//! running.  Spans returned before the call remain valid, but may no longer
+//! reflect the context memory.  The default implementation does nothing.
+- (void)invalidate;
+
+//! Informs the receiver of how the bytes at (\a contextAddress + \a offset)
+//! are going to be accessed.  This is purely a hint and does not change the
+//! behavior of the other methods.  The default implementation does nothing.
+- (void)adviseAccessPattern:(MKMemoryMapAccessPattern)pattern atOffset:(mk_vm_offset_t)offset fromAddress:(mk_vm_address_t)contextAddress length:(mk_vm_size_t)length;
+
 - (nullable NSData*)dataAtOffset:(mk_vm_offset_t)offset fromAddress:(mk_vm_address_t)contextAddress length:(mk_vm_size_t)length requireFull:(BOOL)requireFull error:(NSError**)error;
 
 - (vm_size_t)copyBytesAtOffset:(mk_vm_offset_t)offset fromAddress:(mk_vm_address_t)contextAddress into:(void*)buffer length:(mk_vm_size_t)length requireFull:(BOOL)requireFull error:(NSError**)error;
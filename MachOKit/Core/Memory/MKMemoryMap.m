@@ -113,6 +113,25 @@
 	@throw [NSException exceptionWithName:NSGenericException reason:@"Subclasses must implement -remapBytesAtOffset:fromAddress:length:requireFull:withHandler:." userInfo:nil];
 }
 
+//|++++++++++++++++++++++++++++++++++++|//
+- (MKMemorySpan)spanAtOffset:(mk_vm_offset_t)offset fromAddress:(mk_vm_address_t)contextAddress length:(mk_vm_size_t)length requireFull:(BOOL)requireFull error:(NSError**)error
+{
+    // The copy is autoreleased and owns the bytes of the span.
+    NSData *data = [self dataAtOffset:offset fromAddress:contextAddress length:length requireFull:requireFull error:error];
+    if (data == nil)
+        return (MKMemorySpan){ NULL, 0, nil };
+    
+    return (MKMemorySpan){ data.bytes, data.length, data };
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)invalidate
+{ /* Nothing to do */ }
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)adviseAccessPattern:(__unused MKMemoryMapAccessPattern)pattern atOffset:(__unused mk_vm_offset_t)offset fromAddress:(__unused mk_vm_address_t)contextAddress length:(__unused mk_vm_size_t)length
+{ /* Nothing to do */ }
+
 //|++++++++++++++++++++++++++++++++++++|//
 - (NSData*)dataAtOffset:(mk_vm_offset_t)offset fromAddress:(mk_vm_address_t)contextAddress length:(mk_vm_size_t)length requireFull:(BOOL)requireFull error:(NSError**)error
 {
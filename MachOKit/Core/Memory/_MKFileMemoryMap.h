@@ -32,7 +32,10 @@ NS_ASSUME_NONNULL_BEGIN
 //----------------------------------------------------------------------------//
 @interface _MKFileMemoryMap : MKMemoryMap {
     NSURL *_fileURL;
+    // Wraps _mapping without copying it, and unmaps it when released.
     NSData *_fileData;
+    void *_mapping;
+    size_t _mappingLength;
 }
 
 - (nullable instancetype)initWithURL:(NSURL*)fileURL error:(NSError**)error;
@@ -28,6 +28,13 @@
 #import "_MKFileMemoryMap.h"
 #import "MKInternal.h"
 
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+//! Files no larger than this are read ahead in their entirety when they are
+//! mapped.
+#define MKFileMemoryMapPrefetchThreshold (1024 * 1024)
+
 //----------------------------------------------------------------------------//
 @implementation _MKFileMemoryMap
 
@@ -37,11 +44,76 @@
     self = [super init];
     if (self == nil) return nil;
     
-    _fileData = [[NSData alloc] initWithContentsOfURL:fileURL options:NSDataReadingMappedIfSafe error:error];
-    if (_fileData == nil) { [self release]; return nil; }
-    
     _fileURL = [fileURL retain];
     
+    if (!fileURL.isFileURL) {
+        MK_ERROR_OUT = [NSError mk_errorWithDomain:MKErrorDomain code:MK_EINVAL description:@"%@ is not a file URL.", fileURL];
+        [self release]; return nil;
+    }
+    
+    // The file is mapped directly rather than through NSData, which may
+    // silently read the entire file into memory instead of mapping it (e.g.
+    // for files on network volumes).
+    int fd = open(fileURL.fileSystemRepresentation, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        int err = errno;
+        MK_ERROR_OUT = [NSError mk_errorWithDomain:NSPOSIXErrorDomain code:err description:@"Could not open %@ [%s].", fileURL.path, strerror(err)];
+        [self release]; return nil;
+    }
+    
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        int err = errno;
+        close(fd);
+        MK_ERROR_OUT = [NSError mk_errorWithDomain:NSPOSIXErrorDomain code:err description:@"Could not stat %@ [%s].", fileURL.path, strerror(err)];
+        [self release]; return nil;
+    }
+    
+    if (!S_ISREG(st.st_mode)) {
+        close(fd);
+        MK_ERROR_OUT = [NSError mk_errorWithDomain:MKErrorDomain code:MK_EINVAL description:@"%@ is not a regular file.", fileURL.path];
+        [self release]; return nil;
+    }
+    
+    // Files larger than the address space of this process can not be mapped
+    // in their entirety.  This is only a concern for 32-bit processes; a
+    // 64-bit process can map multi-GB shared caches.
+    if ((uint64_t)st.st_size > SIZE_MAX) {
+        close(fd);
+        MK_ERROR_OUT = [NSError mk_errorWithDomain:MKErrorDomain code:MK_ESIZE description:@"%@ is too large [%lld bytes] to be mapped by this process.", fileURL.path, (long long)st.st_size];
+        [self release]; return nil;
+    }
+    
+    _mappingLength = (size_t)st.st_size;
+    
+    // mmap() does not accept a zero length.  An empty file is an empty map.
+    if (_mappingLength > 0)
+    {
+        _mapping = mmap(NULL, _mappingLength, PROT_READ, MAP_FILE | MAP_PRIVATE, fd, 0);
+        if (_mapping == MAP_FAILED) {
+            int err = errno;
+            _mapping = NULL;
+            close(fd);
+            MK_ERROR_OUT = [NSError mk_errorWithDomain:NSPOSIXErrorDomain code:err description:@"Could not map %@ [%s].", fileURL.path, strerror(err)];
+            [self release]; return nil;
+        }
+        
+        // Small files are read in their entirety almost immediately.  Darwin
+        // has no MAP_POPULATE; ask for the pages to be read ahead instead.
+        if (_mappingLength <= MKFileMemoryMapPrefetchThreshold)
+            madvise(_mapping, _mappingLength, MADV_WILLNEED);
+    }
+    
+    // The mapping holds its own reference to the file.
+    close(fd);
+    
+    // The mapping is unmapped when the last span that borrows from it is
+    // released, which may be after the receiver is deallocated.
+    _fileData = [[NSData alloc] initWithBytesNoCopy:_mapping length:_mappingLength deallocator:^(void *bytes, NSUInteger length) {
+        if (bytes)
+            munmap(bytes, length);
+    }];
+    
     return self;
 }
 
@@ -59,16 +131,15 @@
 //◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (void)remapBytesAtOffset:(mk_vm_offset_t)offset fromAddress:(mk_vm_address_t)contextAddress length:(mk_vm_size_t)length requireFull:(BOOL)requireFull withHandler:(void (^)(vm_address_t address, vm_size_t length, NSError *error))handler
+- (MKMemorySpan)spanAtOffset:(mk_vm_offset_t)offset fromAddress:(mk_vm_address_t)contextAddress length:(mk_vm_size_t)length requireFull:(BOOL)requireFull error:(NSError**)error
 {
     mk_error_t err;
     mk_vm_address_t offsetAddress;
     
     // Compute the offset address.
     if ((err = mk_vm_address_apply_offset(contextAddress, offset, &offsetAddress))) {
-        NSError *error = [NSError mk_errorWithDomain:MKErrorDomain code:(NSInteger)(err | MK_EMEMORY_ERROR) description:@"Arithmetic error [%s] adding offset [%" MK_VM_PRIuOFFSET "] to address [0x%" MK_VM_PRIxADDR "].", mk_error_string(err), offset, contextAddress];
-        handler(0, 0, error);
-        return;
+        MK_ERROR_OUT = [NSError mk_errorWithDomain:MKErrorDomain code:(NSInteger)(err | MK_EMEMORY_ERROR) description:@"Arithmetic error [%s] adding offset [%" MK_VM_PRIuOFFSET "] to address [0x%" MK_VM_PRIxADDR "].", mk_error_string(err), offset, contextAddress];
+        return (MKMemorySpan){ NULL, 0, nil };
     }
     
     mk_vm_size_t fileLength = (mach_vm_size_t)_fileData.length;
@@ -76,16 +147,62 @@
     // contextAddress must be within [0, fileLength)
     if (offsetAddress >= fileLength || (requireFull && (MK_VM_SIZE_MAX - length < offsetAddress || offsetAddress + length > fileLength)))
     {
-        NSError *error = [NSError mk_errorWithDomain:MKErrorDomain code:(NSInteger)(MK_EBAD_ACCESS | MK_EMEMORY_ERROR) description:@"Input range (offset address = 0x%" MK_VM_PRIxADDR ", length = %" MK_VM_PRIxSIZE ") is not within %@", offsetAddress, length, self];
-        handler(0, 0, error);
-        return;
+        MK_ERROR_OUT = [NSError mk_errorWithDomain:MKErrorDomain code:(NSInteger)(MK_EBAD_ACCESS | MK_EMEMORY_ERROR) description:@"Input range (offset address = 0x%" MK_VM_PRIxADDR ", length = %" MK_VM_PRIxSIZE ") is not within %@", offsetAddress, length, self];
+        return (MKMemorySpan){ NULL, 0, nil };
     }
     
+    // The file is mapped in its entirety, so the span borrows directly from
+    // the file data.
+    //
     // Safe - contextAddress >= fileLength would be true otherwise.
-    vm_address_t fileOffset = (vm_address_t)_fileData.bytes + (vm_address_t)offsetAddress;
-    vm_size_t mappingLength = (vm_size_t)MIN(length, fileLength - (vm_address_t)offsetAddress);
+    const uint8_t *bytes = (const uint8_t*)_fileData.bytes + (vm_address_t)offsetAddress;
+    mk_vm_size_t mappingLength = MIN(length, fileLength - offsetAddress);
+    
+    return (MKMemorySpan){ bytes, mappingLength, _fileData };
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)adviseAccessPattern:(MKMemoryMapAccessPattern)pattern atOffset:(mk_vm_offset_t)offset fromAddress:(mk_vm_address_t)contextAddress length:(mk_vm_size_t)length
+{
+    mk_vm_address_t offsetAddress;
+    
+    if (mk_vm_address_apply_offset(contextAddress, offset, &offsetAddress) || offsetAddress >= _mappingLength)
+        return;
+    
+    int advice;
+    switch (pattern) {
+        case MKMemoryMapAccessPatternSequential:
+            advice = MADV_SEQUENTIAL;
+            break;
+        case MKMemoryMapAccessPatternRandom:
+            advice = MADV_RANDOM;
+            break;
+        case MKMemoryMapAccessPatternWillNeed:
+            advice = MADV_WILLNEED;
+            break;
+        default:
+            advice = MADV_NORMAL;
+            break;
+    }
+    
+    // madvise() requires a page aligned address.  The mapping itself is page
+    // aligned.
+    //
+    // SAFE - offsetAddress < _mappingLength
+    size_t start = (size_t)offsetAddress & ~(size_t)vm_page_mask;
+    size_t end = (size_t)MIN(length, _mappingLength - offsetAddress) + (size_t)offsetAddress;
+    
+    // Purely advisory; failure is not an error.
+    madvise((uint8_t*)_mapping + start, end - start, advice);
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)remapBytesAtOffset:(mk_vm_offset_t)offset fromAddress:(mk_vm_address_t)contextAddress length:(mk_vm_size_t)length requireFull:(BOOL)requireFull withHandler:(void (^)(vm_address_t address, vm_size_t length, NSError *error))handler
+{
+    NSError *error = nil;
+    MKMemorySpan span = [self spanAtOffset:offset fromAddress:contextAddress length:length requireFull:requireFull error:&error];
     
-    handler(fileOffset, mappingLength, nil);
+    handler((vm_address_t)span.bytes, (vm_size_t)span.length, error);
 }
 
 @end
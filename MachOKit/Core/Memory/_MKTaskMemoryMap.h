@@ -28,17 +28,49 @@
 #import <MachOKit/MKMemoryMap.h>
 
 #include <mach/mach.h>
+#include <pthread.h>
+
+@class _MKTaskMemoryRegion;
+@class _MKTaskMemoryChunk;
 
 NS_ASSUME_NONNULL_BEGIN
 
+//----------------------------------------------------------------------------//
+//! Reads memory on behalf of a task memory map.  The map reads through
+//! the task port when no reader is provided.
+@protocol _MKTaskMemoryReader <NSObject>
+
+//! Copies up to \a length bytes starting at \a address into \a buffer,
+//! stopping at the first unreadable page.  Returns the number of bytes
+//! copied, which is zero if the first page is unreadable.
+- (mk_vm_size_t)readBytesAtAddress:(mk_vm_address_t)address length:(mk_vm_size_t)length into:(void*)buffer error:(NSError**)error;
+
+@end
+
+
 //----------------------------------------------------------------------------//
 @interface _MKTaskMemoryMap : MKMemoryMap {
 @package
     mach_port_t _task;
+    id<_MKTaskMemoryReader> _reader;
+    // Regions mapped by -spanAtOffset:..., from least to most recently
+    // used.
+    pthread_mutex_t _regionsLock;
+    NSMutableArray<_MKTaskMemoryRegion*> *_regions;
+    // Chunks read by -remapBytesAtOffset:..., keyed by chunk address.  The
+    // chunks are also linked from most to least recently used.
+    pthread_mutex_t _chunkCacheLock;
+    NSMutableDictionary<NSNumber*, _MKTaskMemoryChunk*> *_chunks;
+    _MKTaskMemoryChunk *_mostRecentChunk;
+    _MKTaskMemoryChunk *_leastRecentChunk;
 }
 
 - (nullable instancetype)initWithTask:(mach_port_t)task error:(NSError**)error;
 
+//! Reads through \a reader instead of the task port.  Spans too large for
+//! a chunk are still mapped from \a task.
+- (nullable instancetype)initWithTask:(mach_port_t)task reader:(nullable id<_MKTaskMemoryReader>)reader error:(NSError**)error;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -28,16 +28,92 @@
 #import "_MKTaskMemoryMap.h"
 #import "MKInternal.h"
 
+#include <mach/mach_vm.h>
+
+//! Memory is read and cached in chunks of this many bytes, aligned to the
+//! chunk size.  Reading a whole chunk at a time coalesces the many small
+//! reads made by the parsers into a single read of adjacent pages.  Must be
+//! a multiple of the page size.
+#define MKTaskMemoryMapChunkSize        ((mk_vm_size_t)64 * 1024)
+//! The maximum number of chunks kept in the cache.
+#define MKTaskMemoryMapChunkCapacity    256
+
+//! The maximum number of regions kept mapped for spans.  Regions that are
+//! evicted stay mapped until the spans borrowing from them are released.
+#define MKTaskMemoryMapRegionCapacity   64
+
+//----------------------------------------------------------------------------//
+//! Pages of the target task mapped into the current process.  The owner of
+//! the spans returned by -[_MKTaskMemoryMap spanAtOffset:...].
+@interface _MKTaskMemoryRegion : NSObject {
+@package
+    mk_vm_address_t _contextAddress;
+    mk_vm_size_t _length;
+    vm_address_t _mapping;
+    // YES if the mapping stopped short at an unreadable page.  No larger
+    // mapping of the same range can be made.
+    BOOL _truncated;
+}
+@end
+
+@implementation _MKTaskMemoryRegion
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)dealloc
+{
+    vm_deallocate(mach_task_self(), _mapping, (vm_size_t)_length);
+    
+    [super dealloc];
+}
+
+@end
+
+
+
+//----------------------------------------------------------------------------//
+@interface _MKTaskMemoryChunk : NSObject {
+@package
+    // The address of the first byte held by the chunk.  This is the start
+    // of the chunk unless its leading pages were unreadable.
+    mk_vm_address_t _address;
+    // The number of readable bytes held, starting at _address.
+    mk_vm_size_t _length;
+    uint8_t *_bytes;
+    // Not retained; the cache dictionary owns the chunks.
+    _MKTaskMemoryChunk *_moreRecent;
+    _MKTaskMemoryChunk *_lessRecent;
+}
+@end
+
+@implementation _MKTaskMemoryChunk
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)dealloc
+{
+    free(_bytes);
+    
+    [super dealloc];
+}
+
+@end
+
+
+
 //----------------------------------------------------------------------------//
 @implementation _MKTaskMemoryMap
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (instancetype)initWithTask:(mach_port_t)task error:(NSError**)error
+- (instancetype)initWithTask:(mach_port_t)task reader:(id<_MKTaskMemoryReader>)reader error:(NSError**)error
 {
     self = [super init];
     if (self == nil) return nil;
     
     _task = task;
+    _reader = [reader retain];
+    _chunks = [[NSMutableDictionary alloc] initWithCapacity:MKTaskMemoryMapChunkCapacity];
+    _regions = [[NSMutableArray alloc] initWithCapacity:MKTaskMemoryMapRegionCapacity];
+    pthread_mutex_init(&_regionsLock, NULL);
+    pthread_mutex_init(&_chunkCacheLock, NULL);
     
     kern_return_t err = mach_port_mod_refs(mach_task_self(), _task, MACH_PORT_RIGHT_SEND, 1);
     if (err) {
@@ -48,22 +124,292 @@
     return self;
 }
 
+//|++++++++++++++++++++++++++++++++++++|//
+- (instancetype)initWithTask:(mach_port_t)task error:(NSError**)error
+{ return [self initWithTask:task reader:nil error:error]; }
+
 //|++++++++++++++++++++++++++++++++++++|//
 - (void)dealloc
 {
+    [_regions release];
+    pthread_mutex_destroy(&_regionsLock);
+    
+    [_chunks release];
+    pthread_mutex_destroy(&_chunkCacheLock);
+    
+    [_reader release];
+    
     mach_port_mod_refs(mach_task_self(), _task, MACH_PORT_RIGHT_SEND, -1);
     
     [super dealloc];
 }
 
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+#pragma mark -  Caching Context Memory
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)invalidate
+{
+    pthread_mutex_lock(&_chunkCacheLock);
+    [_chunks removeAllObjects];
+    _mostRecentChunk = nil;
+    _leastRecentChunk = nil;
+    pthread_mutex_unlock(&_chunkCacheLock);
+    
+    // Spans that borrow from the regions keep them alive.
+    pthread_mutex_lock(&_regionsLock);
+    [_regions removeAllObjects];
+    pthread_mutex_unlock(&_regionsLock);
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (mk_vm_size_t)_readBytesAtAddress:(mk_vm_address_t)address length:(mk_vm_size_t)length into:(void*)buffer error:(NSError**)error
+{
+    if (_reader)
+        return [_reader readBytesAtAddress:address length:length into:buffer error:error];
+    
+    // Try the whole range in one call.  This fails if any page in the range
+    // is unreadable, in which case fall back to reading a page at a time to
+    // find the readable prefix.
+    mach_vm_size_t readLength = 0;
+    if (mach_vm_read_overwrite(_task, address, length, (mach_vm_address_t)buffer, &readLength) == KERN_SUCCESS)
+        return readLength;
+    
+    mk_vm_size_t totalLength = 0;
+    while (totalLength < length) {
+        mk_vm_size_t pageLength = MIN(length - totalLength, vm_page_size - ((address + totalLength) & vm_page_mask));
+        
+        if (mach_vm_read_overwrite(_task, address + totalLength, pageLength, (mach_vm_address_t)buffer + totalLength, &readLength) != KERN_SUCCESS)
+            break;
+        
+        totalLength += readLength;
+    }
+    
+    if (totalLength == 0)
+        MK_ERROR_OUT = [NSError mk_errorWithDomain:MKErrorDomain code:(MK_EBAD_ACCESS | MK_EMEMORY_ERROR) description:@"Input range (offset address = 0x%" MK_VM_PRIxADDR ", length = 0x%" MK_VM_PRIxSIZE ") is not within %@.", address, length, self];
+    
+    return totalLength;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+//! Links \a chunk in as the most recently used chunk.  Must be called with
+//! the chunk cache lock held.
+- (void)_linkChunk:(_MKTaskMemoryChunk*)chunk
+{
+    chunk->_moreRecent = nil;
+    chunk->_lessRecent = _mostRecentChunk;
+    if (_mostRecentChunk)
+        _mostRecentChunk->_moreRecent = chunk;
+    else
+        _leastRecentChunk = chunk;
+    _mostRecentChunk = chunk;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+//! Unlinks \a chunk from the recently used list.  Must be called with the
+//! chunk cache lock held.
+- (void)_unlinkChunk:(_MKTaskMemoryChunk*)chunk
+{
+    if (chunk->_moreRecent)
+        chunk->_moreRecent->_lessRecent = chunk->_lessRecent;
+    else
+        _mostRecentChunk = chunk->_lessRecent;
+    
+    if (chunk->_lessRecent)
+        chunk->_lessRecent->_moreRecent = chunk->_moreRecent;
+    else
+        _leastRecentChunk = chunk->_moreRecent;
+    
+    chunk->_moreRecent = nil;
+    chunk->_lessRecent = nil;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+//! Reads up to \a length bytes at \a address into a new chunk.  Returns
+//! \c nil if the first page is unreadable.
+- (_MKTaskMemoryChunk*)_readChunkAtAddress:(mk_vm_address_t)address length:(mk_vm_size_t)length error:(NSError**)error
+{
+    _MKTaskMemoryChunk *chunk = [_MKTaskMemoryChunk new];
+    chunk->_address = address;
+    chunk->_bytes = malloc((size_t)length);
+    if (chunk->_bytes == NULL) {
+        MK_ERROR_OUT = [NSError mk_errorWithDomain:MKErrorDomain code:MK_EINTERNAL_ERROR description:@"Failed to allocate a chunk of %" MK_VM_PRIuSIZE " bytes.", length];
+        [chunk release];
+        return nil;
+    }
+    
+    NSError *readError = nil;
+    chunk->_length = [self _readBytesAtAddress:address length:length into:chunk->_bytes error:&readError];
+    if (chunk->_length == 0) {
+        MK_ERROR_OUT = readError ?: [NSError mk_errorWithDomain:MKErrorDomain code:(MK_EBAD_ACCESS | MK_EMEMORY_ERROR) description:@"Input range (offset address = 0x%" MK_VM_PRIxADDR ", length = 0x%" MK_VM_PRIxSIZE ") is not within %@.", address, length, self];
+        [chunk release];
+        return nil;
+    }
+    
+    return chunk;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+//! Returns the chunk holding the byte at \a address, reading it if it is not
+//! cached.  The returned chunk is retained, and survives eviction until it
+//! is released.  Returns \c nil if the byte is unreadable.
+- (_MKTaskMemoryChunk*)_copyChunkContainingAddress:(mk_vm_address_t)address error:(NSError**)error
+{
+    mk_vm_address_t chunkAddress = address & ~(MKTaskMemoryMapChunkSize - 1);
+    NSNumber *key = @(chunkAddress);
+    
+    pthread_mutex_lock(&_chunkCacheLock);
+    
+    _MKTaskMemoryChunk *chunk = [_chunks objectForKey:key];
+    BOOL cached = (chunk != nil);
+    
+    if (chunk && address >= chunk->_address && address - chunk->_address < chunk->_length) {
+        [self _unlinkChunk:chunk];
+        [self _linkChunk:chunk];
+        [chunk retain];
+        
+        pthread_mutex_unlock(&_chunkCacheLock);
+        return chunk;
+    }
+    
+    pthread_mutex_unlock(&_chunkCacheLock);
+    
+    // Read outside of the lock so that other readers are not held up by the
+    // target task.  Start at the beginning of the chunk, unless a previous
+    // read already found that it does not reach address.  In that case, or
+    // if this read falls short, start at the page holding address instead.
+    chunk = nil;
+    if (!cached)
+        chunk = [self _readChunkAtAddress:chunkAddress length:MKTaskMemoryMapChunkSize error:NULL];
+    
+    if (chunk == nil || address - chunk->_address >= chunk->_length) {
+        [chunk release];
+        
+        mk_vm_address_t pageAddress = mach_vm_trunc_page(address);
+        chunk = [self _readChunkAtAddress:pageAddress length:chunkAddress + MKTaskMemoryMapChunkSize - pageAddress error:error];
+        if (chunk == nil)
+            return nil;
+    }
+    
+    pthread_mutex_lock(&_chunkCacheLock);
+    
+    // Replace the chunk that another reader may have cached in the meantime.
+    _MKTaskMemoryChunk *replaced = [_chunks objectForKey:key];
+    if (replaced)
+        [self _unlinkChunk:replaced];
+    
+    [_chunks setObject:chunk forKey:key];
+    [self _linkChunk:chunk];
+    
+    // Evict the least recently used chunk.
+    if (_chunks.count > MKTaskMemoryMapChunkCapacity) {
+        _MKTaskMemoryChunk *evicted = _leastRecentChunk;
+        [self _unlinkChunk:evicted];
+        [_chunks removeObjectForKey:@(evicted->_address & ~(MKTaskMemoryMapChunkSize - 1))];
+    }
+    
+    pthread_mutex_unlock(&_chunkCacheLock);
+    return chunk;
+}
+
 //◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
 #pragma mark -  Accessing Context Memory
 //◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
 
+//|++++++++++++++++++++++++++++++++++++|//
+- (MKMemorySpan)spanAtOffset:(mk_vm_offset_t)offset fromAddress:(mk_vm_address_t)contextAddress length:(mk_vm_size_t)length requireFull:(BOOL)requireFull error:(NSError**)error
+{
+    mk_error_t mkErr;
+    
+    // Compute the offset address
+    if ((mkErr = mk_vm_address_apply_offset(contextAddress, offset, &contextAddress))) {
+        MK_ERROR_OUT = [NSError mk_errorWithDomain:MKErrorDomain code:(mkErr | MK_EMEMORY_ERROR) description:@"Arithmetic error [%s] adding offset [%" MK_VM_PRIuOFFSET "] to address [0x%" MK_VM_PRIxADDR "].", mk_error_string(mkErr), offset, contextAddress];
+        return (MKMemorySpan){ NULL, 0, nil };
+    }
+    
+    _MKTaskMemoryRegion *region = nil;
+    
+    pthread_mutex_lock(&_regionsLock);
+    
+    // Look for a region that holds every byte a new mapping could return,
+    // starting with the most recently used.
+    for (NSUInteger i = _regions.count; i > 0; i--) {
+        _MKTaskMemoryRegion *candidate = _regions[i - 1];
+        if (contextAddress < candidate->_contextAddress)
+            continue;
+        
+        mk_vm_offset_t regionOffset = contextAddress - candidate->_contextAddress;
+        if (regionOffset >= candidate->_length)
+            continue;
+        if (candidate->_length - regionOffset < length && !(candidate->_truncated && !requireFull))
+            continue;
+        
+        region = [[candidate retain] autorelease];
+        [_regions removeObjectAtIndex:i - 1];
+        [_regions addObject:region];
+        break;
+    }
+    
+    pthread_mutex_unlock(&_regionsLock);
+    
+    // Otherwise serve ranges that fall within a single chunk (most strings
+    // and LEB128 values) from the chunk cache.  The chunk owns the span.
+    if (region == nil && length <= MKTaskMemoryMapChunkSize - (contextAddress & (MKTaskMemoryMapChunkSize - 1)))
+    {
+        _MKTaskMemoryChunk *chunk = [self _copyChunkContainingAddress:contextAddress error:error];
+        if (chunk == nil)
+            return (MKMemorySpan){ NULL, 0, nil };
+        [chunk autorelease];
+        
+        mk_vm_offset_t offsetInChunk = contextAddress - chunk->_address;
+        mk_vm_size_t available = chunk->_length - offsetInChunk;
+        if (requireFull && available < length) {
+            MK_ERROR_OUT = [NSError mk_errorWithDomain:MKErrorDomain code:(MK_EBAD_ACCESS | MK_EMEMORY_ERROR) description:@"Input range (offset address = 0x%" MK_VM_PRIxADDR ", length = 0x%" MK_VM_PRIxSIZE ") is not within %@.", contextAddress, length, self];
+            return (MKMemorySpan){ NULL, 0, nil };
+        }
+        
+        return (MKMemorySpan){ chunk->_bytes + offsetInChunk, MIN(length, available), chunk };
+    }
+    
+    if (region == nil)
+    {
+        vm_address_t mapping;
+        mach_vm_size_t mappingLength;
+        
+        if (![self _mapPagesContainingAddress:contextAddress length:length requireFull:requireFull mapping:&mapping mappingLength:&mappingLength error:error])
+            return (MKMemorySpan){ NULL, 0, nil };
+        
+        region = [[_MKTaskMemoryRegion new] autorelease];
+        region->_contextAddress = mach_vm_trunc_page(contextAddress);
+        region->_length = mappingLength;
+        region->_mapping = mapping;
+        region->_truncated = (mappingLength - (contextAddress - region->_contextAddress) < length);
+        
+        pthread_mutex_lock(&_regionsLock);
+        
+        // Drop the regions the new one supersedes...
+        for (NSUInteger i = _regions.count; i > 0; i--) {
+            _MKTaskMemoryRegion *other = _regions[i - 1];
+            if (other->_contextAddress >= region->_contextAddress && other->_contextAddress - region->_contextAddress + other->_length <= region->_length)
+                [_regions removeObjectAtIndex:i - 1];
+        }
+        
+        // ...and the least recently used ones beyond the capacity.
+        [_regions addObject:region];
+        if (_regions.count > MKTaskMemoryMapRegionCapacity)
+            [_regions removeObjectsInRange:NSMakeRange(0, _regions.count - MKTaskMemoryMapRegionCapacity)];
+        
+        pthread_mutex_unlock(&_regionsLock);
+    }
+    
+    mk_vm_offset_t regionOffset = contextAddress - region->_contextAddress;
+    return (MKMemorySpan){ (const void*)(region->_mapping + regionOffset), MIN(length, region->_length - regionOffset), region };
+}
+
 //|++++++++++++++++++++++++++++++++++++|//
 - (void)remapBytesAtOffset:(mk_vm_offset_t)offset fromAddress:(mk_vm_address_t)contextAddress length:(mk_vm_size_t)length requireFull:(BOOL)requireFull withHandler:(void (^)(vm_address_t address, vm_size_t length, NSError *error))handler
 {
-	// TODO - Investigate caching mappings.  This is too much work to be doing thousands of times.
     mk_error_t mkErr;
     
     // Compute the offset address
@@ -73,6 +419,62 @@
         return;
     }
     
+    // Serve reads that fall within a single chunk from the cache.  Larger
+    // reads are mapped directly and not cached.
+    mk_vm_offset_t chunkOffset = contextAddress & (MKTaskMemoryMapChunkSize - 1);
+    
+    if (length <= MKTaskMemoryMapChunkSize - chunkOffset)
+    {
+        NSError *error = nil;
+        _MKTaskMemoryChunk *chunk = [self _copyChunkContainingAddress:contextAddress error:&error];
+        if (chunk == nil) {
+            handler(0, 0, error);
+            return;
+        }
+        
+        mk_vm_offset_t offsetInChunk = contextAddress - chunk->_address;
+        mk_vm_size_t available = chunk->_length - offsetInChunk;
+        if (requireFull && available < length) {
+            error = [NSError mk_errorWithDomain:MKErrorDomain code:(MK_EBAD_ACCESS | MK_EMEMORY_ERROR) description:@"Input range (offset address = 0x%" MK_VM_PRIxADDR ", length = 0x%" MK_VM_PRIxSIZE ") is not within %@.", contextAddress, length, self];
+            handler(0, 0, error);
+        } else {
+            handler((vm_address_t)(chunk->_bytes + offsetInChunk), (vm_size_t)available, nil);
+        }
+        
+        [chunk release];
+        return;
+    }
+    
+    vm_address_t mappingAddress;
+    mach_vm_size_t mappedLength;
+    NSError *error = nil;
+    
+    if (![self _mapPagesContainingAddress:contextAddress length:length requireFull:requireFull mapping:&mappingAddress mappingLength:&mappedLength error:&error]) {
+        handler(0, 0, error);
+        return;
+    }
+    
+    // Determine the correct offset into the mapping corresponding to the
+    // requested address.
+    mach_vm_offset_t contextAddressOffset = contextAddress - mach_vm_trunc_page(contextAddress);
+    contextAddress = mappingAddress + contextAddressOffset;
+    length = mappedLength - contextAddressOffset;
+    
+    // Call the handler.  The potential down-cast is safe because the mapping
+    // would have failed if we could not bring the entire range into this
+    // process.
+    handler((vm_address_t)contextAddress, (vm_size_t)length, nil);
+    
+    // Cleanup
+    kern_return_t err = vm_deallocate(mach_task_self(), mappingAddress, mappedLength);
+    if (err != KERN_SUCCESS) {
+        // TODO - Warning
+    }
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (BOOL)_mapPagesContainingAddress:(mk_vm_address_t)contextAddress length:(mk_vm_size_t)length requireFull:(BOOL)requireFull mapping:(vm_address_t*)mapping mappingLength:(mach_vm_size_t*)mappingLength error:(NSError**)error
+{
     mach_vm_address_t baseContextAddress = mach_vm_trunc_page(contextAddress);
     mach_vm_offset_t contextAddressOffset = contextAddress - baseContextAddress;
     
@@ -86,9 +488,8 @@
         if (!requireFull)
             totalLength = UINT64_MAX;
         else {
-            NSError *error = [NSError mk_errorWithDomain:MKErrorDomain code:(MK_EBAD_ACCESS | MK_EMEMORY_ERROR) description:@"Input range (offset address = 0x%" MK_VM_PRIxADDR ", length = 0x%" MK_VM_PRIxSIZE ") is not within %@.", contextAddress, length, self];
-            handler(0, 0, error);
-            return;
+            MK_ERROR_OUT = [NSError mk_errorWithDomain:MKErrorDomain code:(MK_EBAD_ACCESS | MK_EMEMORY_ERROR) description:@"Input range (offset address = 0x%" MK_VM_PRIxADDR ", length = 0x%" MK_VM_PRIxSIZE ") is not within %@.", contextAddress, length, self];
+            return NO;
         }
     }
     // Check if adding the totalLength to the baseContextAddress would overflow.
@@ -97,9 +498,8 @@
         if (!requireFull)
             totalLength = UINT64_MAX - baseContextAddress;
         else {
-            NSError *error = [NSError mk_errorWithDomain:MKErrorDomain code:(MK_EBAD_ACCESS | MK_EMEMORY_ERROR) description:@"Input range (offset address = 0x%" MK_VM_PRIxADDR ", length = 0x%" MK_VM_PRIxSIZE ") is not within %@.", contextAddress, length, self];
-            handler(0, 0, error);
-            return;
+            MK_ERROR_OUT = [NSError mk_errorWithDomain:MKErrorDomain code:(MK_EBAD_ACCESS | MK_EMEMORY_ERROR) description:@"Input range (offset address = 0x%" MK_VM_PRIxADDR ", length = 0x%" MK_VM_PRIxSIZE ") is not within %@.", contextAddress, length, self];
+            return NO;
         }
     }
     
@@ -115,16 +515,16 @@
         while (verifiedLength < length) {
             memory_object_size_t entryLength = totalLength - verifiedLength;
             mach_port_t memHandle;
-            kern_return_t error;
+            kern_return_t err;
             
-            error = mach_make_memory_entry_64(_task, &entryLength, baseContextAddress + verifiedLength, VM_PROT_READ, &memHandle, MACH_PORT_NULL);
+            err = mach_make_memory_entry_64(_task, &entryLength, baseContextAddress + verifiedLength, VM_PROT_READ, &memHandle, MACH_PORT_NULL);
             // Break once we hit an unmappable page.
-            if (error != KERN_SUCCESS)
+            if (err != KERN_SUCCESS)
                 break;
             
             // Drop the reference
-            error = mach_port_mod_refs(mach_task_self(), memHandle, MACH_PORT_RIGHT_SEND, -1);
-            if (error != KERN_SUCCESS) {
+            err = mach_port_mod_refs(mach_task_self(), memHandle, MACH_PORT_RIGHT_SEND, -1);
+            if (err != KERN_SUCCESS) {
                 // TODO - Log this.  We're leaking ports.
             }
             
@@ -133,9 +533,8 @@
         
         // No mappable pages found at contextAddress.
         if (verifiedLength == 0) {
-            NSError *error = [NSError mk_errorWithDomain:MKErrorDomain code:(MK_EBAD_ACCESS | MK_EMEMORY_ERROR) description:@"Input range (offset address = 0x%" MK_VM_PRIxADDR ", length = 0x%" MK_VM_PRIxSIZE ") is not within %@.", contextAddress, length, self];
-            handler(0, 0, error);
-            return;
+            MK_ERROR_OUT = [NSError mk_errorWithDomain:MKErrorDomain code:(MK_EBAD_ACCESS | MK_EMEMORY_ERROR) description:@"Input range (offset address = 0x%" MK_VM_PRIxADDR ", length = 0x%" MK_VM_PRIxSIZE ") is not within %@.", contextAddress, length, self];
+            return NO;
         }
         
         if (verifiedLength < totalLength)
@@ -148,9 +547,8 @@
     // Reserve enough pages to contain the mapping.
     kern_return_t err = vm_allocate(mach_task_self(), &mappingAddress, totalLength, VM_FLAGS_ANYWHERE);
     if (err != KERN_SUCCESS) {
-        NSError *error = [NSError mk_errorWithDomain:NSMachErrorDomain code:err description:@"Failed to allocate a target page range for the page remapping."];
-        handler(0, 0, error);
-        return;
+        MK_ERROR_OUT = [NSError mk_errorWithDomain:NSMachErrorDomain code:err description:@"Failed to allocate a target page range for the page remapping."];
+        return NO;
     }
     
     //
@@ -170,9 +568,8 @@
                 // TODO - Log this.  We're leaking pages.
             }
             
-            NSError *error = [NSError mk_errorWithDomain:MKErrorDomain code:(MK_EBAD_ACCESS | MK_EMEMORY_ERROR) description:@"Input range (offset address = 0x%" MK_VM_PRIxADDR ", length = 0x%" MK_VM_PRIxSIZE ") is not within %@.", contextAddress, length, self];
-            handler(0, 0, error);
-            return;
+            MK_ERROR_OUT = [NSError mk_errorWithDomain:MKErrorDomain code:(MK_EBAD_ACCESS | MK_EMEMORY_ERROR) description:@"Input range (offset address = 0x%" MK_VM_PRIxADDR ", length = 0x%" MK_VM_PRIxSIZE ") is not within %@.", contextAddress, length, self];
+            return NO;
         }
         
         // Map the pages into our local task, overwriting the allocation used to
@@ -193,9 +590,8 @@
                 // TODO - Log this.  We're leaking ports.
             }
             
-            NSError *error = [NSError mk_errorWithDomain:NSMachErrorDomain code:err description:@"mach_vm_map() failed."];
-            handler(0, 0, error);
-            return;
+            MK_ERROR_OUT = [NSError mk_errorWithDomain:NSMachErrorDomain code:err description:@"mach_vm_map() failed."];
+            return NO;
         }
         
         // Drop the memory handle
@@ -207,21 +603,9 @@
         mappedLength += entryLength;
     }
     
-    // Determine the correct offset into the mapping corresponding to the
-    // requested address.
-    contextAddress = mappingAddress + contextAddressOffset;
-    length = mappedLength - (contextAddress - mappingAddress);
-    
-    // Call the handler.  The potential down-cast is safe because the mapping
-    // would have failed if we could not bring the entire range into this
-    // process.
-    handler((vm_address_t)contextAddress, (vm_size_t)length, nil);
-    
-    // Cleanup
-    err = vm_deallocate(mach_task_self(), mappingAddress, mappedLength);
-    if (err != KERN_SUCCESS) {
-        // TODO - Warning
-    }
+    *mapping = mappingAddress;
+    *mappingLength = mappedLength;
+    return YES;
 }
 
 @end
@@ -0,0 +1,69 @@
+//----------------------------------------------------------------------------//
+//|
+//|             MachOKit - A Lightweight Mach-O Parsing Library
+//! @file       _MKNodeDispatchTable.h
+//!
+//! @author     D.V.
+//! @copyright  Copyright (c) 2014-2015 D.V. All rights reserved.
+//|
+//| Permission is hereby granted, free of charge, to any person obtaining a
+//| copy of this software and associated documentation files (the "Software"),
+//| to deal in the Software without restriction, including without limitation
+//| the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//| and/or sell copies of the Software, and to permit persons to whom the
+//| Software is furnished to do so, subject to the following conditions:
+//|
+//| The above copyright notice and this permission notice shall be included
+//| in all copies or substantial portions of the Software.
+//|
+//| THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//| OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//| MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//| IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//| CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//| TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//| SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//----------------------------------------------------------------------------//
+
+
+#import <MachOKit/MKBase.h>
+#include <pthread.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+//----------------------------------------------------------------------------//
+//! A memoized mapping from a dispatch key to the best subclass of a node
+//! class.  The subclasses of the base class are partitioned once, when the
+//! table is created, into those whose ranking is fully determined by the
+//! dispatch key and those that must be ranked on every lookup.  The best
+//! subclass among the former is computed the first time each key is seen
+//! and thereafter found with a single hash lookup.
+//
+@interface _MKNodeDispatchTable : NSObject {
+@package
+    Class _baseClass;
+    NSArray *_keyedSubclasses;
+    NSArray *_rankedSubclasses;
+    CFMutableDictionaryRef _entries;
+    CFMutableDictionaryRef _bytesEntries;
+    pthread_mutex_t _lock;
+}
+
+- (instancetype)initWithBaseClass:(Class)baseClass subclasses:(NSSet*)subclasses;
+
+//! The class that the table was built for.
+@property (nonatomic, readonly) Class baseClass;
+
+//! Returns the highest ranked subclass for \a key, or \c Nil if no
+//! subclass ranked above zero.
+- (nullable Class)bestSubclassForKey:(id<NSCopying>)key withRanking:(uint32_t (^)(Class cls))rank;
+
+//! Returns the highest ranked subclass for the key formed by the \a length
+//! bytes at \a bytes, or \c Nil if no subclass ranked above zero.  Keys
+//! are compared byte for byte.  Nothing is allocated unless the key has
+//! not been seen before.
+- (nullable Class)bestSubclassForKeyBytes:(const void*)bytes length:(size_t)length withRanking:(uint32_t (^)(Class cls))rank;
+
+@end
+
+NS_ASSUME_NONNULL_END
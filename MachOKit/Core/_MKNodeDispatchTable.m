@@ -0,0 +1,248 @@
+//----------------------------------------------------------------------------//
+//|
+//|             MachOKit - A Lightweight Mach-O Parsing Library
+//|             _MKNodeDispatchTable.m
+//|
+//|             D.V.
+//|             Copyright (c) 2014-2015 D.V. All rights reserved.
+//|
+//| Permission is hereby granted, free of charge, to any person obtaining a
+//| copy of this software and associated documentation files (the "Software"),
+//| to deal in the Software without restriction, including without limitation
+//| the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//| and/or sell copies of the Software, and to permit persons to whom the
+//| Software is furnished to do so, subject to the following conditions:
+//|
+//| The above copyright notice and this permission notice shall be included
+//| in all copies or substantial portions of the Software.
+//|
+//| THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//| OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//| MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//| IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//| CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//| TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//| SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//----------------------------------------------------------------------------//
+
+
+#import "_MKNodeDispatchTable.h"
+#import "MKInternal.h"
+#import "MKNode.h"
+
+//! An entry in the dispatch table.
+struct _MKNodeDispatchEntry {
+    Class cls;
+    uint32_t score;
+};
+
+//! A key in the table of byte keys.  Stored keys hold a copy of the bytes
+//! immediately after the structure.
+struct _MKNodeDispatchBytesKey {
+    CFHashCode hash;
+    size_t length;
+    const void *bytes;
+};
+
+//|++++++++++++++++++++++++++++++++++++|//
+static CFHashCode
+_MKNodeDispatchBytesKeyHash(const void *value)
+{ return ((const struct _MKNodeDispatchBytesKey*)value)->hash; }
+
+//|++++++++++++++++++++++++++++++++++++|//
+static Boolean
+_MKNodeDispatchBytesKeyEqual(const void *value1, const void *value2)
+{
+    const struct _MKNodeDispatchBytesKey *key1 = value1;
+    const struct _MKNodeDispatchBytesKey *key2 = value2;
+    
+    return key1->length == key2->length && memcmp(key1->bytes, key2->bytes, key1->length) == 0;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+static void
+_MKNodeDispatchBytesKeyRelease(CFAllocatorRef __unused allocator, const void *value)
+{ free((void*)value); }
+
+//|++++++++++++++++++++++++++++++++++++|//
+static struct _MKNodeDispatchBytesKey
+_MKNodeDispatchBytesKeyMake(const void *bytes, size_t length)
+{
+    // 32-bit FNV-1a
+    uint32_t hash = 2166136261U;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= ((const uint8_t*)bytes)[i];
+        hash *= 16777619U;
+    }
+    
+    return (struct _MKNodeDispatchBytesKey){ hash, length, bytes };
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+static void
+_MKNodeDispatchRank(NSArray *subclasses, uint32_t (^rank)(Class cls), struct _MKNodeDispatchEntry *best)
+{
+    for (Class cls in subclasses) {
+        uint32_t score = rank(cls);
+        if (score > best->score) {
+            best->cls = cls;
+            best->score = score;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------//
+@implementation _MKNodeDispatchTable
+
+@synthesize baseClass = _baseClass;
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (instancetype)initWithBaseClass:(Class)baseClass subclasses:(NSSet*)subclasses
+{
+    self = [super init];
+    if (self == nil) return nil;
+    
+    _baseClass = baseClass;
+    
+    NSMutableArray *keyedSubclasses = [[NSMutableArray alloc] initWithCapacity:subclasses.count];
+    NSMutableArray *rankedSubclasses = [[NSMutableArray alloc] init];
+    
+    for (Class cls in subclasses) {
+        if ([baseClass rankingIsDeterminedByDispatchKeyForSubclass:cls])
+            [keyedSubclasses addObject:cls];
+        else
+            [rankedSubclasses addObject:cls];
+    }
+    
+    _keyedSubclasses = [keyedSubclasses copy];
+    _rankedSubclasses = [rankedSubclasses copy];
+    [keyedSubclasses release];
+    [rankedSubclasses release];
+    
+    CFDictionaryKeyCallBacks bytesKeyCallBacks = {
+        .version = 0,
+        .release = _MKNodeDispatchBytesKeyRelease,
+        .equal = _MKNodeDispatchBytesKeyEqual,
+        .hash = _MKNodeDispatchBytesKeyHash
+    };
+    
+    _entries = CFDictionaryCreateMutable(NULL, 0, &kCFTypeDictionaryKeyCallBacks, NULL);
+    _bytesEntries = CFDictionaryCreateMutable(NULL, 0, &bytesKeyCallBacks, NULL);
+    pthread_mutex_init(&_lock, NULL);
+    
+    return self;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (instancetype)init
+{ @throw [NSException exceptionWithName:NSInvalidArgumentException reason:@"-init unavailable." userInfo:nil]; }
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)dealloc
+{
+    CFMutableDictionaryRef tables[] = { _entries, _bytesEntries };
+    
+    for (size_t t = 0; t < sizeof(tables)/sizeof(*tables); t++) {
+        CFIndex count = CFDictionaryGetCount(tables[t]);
+        const void **values = malloc(sizeof(*values) * (size_t)(count ?: 1));
+        if (values) {
+            CFDictionaryGetKeysAndValues(tables[t], NULL, values);
+            for (CFIndex i = 0; i < count; i++)
+                free((void*)values[i]);
+            free(values);
+        }
+        CFRelease(tables[t]);
+    }
+    pthread_mutex_destroy(&_lock);
+    
+    [_keyedSubclasses release];
+    [_rankedSubclasses release];
+    
+    [super dealloc];
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (Class)bestSubclassForKey:(id<NSCopying>)key withRanking:(uint32_t (^)(Class cls))rank
+{
+    struct _MKNodeDispatchEntry best = { Nil, 0 };
+    
+    pthread_mutex_lock(&_lock);
+    const struct _MKNodeDispatchEntry *entry = CFDictionaryGetValue(_entries, key);
+    if (entry)
+        best = *entry;
+    pthread_mutex_unlock(&_lock);
+    
+    if (entry == NULL)
+    {
+        _MKNodeDispatchRank(_keyedSubclasses, rank, &best);
+        
+        struct _MKNodeDispatchEntry *newEntry = malloc(sizeof(*newEntry));
+        if (newEntry) {
+            *newEntry = best;
+            
+            id keyCopy = [(id)key copy];
+            
+            pthread_mutex_lock(&_lock);
+            // Another thread may have computed the same entry.
+            if (CFDictionaryGetValue(_entries, keyCopy) == NULL)
+                CFDictionarySetValue(_entries, keyCopy, newEntry);
+            else
+                free(newEntry);
+            pthread_mutex_unlock(&_lock);
+            
+            [keyCopy release];
+        }
+    }
+    
+    // Subclasses whose ranking may depend on more than the key are always
+    // consulted.
+    _MKNodeDispatchRank(_rankedSubclasses, rank, &best);
+    
+    return best.cls;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (Class)bestSubclassForKeyBytes:(const void*)bytes length:(size_t)length withRanking:(uint32_t (^)(Class cls))rank
+{
+    struct _MKNodeDispatchEntry best = { Nil, 0 };
+    struct _MKNodeDispatchBytesKey key = _MKNodeDispatchBytesKeyMake(bytes, length);
+    
+    pthread_mutex_lock(&_lock);
+    const struct _MKNodeDispatchEntry *entry = CFDictionaryGetValue(_bytesEntries, &key);
+    if (entry)
+        best = *entry;
+    pthread_mutex_unlock(&_lock);
+    
+    if (entry == NULL)
+    {
+        _MKNodeDispatchRank(_keyedSubclasses, rank, &best);
+        
+        struct _MKNodeDispatchEntry *newEntry = malloc(sizeof(*newEntry));
+        struct _MKNodeDispatchBytesKey *keyCopy = malloc(sizeof(*keyCopy) + length);
+        if (newEntry && keyCopy) {
+            *newEntry = best;
+            *keyCopy = key;
+            keyCopy->bytes = memcpy(keyCopy + 1, bytes, length);
+            
+            pthread_mutex_lock(&_lock);
+            // Another thread may have computed the same entry.
+            if (CFDictionaryGetValue(_bytesEntries, keyCopy) == NULL) {
+                CFDictionarySetValue(_bytesEntries, keyCopy, newEntry);
+                newEntry = NULL;
+                keyCopy = NULL;
+            }
+            pthread_mutex_unlock(&_lock);
+        }
+        
+        free(keyCopy);
+        free(newEntry);
+    }
+    
+    // Subclasses whose ranking may depend on more than the key are always
+    // consulted.
+    _MKNodeDispatchRank(_rankedSubclasses, rank, &best);
+    
+    return best.cls;
+}
+
+@end
@@ -128,7 +128,7 @@
 { return MIN(sizeof(struct dyld_cache_header), _mappingOffset); }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     __unused struct dyld_cache_header sch;
     
@@ -165,7 +165,16 @@
         fields = [fields arrayByAddingObject:[MKPrimativeNodeField fieldWithProperty:MK_PROPERTY(cacheType) description:@"Cache Type" offset:offsetof(struct dyld_cache_header, cacheType) size:sizeof(sch.cacheType)]];
     }
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:fields];
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:fields];
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (id)layoutKey
+{
+    __unused struct dyld_cache_header sch;
+    
+    // The fields that are present depend on the mapping offset.
+    return @[super.layoutKey ?: [NSNull null], @(HAS_SLIDE_INFO), @(HAS_LOCAL_SYMBOLS), @(HAS_UUID), @(HAS_CACHE_TYPE)];
 }
 
 @end
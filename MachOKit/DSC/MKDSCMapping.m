@@ -131,9 +131,9 @@
 }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         [MKFormattedNodeField fieldWithProperty:MK_PROPERTY(fileOffset) description:@"File offset" format:MKNodeFieldFormatOffset],
         [MKFormattedNodeField fieldWithProperty:MK_PROPERTY(vmAddress) description:@"VM Address" format:MKNodeFieldFormatAddress],
         [MKFormattedNodeField fieldWithProperty:MK_PROPERTY(vmSize) description:@"VM Size" format:MKNodeFieldFormatSize],
@@ -73,9 +73,9 @@
 { return sizeof(struct dyld_cache_mapping_info); }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         [MKPrimativeNodeField fieldWithProperty:MK_PROPERTY(address) description:@"Mapping Address" offset:offsetof(struct dyld_cache_mapping_info, address) size:sizeof(uint64_t) format:MKNodeFieldFormatAddress],
         [MKPrimativeNodeField fieldWithProperty:MK_PROPERTY(size) description:@"Mapping Size" offset:offsetof(struct dyld_cache_mapping_info, size) size:sizeof(uint64_t) format:MKNodeFieldFormatSize],
         [MKPrimativeNodeField fieldWithProperty:MK_PROPERTY(fileOffset) description:@"File Offset" offset:offsetof(struct dyld_cache_mapping_info, fileOffset) size:sizeof(uint64_t) format:MKNodeFieldFormatOffset],
@@ -346,9 +346,9 @@
 }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         [MKNodeField nodeFieldWithProperty:MK_PROPERTY(slide) description:@"Slide"],
         [MKNodeField nodeFieldWithProperty:MK_PROPERTY(header) description:@"Shared Cache Header"],
         [MKNodeField nodeFieldWithProperty:MK_PROPERTY(mappingInfos) description:@"Mapping Descriptors"],
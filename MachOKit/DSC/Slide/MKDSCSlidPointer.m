@@ -95,9 +95,9 @@
 { return [_page nodeAddress:type]; }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         [MKNodeField nodeFieldWithProperty:MK_PROPERTY(pointerOffset) description:@"Pointer Offset"],
         [MKNodeField nodeFieldWithProperty:MK_PROPERTY(page) description:@"Page"]
     ]];
@@ -302,9 +302,9 @@
 }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         [MKNodeField nodeFieldWithProperty:MK_PROPERTY(header) description:@"Header"],
         [MKNodeField nodeFieldWithProperty:MK_PROPERTY(entries) description:@"Entries"],
         [MKNodeField nodeFieldWithProperty:MK_PROPERTY(toc) description:@"TOC"],
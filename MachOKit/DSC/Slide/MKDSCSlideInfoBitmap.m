@@ -94,7 +94,7 @@
 @synthesize nodeSize = _size;
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
-{ return [super layout]; /* No fields here */ }
+- (MKNodeDescription*)buildLayout
+{ return [super buildLayout]; /* No fields here */ }
 
 @end
@@ -81,9 +81,9 @@
 { return sizeof(struct dyld_cache_image_info); }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         [MKPrimativeNodeField fieldWithProperty:MK_PROPERTY(version) description:@"Version" offset:offsetof(struct dyld_cache_slide_info, version) size:sizeof(uint32_t)],
         [MKPrimativeNodeField fieldWithProperty:MK_PROPERTY(tocOffset) description:@"TOC Offset" offset:offsetof(struct dyld_cache_slide_info, toc_offset) size:sizeof(uint32_t) format:MKNodeFieldFormatOffset],
         [MKPrimativeNodeField fieldWithProperty:MK_PROPERTY(tocCount) description:@"TOC Count" offset:offsetof(struct dyld_cache_slide_info, toc_count) size:sizeof(uint32_t)],
@@ -109,9 +109,9 @@
 { return sizeof(uint16_t); }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         [MKNodeField nodeFieldWithProperty:MK_PROPERTY(pageIndex) description:@"Page Index"],
         [MKPrimativeNodeField fieldWithProperty:MK_PROPERTY(entryIndex) description:@"Entry Index" offset:0 size:sizeof(uint16_t)],
         [MKNodeField nodeFieldWithProperty:MK_PROPERTY(bitmap) description:@"Bitmap"]
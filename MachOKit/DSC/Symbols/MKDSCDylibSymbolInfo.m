@@ -69,9 +69,9 @@
 { return sizeof(struct dyld_cache_local_symbols_entry); }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         [MKPrimativeNodeField fieldWithProperty:MK_PROPERTY(dylibOffset) description:@"Dylib offset" offset:offsetof(struct dyld_cache_local_symbols_entry, dylibOffset) size:sizeof(uint32_t)],
         [MKPrimativeNodeField fieldWithProperty:MK_PROPERTY(nlistStartIndex) description:@"Start Index" offset:offsetof(struct dyld_cache_local_symbols_entry, nlistStartIndex) size:sizeof(uint32_t)],
         [MKPrimativeNodeField fieldWithProperty:MK_PROPERTY(nlistCount) description:@"Number of Symbols" offset:offsetof(struct dyld_cache_local_symbols_entry, nlistCount) size:sizeof(uint32_t)]
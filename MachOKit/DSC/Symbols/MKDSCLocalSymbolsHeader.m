@@ -75,9 +75,9 @@
 { return sizeof(struct dyld_cache_local_symbols_info); }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         [MKPrimativeNodeField fieldWithProperty:MK_PROPERTY(nlistOffset) description:@"Symbol Table Offset" offset:offsetof(struct dyld_cache_local_symbols_info, nlistOffset) size:sizeof(uint32_t)],
         [MKPrimativeNodeField fieldWithProperty:MK_PROPERTY(nlistCount) description:@"Number of Symbols" offset:offsetof(struct dyld_cache_local_symbols_info, nlistCount) size:sizeof(uint32_t)],
         [MKPrimativeNodeField fieldWithProperty:MK_PROPERTY(stringsOffset) description:@"String Table Offset" offset:offsetof(struct dyld_cache_local_symbols_info, stringsOffset) size:sizeof(uint32_t)],
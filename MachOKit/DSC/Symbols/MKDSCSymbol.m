@@ -174,9 +174,9 @@ static bool ReadNList(struct nlist_64 *result, mk_vm_offset_t offset, MKBackedNo
 { return self.dataModel.pointerSize == 8 ? sizeof(struct nlist_64) : sizeof(struct nlist); }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         [MKNodeField nodeFieldWithProperty:MK_PROPERTY(dylib) description:@"Dylib"],
         [MKNodeField nodeFieldWithProperty:MK_PROPERTY(name) description:@"Symbol Name"],
         [MKPrimativeNodeField fieldWithProperty:MK_PROPERTY(strx) description:@"String Table Index" offset:offsetof(struct nlist, n_un.n_strx) size:sizeof(uint32_t)],
@@ -31,16 +31,30 @@
 #import <MachOKit/MKAddressedNode.h>
 #import <MachOKit/MKExportsFieldType.h>
 
+@class MKBackedNode;
 @class MKExportsInfo;
 @class MKExportTrieNode;
 
 NS_ASSUME_NONNULL_BEGIN
 
+//! The terminal information of an exports trie node.
+typedef struct MKExportTerminalInformation {
+    uint64_t flags;
+    //! The symbol offset, or the library ordinal of a re-export.
+    uint64_t offset;
+    //! The resolver offset of a stub and resolver export.
+    uint64_t resolver;
+    //! The name a re-export is imported under, or \c NULL if it is
+    //! re-exported under its own name.
+    const char * _Nullable importedName;
+} MKExportTerminalInformation;
+
 //----------------------------------------------------------------------------//
 @interface MKExport : MKAddressedNode {
 @package
 	uint64_t _flags;
     NSString *_name;
+    mk_vm_offset_t _nodeOffset;
 }
 
 //! Returns the subclass of \ref MKExport that is most suitable for
@@ -48,6 +62,10 @@ NS_ASSUME_NONNULL_BEGIN
 //!	provided sequence of trie \a nodes.
 + (nullable Class)classForTrieNodes:(NSArray<MKExportTrieNode*> *)nodes;
 
+//! Returns the subclass of \ref MKExport that is most suitable for
+//! representing an export with the provided terminal information.
++ (nullable Class)classForTerminalInformation:(MKExportTerminalInformation)terminalInformation;
+
 //◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
 #pragma mark -  Subclassing MKExport
 //! @name       Subclassing MKExport
@@ -62,7 +80,19 @@ NS_ASSUME_NONNULL_BEGIN
 //!	instantiated.  \ref MKExport subclasses in Mach-O Kit return a value no
 //!	larger than \c 100.  You can substitute your own subclass by returning a
 //!	larger value.
-+ (uint32_t)canInstantiateWithTrieNodes:(NSArray<MKExportTrieNode*> *)nodes;
+//!
+//! The default implementation returns the result of
+//! \ref canInstantiateWithTerminalInformation: for the terminal node.
+//! Exports created by \ref MKExportsInfo are ranked with
+//! \ref canInstantiateWithTerminalInformation: only; override that method
+//! instead.
++ (uint32_t)canInstantiateWithTrieNodes:(NSArray<MKExportTrieNode*> *)nodes __attribute__((deprecated("Use +canInstantiateWithTerminalInformation:.")));
+
+//! This method is called on all \ref MKExport subclasses when
+//! determining the appropriate class to instantiate for an export with the
+//! provided terminal information.  The subclass that returns the largest
+//! value will be instantiated.
++ (uint32_t)canInstantiateWithTerminalInformation:(MKExportTerminalInformation)terminalInformation;
 
 //◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
 #pragma mark -  Creating an Export
@@ -74,7 +104,17 @@ NS_ASSUME_NONNULL_BEGIN
 //!	provided sequence of trie \a nodes.
 + (nullable instancetype)exportForTrieNodes:(NSArray<MKExportTrieNode*> *)nodes error:(NSError**)error;
 
-- (nullable instancetype)initWithTrieNodes:(NSArray<MKExportTrieNode*> *)nodes error:(NSError**)error NS_DESIGNATED_INITIALIZER;
+//! Creates and instantiates the appropriate subclass of \ref MKExport
+//! for representing the export with the provided \a name and
+//! \a terminalInformation, read from the trie node at \a offset from
+//! \a parent.
++ (nullable instancetype)exportWithName:(NSString*)name terminalInformation:(MKExportTerminalInformation)terminalInformation atOffset:(mk_vm_offset_t)offset fromParent:(MKBackedNode*)parent error:(NSError**)error;
+
+//! Derives the name and terminal information from the trie \a nodes.  The
+//! terminal node is the parent of the export.
+- (nullable instancetype)initWithTrieNodes:(NSArray<MKExportTrieNode*> *)nodes error:(NSError**)error;
+
+- (nullable instancetype)initWithName:(NSString*)name terminalInformation:(MKExportTerminalInformation)terminalInformation atOffset:(mk_vm_offset_t)offset fromParent:(MKBackedNode*)parent error:(NSError**)error NS_DESIGNATED_INITIALIZER;
 
 - (nullable instancetype)initWithParent:(null_unspecified MKNode*)parent error:(NSError**)error NS_UNAVAILABLE;
 
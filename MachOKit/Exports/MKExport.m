@@ -39,18 +39,57 @@
 + (id*)_subclassesCache
 { static NSSet *subclasses; return &subclasses; }
 
+//|++++++++++++++++++++++++++++++++++++|//
+static MKExportTerminalInformation
+MKExportTerminalInformationForNode(MKExportTrieTerminalNode *terminalNode)
+{
+	MKExportTerminalInformation terminalInformation = { 0 };
+	terminalInformation.flags = terminalNode.flags;
+	terminalInformation.resolver = terminalNode.resolver;
+	
+	if (terminalNode.flags & EXPORT_SYMBOL_FLAGS_REEXPORT) {
+		terminalInformation.offset = (uint64_t)terminalNode.ordinal;
+		terminalInformation.importedName = terminalNode.importedName.string.UTF8String;
+	} else {
+		terminalInformation.offset = terminalNode.offset;
+	}
+	
+	return terminalInformation;
+}
+
 //|++++++++++++++++++++++++++++++++++++|//
 + (uint32_t)canInstantiateWithTrieNodes:(NSArray<MKExportTrieNode*> *)nodes
 {
-#pragma unused(nodes)
+	MKExportTrieTerminalNode *terminalNode = (MKExportTrieTerminalNode*)nodes.lastObject;
+	return [self canInstantiateWithTerminalInformation:MKExportTerminalInformationForNode(terminalNode)];
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
++ (uint32_t)canInstantiateWithTerminalInformation:(MKExportTerminalInformation)terminalInformation
+{
+#pragma unused(terminalInformation)
 	return (self == MKExport.class) ? 10 : 0;
 }
 
 //|++++++++++++++++++++++++++++++++++++|//
 + (Class)classForTrieNodes:(NSArray<MKExportTrieNode*> *)nodes
 {
+	// Subclasses may still override the deprecated ranking method.
 	Class subclass = [self bestSubclassWithRanking:^uint32_t(Class cls) {
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdeprecated-declarations"
 		return [cls canInstantiateWithTrieNodes:nodes];
+#pragma clang diagnostic pop
+	}];
+	
+	return subclass;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
++ (Class)classForTerminalInformation:(MKExportTerminalInformation)terminalInformation
+{
+	Class subclass = [self bestSubclassWithRanking:^uint32_t(Class cls) {
+		return [cls canInstantiateWithTerminalInformation:terminalInformation];
 	}];
 	
 	return subclass;
@@ -72,45 +111,66 @@
 	return [[[exportClass alloc] initWithTrieNodes:nodes error:error] autorelease];
 }
 
+//|++++++++++++++++++++++++++++++++++++|//
++ (instancetype)exportWithName:(NSString*)name terminalInformation:(MKExportTerminalInformation)terminalInformation atOffset:(mk_vm_offset_t)offset fromParent:(MKBackedNode*)parent error:(NSError**)error
+{
+	Class exportClass = [self classForTerminalInformation:terminalInformation];
+	
+	NSAssert(exportClass != nil, @"No class for terminal information.");
+	return [[[exportClass alloc] initWithName:name terminalInformation:terminalInformation atOffset:offset fromParent:parent error:error] autorelease];
+}
+
 //|++++++++++++++++++++++++++++++++++++|//
 - (instancetype)initWithTrieNodes:(NSArray<MKExportTrieNode*> *)nodes error:(NSError**)error
 {
 	MKExportTrieTerminalNode *terminalNode = (MKExportTrieTerminalNode*)nodes.lastObject;
 	NSAssert([terminalNode isKindOfClass:MKExportTrieTerminalNode.class], @"The final node in the provided branch must be a terminal node.");
 	
-	self = [super initWithParent:terminalNode error:error];
-	if (self == nil) return nil;
-	
-	_flags = terminalNode.flags;
+	NSString *name = @"";
+	MKExportTrieNode *unnamedNode = nil;
+	MKExportTrieBranch *unnamedBranch = nil;
 	
     // Build up the export name
-    @autoreleasepool
-    {
-        _name = @"";
+    for (NSUInteger i = 1; i < nodes.count; i++) {
+        MKExportTrieNode *current = nodes[i-1];
+        MKExportTrieNode *next = nodes[i];
         
-        for (NSUInteger i = 1; i < nodes.count; i++) {
-            MKExportTrieNode *current = nodes[i-1];
-            MKExportTrieNode *next = nodes[i];
-            
-            MKExportTrieBranch *branch = nil;
-            for (MKExportTrieBranch *c in current.branches) {
-                if (next.nodeOffset == c.offset)
-                    branch = c;
-            }
-            NSAssert(branch != nil, @"%@ is not referenced by any branches of %@.", next.compactDescription, current.compactDescription);
-            
-            NSString *prefix = branch.prefix.string;
-            if (prefix == nil) {
-				MK_PUSH_WARNING(name, MK_EINVALID_DATA, @"Branch %@ of %@ does not contain a prefix.", branch.compactDescription, current.compactDescription);
-                break;
-            }
-            
-            _name = [_name stringByAppendingString:prefix];
+        MKExportTrieBranch *branch = nil;
+        for (MKExportTrieBranch *c in current.branches) {
+            if (next.nodeOffset == c.offset)
+                branch = c;
         }
-		
-		_name = [_name retain];
+        NSAssert(branch != nil, @"%@ is not referenced by any branches of %@.", next.compactDescription, current.compactDescription);
+        
+        NSString *prefix = branch.prefix.string;
+        if (prefix == nil) {
+            unnamedNode = current;
+            unnamedBranch = branch;
+            break;
+        }
+        
+        name = [name stringByAppendingString:prefix];
     }
-    
+	
+	self = [self initWithName:name terminalInformation:MKExportTerminalInformationForNode(terminalNode) atOffset:0 fromParent:terminalNode error:error];
+	if (self == nil) return nil;
+	
+	if (unnamedBranch)
+		MK_PUSH_WARNING(name, MK_EINVALID_DATA, @"Branch %@ of %@ does not contain a prefix.", unnamedBranch.compactDescription, unnamedNode.compactDescription);
+	
+	return self;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (instancetype)initWithName:(NSString*)name terminalInformation:(MKExportTerminalInformation)terminalInformation atOffset:(mk_vm_offset_t)offset fromParent:(MKBackedNode*)parent error:(NSError**)error
+{
+	self = [super initWithParent:parent error:error];
+	if (self == nil) return nil;
+	
+	_flags = terminalInformation.flags;
+	_name = [name copy];
+	_nodeOffset = offset;
+	
 	return self;
 }
 
@@ -150,10 +210,10 @@
 
 //|++++++++++++++++++++++++++++++++++++|//
 - (mk_vm_address_t)nodeAddress:(MKNodeAddressType)type
-{ return [(MKBackedNode*)self.parent nodeAddress:type]; }
+{ return [(MKBackedNode*)self.parent nodeAddress:type] + _nodeOffset; }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
 	MKNodeFieldBuilder *kind = [MKNodeFieldBuilder
 		builderWithProperty:MK_PROPERTY(kind)
@@ -176,7 +236,7 @@
 	name.description = @"Name";
 	name.options = MKNodeFieldOptionDisplayAsDetail;
 	
-	return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+	return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
 		kind.build,
 		options.build,
 		name.build
@@ -98,7 +98,7 @@
 }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
 	MKNodeFieldBuilder *prefix = [MKNodeFieldBuilder
 		builderWithProperty:MK_PROPERTY(prefix)
@@ -115,7 +115,7 @@
     offset.dataRecipe = MKNodeFieldDataOperationExtractDynamicSubrange.sharedInstance;
 	offset.options = MKNodeFieldOptionDisplayAsDetail;
 	
-	return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+	return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
 		prefix.build,
 		offset.build
 	]];
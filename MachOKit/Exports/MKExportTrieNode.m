@@ -230,7 +230,7 @@ bool ReadTerminalSize(uint64_t *result, size_t *size, mk_vm_offset_t offset, MKB
 }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
 	MKNodeFieldBuilder *terminalInformationSize = [MKNodeFieldBuilder
 		builderWithProperty:MK_PROPERTY(terminalInformationSize)
@@ -255,7 +255,7 @@ bool ReadTerminalSize(uint64_t *result, size_t *size, mk_vm_offset_t offset, MKB
 	branches.description = @"Branches";
 	branches.options = MKNodeFieldOptionDisplayAsDetail | MKNodeFieldOptionMergeContainerContents;
 	
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
 		terminalInformationSize.build,
 		childCount.build,
 		branches.build
@@ -219,7 +219,7 @@
 { return [self offsetFieldOffset]; }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     NSMutableArray *fields = [[NSMutableArray alloc] init];
     
@@ -322,4 +322,11 @@
     return description;
 }
 
+//|++++++++++++++++++++++++++++++++++++|//
+- (id)layoutKey
+{
+    // The fields following the flags depend on the kind of export.
+    return @[super.layoutKey ?: [NSNull null], @(self.flags & (EXPORT_SYMBOL_FLAGS_REEXPORT | EXPORT_SYMBOL_FLAGS_STUB_AND_RESOLVER))];
+}
+
 @end
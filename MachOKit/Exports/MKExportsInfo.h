@@ -26,6 +26,7 @@
 //----------------------------------------------------------------------------//
 
 #include <MachOKit/macho.h>
+#include <pthread.h>
 #import <Foundation/Foundation.h>
 
 #import <MachOKit/MKLinkEditNode.h>
@@ -38,19 +39,38 @@ NS_ASSUME_NONNULL_BEGIN
 //----------------------------------------------------------------------------//
 @interface MKExportsInfo : MKLinkEditNode {
 @package
+	MKMemorySpan _trie;
 	NSArray<__kindof MKExportTrieNode*> *_nodes;
-    NSArray<__kindof MKExport*> *_exports;
+	pthread_mutex_t _nodesLock;
+	NSArray<__kindof MKExport*> *_exports;
+	pthread_mutex_t _exportsLock;
+	// Lookup by name
+	NSMutableDictionary<NSString*, id> *_exportsByName;
+	pthread_mutex_t _exportsByNameLock;
 }
 
 //! Initializes the receiver with the provided Mach-O.
 - (nullable instancetype)initWithImage:(MKMachOImage*)image error:(NSError**)error;
 
-//! An array of nodes comprising the exports trie.
+//! An array of nodes comprising the exports trie.  The nodes are parsed
+//! the first time this property is accessed.
 @property (nonatomic, readonly) NSArray<__kindof MKExportTrieNode*> *nodes;
 
-//! An array of exports derived from the exports trie.
+//! An array of exports derived from the exports trie.  The trie is
+//! validated, and any warnings pushed, when the receiver is initialized.
+//! The exports are created the first time this property is accessed.
 @property (nonatomic, readonly) NSArray<__kindof MKExport*> *exports;
 
+//! Returns the export with the provided \a name, or \c nil if the image
+//! does not export a symbol with that name.  Only the trie nodes along the
+//! path to \a name are visited.  Results are cached; subsequent lookups of
+//! the same name return the same export.
+- (nullable __kindof MKExport*)exportForName:(NSString*)name;
+
+//! Looks up each name in \a names as if by -exportForName:.  Names
+//! that are not exported are omitted from the returned dictionary.
+- (NSDictionary<NSString*, __kindof MKExport*> *)exportsForNames:(NSArray<NSString*> *)names;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -33,27 +33,143 @@
 #import "MKExportTrieTerminalNode.h"
 #import "MKExportTrieBranch.h"
 #import "MKExport.h"
+#import "MKInternal.h"
+
+#include "_mach_trie.h"
 
 //----------------------------------------------------------------------------//
 @implementation MKExportsInfo
 
-@synthesize nodes = _nodes;
-@synthesize exports = _exports;
-
 //|++++++++++++++++++++++++++++++++++++|//
 - (instancetype)initWithSize:(mk_vm_size_t)size offset:(mk_vm_offset_t)offset inImage:(MKMachOImage*)image error:(NSError**)error
 {
 	self = [super initWithSize:size offset:offset inImage:image error:error];
 	if (self == nil) return nil;
 	
+	_exportsByName = [[NSMutableDictionary alloc] init];
+	pthread_mutex_init(&_exportsByNameLock, NULL);
+	pthread_mutex_init(&_exportsLock, NULL);
+	pthread_mutex_init(&_nodesLock, NULL);
+	
 	// An size of zero indicates that the images does not have any exports.
 	if (self.nodeSize == 0) {
 		// Not an error.
 		[self release]; return nil;
 	}
 	
-	// Parse the trie
+	// The walk follows child offsets rather than reading the trie in order.
+	[self.memoryMap adviseAccessPattern:MKMemoryMapAccessPatternRandom atOffset:0 fromAddress:self.nodeContextAddress length:self.nodeSize];
+	
+	// Map the trie once.  The exports list and lookups by name both walk the
+	// mapped bytes, and neither is built until it is needed.
+	NSError *memoryMapError = nil;
+	_trie = [self.memoryMap spanAtOffset:0 fromAddress:self.nodeContextAddress length:self.nodeSize requireFull:YES error:&memoryMapError];
+	if (_trie.bytes == NULL)
+		MK_PUSH_WARNING_WITH_ERROR(exports, MK_EINTERNAL_ERROR, memoryMapError, @"Could not map the exports trie.");
+	[_trie.owner retain];
+	
+	// Validate the trie without creating any exports, so that its warnings
+	// are available as soon as the receiver is initialized.  The exports
+	// are created by a second walk, on first access.
+	if (_trie.bytes)
+		[self _walkTrie:_trie.bytes length:_trie.length addingExportsTo:nil];
+	
+	return self;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (instancetype)_initWithDyldInfo:(MKLCDyldInfo*)dyldInfo inImage:(MKMachOImage*)image error:(NSError**)error
+{ return [self initWithSize:dyldInfo.export_size offset:dyldInfo.export_off inImage:image error:error]; }
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (instancetype)initWithImage:(MKMachOImage*)image error:(NSError**)error
+{
+	NSParameterAssert(image != nil);
+	
+	// Find LC_DYLD_INFO
+	MKLCDyldInfo *dyldInfoLoadCommand = nil;
 	{
+		NSMutableArray *commands = [[NSMutableArray alloc] initWithCapacity:1];
+		
+		NSArray *dyldInfoCommands = [image loadCommandsOfType:LC_DYLD_INFO];
+		if (dyldInfoCommands) [commands addObjectsFromArray:dyldInfoCommands];
+		
+		NSArray *dyldInfoOnlyCommands = [image loadCommandsOfType:LC_DYLD_INFO_ONLY];
+		if (dyldInfoOnlyCommands) [commands addObjectsFromArray:dyldInfoOnlyCommands];
+		
+		if (commands.count > 1)
+			MK_PUSH_WARNING(nil, MK_EINVALID_DATA, @"Image contains multiple LC_DYLD_INFO load commands.  Ignoring %@.", commands.lastObject);
+		
+		if (commands.count == 0) {
+			MK_ERROR_OUT = [NSError mk_errorWithDomain:MKErrorDomain code:MK_ENOT_FOUND description:@"Image does not contain a LC_DYLD_INFO load command."];
+			[commands release];
+			[self release]; return nil;
+		}
+		
+		dyldInfoLoadCommand = [[commands.firstObject retain] autorelease];
+		[commands release];
+	}
+	
+	return [self _initWithDyldInfo:dyldInfoLoadCommand inImage:image error:error];
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (instancetype)initWithParent:(MKNode*)parent error:(NSError**)error
+{ return [self initWithImage:parent.macho error:error]; }
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)dealloc
+{
+	pthread_mutex_destroy(&_exportsByNameLock);
+	pthread_mutex_destroy(&_exportsLock);
+	pthread_mutex_destroy(&_nodesLock);
+	[_exportsByName release];
+    [_exports release];
+	[_nodes release];
+	[_trie.owner release];
+	
+	[super dealloc];
+}
+
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+#pragma mark -  Exports Trie
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (NSArray*)exports
+{
+	pthread_mutex_lock(&_exportsLock);
+	
+	if (_exports == nil)
+	@autoreleasepool {
+		NSMutableArray<MKExport*> *exports = [[NSMutableArray alloc] init];
+		
+		if (_trie.bytes)
+			[self _walkTrie:_trie.bytes length:_trie.length addingExportsTo:exports];
+		
+		[exports sortUsingComparator:^(MKExport *left, MKExport *right) {
+			if (left.nodeVMAddress < right.nodeVMAddress) return NSOrderedAscending;
+			else if (left.nodeVMAddress > right.nodeVMAddress) return NSOrderedDescending;
+			else return NSOrderedSame;
+		}];
+		
+		_exports = [exports copy];
+		[exports release];
+	}
+	
+	pthread_mutex_unlock(&_exportsLock);
+	
+	// SAFE - Once set, _exports is never modified.
+	return _exports;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (NSArray*)nodes
+{
+	pthread_mutex_lock(&_nodesLock);
+	
+	if (_nodes == nil)
+	@autoreleasepool {
 		NSMutableArray<__kindof MKExportTrieNode*> *nodes = [[NSMutableArray alloc] initWithCapacity:(NSUInteger)self.nodeSize/64];
 		mk_vm_offset_t offset = 0;
 		
@@ -80,146 +196,502 @@
 		[nodes release];
 	}
 	
-	// Build the exports list
-	@autoreleasepool
+	pthread_mutex_unlock(&_nodesLock);
+	
+	// SAFE - Once set, _nodes is never modified.
+	return _nodes;
+}
+
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+#pragma mark -  Walking the Trie
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+
+//! A trie node waiting to be visited.  The node's name is the first
+//! \c nameLength bytes of the name buffer followed by \c prefix.
+struct MKExportsInfoPendingNode {
+	uint64_t offset;
+	size_t nameLength;
+	const uint8_t *prefix;
+	size_t prefixLength;
+};
+
+//|++++++++++++++++++++++++++++++++++++|//
+static mk_error_t
+MKExportsInfoReadTerminalInformation(const uint8_t *p, const uint8_t *end, MKExportTerminalInformation *terminalInformation)
+{
+	mk_error_t err;
+	size_t ulebSize;
+	
+	*terminalInformation = (MKExportTerminalInformation){ 0 };
+	
+	if ((err = _mk_mach_trie_copy_uleb128(p, end, &terminalInformation->flags, &ulebSize)))
+		return err;
+	p += ulebSize;
+	
+	if (terminalInformation->flags & EXPORT_SYMBOL_FLAGS_REEXPORT)
+	{
+		// The library ordinal, followed by the imported name.  An empty
+		// imported name means the symbol is re-exported under its own name.
+		if ((err = _mk_mach_trie_copy_uleb128(p, end, &terminalInformation->offset, &ulebSize)))
+			return err;
+		p += ulebSize;
+		
+		size_t importedNameLength = strnlen((const char*)p, (size_t)(end - p));
+		if (importedNameLength == (size_t)(end - p))
+			return MK_EINVALID_DATA;
+		
+		if (importedNameLength > 0)
+			terminalInformation->importedName = (const char*)p;
+	}
+	else
+	{
+		switch (terminalInformation->flags & EXPORT_SYMBOL_FLAGS_KIND_MASK) {
+			case EXPORT_SYMBOL_FLAGS_KIND_REGULAR:
+			case EXPORT_SYMBOL_FLAGS_KIND_THREAD_LOCAL:
+			case EXPORT_SYMBOL_FLAGS_KIND_ABSOLUTE:
+				if ((err = _mk_mach_trie_copy_uleb128(p, end, &terminalInformation->offset, &ulebSize)))
+					return err;
+				p += ulebSize;
+				break;
+			default:
+				// Unknown kind.  The caller reports it.
+				return MK_ESUCCESS;
+		}
+		
+		// dyld only accepts the EXPORT_SYMBOL_FLAGS_STUB_AND_RESOLVER flag if the
+		// export kind is EXPORT_SYMBOL_FLAGS_KIND_REGULAR
+		if ((terminalInformation->flags & EXPORT_SYMBOL_FLAGS_STUB_AND_RESOLVER) && (terminalInformation->flags & EXPORT_SYMBOL_FLAGS_KIND_MASK) == EXPORT_SYMBOL_FLAGS_KIND_REGULAR) {
+			if ((err = _mk_mach_trie_copy_uleb128(p, end, &terminalInformation->resolver, &ulebSize)))
+				return err;
+		}
+	}
+	
+	return MK_ESUCCESS;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+//! Returns \c true if the \a length bytes at \a bytes are well formed UTF-8.
+static bool
+MKExportsInfoIsValidUTF8(const uint8_t *bytes, size_t length)
+{
+	const uint8_t *end = bytes + length;
+	
+	while (bytes < end)
 	{
-        NSMutableArray<MKExport*> *exports = [[NSMutableArray alloc] init];
+		uint8_t lead = *bytes++;
+		if (lead < 0x80)
+			continue;
+		
+		size_t continuationCount;
+		uint32_t codePoint;
+		uint32_t minimum;
+		
+		if ((lead & 0xE0) == 0xC0) {
+			continuationCount = 1; codePoint = lead & 0x1F; minimum = 0x80;
+		} else if ((lead & 0xF0) == 0xE0) {
+			continuationCount = 2; codePoint = lead & 0x0F; minimum = 0x800;
+		} else if ((lead & 0xF8) == 0xF0) {
+			continuationCount = 3; codePoint = lead & 0x07; minimum = 0x10000;
+		} else {
+			return false;
+		}
+		
+		if ((size_t)(end - bytes) < continuationCount)
+			return false;
+		
+		for (size_t i = 0; i < continuationCount; i++) {
+			if ((bytes[i] & 0xC0) != 0x80)
+				return false;
+			codePoint = (codePoint << 6) | (bytes[i] & 0x3F);
+		}
+		bytes += continuationCount;
+		
+		// Reject overlong encodings, surrogates and values beyond U+10FFFF.
+		if (codePoint < minimum || codePoint > 0x10FFFF || (codePoint >= 0xD800 && codePoint <= 0xDFFF))
+			return false;
+	}
+	
+	return true;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)_walkTrie:(const uint8_t*)trie length:(mk_vm_size_t)trieLength addingExportsTo:(NSMutableArray<MKExport*> *)exports
+{
+	const uint8_t *end = trie + trieLength;
+	
+	// Only the validating walk, which does not create exports, pushes
+	// warnings.  The second walk would repeat them, from whichever thread
+	// first accessed -exports.
+#define MKExportsInfoWalkWarning(CODE, ...) do { if (exports == nil) MK_PUSH_WARNING(exports, CODE, __VA_ARGS__); } while (0)
+	
+	// A well formed trie is a tree.  Every node is visited at most once so
+	// that a malformed trie can not send the walk around a cycle.
+	uint8_t *visited = calloc((size_t)(trieLength + 7) / 8, sizeof(uint8_t));
+	size_t pendingCapacity = 64;
+	struct MKExportsInfoPendingNode *pending = malloc(pendingCapacity * sizeof(*pending));
+	size_t nameCapacity = 256;
+	char *name = malloc(nameCapacity);
+	
+	if (visited == NULL || pending == NULL || name == NULL) {
+		MKExportsInfoWalkWarning(MK_EINTERNAL_ERROR, @"Could not allocate the trie walker state.");
+		free(visited); free(pending); free(name);
+		return;
+	}
+	
+	// The pending nodes form a stack, so the walk is depth first.  Everything
+	// visited between pushing a node and popping it descends from its
+	// siblings, and only writes past its parent's name.  The first nameLength
+	// bytes of the name buffer therefore still hold the parent's name when
+	// the node is popped.
+	size_t pendingCount = 0;
+	pending[pendingCount++] = (struct MKExportsInfoPendingNode){ 0, 0, NULL, 0 };
+	
+	while (pendingCount > 0)
+	@autoreleasepool {
+		struct MKExportsInfoPendingNode node = pending[--pendingCount];
+		mk_error_t err;
+		
+		if (node.offset >= trieLength) {
+			MKExportsInfoWalkWarning(MK_EOUT_OF_RANGE, @"Trie node offset [%" PRIu64 "] is beyond the end of the trie.", node.offset);
+			continue;
+		}
+		if (visited[node.offset / 8] & (1 << (node.offset % 8))) {
+			MKExportsInfoWalkWarning(MK_EINVALID_DATA, @"Trie node at offset [%" PRIu64 "] is referenced more than once.", node.offset);
+			continue;
+		}
+		visited[node.offset / 8] |= (uint8_t)(1 << (node.offset % 8));
+		
+		// Append the node's prefix to its parent's name.
+		size_t nameLength = node.nameLength + node.prefixLength;
+		if (nameLength > nameCapacity) {
+			char *newName = realloc(name, nameLength * 2);
+			if (newName == NULL) {
+				MKExportsInfoWalkWarning(MK_EINTERNAL_ERROR, @"Could not grow the name buffer.");
+				break;
+			}
+			name = newName;
+			nameCapacity = nameLength * 2;
+		}
+		if (node.prefixLength)
+			memcpy(name + node.nameLength, node.prefix, node.prefixLength);
+		
+		const uint8_t *p = trie + node.offset;
+		uint64_t terminalSize;
+		size_t ulebSize;
+		
+		if ((err = _mk_mach_trie_copy_uleb128(p, end, &terminalSize, &ulebSize))) {
+			MKExportsInfoWalkWarning(err, @"Could not read the terminal size of the trie node at offset [%" PRIu64 "].", node.offset);
+			continue;
+		}
+		p += ulebSize;
+		
+		if (terminalSize > (uint64_t)(end - p)) {
+			MKExportsInfoWalkWarning(MK_EOUT_OF_RANGE, @"Terminal information of the trie node at offset [%" PRIu64 "] extends beyond the end of the trie.", node.offset);
+			continue;
+		}
+		
+		const uint8_t *children = p + terminalSize;
 		
-		if (_nodes.count > 0)
+		if (terminalSize > 0)
 		{
-			// depth first, postorder traversal
-			
-			NSMutableArray<MKExportTrieNode*> *path = [[NSMutableArray alloc] init];
-			NSMutableArray<__kindof MKNode*> *queue = [[NSMutableArray alloc] init];
-			
-			// Seed the queue with the root node
-			[path addObject:_nodes.firstObject];
-			[queue addObject:_nodes.firstObject];
-			for (id child in _nodes.firstObject.branches.reverseObjectEnumerator)
-				[queue addObject:child];
+			MKExportTerminalInformation terminalInformation;
 			
-			while (queue.count != 0) {
-				__kindof MKNode *next = queue.lastObject;
-				[queue removeLastObject];
+			if ((err = MKExportsInfoReadTerminalInformation(p, children, &terminalInformation))) {
+				MKExportsInfoWalkWarning(err, @"Could not read the terminal information of the trie node at offset [%" PRIu64 "].", node.offset);
+			} else {
+				uint64_t kind = terminalInformation.flags & EXPORT_SYMBOL_FLAGS_KIND_MASK;
+				if ((terminalInformation.flags & EXPORT_SYMBOL_FLAGS_REEXPORT) == 0 && kind != EXPORT_SYMBOL_FLAGS_KIND_REGULAR && kind != EXPORT_SYMBOL_FLAGS_KIND_THREAD_LOCAL && kind != EXPORT_SYMBOL_FLAGS_KIND_ABSOLUTE)
+					MKExportsInfoWalkWarning(MK_EINVALID_DATA, @"Unknown export symbol kind (flags=0x%" PRIx64 ") in the trie node at offset [%" PRIu64 "].", terminalInformation.flags, node.offset);
 				
-				if ([next isKindOfClass:MKExportTrieBranch.class]) {
-					NSError *traversalError = nil;
-					MKExportTrieBranch *branch = next;
-					mk_vm_address_t targetAddress;
-					mk_error_t err;
-					
-					if ((err = mk_vm_address_apply_offset(self.nodeVMAddress, branch.offset, &targetAddress))) {
-						traversalError = MK_MAKE_VM_ADDRESS_APPLY_OFFSET_ARITHMETIC_ERROR(err, self.nodeVMAddress, branch.offset);
-						MK_PUSH_WARNING_WITH_ERROR(exports, MK_ENOT_FOUND, traversalError, @"Could not locate the trie node referenced by branch %@ of %@.", branch.compactDescription, branch.parent.compactDescription);
-						continue;
-					}
-					
-					MKResult<MKExportTrieNode*> *targetNode = (typeof(targetNode))[self childNodeAtVMAddress:targetAddress targetClass:MKExportTrieNode.class];
-					if (targetNode.value == nil) {
-						traversalError = [NSError mk_errorWithDomain:MKErrorDomain code:MK_ENOT_FOUND underlyingError:targetNode.error description:@"No trie node at address [0x%" MK_VM_PRIxADDR "]", targetAddress];
-						MK_PUSH_WARNING_WITH_ERROR(exports, MK_ENOT_FOUND, traversalError, @"Could not locate the trie node referenced by branch %@ of %@.", branch.compactDescription, branch.parent.compactDescription);
-						continue;
-					}
-					
-					[path addObject:targetNode.value];
-					[queue addObject:targetNode.value];
-					for (id child in targetNode.value.branches.reverseObjectEnumerator)
-						[queue addObject:child];
-					
-				} else {
-					NSAssert(next == path.lastObject, @"Branch mismatch.");
-					
-					if ([next isKindOfClass:MKExportTrieTerminalNode.class]) {
-						NSError *exportError = nil;
-						MKExport *export = [MKExport exportForTrieNodes:path error:&exportError];
-						
-						if (export) {
-							[exports addObject:export];
-						} else {
-							MK_PUSH_WARNING_WITH_ERROR(exports, MK_EINTERNAL_ERROR, exportError, @"Could not create export for terminal node %@.", next.compactDescription);
-						}
-					}
-					
-					[path removeLastObject];
+				bool validName = MKExportsInfoIsValidUTF8((const uint8_t*)name, nameLength);
+				if (!validName)
+					MKExportsInfoWalkWarning(MK_EINVALID_DATA, @"The name of the export at offset [%" PRIu64 "] is not valid UTF-8.", node.offset);
+				
+				if (exports) {
+					NSString *exportName = [[NSString alloc] initWithBytes:name length:nameLength encoding:validName ? NSUTF8StringEncoding : NSISOLatin1StringEncoding];
+					MKExport *export = [MKExport exportWithName:exportName terminalInformation:terminalInformation atOffset:node.offset fromParent:self error:NULL];
+					if (export)
+						[exports addObject:export];
+					[exportName release];
 				}
 			}
+		}
+		
+		if (children >= end) {
+			MKExportsInfoWalkWarning(MK_EOUT_OF_RANGE, @"Trie node at offset [%" PRIu64 "] is missing its child count.", node.offset);
+			continue;
+		}
+		
+		uint8_t childCount = *children++;
+		
+		for (uint8_t i = 0; i < childCount; i++)
+		{
+			const uint8_t *prefix = children;
+			size_t prefixLength = strnlen((const char*)prefix, (size_t)(end - prefix));
+			if (prefixLength == (size_t)(end - prefix)) {
+				MKExportsInfoWalkWarning(MK_EINVALID_DATA, @"Branch %" PRIu8 " of the trie node at offset [%" PRIu64 "] has an unterminated prefix.", i, node.offset);
+				break;
+			}
+			children += prefixLength + 1;
 			
-			[queue release];
-			[path release];
+			uint64_t childOffset;
+			if ((err = _mk_mach_trie_copy_uleb128(children, end, &childOffset, &ulebSize))) {
+				MKExportsInfoWalkWarning(err, @"Could not read the offset of branch %" PRIu8 " of the trie node at offset [%" PRIu64 "].", i, node.offset);
+				break;
+			}
+			children += ulebSize;
 			
-			[exports sortUsingComparator:^(MKExport *left, MKExport *right) {
-				if (left.nodeVMAddress < right.nodeVMAddress) return NSOrderedAscending;
-				else if (left.nodeVMAddress > right.nodeVMAddress) return NSOrderedDescending;
-				else return NSOrderedSame;
-			}];
+			if (pendingCount == pendingCapacity) {
+				struct MKExportsInfoPendingNode *newPending = realloc(pending, pendingCapacity * 2 * sizeof(*pending));
+				if (newPending == NULL) {
+					MKExportsInfoWalkWarning(MK_EINTERNAL_ERROR, @"Could not grow the trie walker stack.");
+					break;
+				}
+				pending = newPending;
+				pendingCapacity *= 2;
+			}
+			
+			pending[pendingCount++] = (struct MKExportsInfoPendingNode){ childOffset, nameLength, prefix, prefixLength };
 		}
-		
-        _exports = [exports copy];
-        [exports release];
 	}
 	
-	return self;
+	free(name);
+	free(pending);
+	free(visited);
+	
+#undef MKExportsInfoWalkWarning
 }
 
-//|++++++++++++++++++++++++++++++++++++|//
-- (instancetype)_initWithDyldInfo:(MKLCDyldInfo*)dyldInfo inImage:(MKMachOImage*)image error:(NSError**)error
-{ return [self initWithSize:dyldInfo.export_size offset:dyldInfo.export_off inImage:image error:error]; }
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+#pragma mark -  Looking Up Exports
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (instancetype)initWithImage:(MKMachOImage*)image error:(NSError**)error
+//! Follows the branches matching \a name from the root of the trie.  Returns
+//! the offset of the node reached by consuming all of \a name, or a negative
+//! value if there is no such node or the trie is malformed.
+static int64_t
+MKExportsInfoFindNode(const uint8_t *trie, const uint8_t *end, const char *name, size_t nameLength)
 {
-	NSParameterAssert(image != nil);
+	uint64_t offset = 0;
 	
-	// Find LC_DYLD_INFO
-	MKLCDyldInfo *dyldInfoLoadCommand = nil;
+	while (1)
 	{
-		NSMutableArray *commands = [[NSMutableArray alloc] initWithCapacity:1];
+		const uint8_t *p = trie + offset;
+		uint64_t terminalSize;
+		size_t ulebSize;
 		
-		NSArray *dyldInfoCommands = [image loadCommandsOfType:LC_DYLD_INFO];
-		if (dyldInfoCommands) [commands addObjectsFromArray:dyldInfoCommands];
+		if (_mk_mach_trie_copy_uleb128(p, end, &terminalSize, &ulebSize))
+			return -1;
+		p += ulebSize;
 		
-		NSArray *dyldInfoOnlyCommands = [image loadCommandsOfType:LC_DYLD_INFO_ONLY];
-		if (dyldInfoOnlyCommands) [commands addObjectsFromArray:dyldInfoOnlyCommands];
+		if (terminalSize > (uint64_t)(end - p))
+			return -1;
 		
-		if (commands.count > 1)
-			MK_PUSH_WARNING(nil, MK_EINVALID_DATA, @"Image contains multiple LC_DYLD_INFO load commands.  Ignoring %@.", commands.lastObject);
+		if (nameLength == 0)
+			return terminalSize > 0 ? (int64_t)offset : -1;
 		
-		if (commands.count == 0) {
-			MK_ERROR_OUT = [NSError mk_errorWithDomain:MKErrorDomain code:MK_ENOT_FOUND description:@"Image does not contain a LC_DYLD_INFO load command."];
-			[commands release];
-			[self release]; return nil;
+		const uint8_t *children = p + terminalSize;
+		if (children >= end)
+			return -1;
+		
+		uint8_t childCount = *children++;
+		bool matched = false;
+		
+		for (uint8_t i = 0; i < childCount && !matched; i++)
+		{
+			const uint8_t *prefix = children;
+			size_t prefixLength = strnlen((const char*)prefix, (size_t)(end - prefix));
+			if (prefixLength == (size_t)(end - prefix))
+				return -1;
+			children += prefixLength + 1;
+			
+			uint64_t childOffset;
+			if (_mk_mach_trie_copy_uleb128(children, end, &childOffset, &ulebSize))
+				return -1;
+			children += ulebSize;
+			
+			// An empty prefix would not consume any of the name.  Rejecting it
+			// guarantees the walk ends after at most nameLength steps, even
+			// for a trie that contains cycles.
+			if (prefixLength == 0 || prefixLength > nameLength || memcmp(prefix, name, prefixLength) != 0)
+				continue;
+			if (childOffset >= (uint64_t)(end - trie))
+				return -1;
+			
+			name += prefixLength;
+			nameLength -= prefixLength;
+			offset = childOffset;
+			matched = true;
 		}
 		
-		dyldInfoLoadCommand = [[commands.firstObject retain] autorelease];
-		[commands release];
+		// Branch prefixes of a node never share a first character, so there
+		// is no need to try the remaining branches.
+		if (!matched)
+			return -1;
 	}
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (MKExport*)_lookupExportForName:(NSString*)name
+{
+	if (_trie.bytes == NULL)
+		return nil;
 	
-	return [self _initWithDyldInfo:dyldInfoLoadCommand inImage:image error:error];
+	const uint8_t *trie = _trie.bytes;
+	const uint8_t *end = trie + _trie.length;
+	const char *utf8Name = name.UTF8String;
+	if (utf8Name == NULL)
+		return nil;
+	
+	int64_t offset = MKExportsInfoFindNode(trie, end, utf8Name, strlen(utf8Name));
+	if (offset < 0)
+		return nil;
+	
+	// MKExportsInfoFindNode() has already validated the terminal size.
+	const uint8_t *p = trie + offset;
+	uint64_t terminalSize;
+	size_t ulebSize;
+	_mk_mach_trie_copy_uleb128(p, end, &terminalSize, &ulebSize);
+	p += ulebSize;
+	
+	MKExportTerminalInformation terminalInformation;
+	if (MKExportsInfoReadTerminalInformation(p, p + terminalSize, &terminalInformation))
+		return nil;
+	
+	return [MKExport exportWithName:name terminalInformation:terminalInformation atOffset:(mk_vm_offset_t)offset fromParent:self error:NULL];
 }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (instancetype)initWithParent:(MKNode*)parent error:(NSError**)error
-{ return [self initWithImage:parent.macho error:error]; }
+- (MKExport*)_cachedExportForName:(NSString*)name
+{
+	id export;
+	
+	pthread_mutex_lock(&_exportsByNameLock);
+	export = [[_exportsByName[name] retain] autorelease];
+	pthread_mutex_unlock(&_exportsByNameLock);
+	
+	if (export == nil) {
+		// The trie is walked outside of the lock.  If another thread caches
+		// the same name first, its export is returned instead.
+		id newExport = [self _lookupExportForName:name] ?: (id)[NSNull null];
+		
+		pthread_mutex_lock(&_exportsByNameLock);
+		export = _exportsByName[name];
+		if (export == nil) {
+			NSString *key = [name copy];
+			_exportsByName[key] = newExport;
+			[key release];
+			export = newExport;
+		}
+		[[export retain] autorelease];
+		pthread_mutex_unlock(&_exportsByNameLock);
+	}
+	
+	return export == [NSNull null] ? nil : export;
+}
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (void)dealloc
+- (MKExport*)exportForName:(NSString*)name
 {
-    [_exports release];
-	[_nodes release];
+	NSParameterAssert(name != nil);
 	
-	[super dealloc];
+	return [self _cachedExportForName:name];
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (NSDictionary*)exportsForNames:(NSArray*)names
+{
+	NSParameterAssert(names != nil);
+	
+	NSMutableDictionary<NSString*, MKExport*> *exports = [[NSMutableDictionary alloc] initWithCapacity:names.count];
+	
+	for (NSString *name in names) @autoreleasepool {
+		MKExport *export = [self _cachedExportForName:name];
+		if (export)
+			exports[name] = export;
+	}
+	
+	return [exports autorelease];
 }
 
 //◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
 #pragma mark -  MKPointer
 //◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
 
+//|++++++++++++++++++++++++++++++++++++|//
+//! Returns the size of the trie node at \a offset, computed as by
+//! \ref MKExportTrieNode, or 0 if the node is malformed.
+static uint64_t
+MKExportsInfoNodeSize(const uint8_t *trie, const uint8_t *end, uint64_t offset)
+{
+	const uint8_t *p = trie + offset;
+	uint64_t terminalSize;
+	size_t ulebSize;
+	
+	if (_mk_mach_trie_copy_uleb128(p, end, &terminalSize, &ulebSize))
+		return 0;
+	p += ulebSize;
+	
+	if (terminalSize >= (uint64_t)(end - p))
+		return 0;
+	p += terminalSize;
+	
+	uint8_t childCount = *p++;
+	
+	for (uint8_t i = 0; i < childCount; i++)
+	{
+		size_t prefixLength = strnlen((const char*)p, (size_t)(end - p));
+		if (prefixLength == (size_t)(end - p))
+			return 0;
+		p += prefixLength + 1;
+		
+		uint64_t childOffset;
+		if (_mk_mach_trie_copy_uleb128(p, end, &childOffset, &ulebSize))
+			return 0;
+		p += ulebSize;
+	}
+	
+	return (uint64_t)(p - (trie + offset));
+}
+
 //|++++++++++++++++++++++++++++++++++++|//
 - (MKResult*)childNodeOccupyingVMAddress:(mk_vm_address_t)address targetClass:(Class)targetClass
 {
-    MKResult *child = [MKBackedNode childNodeOccupyingVMAddress:address targetClass:targetClass inSortedArray:(NSArray *)self.nodes];
-    if (child.value)
-        return child;
+	pthread_mutex_lock(&_nodesLock);
+	NSArray *nodes = [[_nodes retain] autorelease];
+	pthread_mutex_unlock(&_nodesLock);
+	
+	if (nodes) {
+		MKResult *child = [MKBackedNode childNodeOccupyingVMAddress:address targetClass:targetClass inSortedArray:nodes];
+		if (child.value)
+			return child;
+	} else if (_trie.bytes && address >= self.nodeVMAddress && address - self.nodeVMAddress < _trie.length) {
+		// The nodes are laid out back to back, as -nodes parses them.  Step
+		// over the node sizes in the mapped trie and only instantiate the
+		// node that occupies the address.
+		const uint8_t *trie = _trie.bytes;
+		const uint8_t *end = trie + _trie.length;
+		uint64_t target = address - self.nodeVMAddress;
+		uint64_t offset = 0;
+		
+		while (offset < _trie.length)
+		{
+			uint64_t size = MKExportsInfoNodeSize(trie, end, offset);
+			if (size == 0)
+				break;
+			
+			if (target < offset + size) {
+				MKExportTrieNode *node = [MKExportTrieNode nodeAtOffset:offset fromParent:self error:NULL];
+				MKResult *child = [node childNodeOccupyingVMAddress:address targetClass:targetClass];
+				if (child.value)
+					return child;
+				break;
+			}
+			
+			offset += size;
+		}
+	}
 	
 	return [super childNodeOccupyingVMAddress:address targetClass:targetClass];
 }
@@ -229,7 +701,7 @@
 //◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
 	MKNodeFieldBuilder *nodes = [MKNodeFieldBuilder
 		builderWithProperty:MK_PROPERTY(nodes)
@@ -245,7 +717,7 @@
 	exports.description = @"Exports";
 	exports.options = MKNodeFieldOptionDisplayAsChild | MKNodeFieldOptionDisplayCollectionContentsAsDetail;
 	
-	return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+	return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
 		nodes.build,
 		exports.build
 	]];
@@ -30,28 +30,23 @@
 #import "MKCString.h"
 #import "MKMachO+Libraries.h"
 #import "MKDependentLibrary.h"
-#import "MKExportTrieTerminalNode.h"
 
 //----------------------------------------------------------------------------//
 @implementation MKReExport
 
 //|++++++++++++++++++++++++++++++++++++|//
-+ (uint32_t)canInstantiateWithTrieNodes:(NSArray<MKExportTrieNode*>*)nodes
++ (uint32_t)canInstantiateWithTerminalInformation:(MKExportTerminalInformation)terminalInformation
 {
-	MKExportTrieTerminalNode *terminalNode = (MKExportTrieTerminalNode*)nodes.lastObject;
-	
-	return (self == MKReExport.class && terminalNode.flags & EXPORT_SYMBOL_FLAGS_REEXPORT) ? 50 : 0;
+	return (self == MKReExport.class && terminalInformation.flags & EXPORT_SYMBOL_FLAGS_REEXPORT) ? 50 : 0;
 }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (instancetype)initWithTrieNodes:(NSArray<MKExportTrieNode*>*)nodes error:(NSError**)error
+- (instancetype)initWithName:(NSString*)name terminalInformation:(MKExportTerminalInformation)terminalInformation atOffset:(mk_vm_offset_t)offset fromParent:(MKBackedNode*)parent error:(NSError**)error
 {
-	self = [super initWithTrieNodes:nodes error:error];
+	self = [super initWithName:name terminalInformation:terminalInformation atOffset:offset fromParent:parent error:error];
 	if (self == nil) return nil;
 	
-	MKExportTrieTerminalNode *terminalNode = (MKExportTrieTerminalNode*)nodes.lastObject;
-	
-	_sourceLibraryOrdinal = terminalNode.ordinal;
+	_sourceLibraryOrdinal = (int64_t)terminalInformation.offset;
     if (_sourceLibraryOrdinal > 0) {
         NSArray *libraries = self.macho.dependentLibraries;
         MKResult<MKDependentLibrary*> *library = nil;
@@ -68,7 +63,8 @@
         MK_PUSH_WARNING(sourceLibrary, MK_EOUT_OF_RANGE, @"Unsupported special library ordinal [%" PRIi64 "] in an export.", _sourceLibraryOrdinal);
     }
     
-	_importedName = [terminalNode.importedName.string retain];
+	if (terminalInformation.importedName)
+		_importedName = [[NSString alloc] initWithUTF8String:terminalInformation.importedName];
 	
 	return self;
 }
@@ -95,7 +91,7 @@
 //◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
 	MKNodeFieldBuilder *sourceLibraryOrdinal = [MKNodeFieldBuilder
 		builderWithProperty:MK_PROPERTY(sourceLibraryOrdinal)
@@ -118,7 +114,7 @@
     importedName.description = @"Imported Name";
     importedName.options = MKNodeFieldOptionDisplayAsDetail;
     
-	return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+	return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
 		sourceLibraryOrdinal.build,
         sourceLibrary.build,
         importedName.build
@@ -27,15 +27,14 @@
 
 #import "MKRegularExport.h"
 #import "MKInternal.h"
-#import "MKExportTrieTerminalNode.h"
 
 //----------------------------------------------------------------------------//
 @implementation MKRegularExport
 
 //|++++++++++++++++++++++++++++++++++++|//
-+ (uint32_t)canInstantiateWithTrieNodes:(NSArray<MKExportTrieNode*>*)nodes
++ (uint32_t)canInstantiateWithTerminalInformation:(MKExportTerminalInformation)terminalInformation
 {
-#pragma unused(nodes)
+#pragma unused(terminalInformation)
     if (self != MKRegularExport.class)
         return 0;
     
@@ -43,14 +42,12 @@
 }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (instancetype)initWithTrieNodes:(NSArray<MKExportTrieNode*>*)nodes error:(NSError**)error
+- (instancetype)initWithName:(NSString*)name terminalInformation:(MKExportTerminalInformation)terminalInformation atOffset:(mk_vm_offset_t)offset fromParent:(MKBackedNode*)parent error:(NSError**)error
 {
-	self = [super initWithTrieNodes:nodes error:error];
+	self = [super initWithName:name terminalInformation:terminalInformation atOffset:offset fromParent:parent error:error];
 	if (self == nil) return nil;
 	
-	MKExportTrieTerminalNode *terminalNode = (MKExportTrieTerminalNode*)nodes.lastObject;
-	
-	_address = terminalNode.offset;
+	_address = terminalInformation.offset;
 	
 	return self;
 }
@@ -66,7 +63,7 @@
 //◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     MKNodeFieldBuilder *address = [MKNodeFieldBuilder
         builderWithProperty:MK_PROPERTY(address)
@@ -75,7 +72,7 @@
     address.description = @"Address";
     address.options = MKNodeFieldOptionDisplayAsDetail;
     
-	return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+	return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         address.build
 	]];
 }
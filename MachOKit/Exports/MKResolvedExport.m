@@ -27,31 +27,26 @@
 
 #import "MKResolvedExport.h"
 #import "MKInternal.h"
-#import "MKExportTrieTerminalNode.h"
 
 //----------------------------------------------------------------------------//
 @implementation MKResolvedExport
 
 //|++++++++++++++++++++++++++++++++++++|//
-+ (uint32_t)canInstantiateWithTrieNodes:(NSArray<MKExportTrieNode*>*)nodes
++ (uint32_t)canInstantiateWithTerminalInformation:(MKExportTerminalInformation)terminalInformation
 {
     if (self != MKResolvedExport.class)
         return 0;
     
-	MKExportTrieTerminalNode *terminalNode = (MKExportTrieTerminalNode*)nodes.lastObject;
-	
-	return (terminalNode.flags & EXPORT_SYMBOL_FLAGS_STUB_AND_RESOLVER) ? 40 : 0;
+	return (terminalInformation.flags & EXPORT_SYMBOL_FLAGS_STUB_AND_RESOLVER) ? 40 : 0;
 }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (instancetype)initWithTrieNodes:(NSArray<MKExportTrieNode*>*)nodes error:(NSError**)error
+- (instancetype)initWithName:(NSString*)name terminalInformation:(MKExportTerminalInformation)terminalInformation atOffset:(mk_vm_offset_t)offset fromParent:(MKBackedNode*)parent error:(NSError**)error
 {
-	self = [super initWithTrieNodes:nodes error:error];
+	self = [super initWithName:name terminalInformation:terminalInformation atOffset:offset fromParent:parent error:error];
 	if (self == nil) return nil;
-	
-	MKExportTrieTerminalNode *terminalNode = (MKExportTrieTerminalNode*)nodes.lastObject;
 
-	_resolverAddress = terminalNode.resolver;
+	_resolverAddress = terminalInformation.resolver;
 	
 	return self;
 }
@@ -67,7 +62,7 @@
 //◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
 	MKNodeFieldBuilder *resolver = [MKNodeFieldBuilder
 		builderWithProperty:MK_PROPERTY(resolverAddress)
@@ -76,7 +71,7 @@
 	resolver.description = @"Resolver Address";
 	resolver.options = MKNodeFieldOptionDisplayAsDetail;
 	
-	return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+	return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
 		resolver.build
 	]];
 }
@@ -85,7 +85,7 @@
 { return sizeof(struct fat_arch); }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     MKNodeFieldBuilder *cpuType = [MKNodeFieldBuilder
         builderWithProperty:MK_PROPERTY(cputype)
@@ -127,7 +127,7 @@
     alignment.description = @"Alignment";
     alignment.options = MKNodeFieldOptionDisplayAsDetail;
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         cpuType.build,
         cpuSubType.build,
         offset.build,
@@ -136,6 +136,13 @@
     ]];
 }
 
+//|++++++++++++++++++++++++++++++++++++|//
+- (id)layoutKey
+{
+    // The type of the cpusubtype field depends on the cputype.
+    return @[super.layoutKey ?: [NSNull null], @(self.cputype)];
+}
+
 //◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
 #pragma mark -  NSObject
 //◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
@@ -136,7 +136,7 @@
 }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     MKNodeFieldBuilder *magic = [MKNodeFieldBuilder
         builderWithProperty:MK_PROPERTY(magic)
@@ -165,7 +165,7 @@
     architectures.description = @"Architectures";
     architectures.options = MKNodeFieldOptionDisplayAsChild | MKNodeFieldOptionDisplayAsDetail | MKNodeFieldOptionMergeWithParent;
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         magic.build,
         nfat_arch.build,
         architectures.build
@@ -87,7 +87,7 @@
 { return [(MKBackedNode*)self.parent nodeAddress:type]; }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     MKNodeFieldBuilder *address = [MKNodeFieldBuilder
         builderWithProperty:MK_PROPERTY(address)
@@ -103,7 +103,7 @@
     thumb.description = @"Thumb";
     thumb.options = MKNodeFieldOptionDisplayAsDetail;
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         address.build,
         thumb.build
     ]];
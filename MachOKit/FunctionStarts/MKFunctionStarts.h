@@ -26,6 +26,7 @@
 //----------------------------------------------------------------------------//
 
 #include <MachOKit/macho.h>
+#include <pthread.h>
 #import <Foundation/Foundation.h>
 
 #import <MachOKit/MKLinkEditNode.h>
@@ -39,15 +40,62 @@ NS_ASSUME_NONNULL_BEGIN
 @interface MKFunctionStarts : MKLinkEditNode {
 @package
     NSArray<MKFunctionOffset*> *_offsets;
+    pthread_mutex_t _offsetsLock;
     NSArray<MKFunction*> *_functions;
+    pthread_mutex_t _functionsLock;
+    // Function addresses, in ascending order.  The thumb bit is not
+    // cleared. //
+    mk_vm_address_t *_addresses;
+    // Offset of the delta for each function, in the data //
+    uint32_t *_dataOffsets;
+    NSUInteger _addressCount;
+    mk_vm_address_t _addressMask;
+    mk_vm_address_t _endAddress;
 }
 
-//!
+//! An array of nodes, one for each delta in the function starts data.  The
+//! nodes are instantiated the first time this property is accessed.
 @property (nonatomic, readonly) NSArray<MKFunctionOffset*> *offsets;
 
-//!
+//! An array of functions, in ascending order of address.  The functions
+//! are instantiated the first time this property is accessed.
 @property (nonatomic, readonly) NSArray<MKFunction*> *functions;
 
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+#pragma mark -  Looking Up Functions
+//! @name       Looking Up Functions
+//!
+//! The function starts data is decoded into a sorted array of addresses
+//! when the receiver is initialized.  These methods search that array
+//! without instantiating any nodes.  Addresses follow \c MKNodeVMAddress
+//! semantics; the slide of an image loaded from memory is not applied.
+//! A function extends from its address to the address of the next
+//! function.  The last function extends to the end of the segment that
+//! contains it.
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+
+//! The number of functions.
+@property (nonatomic, readonly) NSUInteger functionCount;
+
+//! Returns the address of the function at \a index.  As for
+//! \ref -[MKFunction address], the thumb bit is cleared.
+- (mk_vm_address_t)addressOfFunctionAtIndex:(NSUInteger)index;
+
+//! Returns the index of the function that contains \a address, or
+//! \c NSNotFound.
+- (NSUInteger)indexOfFunctionContainingAddress:(mk_vm_address_t)address;
+
+//! Returns the function that contains \a address, or \c nil.  If the
+//! \ref functions have not been instantiated, only the returned function
+//! is.
+- (nullable MKFunction*)functionContainingAddress:(mk_vm_address_t)address;
+
+//! Looks up each of the \a count addresses in \a addresses as if by
+//! \ref indexOfFunctionContainingAddress:, and stores the result in the
+//! corresponding element of \a indexes.  Runs of addresses in ascending
+//! order are looked up without restarting the search.
+- (void)getIndexes:(NSUInteger*)indexes ofFunctionsContainingAddresses:(const mk_vm_address_t*)addresses count:(NSUInteger)count;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -28,26 +28,173 @@
 #import "MKFunctionStarts.h"
 #import "MKInternal.h"
 #import "MKMachO.h"
+#import "MKMachO+Segments.h"
+#import "MKSegment.h"
 #import "MKLCFunctionStarts.h"
 #import "MKFunctionOffset.h"
 #import "MKFunction.h"
 
+//|++++++++++++++++++++++++++++++++++++|//
+static NSUInteger
+MKFunctionStartsDecode(mk_vm_address_t *addresses, uint32_t *dataOffsets, const uint8_t *start, const uint8_t *end, mk_vm_address_t address, mk_error_t *error)
+{
+    const uint8_t *p = start;
+    NSUInteger count = 0;
+    
+    while (p < end)
+    {
+        uint32_t dataOffset = (uint32_t)(p - start);
+        uint64_t delta = 0;
+        unsigned shift = 0;
+        uint8_t byte;
+        
+        do {
+            if (p == end || shift > 63) { *error = MK_EINVALID_DATA; return count; }
+            byte = *p++;
+            delta |= (uint64_t)(byte & 0x7f) << shift;
+            shift += 7;
+        } while (byte & 0x80);
+        
+        // The list is terminated by a zero delta.
+        if (delta == 0)
+            break;
+        
+        if (address + delta < address) { *error = MK_EOVERFLOW; return count; }
+        address += delta;
+        
+        addresses[count] = address;
+        dataOffsets[count] = dataOffset;
+        count++;
+    }
+    
+    return count;
+}
+
 //----------------------------------------------------------------------------//
 @implementation MKFunctionStarts
 
-@synthesize offsets = _offsets;
-@synthesize functions = _functions;
-
 //|++++++++++++++++++++++++++++++++++++|//
 - (instancetype)initWithSize:(mk_vm_size_t)size offset:(mk_vm_offset_t)offset inImage:(MKMachOImage*)image error:(NSError**)error
 {
     self = [super initWithSize:size offset:offset inImage:image error:error];
     if (self == nil) return nil;
     
-    // Parse the function offsets
-    @autoreleasepool
+    pthread_mutex_init(&_offsetsLock, NULL);
+    pthread_mutex_init(&_functionsLock, NULL);
+    
+    // Decode the function addresses.  Each delta is at least one byte, which
+    // bounds the number of addresses.
     {
-        NSMutableArray<MKFunctionOffset*> *offsets = [[NSMutableArray alloc] initWithCapacity:(NSUInteger)size/3];
+        mk_vm_size_t nodeSize = self.nodeSize;
+        // The initial offset is the delta from the start of __TEXT
+        mk_vm_address_t textAddress = self.macho.nodeVMAddress;
+        __block mk_error_t decodeError = MK_ESUCCESS;
+        __block NSError *remapError = nil;
+        
+        // Lookups clear the thumb bit.  See -[MKFunction address].
+        _addressMask = (mk_architecture_get_cpu_type(self.macho.architecture) == CPU_TYPE_ARM) ? (mk_vm_address_t)-2 : (mk_vm_address_t)-1;
+        
+        _addresses = malloc((size_t)(nodeSize ?: 1) * sizeof(*_addresses));
+        _dataOffsets = malloc((size_t)(nodeSize ?: 1) * sizeof(*_dataOffsets));
+        
+        if (_addresses == NULL || _dataOffsets == NULL) {
+            MK_PUSH_WARNING(functionCount, MK_EINTERNAL_ERROR, @"Could not allocate storage for the function starts of [%" MK_VM_PRIuSIZE "] bytes of data.", nodeSize);
+        } else if (nodeSize > 0) {
+            [self.memoryMap adviseAccessPattern:MKMemoryMapAccessPatternSequential atOffset:0 fromAddress:self.nodeContextAddress length:nodeSize];
+            
+            [self.memoryMap remapBytesAtOffset:0 fromAddress:self.nodeContextAddress length:nodeSize requireFull:YES withHandler:^(vm_address_t address, vm_size_t length, NSError *e) {
+                if (e) { remapError = [e retain]; return; }
+                _addressCount = MKFunctionStartsDecode(_addresses, _dataOffsets, (const uint8_t*)address, (const uint8_t*)address + length, textAddress, &decodeError);
+            }];
+        }
+        
+        if (remapError) {
+            MK_PUSH_WARNING_WITH_ERROR(functionCount, MK_EINTERNAL_ERROR, remapError, @"Could not map the function starts data.");
+            [remapError release];
+        } else if (decodeError != MK_ESUCCESS) {
+            MK_PUSH_WARNING(functionCount, decodeError, @"Function starts data is malformed after function [%lu].  Truncating.", (unsigned long)_addressCount);
+        }
+        
+        // Release the unused capacity.  If shrinking fails, the original
+        // allocations are kept.
+        if (_addressCount > 0) {
+            mk_vm_address_t *addresses = realloc(_addresses, _addressCount * sizeof(*_addresses));
+            if (addresses) _addresses = addresses;
+            uint32_t *dataOffsets = realloc(_dataOffsets, _addressCount * sizeof(*_dataOffsets));
+            if (dataOffsets) _dataOffsets = dataOffsets;
+        }
+        
+        // The last function extends to the end of its segment.
+        if (_addressCount > 0) {
+            mk_vm_address_t lastAddress = _addresses[_addressCount - 1] & _addressMask;
+            _endAddress = lastAddress + 1;
+            
+            for (MKResult<MKSegment*> *result in self.macho.segments) {
+                MKSegment *segment = result.value;
+                if (segment && lastAddress >= segment.vmAddress && lastAddress - segment.vmAddress < segment.vmSize) {
+                    _endAddress = segment.vmAddress + segment.vmSize;
+                    break;
+                }
+            }
+        }
+    }
+    
+    return self;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (instancetype)initWithImage:(MKMachOImage*)image error:(NSError**)error
+{
+    NSParameterAssert(image != nil);
+    
+    // Find LC_FUNCTION_STARTS
+    MKLCFunctionStarts *functionStartsLoadCommand = nil;
+    {
+        NSArray<MKLCFunctionStarts*> *commands = [image loadCommandsOfType:LC_FUNCTION_STARTS];
+        
+        if (commands.count > 1)
+            MK_PUSH_WARNING(nil, MK_EINVALID_DATA, @"Image contains multiple LC_FUNCTION_STARTS load commands.  Ignoring %@.", commands.lastObject);
+        
+        if (commands.count == 0) {
+            // Not an error - Image has no function starts information.
+            [self release]; return nil;
+        }
+        
+        functionStartsLoadCommand = [[commands.firstObject retain] autorelease];
+    }
+    
+    return [self initWithSize:functionStartsLoadCommand.datasize offset:functionStartsLoadCommand.dataoff inImage:image error:error];
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (instancetype)initWithParent:(MKNode*)parent error:(NSError**)error
+{ return [self initWithImage:parent.macho error:error]; }
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)dealloc
+{
+    free(_dataOffsets);
+    free(_addresses);
+    [_functions release];
+    [_offsets release];
+    pthread_mutex_destroy(&_functionsLock);
+    pthread_mutex_destroy(&_offsetsLock);
+    
+    [super dealloc];
+}
+
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+#pragma mark -  Function Starts Nodes
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (NSArray*)offsets
+{
+    pthread_mutex_lock(&_offsetsLock);
+    
+    if (_offsets == nil)
+    @autoreleasepool {
+        NSMutableArray<MKFunctionOffset*> *offsets = [[NSMutableArray alloc] initWithCapacity:_addressCount + 1];
         mk_vm_offset_t offset = 0;
         
         while (offset < self.nodeSize)
@@ -71,10 +218,20 @@
         [offsets release];
     }
     
-    // Determine the function addresses
-    @autoreleasepool
-    {
-        NSMutableArray<MKFunction*> *functions = [[NSMutableArray alloc] initWithCapacity:(NSUInteger)size/3];
+    pthread_mutex_unlock(&_offsetsLock);
+    
+    // SAFE - Once set, _offsets is never modified.
+    return _offsets;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (NSArray*)functions
+{
+    pthread_mutex_lock(&_functionsLock);
+    
+    if (_functions == nil)
+    @autoreleasepool {
+        NSMutableArray<MKFunction*> *functions = [[NSMutableArray alloc] initWithCapacity:_addressCount];
         
         mk_error_t err;
         NSError *functionError = nil;
@@ -86,7 +243,7 @@
         // TODO - Thumb needs some special handling.  See FunctionStartsAtom<A>::encode()
         // <https://opensource.apple.com/source/ld64/ld64-274.2/src/ld/LinkEdit.hpp.auto.html>
         
-        for (MKFunctionOffset *offset in _offsets) {
+        for (MKFunctionOffset *offset in self.offsets) {
             context.offset = offset;
             
             mk_vm_offset_t nextFunctionOffset = offset.offset;
@@ -114,44 +271,111 @@
         [functions release];
     }
     
-    return self;
+    pthread_mutex_unlock(&_functionsLock);
+    
+    // SAFE - Once set, _functions is never modified.
+    return _functions;
 }
 
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+#pragma mark -  Looking Up Functions
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+
+@synthesize functionCount = _addressCount;
+
 //|++++++++++++++++++++++++++++++++++++|//
-- (instancetype)initWithImage:(MKMachOImage*)image error:(NSError**)error
+- (mk_vm_address_t)addressOfFunctionAtIndex:(NSUInteger)index
 {
-    NSParameterAssert(image != nil);
+    if (index >= _addressCount) {
+        NSString *reason = [NSString stringWithFormat:@"Index [%lu] is beyond the bounds of the function list [0 .. %lu).", (unsigned long)index, (unsigned long)_addressCount];
+        @throw [NSException exceptionWithName:NSRangeException reason:reason userInfo:nil];
+    }
     
-    // Find LC_FUNCTION_STARTS
-    MKLCFunctionStarts *functionStartsLoadCommand = nil;
-    {
-        NSArray<MKLCFunctionStarts*> *commands = [image loadCommandsOfType:LC_FUNCTION_STARTS];
-        
-        if (commands.count > 1)
-            MK_PUSH_WARNING(nil, MK_EINVALID_DATA, @"Image contains multiple LC_FUNCTION_STARTS load commands.  Ignoring %@.", commands.lastObject);
-        
-        if (commands.count == 0) {
-            // Not an error - Image has no function starts information.
-            [self release]; return nil;
-        }
-        
-        functionStartsLoadCommand = [[commands.firstObject retain] autorelease];
+    return _addresses[index] & _addressMask;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+static NSUInteger
+MKFunctionStartsSearch(const mk_vm_address_t *addresses, NSUInteger lo, NSUInteger hi, mk_vm_address_t mask, mk_vm_address_t address)
+{
+    // Find the last address in [lo, hi) that is <= address.
+    while (lo < hi) {
+        NSUInteger mid = lo + (hi - lo) / 2;
+        if ((addresses[mid] & mask) <= address)
+            lo = mid + 1;
+        else
+            hi = mid;
     }
     
-    return [self initWithSize:functionStartsLoadCommand.datasize offset:functionStartsLoadCommand.dataoff inImage:image error:error];
+    return lo - 1;
 }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (instancetype)initWithParent:(MKNode*)parent error:(NSError**)error
-{ return [self initWithImage:parent.macho error:error]; }
+- (NSUInteger)indexOfFunctionContainingAddress:(mk_vm_address_t)address
+{
+    if (_addressCount == 0 || address < (_addresses[0] & _addressMask) || address >= _endAddress)
+        return NSNotFound;
+    
+    return MKFunctionStartsSearch(_addresses, 0, _addressCount, _addressMask, address);
+}
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (void)dealloc
+- (MKFunction*)functionContainingAddress:(mk_vm_address_t)address
 {
-    [_functions release];
-    [_offsets release];
+    NSUInteger index = [self indexOfFunctionContainingAddress:address];
+    if (index == NSNotFound)
+        return nil;
     
-    [super dealloc];
+    pthread_mutex_lock(&_functionsLock);
+    NSArray<MKFunction*> *functions = [[_functions retain] autorelease];
+    pthread_mutex_unlock(&_functionsLock);
+    
+    if (functions)
+        return (index < functions.count) ? functions[index] : nil;
+    
+    // Instantiate only the function containing the address, and the
+    // function offset node that it belongs to.
+    MKFunctionOffset *offset = [[[MKFunctionOffset alloc] initWithOffset:_dataOffsets[index] fromParent:self error:NULL] autorelease];
+    if (offset == nil)
+        return nil;
+    
+    struct MKFunctionStartsContext context = { .address = _addresses[index], .offset = offset, .info = self };
+    return [[[MKFunction alloc] initWithContext:&context error:NULL] autorelease];
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)getIndexes:(NSUInteger*)indexes ofFunctionsContainingAddresses:(const mk_vm_address_t*)addresses count:(NSUInteger)count
+{
+    NSParameterAssert(indexes != NULL || count == 0);
+    NSParameterAssert(addresses != NULL || count == 0);
+    
+    // While the addresses ascend, each search starts from the previous
+    // result.
+    NSUInteger lo = 0;
+    mk_vm_address_t previous = 0;
+    
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        mk_vm_address_t address = addresses[i];
+        
+        if (_addressCount == 0 || address < (_addresses[0] & _addressMask) || address >= _endAddress) {
+            indexes[i] = NSNotFound;
+            continue;
+        }
+        
+        if (address < previous)
+            lo = 0;
+        previous = address;
+        
+        // Most nearby addresses fall in the same or the next function.
+        if (lo + 1 < _addressCount && (_addresses[lo] & _addressMask) <= address && address < (_addresses[lo + 1] & _addressMask)) {
+            indexes[i] = lo;
+            continue;
+        }
+        
+        lo = MKFunctionStartsSearch(_addresses, lo, _addressCount, _addressMask, address);
+        indexes[i] = lo;
+    }
 }
 
 //◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
@@ -159,7 +383,7 @@
 //◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     MKNodeFieldBuilder *offsets = [MKNodeFieldBuilder
         builderWithProperty:MK_PROPERTY(offsets)
@@ -175,7 +399,7 @@
     functions.description = @"Functions";
     functions.options = MKNodeFieldOptionDisplayAsChild | MKNodeFieldOptionDisplayContainerContentsAsDetail;
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         offsets.build,
         functions.build
     ]];
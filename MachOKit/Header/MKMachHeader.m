@@ -81,7 +81,7 @@
 { return sizeof(struct mach_header); }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     __unused struct mach_header mh;
     
@@ -147,7 +147,7 @@
     flags.description = @"Flags";
     flags.options = MKNodeFieldOptionDisplayAsDetail;
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         magic.build,
         cputype.build,
         cpusubtype.build,
@@ -158,6 +158,13 @@
     ]];
 }
 
+//|++++++++++++++++++++++++++++++++++++|//
+- (id)layoutKey
+{
+    // The type of the cpusubtype field depends on the cputype.
+    return @[super.layoutKey ?: [NSNull null], @(self.cputype)];
+}
+
 //◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
 #pragma mark -  NSObject
 //◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
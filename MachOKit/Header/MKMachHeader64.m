@@ -72,7 +72,7 @@
 { return sizeof(struct mach_header_64); }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     __unused struct mach_header_64 mh;
     
@@ -84,7 +84,7 @@
     reserved.description = @"Reserved";
     reserved.options = MKNodeFieldOptionDisplayAsDetail;
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         reserved.build
     ]];
 }
@@ -0,0 +1,99 @@
+//----------------------------------------------------------------------------//
+//|
+//|             MachOKit - A Lightweight Mach-O Parsing Library
+//! @file       MKImageIndex.h
+//!
+//! @author     D.V.
+//! @copyright  Copyright (c) 2014-2015 D.V. All rights reserved.
+//|
+//| Permission is hereby granted, free of charge, to any person obtaining a
+//| copy of this software and associated documentation files (the "Software"),
+//| to deal in the Software without restriction, including without limitation
+//| the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//| and/or sell copies of the Software, and to permit persons to whom the
+//| Software is furnished to do so, subject to the following conditions:
+//|
+//| The above copyright notice and this permission notice shall be included
+//| in all copies or substantial portions of the Software.
+//|
+//| THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//| OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//| MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//| IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//| CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//| TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//| SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//----------------------------------------------------------------------------//
+
+
+#include <MachOKit/macho.h>
+#import <Foundation/Foundation.h>
+
+@class MKMachOImage;
+
+NS_ASSUME_NONNULL_BEGIN
+
+//----------------------------------------------------------------------------//
+//! An instance of \c MKImageIndex wraps a persistent image index (see
+//! \c mk_image_index_t).  An index is built once from a fully parsed
+//! \ref MKMachOImage and written to disk.  Later, it is loaded with a single
+//! \c mmap and queried in place, without reparsing the image.
+//
+@interface MKImageIndex : NSObject {
+@package
+    mk_image_index_t _index;
+    NSData *_data;
+}
+
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+#pragma mark -  Building an Index
+//! @name       Building an Index
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+
+//! Builds an image index for \a image.  The segment and section tables,
+//! symbol table, exports and function starts of \a image are parsed if they
+//! have not been already.
+//!
+//! @return
+//! The serialized index, or \c nil if \a image has no \c LC_UUID.
++ (nullable NSData*)indexDataForImage:(MKMachOImage*)image error:(NSError**)error;
+
+//! Builds an image index for \a image and atomically writes it to \a url.
++ (BOOL)writeIndexForImage:(MKMachOImage*)image toURL:(NSURL*)url error:(NSError**)error;
+
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+#pragma mark -  Loading an Index
+//! @name       Loading an Index
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+
+//! Maps the image index at \a url.
+- (nullable instancetype)initWithContentsOfURL:(NSURL*)url error:(NSError**)error;
+
+//! Initializes the receiver with an image index previously returned from
+//! \ref indexDataForImage:error:.
+- (nullable instancetype)initWithData:(NSData*)data error:(NSError**)error;
+
+//! The underlying index.  Valid for the lifetime of the receiver.
+@property (nonatomic, readonly) const mk_image_index_t *index;
+
+@property (nonatomic, readonly) NSUUID *uuid;
+@property (nonatomic, readonly) cpu_type_t cputype;
+@property (nonatomic, readonly) cpu_subtype_t cpusubtype;
+
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+#pragma mark -  Validating an Index
+//! @name       Validating an Index
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+
+//! Returns \c YES if the receiver was built from an image with the same
+//! UUID and architecture as \a image.
+- (BOOL)isValidForImage:(MKMachOImage*)image;
+
+//! Returns \c YES if the file at \a url contains an image (or FAT slice)
+//! with the same UUID and architecture as the receiver.  Only the headers
+//! and load commands of the file are read.
+- (BOOL)isValidForFileAtURL:(NSURL*)url;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,501 @@
+//----------------------------------------------------------------------------//
+//|
+//|             MachOKit - A Lightweight Mach-O Parsing Library
+//|             MKImageIndex.m
+//|
+//|             D.V.
+//|             Copyright (c) 2014-2015 D.V. All rights reserved.
+//|
+//| Permission is hereby granted, free of charge, to any person obtaining a
+//| copy of this software and associated documentation files (the "Software"),
+//| to deal in the Software without restriction, including without limitation
+//| the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//| and/or sell copies of the Software, and to permit persons to whom the
+//| Software is furnished to do so, subject to the following conditions:
+//|
+//| The above copyright notice and this permission notice shall be included
+//| in all copies or substantial portions of the Software.
+//|
+//| THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//| OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//| MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//| IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//| CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//| TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//| SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//----------------------------------------------------------------------------//
+
+
+#import "MKImageIndex.h"
+#import "MKInternal.h"
+#import "MKMachO.h"
+#import "MKMachHeader.h"
+#import "MKLCUUID.h"
+#import "MKLCSegment.h"
+#import "MKMachO+Symbols.h"
+#import "MKSymbolTable.h"
+#import "MKRegularSymbol.h"
+#import "MKCString.h"
+#import "MKMachO+Exports.h"
+#import "MKExportsInfo.h"
+#import "MKRegularExport.h"
+#import "MKResolvedExport.h"
+#import "MKReExport.h"
+#import "MKMachO+Functions.h"
+#import "MKFunctionStarts.h"
+#import "MKFunction.h"
+#import "MKImageInventory.h"
+
+//----------------------------------------------------------------------------//
+#pragma mark -  Building
+//----------------------------------------------------------------------------//
+
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+//! An export entry paired with its name, for sorting.
+//
+struct MKImageIndexNamedExport {
+    mk_image_index_export_t entry;
+    const char *name;
+};
+
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+//! An export index paired with its address, for sorting.
+//
+struct MKImageIndexAddressedExport {
+    uint64_t value;
+    uint32_t index;
+};
+
+//|++++++++++++++++++++++++++++++++++++|//
+static int
+MKImageIndexCompareSymbols(const void *a, const void *b)
+{
+    const mk_image_index_symbol_t *lhs = a;
+    const mk_image_index_symbol_t *rhs = b;
+    
+    if (lhs->address != rhs->address)
+        return (lhs->address < rhs->address) ? -1 : 1;
+    // Keep the result deterministic for symbols at the same address.
+    return (lhs->name < rhs->name) ? -1 : (lhs->name > rhs->name);
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+static int
+MKImageIndexCompareExports(const void *a, const void *b)
+{
+    const struct MKImageIndexNamedExport *lhs = a;
+    const struct MKImageIndexNamedExport *rhs = b;
+    return strcmp(lhs->name, rhs->name);
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+static int
+MKImageIndexCompareAddressedExports(const void *a, const void *b)
+{
+    const struct MKImageIndexAddressedExport *lhs = a;
+    const struct MKImageIndexAddressedExport *rhs = b;
+    
+    if (lhs->value != rhs->value)
+        return (lhs->value < rhs->value) ? -1 : 1;
+    return (lhs->index < rhs->index) ? -1 : (lhs->index > rhs->index);
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+static int
+MKImageIndexCompareAddresses(const void *a, const void *b)
+{
+    uint64_t lhs = *(const uint64_t*)a;
+    uint64_t rhs = *(const uint64_t*)b;
+    return (lhs < rhs) ? -1 : (lhs > rhs);
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+static uint32_t
+MKImageIndexAddString(NSMutableData *strings, NSMutableDictionary<NSString*, NSNumber*> *offsets, NSString *string)
+{
+    if (string.length == 0)
+        return 0;
+    
+    NSNumber *existing = offsets[string];
+    if (existing)
+        return existing.unsignedIntValue;
+    
+    const char *utf8 = string.UTF8String;
+    if (utf8 == NULL)
+        return 0;
+    
+    uint32_t offset = (uint32_t)strings.length;
+    [strings appendBytes:utf8 length:strlen(utf8) + 1];
+    offsets[string] = @(offset);
+    
+    return offset;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+static void
+MKImageIndexCopyName(char output[16], NSString *name)
+{
+    memset(output, 0, 16);
+    
+    const char *utf8 = name.UTF8String;
+    if (utf8)
+        strncpy(output, utf8, 16);
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+static mk_image_index_table_t
+MKImageIndexAppendTable(NSMutableData *output, const void *bytes, size_t entrySize, NSUInteger count, size_t alignment)
+{
+    mk_image_index_table_t table = { 0, 0 };
+    
+    if (count == 0)
+        return table;
+    
+    NSUInteger padding = (alignment - (output.length % alignment)) % alignment;
+    [output increaseLengthBy:padding];
+    
+    table.offset = (uint32_t)output.length;
+    table.count = (uint32_t)count;
+    [output appendBytes:bytes length:entrySize * count];
+    
+    return table;
+}
+
+//----------------------------------------------------------------------------//
+@implementation MKImageIndex
+
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+#pragma mark -  Building an Index
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+
+//|++++++++++++++++++++++++++++++++++++|//
++ (NSData*)indexDataForImage:(MKMachOImage*)image error:(NSError**)error
+{
+    NSParameterAssert(image != nil);
+    
+    MKLCUUID *uuidCommand = [[image loadCommandsOfType:LC_UUID] firstObject];
+    if (uuidCommand == nil) {
+        MK_ERROR_OUT = [NSError mk_errorWithDomain:MKErrorDomain code:MK_ENOT_FOUND description:@"Image does not have an LC_UUID load command."];
+        return nil;
+    }
+    
+    mk_image_index_header_t header;
+    memset(&header, 0, sizeof(header));
+    header.magic = MK_IMAGE_INDEX_MAGIC;
+    header.version = MK_IMAGE_INDEX_VERSION;
+    header.cputype = image.header.cputype;
+    header.cpusubtype = image.header.cpusubtype;
+    [uuidCommand.uuid getUUIDBytes:header.uuid];
+    
+    NSMutableData *strings = [NSMutableData dataWithLength:1];
+    NSMutableDictionary *stringOffsets = [NSMutableDictionary dictionary];
+    
+    // Segments and sections, in load command order.
+    NSMutableData *segments = [NSMutableData data];
+    NSMutableData *sections = [NSMutableData data];
+    BOOL foundVMAddress = NO;
+    
+    for (MKLoadCommand *loadCommand in image.loadCommands)
+    {
+        if (![loadCommand conformsToProtocol:@protocol(MKLCSegment)])
+            continue;
+        
+        id<MKLCSegment> segmentCommand = (id<MKLCSegment>)loadCommand;
+        mk_image_index_segment_t segment;
+        
+        MKImageIndexCopyName(segment.name, segmentCommand.segname);
+        segment.vmaddr = segmentCommand.mk_vmaddr;
+        segment.vmsize = segmentCommand.mk_vmsize;
+        segment.fileoff = segmentCommand.mk_fileoff;
+        segment.filesize = segmentCommand.mk_filesize;
+        segment.maxprot = (uint32_t)segmentCommand.maxprot;
+        segment.initprot = (uint32_t)segmentCommand.initprot;
+        segment.first_section = (uint32_t)(sections.length / sizeof(mk_image_index_section_t));
+        segment.nsects = 0;
+        
+        // The segment that maps the header determines the preferred load
+        // address.
+        if (!foundVMAddress && segment.fileoff == 0 && segment.filesize != 0) {
+            header.vmaddr = segment.vmaddr;
+            foundVMAddress = YES;
+        }
+        
+        for (id<MKLCSection> sectionCommand in segmentCommand.sections) {
+            mk_image_index_section_t section;
+            
+            MKImageIndexCopyName(section.segname, sectionCommand.segname);
+            MKImageIndexCopyName(section.sectname, sectionCommand.sectname);
+            section.addr = sectionCommand.mk_addr;
+            section.size = sectionCommand.mk_size;
+            section.offset = (uint32_t)sectionCommand.mk_offset;
+            section.flags = sectionCommand.flags;
+            
+            [sections appendBytes:&section length:sizeof(section)];
+            segment.nsects++;
+        }
+        
+        [segments appendBytes:&segment length:sizeof(segment)];
+    }
+    
+    // Symbols, sorted by address.  Only symbols defined in a section are
+    // indexed; debug, absolute, undefined, and indirect symbols do not have
+    // an address in this image.
+    NSMutableData *symbols = [NSMutableData data];
+    
+    for (MKSymbol *symbol in image.symbolTable.value.symbols)
+    {
+        if (![symbol isKindOfClass:MKRegularSymbol.class])
+            continue;
+        if ((symbol.type & N_STAB) || (symbol.type & N_TYPE) != N_SECT)
+            continue;
+        
+        mk_image_index_symbol_t entry;
+        entry.address = symbol.value;
+        entry.name = MKImageIndexAddString(strings, stringOffsets, [(MKRegularSymbol*)symbol name].value.string);
+        entry.type = symbol.type;
+        entry.sect = symbol.sect;
+        entry.desc = symbol.desc;
+        
+        [symbols appendBytes:&entry length:sizeof(entry)];
+    }
+    
+    NSUInteger symbolCount = symbols.length / sizeof(mk_image_index_symbol_t);
+    mk_image_index_symbol_t *symbolEntries = symbols.mutableBytes;
+    qsort(symbolEntries, symbolCount, sizeof(mk_image_index_symbol_t), MKImageIndexCompareSymbols);
+    
+    // Exports
+    NSArray<MKExport*> *exports = image.exportsInfo.value.exports;
+    NSMutableData *namedExports = [NSMutableData dataWithLength:exports.count * sizeof(struct MKImageIndexNamedExport)];
+    struct MKImageIndexNamedExport *namedExportEntries = namedExports.mutableBytes;
+    
+    [exports enumerateObjectsUsingBlock:^(MKExport *anExport, NSUInteger idx, __unused BOOL *stop) {
+        mk_image_index_export_t *entry = &namedExportEntries[idx].entry;
+        
+        entry->name = MKImageIndexAddString(strings, stringOffsets, anExport.name);
+        entry->flags = (uint32_t)(anExport.kind | anExport.options);
+        
+        if ([anExport isKindOfClass:MKReExport.class]) {
+            entry->value = (uint64_t)[(MKReExport*)anExport sourceLibraryOrdinal];
+            entry->imported_name = MKImageIndexAddString(strings, stringOffsets, [(MKReExport*)anExport importedName]);
+        } else if ([anExport isKindOfClass:MKRegularExport.class]) {
+            entry->value = [(MKRegularExport*)anExport address];
+        }
+        
+        if ([anExport isKindOfClass:MKResolvedExport.class])
+            entry->resolver = [(MKResolvedExport*)anExport resolverAddress];
+    }];
+    
+    // The string table is complete; resolve the export names and sort.
+    NSMutableData *exportEntries = [NSMutableData dataWithLength:exports.count * sizeof(mk_image_index_export_t)];
+    {
+        const char *stringBytes = strings.bytes;
+        
+        for (NSUInteger i = 0; i < exports.count; i++)
+            namedExportEntries[i].name = stringBytes + namedExportEntries[i].entry.name;
+        
+        qsort(namedExportEntries, exports.count, sizeof(struct MKImageIndexNamedExport), MKImageIndexCompareExports);
+        
+        mk_image_index_export_t *entries = exportEntries.mutableBytes;
+        for (NSUInteger i = 0; i < exports.count; i++)
+            entries[i] = namedExportEntries[i].entry;
+    }
+    
+    // Exports with an address, sorted by address.  Re-exports do not have
+    // an address in this image.  The value of absolute and thread local
+    // exports is not an offset from the start of the image.
+    NSMutableData *exportsByAddress = [NSMutableData data];
+    {
+        const mk_image_index_export_t *entries = exportEntries.bytes;
+        NSMutableData *addressedExports = [NSMutableData data];
+        
+        for (uint32_t i = 0; i < (uint32_t)exports.count; i++) {
+            if (entries[i].flags & EXPORT_SYMBOL_FLAGS_REEXPORT)
+                continue;
+            if ((entries[i].flags & EXPORT_SYMBOL_FLAGS_KIND_MASK) != EXPORT_SYMBOL_FLAGS_KIND_REGULAR)
+                continue;
+            
+            struct MKImageIndexAddressedExport addressed = { entries[i].value, i };
+            [addressedExports appendBytes:&addressed length:sizeof(addressed)];
+        }
+        
+        NSUInteger count = addressedExports.length / sizeof(struct MKImageIndexAddressedExport);
+        struct MKImageIndexAddressedExport *addressed = addressedExports.mutableBytes;
+        qsort(addressed, count, sizeof(*addressed), MKImageIndexCompareAddressedExports);
+        
+        for (NSUInteger i = 0; i < count; i++)
+            [exportsByAddress appendBytes:&addressed[i].index length:sizeof(uint32_t)];
+    }
+    
+    // Function starts
+    NSArray<MKFunction*> *functions = image.functionStarts.value.functions;
+    NSMutableData *functionStarts = [NSMutableData dataWithLength:functions.count * sizeof(uint64_t)];
+    {
+        uint64_t *starts = functionStarts.mutableBytes;
+        
+        [functions enumerateObjectsUsingBlock:^(MKFunction *function, NSUInteger idx, __unused BOOL *stop) {
+            starts[idx] = function.address;
+        }];
+        
+        qsort(starts, functions.count, sizeof(uint64_t), MKImageIndexCompareAddresses);
+    }
+    
+    // Symbol name hash.  The bucket count is at least twice the number of
+    // symbols so probe sequences stay short.
+    uint32_t bucketCount = 0;
+    NSMutableData *symbolNames = nil;
+    if (symbolCount > 0)
+    {
+        bucketCount = 1;
+        while ((NSUInteger)bucketCount < symbolCount * 2)
+            bucketCount <<= 1;
+        
+        symbolNames = [NSMutableData dataWithLength:bucketCount * sizeof(uint32_t)];
+        uint32_t *buckets = symbolNames.mutableBytes;
+        const char *stringBytes = strings.bytes;
+        uint32_t mask = bucketCount - 1;
+        
+        for (uint32_t i = 0; i < (uint32_t)symbolCount; i++) {
+            if (symbolEntries[i].name == 0)
+                continue;
+            
+            uint32_t bucket = mk_image_index_hash_name(stringBytes + symbolEntries[i].name) & mask;
+            while (buckets[bucket] != 0)
+                bucket = (bucket + 1) & mask;
+            buckets[bucket] = i + 1;
+        }
+    }
+    
+    if (strings.length > UINT32_MAX) {
+        MK_ERROR_OUT = [NSError mk_errorWithDomain:MKErrorDomain code:MK_ESIZE description:@"String table is too large for an image index."];
+        return nil;
+    }
+    
+    // Assemble the index.
+    NSMutableData *output = [NSMutableData dataWithLength:sizeof(header)];
+    
+    header.segments = MKImageIndexAppendTable(output, segments.bytes, sizeof(mk_image_index_segment_t), segments.length / sizeof(mk_image_index_segment_t), 8);
+    header.sections = MKImageIndexAppendTable(output, sections.bytes, sizeof(mk_image_index_section_t), sections.length / sizeof(mk_image_index_section_t), 8);
+    header.symbols = MKImageIndexAppendTable(output, symbolEntries, sizeof(mk_image_index_symbol_t), symbolCount, 8);
+    header.symbol_names = MKImageIndexAppendTable(output, symbolNames.bytes, sizeof(uint32_t), bucketCount, 4);
+    header.exports = MKImageIndexAppendTable(output, exportEntries.bytes, sizeof(mk_image_index_export_t), exports.count, 8);
+    header.exports_by_address = MKImageIndexAppendTable(output, exportsByAddress.bytes, sizeof(uint32_t), exportsByAddress.length / sizeof(uint32_t), 4);
+    header.function_starts = MKImageIndexAppendTable(output, functionStarts.bytes, sizeof(uint64_t), functions.count, 8);
+    header.strings = MKImageIndexAppendTable(output, strings.bytes, 1, strings.length, 1);
+    
+    if (output.length > UINT32_MAX) {
+        MK_ERROR_OUT = [NSError mk_errorWithDomain:MKErrorDomain code:MK_ESIZE description:@"Image index is too large."];
+        return nil;
+    }
+    
+    header.size = (uint32_t)output.length;
+    [output replaceBytesInRange:NSMakeRange(0, sizeof(header)) withBytes:&header];
+    
+    return output;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
++ (BOOL)writeIndexForImage:(MKMachOImage*)image toURL:(NSURL*)url error:(NSError**)error
+{
+    NSData *data = [self indexDataForImage:image error:error];
+    if (data == nil)
+        return NO;
+    
+    return [data writeToURL:url options:NSDataWritingAtomic error:error];
+}
+
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+#pragma mark -  Loading an Index
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (instancetype)initWithContentsOfURL:(NSURL*)url error:(NSError**)error
+{
+    NSParameterAssert(url.isFileURL);
+    mk_error_t err;
+    
+    self = [super init];
+    if (self == nil) return nil;
+    
+    if ((err = mk_image_index_open(url.fileSystemRepresentation, &_index))) {
+        MK_ERROR_OUT = [NSError mk_errorWithDomain:MKErrorDomain code:err description:@"Could not load image index at [%@].", url.path];
+        [self release]; return nil;
+    }
+    
+    return self;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (instancetype)initWithData:(NSData*)data error:(NSError**)error
+{
+    NSParameterAssert(data != nil);
+    mk_error_t err;
+    
+    self = [super init];
+    if (self == nil) return nil;
+    
+    _data = [data copy];
+    
+    if ((err = mk_image_index_init_with_bytes(_data.bytes, _data.length, &_index))) {
+        MK_ERROR_OUT = [NSError mk_errorWithDomain:MKErrorDomain code:err description:@"Invalid image index."];
+        [self release]; return nil;
+    }
+    
+    return self;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)dealloc
+{
+    mk_image_index_close(&_index);
+    [_data release];
+    
+    [super dealloc];
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (const mk_image_index_t*)index
+{ return &_index; }
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (NSUUID*)uuid
+{ return [[[NSUUID alloc] initWithUUIDBytes:_index.header->uuid] autorelease]; }
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (cpu_type_t)cputype
+{ return _index.header->cputype; }
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (cpu_subtype_t)cpusubtype
+{ return _index.header->cpusubtype; }
+
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+#pragma mark -  Validating an Index
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (BOOL)isValidForImage:(MKMachOImage*)image
+{
+    MKLCUUID *uuidCommand = [[image loadCommandsOfType:LC_UUID] firstObject];
+    if (uuidCommand == nil)
+        return NO;
+    
+    uuid_t uuid;
+    [uuidCommand.uuid getUUIDBytes:uuid];
+    
+    return mk_image_index_matches(&_index, uuid, image.header.cputype, image.header.cpusubtype);
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (BOOL)isValidForFileAtURL:(NSURL*)url
+{
+    __block BOOL valid = NO;
+    
+    [MKImageInventory summarizeFileAtURL:url withHandler:^(__unused NSURL *fileURL, __unused uint32_t sliceIndex, const mk_macho_summary_t *summary) {
+        if (mk_image_index_matches_summary(&_index, summary))
+            valid = YES;
+    } error:NULL];
+    
+    return valid;
+}
+
+@end
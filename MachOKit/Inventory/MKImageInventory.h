@@ -0,0 +1,71 @@
+//----------------------------------------------------------------------------//
+//|
+//|             MachOKit - A Lightweight Mach-O Parsing Library
+//! @file       MKImageInventory.h
+//!
+//! @author     D.V.
+//! @copyright  Copyright (c) 2014-2015 D.V. All rights reserved.
+//|
+//| Permission is hereby granted, free of charge, to any person obtaining a
+//| copy of this software and associated documentation files (the "Software"),
+//| to deal in the Software without restriction, including without limitation
+//| the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//| and/or sell copies of the Software, and to permit persons to whom the
+//| Software is furnished to do so, subject to the following conditions:
+//|
+//| The above copyright notice and this permission notice shall be included
+//| in all copies or substantial portions of the Software.
+//|
+//| THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//| OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//| MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//| IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//| CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//| TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//| SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//----------------------------------------------------------------------------//
+
+
+#include <MachOKit/macho.h>
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+//! Invoked once for each Mach-O image found.  For FAT binaries, \a sliceIndex
+//! is the index of the architecture in the FAT header; otherwise it is \c 0.
+//! The \a summary is only valid for the duration of the call.
+typedef void (^MKImageInventoryHandler)(NSURL *fileURL, uint32_t sliceIndex, const mk_macho_summary_t *summary);
+
+//! Invoked when a file could not be read.  Files that are not Mach-O images
+//! are skipped without reporting an error.
+typedef void (^MKImageInventoryErrorHandler)(NSURL *fileURL, NSError *error);
+
+//----------------------------------------------------------------------------//
+//! \c MKImageInventory summarizes Mach-O images on disk without creating a
+//! \ref MKMachOImage.  Only the header and load commands of each image are
+//! read, usually with a single \c pread of the first page of the file.
+//!
+//! Use this when only the UUID, platform, install name and dependent
+//! libraries of a large number of images are needed.
+//
+@interface MKImageInventory : NSObject
+
+//! Summarizes each Mach-O image in the file at \a fileURL.  The handler is
+//! invoked on the calling thread.
+//!
+//! @return
+//! \c NO if the file could not be read.  Returns \c YES without invoking
+//! the handler if the file is not a Mach-O image.
++ (BOOL)summarizeFileAtURL:(NSURL*)fileURL withHandler:(MKImageInventoryHandler)handler error:(NSError**)error;
+
+//! Recursively summarizes all Mach-O images in the directory at
+//! \a directoryURL, reading up to \a maxConcurrentFiles files in parallel.
+//! Pass \c 0 to use the number of active processors.
+//!
+//! Both handlers are invoked concurrently from multiple threads.  This
+//! method returns once all files have been processed.
++ (void)scanDirectoryAtURL:(NSURL*)directoryURL maxConcurrentFiles:(NSUInteger)maxConcurrentFiles withHandler:(MKImageInventoryHandler)handler errorHandler:(nullable MKImageInventoryErrorHandler)errorHandler;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,250 @@
+//----------------------------------------------------------------------------//
+//|
+//|             MachOKit - A Lightweight Mach-O Parsing Library
+//|             MKImageInventory.m
+//|
+//|             D.V.
+//|             Copyright (c) 2014-2015 D.V. All rights reserved.
+//|
+//| Permission is hereby granted, free of charge, to any person obtaining a
+//| copy of this software and associated documentation files (the "Software"),
+//| to deal in the Software without restriction, including without limitation
+//| the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//| and/or sell copies of the Software, and to permit persons to whom the
+//| Software is furnished to do so, subject to the following conditions:
+//|
+//| The above copyright notice and this permission notice shall be included
+//| in all copies or substantial portions of the Software.
+//|
+//| THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//| OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//| MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//| IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//| CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//| TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//| SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//----------------------------------------------------------------------------//
+
+
+#import "MKImageInventory.h"
+#import "MKInternal.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <mach-o/fat.h>
+
+//! The number of bytes read from the start of each image.  This is almost
+//! always enough to hold the header and all of the load commands.
+#define MKImageInventoryInitialReadSize 4096
+
+//|++++++++++++++++++++++++++++++++++++|//
+static NSError*
+MKImageInventoryPOSIXError(NSURL *fileURL, int code, NSString *description)
+{
+    NSError *posixError = [NSError errorWithDomain:NSPOSIXErrorDomain code:code userInfo:@{NSFilePathErrorKey: fileURL.path}];
+    return [NSError mk_errorWithDomain:MKErrorDomain code:MK_EBAD_ACCESS underlyingError:posixError description:@"%@ [%@].", description, fileURL.path];
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+//! Summarizes the image at \a offset in a file of \a fileSize bytes.
+//! \a buffer must be at least \c MKImageInventoryInitialReadSize bytes.
+//! Returns \c NO only for I/O errors.
+static BOOL
+MKImageInventorySummarizeImage(int fd, NSURL *fileURL, off_t fileSize, off_t offset, uint32_t sliceIndex, uint8_t *buffer, mk_macho_summary_t *summary, MKImageInventoryHandler handler, NSError **error)
+{
+    ssize_t bytesRead = pread(fd, buffer, MKImageInventoryInitialReadSize, offset);
+    if (bytesRead < 0) {
+        MK_ERROR_OUT = MKImageInventoryPOSIXError(fileURL, errno, @"Could not read file");
+        return NO;
+    }
+    
+    size_t requiredLength = mk_macho_summary_get_required_length(buffer, (size_t)bytesRead);
+    if (requiredLength == 0)
+        return YES;
+    
+    if (requiredLength <= (size_t)bytesRead) {
+        if (mk_macho_summarize_bytes(buffer, (size_t)bytesRead, summary) == MK_ESUCCESS)
+            handler(fileURL, sliceIndex, summary);
+        return YES;
+    }
+    
+    // The load commands extend past the initial read.  An image whose load
+    // commands extend past the end of the file is skipped, rather than
+    // trusting sizeofcmds to size the allocation.
+    if (requiredLength > (uint64_t)(fileSize - offset))
+        return YES;
+    
+    uint8_t *commands = malloc(requiredLength);
+    if (commands == NULL) {
+        MK_ERROR_OUT = MKImageInventoryPOSIXError(fileURL, ENOMEM, @"Could not allocate memory for the load commands of file");
+        return NO;
+    }
+    
+    bytesRead = pread(fd, commands, requiredLength, offset);
+    if (bytesRead < 0) {
+        MK_ERROR_OUT = MKImageInventoryPOSIXError(fileURL, errno, @"Could not read file");
+        free(commands);
+        return NO;
+    }
+    
+    if (mk_macho_summarize_bytes(commands, (size_t)bytesRead, summary) == MK_ESUCCESS)
+        handler(fileURL, sliceIndex, summary);
+    
+    free(commands);
+    return YES;
+}
+
+//----------------------------------------------------------------------------//
+@implementation MKImageInventory
+
+//|++++++++++++++++++++++++++++++++++++|//
++ (BOOL)summarizeFileAtURL:(NSURL*)fileURL withHandler:(MKImageInventoryHandler)handler error:(NSError**)error
+{
+    NSParameterAssert(fileURL.isFileURL);
+    NSParameterAssert(handler != nil);
+    
+    int fd = open(fileURL.fileSystemRepresentation, O_RDONLY);
+    if (fd < 0) {
+        MK_ERROR_OUT = MKImageInventoryPOSIXError(fileURL, errno, @"Could not open file");
+        return NO;
+    }
+    
+    uint8_t *buffer = malloc(MKImageInventoryInitialReadSize);
+    mk_macho_summary_t *summary = malloc(sizeof(*summary));
+    BOOL retValue = YES;
+    
+    if (buffer == NULL || summary == NULL) {
+        MK_ERROR_OUT = MKImageInventoryPOSIXError(fileURL, ENOMEM, @"Could not allocate memory to summarize file");
+        retValue = NO;
+        goto done;
+    }
+    
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        MK_ERROR_OUT = MKImageInventoryPOSIXError(fileURL, errno, @"Could not stat file");
+        retValue = NO;
+        goto done;
+    }
+    
+    struct fat_header fatHeader;
+    ssize_t bytesRead = pread(fd, &fatHeader, sizeof(fatHeader), 0);
+    if (bytesRead < 0) {
+        MK_ERROR_OUT = MKImageInventoryPOSIXError(fileURL, errno, @"Could not read file");
+        retValue = NO;
+        goto done;
+    }
+    
+    // The FAT header is always big endian.
+    uint32_t fatMagic = OSSwapBigToHostInt32(fatHeader.magic);
+    
+    if ((size_t)bytesRead == sizeof(fatHeader) && (fatMagic == FAT_MAGIC || fatMagic == FAT_MAGIC_64))
+    {
+        // An architecture table that does not fit in the file is not a FAT
+        // header.  Java class files share FAT_MAGIC.
+        uint32_t nfat_arch = OSSwapBigToHostInt32(fatHeader.nfat_arch);
+        size_t archSize = (fatMagic == FAT_MAGIC_64) ? sizeof(struct fat_arch_64) : sizeof(struct fat_arch);
+        uint64_t archesLength = (uint64_t)archSize * nfat_arch;
+        
+        if (archesLength > (uint64_t)st.st_size - sizeof(fatHeader))
+            goto done;
+        
+        uint8_t *arches = malloc((size_t)archesLength);
+        if (arches == NULL && archesLength != 0) {
+            MK_ERROR_OUT = MKImageInventoryPOSIXError(fileURL, ENOMEM, @"Could not allocate memory for the FAT architectures of file");
+            retValue = NO;
+            goto done;
+        }
+        
+        bytesRead = pread(fd, arches, (size_t)archesLength, sizeof(fatHeader));
+        if (bytesRead < 0) {
+            MK_ERROR_OUT = MKImageInventoryPOSIXError(fileURL, errno, @"Could not read file");
+            free(arches);
+            retValue = NO;
+            goto done;
+        }
+        
+        // The file may have been truncated since it was stat'ed.
+        uint32_t availableArches = (uint32_t)((size_t)bytesRead / archSize);
+        
+        for (uint32_t i = 0; i < availableArches && retValue; i++)
+        {
+            off_t sliceOffset;
+            if (fatMagic == FAT_MAGIC_64)
+                sliceOffset = (off_t)OSSwapBigToHostInt64(((struct fat_arch_64*)arches)[i].offset);
+            else
+                sliceOffset = (off_t)OSSwapBigToHostInt32(((struct fat_arch*)arches)[i].offset);
+            
+            // Slices outside of the file are skipped.
+            if (sliceOffset < 0 || sliceOffset >= st.st_size)
+                continue;
+            
+            retValue = MKImageInventorySummarizeImage(fd, fileURL, st.st_size, sliceOffset, i, buffer, summary, handler, error);
+        }
+        
+        free(arches);
+    }
+    else
+    {
+        retValue = MKImageInventorySummarizeImage(fd, fileURL, st.st_size, 0, 0, buffer, summary, handler, error);
+    }
+    
+done:
+    free(summary);
+    free(buffer);
+    close(fd);
+    return retValue;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
++ (void)scanDirectoryAtURL:(NSURL*)directoryURL maxConcurrentFiles:(NSUInteger)maxConcurrentFiles withHandler:(MKImageInventoryHandler)handler errorHandler:(MKImageInventoryErrorHandler)errorHandler
+{
+    NSParameterAssert(directoryURL.isFileURL);
+    NSParameterAssert(handler != nil);
+    
+    if (maxConcurrentFiles == 0)
+        maxConcurrentFiles = NSProcessInfo.processInfo.activeProcessorCount;
+    
+    NSArray *keys = @[NSURLIsRegularFileKey, NSURLFileSizeKey];
+    NSDirectoryEnumerator *enumerator = [NSFileManager.defaultManager enumeratorAtURL:directoryURL includingPropertiesForKeys:keys options:0 errorHandler:^BOOL(NSURL *url, NSError *e) {
+        if (errorHandler) errorHandler(url, e);
+        return YES;
+    }];
+    
+    // The enumerator is not thread safe; it is drained on this thread while
+    // the files are read concurrently.  The semaphore bounds the number of
+    // files in flight so enumeration does not run arbitrarily far ahead.
+    dispatch_queue_t queue = dispatch_get_global_queue(QOS_CLASS_UTILITY, 0);
+    dispatch_group_t group = dispatch_group_create();
+    dispatch_semaphore_t inFlight = dispatch_semaphore_create((long)maxConcurrentFiles);
+    
+    for (NSURL *fileURL in enumerator) @autoreleasepool {
+        NSNumber *isRegularFile = nil;
+        NSNumber *fileSize = nil;
+        
+        [fileURL getResourceValue:&isRegularFile forKey:NSURLIsRegularFileKey error:NULL];
+        [fileURL getResourceValue:&fileSize forKey:NSURLFileSizeKey error:NULL];
+        
+        if (isRegularFile.boolValue == NO || fileSize.unsignedLongLongValue < sizeof(struct mach_header))
+            continue;
+        
+        dispatch_semaphore_wait(inFlight, DISPATCH_TIME_FOREVER);
+        
+        [fileURL retain];
+        dispatch_group_async(group, queue, ^{ @autoreleasepool {
+            NSError *fileError = nil;
+            
+            if ([self summarizeFileAtURL:fileURL withHandler:handler error:&fileError] == NO && errorHandler)
+                errorHandler(fileURL, fileError);
+            
+            [fileURL release];
+            dispatch_semaphore_signal(inFlight);
+        }});
+    }
+    
+    dispatch_group_wait(group, DISPATCH_TIME_FOREVER);
+    
+    dispatch_release(inFlight);
+    dispatch_release(group);
+}
+
+@end
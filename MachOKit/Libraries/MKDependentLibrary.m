@@ -104,7 +104,7 @@
 { return [_loadCommand nodeAddress:type]; }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     MKNodeFieldBuilder *name = [MKNodeFieldBuilder
         builderWithProperty:MK_PROPERTY(name)
@@ -162,7 +162,7 @@
     rexported.description = @"Reexported";
     rexported.options = MKNodeFieldOptionDisplayAsDetail;
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         name.build,
         timestamp.build,
         currentVersion.build,
@@ -135,7 +135,7 @@
 }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     __unused struct build_version_command bvc;
     
@@ -195,7 +195,7 @@
     tools.description = @"Build Tool Versions";
     tools.options = MKNodeFieldOptionDisplayAsDetail | MKNodeFieldOptionMergeWithParent;
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         platform.build,
         minos.build,
         sdk.build,
@@ -235,7 +235,7 @@
 { return sizeof(struct build_tool_version); }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     __unused struct build_tool_version btv;
     
@@ -262,7 +262,7 @@
     version.options = MKNodeFieldOptionDisplayAsDetail;
     version.formatter = [NSFormatter mk_hex32Formatter];
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         tool.build,
         version.build
     ]];
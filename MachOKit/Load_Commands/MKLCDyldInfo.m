@@ -85,7 +85,7 @@
 }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     __unused struct dyld_info_command lc;
     
@@ -179,7 +179,7 @@
     export_size.description = @"Export Info Size";
     export_size.options = MKNodeFieldOptionDisplayAsDetail;
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         rebase_off.build,
         rebase_size.build,
         bind_off.build,
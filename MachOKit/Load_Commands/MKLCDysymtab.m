@@ -105,7 +105,7 @@
 }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     __unused struct dysymtab_command lc;
     
@@ -271,7 +271,7 @@
     nlocrel.description = @"Local Relocations Table Entries";
     nlocrel.options = MKNodeFieldOptionDisplayAsDetail;
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         ilocalsym.build,
         nlocalsym.build,
         iextdefsym.build,
@@ -67,7 +67,7 @@
 }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     __unused struct encryption_info_command lc;
     
@@ -98,7 +98,7 @@
     cryptid.description = @"Encryption System";
     cryptid.options = MKNodeFieldOptionDisplayAsDetail;
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         cryptoff.build,
         cryptsize.build,
         cryptid.build
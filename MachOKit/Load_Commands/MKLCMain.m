@@ -65,7 +65,7 @@
 }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     __unused struct entry_point_command lc;
     
@@ -87,7 +87,7 @@
     stacksize.description = @"Stack Size";
     stacksize.options = MKNodeFieldOptionDisplayAsDetail;
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         entryoff.build,
         stacksize.build
     ]];
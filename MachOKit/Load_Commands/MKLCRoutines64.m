@@ -77,7 +77,7 @@
 }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     __unused struct routines_command_64 lc;
     
@@ -154,7 +154,7 @@
     reserved6.description = @"Reserved6";
     reserved6.options = MKNodeFieldOptionDisplayAsDetail;
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         init_address.build,
         init_module.build,
         reserved1.build,
@@ -69,7 +69,7 @@
 }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     __unused struct symtab_command lc;
     
@@ -109,7 +109,7 @@
     strsize.description = @"String Table Size";
     strsize.options = MKNodeFieldOptionDisplayAsDetail;
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         symoff.build,
         nsyms.build,
         stroff.build,
@@ -41,6 +41,18 @@ extern const uint32_t _mk_load_command_classes_count;
 + (id*)_subclassesCache
 { static NSSet *subclasses; return &subclasses; }
 
+//|++++++++++++++++++++++++++++++++++++|//
++ (id*)_dispatchTableCache
+{ static id table; return &table; }
+
+//|++++++++++++++++++++++++++++++++++++|//
++ (BOOL)rankingIsDeterminedByDispatchKeyForSubclass:(Class)subclass
+{
+#pragma unused (subclass)
+    // The command ID is the only input to +canInstantiateWithLoadCommandID:.
+    return YES;
+}
+
 //|++++++++++++++++++++++++++++++++++++|//
 + (uint32_t)canInstantiateWithLoadCommandID:(uint32_t)commandID
 {
@@ -53,7 +65,7 @@ extern const uint32_t _mk_load_command_classes_count;
 {
     // If we have one or more compatible subclasses, return the best match.
     {
-        Class subclass = [self bestSubclassWithRanking:^uint32_t(Class cls) {
+        Class subclass = [self bestSubclassForDispatchKey:@(commandID) withRanking:^uint32_t(Class cls) {
             return [cls canInstantiateWithLoadCommandID:commandID];
         }];
         
@@ -211,7 +223,7 @@ extern const uint32_t _mk_load_command_classes_count;
 { return _cmdSize; }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     static NSMutableDictionary *s_loadCommandNames = nil;
     static dispatch_once_t onceToken;
@@ -246,7 +258,7 @@ extern const uint32_t _mk_load_command_classes_count;
     cmdsize.description = @"Command Size";
     cmdsize.options = MKNodeFieldOptionDisplayAsDetail;
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         cmd.build,
         cmdsize.build
     ]];
@@ -49,6 +49,7 @@
 @class MKStringTable;
 @class MKSymbolTable;
 @class MKIndirectSymbolTable;
+@class MKObjCIndex;
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -102,6 +103,8 @@ typedef NS_OPTIONS(NSUInteger, MKMachOImageFlags) {
     MKResult<MKStringTable*> *_stringTable;
     MKResult<MKSymbolTable*> *_symbolTable;
     MKResult<MKIndirectSymbolTable*> *_indirectSymbolTable;
+    // ObjC //
+    MKResult<MKObjCIndex*> *_objcIndex;
 }
 
 - (nullable instancetype)initWithName:(nullable const char*)name flags:(MKMachOImageFlags)flags atAddress:(mk_vm_address_t)contextAddress inMapping:(MKMemoryMap*)mapping error:(NSError**)error NS_DESIGNATED_INITIALIZER;
@@ -72,27 +72,21 @@
         case MH_MAGIC:
             // All 32-bit darwin ABIs use ILP32
             _dataModel = [(magic == MH_MAGIC) ? [MKILP32DataModel dataModelWithHostEndianness] : [MKILP32DataModel dataModelWithByteSwappedEndianness] retain];
-            _header = [[MKMachHeader alloc] initWithOffset:0 fromParent:self error:&localError];
             break;
         case MH_CIGAM_64:
         case MH_MAGIC_64:
             // All 64-bit darwin ABIs use LP64
             _dataModel = [(magic == MH_MAGIC_64) ? [MKLP64DataModel dataModelWithHostEndianness] : [MKLP64DataModel dataModelWithByteSwappedEndianness] retain];
-            _header = [[MKMachHeader64 alloc] initWithOffset:0 fromParent:self error:&localError];
             break;
         default:
             MK_ERROR_OUT = [NSError mk_errorWithDomain:MKErrorDomain code:MK_EINVAL description:@"Bad Mach-O magic: 0x%" PRIx32 ".", magic];
             [self release]; return nil;
     }
     
-    if (_header == nil) {
-        MK_ERROR_OUT = [NSError mk_errorWithDomain:MKErrorDomain code:localError.code underlyingError:localError description:@"Failed to load Mach header"];
-        [self release]; return nil;
-    }
-    
-    // Now that the header is loaded, further specialize the data model based
-    // on the architecture, if needed.
-    switch (self.header.cputype) {
+    // Further specialize the data model based on the architecture, if
+    // needed.  Nodes capture the data model of their parent when they are
+    // initialized, so this must be settled before the header is created.
+    switch ([mapping readDoubleWordAtOffset:offsetof(struct mach_header, cputype) fromAddress:contextAddress withDataModel:_dataModel error:NULL]) {
         case CPU_TYPE_ARM64:
             [_dataModel release];
             _dataModel = [[MKDarwinARM64DataModel sharedDataModel] retain];
@@ -105,6 +99,16 @@
             break;
     }
     
+    if (magic == MH_MAGIC_64 || magic == MH_CIGAM_64)
+        _header = [[MKMachHeader64 alloc] initWithOffset:0 fromParent:self error:&localError];
+    else
+        _header = [[MKMachHeader alloc] initWithOffset:0 fromParent:self error:&localError];
+    
+    if (_header == nil) {
+        MK_ERROR_OUT = [NSError mk_errorWithDomain:MKErrorDomain code:localError.code underlyingError:localError description:@"Failed to load Mach header"];
+        [self release]; return nil;
+    }
+    
     // Only support a subset of the Mach-O types at this time
     switch (_header.filetype) {
         case MH_OBJECT:
@@ -220,6 +224,8 @@
 //|++++++++++++++++++++++++++++++++++++|//
 - (void)dealloc
 {
+    [_objcIndex release];
+    
     [_indirectSymbolTable release];
     [_symbolTable release];
     [_stringTable release];
@@ -334,7 +340,7 @@
 { return nil; }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     MKNodeFieldBuilder *header = [MKNodeFieldBuilder
         builderWithProperty:MK_PROPERTY(header)
@@ -350,7 +356,7 @@
     loadCommands.description = @"Load Commands";
     loadCommands.options = MKNodeFieldOptionDisplayAsChild | MKNodeFieldOptionDisplayContainerContentsAsChild;
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         //[MKNodeField nodeFieldWithProperty:MK_PROPERTY(name) description:@"Image Path"],
         //[MKNodeField nodeFieldWithProperty:MK_PROPERTY(slide) description:@"Slide"],
         header.build,
@@ -28,11 +28,24 @@
 #import "MKNode+MachO.h"
 #import "MKMachO.h"
 
+#import <objc/runtime.h>
+
 //----------------------------------------------------------------------------//
 @implementation MKNode (MachO)
 
 //|++++++++++++++++++++++++++++++++++++|//
 - (MKMachOImage*)macho
-{ return [self nearestAncestorOfType:MKMachOImage.class]; }
+{
+    if ([self isKindOfClass:MKMachOImage.class])
+        return (MKMachOImage*)self;
+    
+    MKMachOImage *macho = objc_loadWeak(&_macho);
+    if (macho == nil) {
+        macho = self.parent.macho;
+        objc_storeWeak(&_macho, macho);
+    }
+    
+    return macho;
+}
 
 @end
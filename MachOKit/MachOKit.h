@@ -41,6 +41,10 @@
 /* CORE */
 #import <MachOKit/MKMemoryMap.h>
 #import <MachOKit/MKNodeDescription.h>
+#import <MachOKit/MKNodeSerializer.h>
+#import <MachOKit/MKNodeTextSink.h>
+#import <MachOKit/MKNodeJSONSink.h>
+#import <MachOKit/MKNodeCBORSink.h>
 #import <MachOKit/MKDataModel.h>
 #import <MachOKit/MKNode.h>
 #import <MachOKit/MKAddressedNode.h>
@@ -60,6 +64,12 @@
 #import <MachOKit/MKFatBinary.h>
 #import <MachOKit/MKFatArch.h>
 
+/* INVENTORY */
+#import <MachOKit/MKImageInventory.h>
+
+/* INDEX */
+#import <MachOKit/MKImageIndex.h>
+
 /* DSC */
 #import <MachOKit/MKSharedCache.h>
 #import <MachOKit/MKDSCHeader.h>
@@ -240,6 +250,8 @@
 #import <MachOKit/MKCFString.h>
     #import <MachOKit/MKCFStringSection.h>
 
+#import <MachOKit/MKMachO+ObjC.h>
+    #import <MachOKit/MKObjCIndex.h>
 #import <MachOKit/MKDataModel+ObjC.h>
 #import <MachOKit/MKObjCElementList.h>
 #import <MachOKit/MKObjCImageInfo.h>
@@ -149,7 +149,7 @@ struct objc_cat_32 {
 { return (self.dataModel.pointerSize == 8) ? sizeof(struct objc_cat_64) : sizeof(struct objc_cat_32); }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     struct objc_cat_64 cat64;
     struct objc_cat_32 cat32;
@@ -227,7 +227,7 @@ struct objc_cat_32 {
 #undef FIELD_OFFSET
 #undef FIELD_TYPE
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         name.build,
         cls.build,
         instanceMethods.build,
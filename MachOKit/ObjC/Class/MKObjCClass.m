@@ -152,7 +152,7 @@ struct objc_class_32 {
 { return self.dataModel.pointerSize == 8 ? sizeof(struct objc_class_64) : sizeof(struct objc_class_32); }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     struct objc_class_64 cls64;
     struct objc_class_32 cls32;
@@ -221,7 +221,7 @@ struct objc_class_32 {
 #undef FIELD_OFFSET
 #undef FIELD_TYPE
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         metaClass.build,
         superClass.build,
         cache.build,
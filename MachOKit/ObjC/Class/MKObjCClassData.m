@@ -164,7 +164,7 @@ struct objc_class_data_32 {
 { return (self.dataModel.pointerSize == 8) ? sizeof(struct objc_class_data_64) : sizeof(struct objc_class_data_32); }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     struct objc_class_data_64 data64;
     struct objc_class_data_32 data32;
@@ -278,7 +278,7 @@ struct objc_class_data_32 {
 #undef FIELD_OFFSET
 #undef FIELD_TYPE
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         flags.build,
         instanceStart.build,
         instanceSize.build,
@@ -83,7 +83,7 @@ struct objc_image_info {
 { return sizeof(struct objc_image_info); }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     __unused struct objc_image_info ii;
     
@@ -106,7 +106,7 @@ struct objc_image_info {
     flags.formatter = [NSFormatter mk_hexCompactFormatter];
 #endif
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         version.build,
         flags.build
     ]];
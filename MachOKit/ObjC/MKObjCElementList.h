@@ -26,6 +26,7 @@
 //----------------------------------------------------------------------------//
 
 #include <MachOKit/macho.h>
+#include <pthread.h>
 #import <Foundation/Foundation.h>
 
 #import <MachOKit/MKOffsetNode.h>
@@ -36,11 +37,20 @@ NS_ASSUME_NONNULL_BEGIN
 @interface MKObjCElementList<Element> : MKOffsetNode {
 @package
     mk_vm_size_t _nodeSize;
-    NSArray<Element> *_elements;
+    // Not retained; see -elements.
+    /*__weak*/ NSArray<Element> *_elements;
+    pthread_mutex_t _elementsLock;
+    // The number of elements that can be read.
+    uint32_t _elementCount;
     uint32_t _entsizeAndFlags;
     uint32_t _count;
 }
 
+//! The elements of the list, in order.  Each element is instantiated when
+//! it is first accessed, and cached for as long as the returned array is
+//! alive.
+//! The count of the array may be less than \ref count if part of the list
+//! could not be read.
 @property (nonatomic, readonly) NSArray<Element> *elements;
 
 //! Flags
@@ -27,6 +27,9 @@
 
 #import "MKObjCElementList.h"
 #import "MKInternal.h"
+#import "_MKObjCElementArray.h"
+
+#import <objc/runtime.h>
 
 struct objc_entlist {
     uint32_t entsizeAndFlags;
@@ -45,6 +48,8 @@ struct objc_entlist {
     
     MKDataModel* dataModel = self.dataModel;
     
+    pthread_mutex_init(&_elementsLock, NULL);
+    
     __block NSError *memoryMapError = nil;
     mk_error_t err;
     
@@ -87,51 +92,49 @@ struct objc_entlist {
         MK_PUSH_WARNING(nil, MK_EOUT_OF_RANGE, @"Element list size [%" MK_VM_PRIuSIZE "] extends beyond parent node: %@.", self.nodeSize, self.parent.compactDescription);
     }
     
-    // Load elements
+    // Elements are instantiated lazily by the elements array, at offsets
+    // computed from the entsize.  Determine how many elements fit in the
+    // readable portion of the list.
     {
-        NSMutableArray *elements = [[NSMutableArray alloc] initWithCapacity:_count];
+        uint32_t entsize = self.entsize;
         mk_vm_offset_t offset = offsetof(typeof(lst), bytes);
+        uint32_t count = _count;
         
         Class targetClass = [self.class classForGenericArgumentAtIndex:0];
         NSAssert(targetClass != nil, @"No class specified for list elements.  Did you implement +classForGenericArgumentAtIndex: ?");
         
-        for (uint32_t i = 0; i < _count; i++)
-        {
+        if (entsize == 0 && count > 0) {
+            MK_PUSH_WARNING(elements, MK_ESIZE, @"Element size is zero.  Ignoring [%" PRIu32 "] elements.", count);
+            count = 0;
+        }
+        
+        // While we could permit readable elements that extend beyond the
+        // size computed from the list header, that could yield invalid
+        // data.
+        // SAFE - _nodeSize is at least the size of the list header, or the
+        //        header could not have been read.
+        if (count > 0 && (_nodeSize - offset) / entsize < count) {
+            count = (uint32_t)((_nodeSize - offset) / entsize);
+            MK_PUSH_WARNING(elements, MK_EOUT_OF_RANGE, @"Part of element at index [%" PRIu32 "] is beyond element list size.", count);
+        }
+        
+        // Parse the first element to check that the element class agrees
+        // with the entsize.  The stride is always the entsize.
+        if (count > 0) {
             NSError *elementError = nil;
             
             MKOffsetNode *element = [[targetClass alloc] initWithOffset:offset fromParent:self error:&elementError];
             if (element == nil) {
-                MK_PUSH_WARNING_WITH_ERROR(elements, MK_EINTERNAL_ERROR, elementError, @"Could not parse element at index [%" PRIu32 "].", i);
-                // We might be able to continue parsing additional elemements,
-                // but that would break the ordering so just stop here.
-                break;
+                MK_PUSH_WARNING_WITH_ERROR(elements, MK_EINTERNAL_ERROR, elementError, @"Could not parse element at index [0].");
+                count = 0;
+            } else if (element.nodeSize != entsize) {
+                MK_PUSH_WARNING(elements, MK_ESIZE, @"Elements have an unexpected size.  Expected [%" PRIu32 "] bytes but parsed [%" MK_VM_PRIuSIZE "] bytes.", entsize, element.nodeSize);
             }
             
-            // Use the entsize, rather than the parsed element's nodeSize, when
-            // advancing the offset.
-            // SAFE - Computing the node size would have failed if this could
-            //        overflow.
-            offset += self.entsize;
-            
-            if (element.nodeSize != self.entsize) {
-                MK_PUSH_WARNING(elements, MK_ESIZE, @"Element at index [%" PRIu32 "] has an unexpected size.  Expected [%" PRIu32 "] bytes but parsed [" MK_VM_PRIuSIZE "] bytes.", i, self.entsize, element.nodeSize);
-            }
-            
-            // While we could permit readable elements that extend beyond the
-            // size computed from the list header, that could yield invalid
-            // data.
-            if (offset > _nodeSize) {
-                MK_PUSH_WARNING(elements, MK_EOUT_OF_RANGE, @"Part of element at index [%" PRIu32 "] is beyond element list size.", i);
-                [element release];
-                break;
-            }
-            
-            [elements addObject:element];
             [element release];
         }
         
-        _elements = [elements copy];
-        [elements release];
+        _elementCount = count;
     }
     
     return self;
@@ -140,7 +143,8 @@ struct objc_entlist {
 //|++++++++++++++++++++++++++++++++++++|//
 - (void)dealloc
 {
-    [_elements release];
+    objc_storeWeak(&_elements, nil);
+    pthread_mutex_destroy(&_elementsLock);
     
     [super dealloc];
 }
@@ -161,9 +165,29 @@ struct objc_entlist {
 #pragma mark -  List Values
 //◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
 
-@synthesize elements = _elements;
 @synthesize count = _count;
 
+//|++++++++++++++++++++++++++++++++++++|//
+- (NSArray*)elements
+{
+    // The array retains the receiver.  Keeping only a weak reference here
+    // lets the list and its elements be released together.
+    if (_elementCount == 0)
+        return @[];
+    
+    NSArray *elements;
+    
+    pthread_mutex_lock(&_elementsLock);
+    elements = objc_loadWeak(&_elements);
+    if (elements == nil) {
+        elements = [[[_MKObjCElementArray alloc] initWithList:self count:_elementCount offset:offsetof(struct objc_entlist, bytes) stride:self.entsize elementClass:[self.class classForGenericArgumentAtIndex:0]] autorelease];
+        objc_storeWeak(&_elements, elements);
+    }
+    pthread_mutex_unlock(&_elementsLock);
+    
+    return elements ?: @[];
+}
+
 //|++++++++++++++++++++++++++++++++++++|//
 - (uint32_t)flags
 { return _entsizeAndFlags & self.class.flagsMask; }
@@ -179,9 +203,19 @@ struct objc_entlist {
 //|++++++++++++++++++++++++++++++++++++|//
 - (MKResult*)childNodeOccupyingVMAddress:(mk_vm_address_t)address targetClass:(Class)targetClass
 {
-    MKResult *child = [MKBackedNode childNodeOccupyingVMAddress:address targetClass:targetClass inSortedArray:(NSArray *)self.elements];
-    if (child.value)
-        return child;
+    // The elements are contiguous and equally sized, so the index of the
+    // element occupying the address can be computed directly.
+    mk_vm_address_t elementsAddress = self.nodeVMAddress + offsetof(struct objc_entlist, bytes);
+    
+    if (address >= elementsAddress && _elementCount > 0) {
+        mk_vm_offset_t index = (address - elementsAddress) / self.entsize;
+        
+        if (index < _elementCount) {
+            MKResult *child = [self.elements[(NSUInteger)index] childNodeOccupyingVMAddress:address targetClass:targetClass];
+            if (child.value)
+                return child;
+        }
+    }
     
     return [super childNodeOccupyingVMAddress:address targetClass:targetClass];
 }
@@ -193,7 +227,7 @@ struct objc_entlist {
 @synthesize nodeSize = _nodeSize;
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     struct objc_entlist lst;
     
@@ -231,7 +265,7 @@ struct objc_entlist {
     elements.description = @"Elements";
     elements.options = MKNodeFieldOptionDisplayAsDetail | MKNodeFieldOptionMergeContainerContents;
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         entsize.build,
         flags.build,
         count.build,
@@ -0,0 +1,124 @@
+//----------------------------------------------------------------------------//
+//|
+//|             MachOKit - A Lightweight Mach-O Parsing Library
+//! @file       MKObjCIndex.h
+//!
+//! @author     D.V.
+//! @copyright  Copyright (c) 2014-2015 D.V. All rights reserved.
+//|
+//| Permission is hereby granted, free of charge, to any person obtaining a
+//| copy of this software and associated documentation files (the "Software"),
+//| to deal in the Software without restriction, including without limitation
+//| the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//| and/or sell copies of the Software, and to permit persons to whom the
+//| Software is furnished to do so, subject to the following conditions:
+//|
+//| The above copyright notice and this permission notice shall be included
+//| in all copies or substantial portions of the Software.
+//|
+//| THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//| OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//| MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//| IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//| CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//| TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//| SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//----------------------------------------------------------------------------//
+
+
+#include <MachOKit/macho.h>
+#import <Foundation/Foundation.h>
+
+#import <MachOKit/MKNode.h>
+#import <MachOKit/MKPointerNode.h>
+
+@class MKMachOImage;
+@class MKObjCClass;
+@class MKObjCCategory;
+@class MKObjCProtocol;
+@class MKCString;
+
+struct MKObjCIndexSection;
+struct MKObjCIndexEntry;
+
+NS_ASSUME_NONNULL_BEGIN
+
+//----------------------------------------------------------------------------//
+//! An instance of \c MKObjCIndex maps the names of the Objective-C classes,
+//! metaclasses, categories, protocols and selectors defined or referenced
+//! by an image to the nodes that describe them.
+//!
+//! The index is built in a single pass over the class list, category list,
+//! protocol list and selector reference sections of the image.  No nodes are
+//! instantiated while building the index.  Each name is stored as the
+//! address of the string in the image, along with its hash, and compared
+//! against the image's memory when it is looked up.
+//
+@interface MKObjCIndex : MKNode {
+@package
+    // Sections, sorted by address //
+    struct MKObjCIndexSection *_sections;
+    NSUInteger _sectionCount;
+    // Entries, sorted by name hash //
+    struct MKObjCIndexEntry *_classes;
+    NSUInteger _classCount;
+    struct MKObjCIndexEntry *_metaClasses;
+    NSUInteger _metaClassCount;
+    struct MKObjCIndexEntry *_categories;
+    NSUInteger _categoryCount;
+    struct MKObjCIndexEntry *_protocols;
+    NSUInteger _protocolCount;
+    struct MKObjCIndexEntry *_selectors;
+    NSUInteger _selectorCount;
+}
+
+//! Initializes the receiver with the provided Mach-O.
+- (nullable instancetype)initWithImage:(MKMachOImage*)image error:(NSError**)error;
+
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+#pragma mark -  Index Contents
+//! @name       Index Contents
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+
+//! The number of classes in the index.  A class that is listed in both
+//! \c __objc_classlist and \c __objc_nlclslist is counted once.
+@property (nonatomic, readonly) NSUInteger classCount;
+
+//! The number of metaclasses in the index.
+@property (nonatomic, readonly) NSUInteger metaClassCount;
+
+//! The number of categories in the index.
+@property (nonatomic, readonly) NSUInteger categoryCount;
+
+//! The number of protocols in the index.
+@property (nonatomic, readonly) NSUInteger protocolCount;
+
+//! The number of selector references in the index.
+@property (nonatomic, readonly) NSUInteger selectorCount;
+
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+#pragma mark -  Looking Up Metadata by Name
+//! @name       Looking Up Metadata by Name
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+
+//! Returns the class named \a name.  The returned optional contains a
+//! \c nil value and a \c nil error if the image does not define a class
+//! with that name.
+- (MKResult<MKObjCClass*> *)classNamed:(NSString*)name;
+
+//! Returns the metaclass of the class named \a name.
+- (MKResult<MKObjCClass*> *)metaClassNamed:(NSString*)name;
+
+//! Returns the categories named \a name.  Category names are not unique;
+//! the categories are returned in ascending order of address.
+- (NSArray<MKResult<MKObjCCategory*>*> *)categoriesNamed:(NSString*)name;
+
+//! Returns the protocol named \a name.
+- (MKResult<MKObjCProtocol*> *)protocolNamed:(NSString*)name;
+
+//! Returns the selector reference for the selector named \a name.
+- (MKResult<MKPointerNode<MKCString*>*> *)selectorReferenceNamed:(NSString*)name;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,590 @@
+//----------------------------------------------------------------------------//
+//|
+//|             MachOKit - A Lightweight Mach-O Parsing Library
+//|             MKObjCIndex.m
+//|
+//|             D.V.
+//|             Copyright (c) 2014-2015 D.V. All rights reserved.
+//|
+//| Permission is hereby granted, free of charge, to any person obtaining a
+//| copy of this software and associated documentation files (the "Software"),
+//| to deal in the Software without restriction, including without limitation
+//| the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//| and/or sell copies of the Software, and to permit persons to whom the
+//| Software is furnished to do so, subject to the following conditions:
+//|
+//| The above copyright notice and this permission notice shall be included
+//| in all copies or substantial portions of the Software.
+//|
+//| THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//| OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//| MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//| IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//| CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//| TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//| SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//----------------------------------------------------------------------------//
+
+
+#import "MKObjCIndex.h"
+#import "MKInternal.h"
+#import "MKMachO.h"
+#import "MKMachO+Segments.h"
+#import "MKSection.h"
+#import "MKObjCClass.h"
+#import "MKObjCCategory.h"
+#import "MKObjCProtocol.h"
+#import "MKCString.h"
+#import "MKObjCClassListSection.h"
+#import "MKObjCCategoryListSection.h"
+#import "MKObjCProtocolListSection.h"
+#import "MKObjCSelectorReferencesSection.h"
+
+// from https://opensource.apple.com/source/objc4/objc4-781/runtime/objc-runtime-new.h.auto.html
+#define FAST_DATA_MASK_64       0x00007ffffffffff8UL
+#define FAST_DATA_MASK_32       0xfffffffcUL
+
+// Offsets of the fields read while building the index, in units of the
+// pointer size.
+#define OBJC_CLASS_ISA          0
+#define OBJC_CLASS_DATA         4
+#define OBJC_CATEGORY_NAME      0
+#define OBJC_PROTOCOL_NAME      1
+// Offset of the name field of class_ro_t, in bytes.
+#define OBJC_CLASS_RO_NAME_64   24
+#define OBJC_CLASS_RO_NAME_32   16
+
+//! A section of the image that may be read while building the index.
+struct MKObjCIndexSection {
+    mk_vm_address_t vmAddress;
+    mk_vm_size_t size;
+    //! Not retained.  Only valid while the index is being built.
+    MKSection *section;
+    //! Mapped when the section is first read.  The owner is retained.
+    MKMemorySpan span;
+    //! Set, and retained, if the section could not be mapped.
+    NSError *error;
+};
+
+//! A name in the index.
+struct MKObjCIndexEntry {
+    uint32_t hash;
+    uint32_t length;
+    //! The address of the name.
+    mk_vm_address_t name;
+    //! The address of the node the name belongs to.
+    mk_vm_address_t node;
+};
+
+//! State needed to decode pointers while building the index.
+struct MKObjCIndexReader {
+    MKMemoryMap *memoryMap;
+    struct MKObjCIndexSection *sections;
+    NSUInteger sectionCount;
+    mk_vm_size_t pointerSize;
+    bool swap;
+    bool removeSlide;
+    mk_vm_slide_t slide;
+};
+
+//|++++++++++++++++++++++++++++++++++++|//
+static int
+MKObjCIndexCompareSections(const void *a, const void *b)
+{
+    const struct MKObjCIndexSection *left = a;
+    const struct MKObjCIndexSection *right = b;
+    
+    if (left->vmAddress != right->vmAddress)
+        return left->vmAddress < right->vmAddress ? -1 : 1;
+    return 0;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+static struct MKObjCIndexSection*
+MKObjCIndexSectionContainingAddress(struct MKObjCIndexSection *sections, NSUInteger sectionCount, mk_vm_address_t address)
+{
+    // Find the last section that starts at or before the address.
+    NSUInteger lo = 0, hi = sectionCount;
+    while (lo < hi) {
+        NSUInteger mid = lo + (hi - lo) / 2;
+        if (sections[mid].vmAddress <= address)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    
+    if (lo == 0)
+        return NULL;
+    
+    struct MKObjCIndexSection *section = &sections[lo - 1];
+    if (address - section->vmAddress >= section->size)
+        return NULL;
+    
+    return section;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+static const uint8_t*
+MKObjCIndexBytesInSection(const struct MKObjCIndexSection *section, mk_vm_address_t address, mk_vm_size_t *available)
+{
+    if (section == NULL || section->span.bytes == NULL)
+        return NULL;
+    
+    mk_vm_offset_t offset = address - section->vmAddress;
+    *available = section->span.length - offset;
+    return (const uint8_t*)section->span.bytes + offset;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+static const uint8_t*
+MKObjCIndexBytesAtAddress(const struct MKObjCIndexReader *reader, mk_vm_address_t address, mk_vm_size_t *available)
+{
+    struct MKObjCIndexSection *section = MKObjCIndexSectionContainingAddress(reader->sections, reader->sectionCount, address);
+    if (section == NULL)
+        return NULL;
+    
+    // Only the sections that the index reads from are mapped, each in
+    // full.  A section that can not be mapped is not tried again.
+    if (section->span.bytes == NULL && section->error == nil) {
+        NSError *memoryMapError = nil;
+        
+        MKMemorySpan span = [reader->memoryMap spanAtOffset:0 fromAddress:section->section.nodeContextAddress length:section->size requireFull:YES error:&memoryMapError];
+        if (span.bytes == NULL) {
+            section->error = [(memoryMapError ?: [NSError mk_errorWithDomain:MKErrorDomain code:MK_EINTERNAL_ERROR description:@"Could not map section %@.", section->section.name]) retain];
+            return NULL;
+        }
+        
+        [span.owner retain];
+        section->span = span;
+    }
+    
+    return MKObjCIndexBytesInSection(section, address, available);
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+static bool
+MKObjCIndexReadPointer(const struct MKObjCIndexReader *reader, mk_vm_address_t address, mk_vm_address_t *value)
+{
+    mk_vm_size_t available;
+    const uint8_t *bytes = MKObjCIndexBytesAtAddress(reader, address, &available);
+    if (bytes == NULL || available < reader->pointerSize)
+        return false;
+    
+    if (reader->pointerSize == 8) {
+        uint64_t pointer;
+        memcpy(&pointer, bytes, sizeof(pointer));
+        *value = reader->swap ? __builtin_bswap64(pointer) : pointer;
+    } else {
+        uint32_t pointer;
+        memcpy(&pointer, bytes, sizeof(pointer));
+        *value = reader->swap ? __builtin_bswap32(pointer) : pointer;
+    }
+    
+    // If the image has been processed by dyld, the pointers hold slid
+    // addresses.
+    if (reader->removeSlide && mk_vm_address_remove_slide(*value, reader->slide, value) != MK_ESUCCESS)
+        return false;
+    
+    return true;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+static inline uint32_t
+MKObjCIndexHash(const uint8_t *bytes, size_t length)
+{
+    // 32-bit FNV-1a
+    uint32_t hash = 2166136261U;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= bytes[i];
+        hash *= 16777619U;
+    }
+    return hash;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+static bool
+MKObjCIndexAppend(struct MKObjCIndexEntry *entries, NSUInteger *count, const struct MKObjCIndexReader *reader, mk_vm_address_t name, mk_vm_address_t node)
+{
+    mk_vm_size_t available;
+    const uint8_t *bytes = MKObjCIndexBytesAtAddress(reader, name, &available);
+    if (bytes == NULL)
+        return false;
+    
+    const uint8_t *terminator = memchr(bytes, '\0', (size_t)MIN(available, (mk_vm_size_t)UINT32_MAX));
+    if (terminator == NULL)
+        return false;
+    
+    struct MKObjCIndexEntry *entry = &entries[(*count)++];
+    entry->length = (uint32_t)(terminator - bytes);
+    entry->hash = MKObjCIndexHash(bytes, entry->length);
+    entry->name = name;
+    entry->node = node;
+    
+    return true;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+static int
+MKObjCIndexCompareEntries(const void *a, const void *b)
+{
+    const struct MKObjCIndexEntry *left = a;
+    const struct MKObjCIndexEntry *right = b;
+    
+    if (left->hash != right->hash)
+        return left->hash < right->hash ? -1 : 1;
+    if (left->length != right->length)
+        return left->length < right->length ? -1 : 1;
+    if (left->node != right->node)
+        return left->node < right->node ? -1 : 1;
+    return 0;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+static NSUInteger
+MKObjCIndexSort(struct MKObjCIndexEntry *entries, NSUInteger count)
+{
+    if (count == 0)
+        return 0;
+    
+    qsort(entries, count, sizeof(*entries), MKObjCIndexCompareEntries);
+    
+    // A node may be listed more than once, e.g. a class that appears in
+    // both __objc_classlist and __objc_nlclslist.
+    NSUInteger unique = 1;
+    for (NSUInteger i = 1; i < count; i++) {
+        if (entries[i].node != entries[unique - 1].node || entries[i].hash != entries[unique - 1].hash)
+            entries[unique++] = entries[i];
+    }
+    
+    return unique;
+}
+
+//----------------------------------------------------------------------------//
+@implementation MKObjCIndex
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (instancetype)initWithImage:(MKMachOImage*)image error:(NSError**)error
+{
+    NSParameterAssert(image != nil);
+    
+    self = [super initWithParent:image error:error];
+    if (self == nil) return nil;
+    
+    mk_vm_size_t pointerSize = self.dataModel.pointerSize;
+    if (pointerSize != 8 && pointerSize != 4) {
+        MK_ERROR_OUT = [NSError mk_errorWithDomain:MKErrorDomain code:MK_EINVALID_DATA description:@"Unsupported pointer size [%" MK_VM_PRIuSIZE "].", pointerSize];
+        [self release]; return nil;
+    }
+    
+    // Collect the sections of the image, sorted by address.  A section is
+    // mapped when the index first reads from it.  The spans are used again
+    // to compare names during lookups, so their owners are kept until the
+    // index is deallocated.
+    {
+        NSArray<MKSection*> *sections = image.sections.allValues;
+        _sections = calloc(sections.count ?: 1, sizeof(*_sections));
+        if (_sections == NULL) {
+            MK_ERROR_OUT = [NSError mk_errorWithDomain:MKErrorDomain code:MK_EINTERNAL_ERROR description:@"Could not allocate the section table."];
+            [self release]; return nil;
+        }
+        
+        for (MKSection *section in sections) {
+            if (section.nodeSize == 0)
+                continue;
+            
+            _sections[_sectionCount++] = (struct MKObjCIndexSection){ .vmAddress = section.vmAddress, .size = section.nodeSize, .section = section };
+        }
+        
+        qsort(_sections, _sectionCount, sizeof(*_sections), MKObjCIndexCompareSections);
+    }
+    
+    struct MKObjCIndexReader reader = {
+        .memoryMap = self.memoryMap,
+        .sections = _sections,
+        .sectionCount = _sectionCount,
+        .pointerSize = pointerSize,
+        .swap = (self.dataModel.byteOrder == &mk_byteorder_swapped),
+        .removeSlide = image.isFromMemory,
+        .slide = image.slide
+    };
+    
+    NSMutableArray<MKObjCClassListSection*> *classLists = [NSMutableArray array];
+    NSMutableArray<MKObjCCategoryListSection*> *categoryLists = [NSMutableArray array];
+    NSMutableArray<MKObjCProtocolListSection*> *protocolLists = [NSMutableArray array];
+    NSMutableArray<MKObjCSelectorReferencesSection*> *selectorReferences = [NSMutableArray array];
+    NSUInteger classCapacity = 0, categoryCapacity = 0, protocolCapacity = 0, selectorCapacity = 0;
+    
+    for (MKSection *section in image.sections.allValues) {
+        if ([section isKindOfClass:MKObjCClassListSection.class]) {
+            [classLists addObject:(id)section];
+            classCapacity += [(MKObjCClassListSection*)section elements].count;
+        } else if ([section isKindOfClass:MKObjCCategoryListSection.class]) {
+            [categoryLists addObject:(id)section];
+            categoryCapacity += [(MKObjCCategoryListSection*)section elements].count;
+        } else if ([section isKindOfClass:MKObjCProtocolListSection.class]) {
+            [protocolLists addObject:(id)section];
+            protocolCapacity += [(MKObjCProtocolListSection*)section elements].count;
+        } else if ([section isKindOfClass:MKObjCSelectorReferencesSection.class]) {
+            [selectorReferences addObject:(id)section];
+            selectorCapacity += [(MKObjCSelectorReferencesSection*)section elements].count;
+        }
+    }
+    
+    _classes = malloc((classCapacity ?: 1) * sizeof(*_classes));
+    _metaClasses = malloc((classCapacity ?: 1) * sizeof(*_metaClasses));
+    _categories = malloc((categoryCapacity ?: 1) * sizeof(*_categories));
+    _protocols = malloc((protocolCapacity ?: 1) * sizeof(*_protocols));
+    _selectors = malloc((selectorCapacity ?: 1) * sizeof(*_selectors));
+    
+    if (_classes == NULL || _metaClasses == NULL || _categories == NULL || _protocols == NULL || _selectors == NULL) {
+        MK_ERROR_OUT = [NSError mk_errorWithDomain:MKErrorDomain code:MK_EINTERNAL_ERROR description:@"Could not allocate the index entries."];
+        [self release]; return nil;
+    }
+    
+    // Classes and metaclasses.  The metaclass shares the name of its class.
+    {
+        __block NSUInteger skipped = 0;
+        mk_vm_address_t dataMask = (pointerSize == 8) ? FAST_DATA_MASK_64 : FAST_DATA_MASK_32;
+        mk_vm_offset_t nameOffset = (pointerSize == 8) ? OBJC_CLASS_RO_NAME_64 : OBJC_CLASS_RO_NAME_32;
+        
+        for (MKObjCClassListSection *section in classLists) {
+            [section enumerateAddressesUsingBlock:^(mk_vm_address_t cls, __unused NSUInteger index, __unused BOOL *stop) {
+                mk_vm_address_t data, name, metaClass;
+                
+                if (!MKObjCIndexReadPointer(&reader, cls + OBJC_CLASS_DATA * pointerSize, &data) ||
+                    !MKObjCIndexReadPointer(&reader, (data & dataMask) + nameOffset, &name) ||
+                    !MKObjCIndexAppend(_classes, &_classCount, &reader, name, cls)) {
+                    skipped++;
+                    return;
+                }
+                
+                if (MKObjCIndexReadPointer(&reader, cls + OBJC_CLASS_ISA * pointerSize, &metaClass) && metaClass != 0)
+                    MKObjCIndexAppend(_metaClasses, &_metaClassCount, &reader, name, metaClass);
+            }];
+        }
+        
+        if (skipped)
+            MK_PUSH_WARNING(classCount, MK_EINVALID_DATA, @"Could not read the name of [%lu] classes.", (unsigned long)skipped);
+    }
+    
+    // Categories
+    {
+        __block NSUInteger skipped = 0;
+        
+        for (MKObjCCategoryListSection *section in categoryLists) {
+            [section enumerateAddressesUsingBlock:^(mk_vm_address_t category, __unused NSUInteger index, __unused BOOL *stop) {
+                mk_vm_address_t name;
+                
+                if (!MKObjCIndexReadPointer(&reader, category + OBJC_CATEGORY_NAME * pointerSize, &name) ||
+                    !MKObjCIndexAppend(_categories, &_categoryCount, &reader, name, category))
+                    skipped++;
+            }];
+        }
+        
+        if (skipped)
+            MK_PUSH_WARNING(categoryCount, MK_EINVALID_DATA, @"Could not read the name of [%lu] categories.", (unsigned long)skipped);
+    }
+    
+    // Protocols
+    {
+        __block NSUInteger skipped = 0;
+        
+        for (MKObjCProtocolListSection *section in protocolLists) {
+            [section enumerateAddressesUsingBlock:^(mk_vm_address_t protocol, __unused NSUInteger index, __unused BOOL *stop) {
+                mk_vm_address_t name;
+                
+                if (!MKObjCIndexReadPointer(&reader, protocol + OBJC_PROTOCOL_NAME * pointerSize, &name) ||
+                    !MKObjCIndexAppend(_protocols, &_protocolCount, &reader, name, protocol))
+                    skipped++;
+            }];
+        }
+        
+        if (skipped)
+            MK_PUSH_WARNING(protocolCount, MK_EINVALID_DATA, @"Could not read the name of [%lu] protocols.", (unsigned long)skipped);
+    }
+    
+    // Selector references.  The referenced address is the name.
+    {
+        __block NSUInteger skipped = 0;
+        
+        for (MKObjCSelectorReferencesSection *section in selectorReferences) {
+            mk_vm_address_t vmAddress = section.nodeVMAddress;
+            
+            [section enumerateAddressesUsingBlock:^(mk_vm_address_t name, NSUInteger index, __unused BOOL *stop) {
+                if (!MKObjCIndexAppend(_selectors, &_selectorCount, &reader, name, vmAddress + index * pointerSize))
+                    skipped++;
+            }];
+        }
+        
+        if (skipped)
+            MK_PUSH_WARNING(selectorCount, MK_EINVALID_DATA, @"Could not read the name of [%lu] selectors.", (unsigned long)skipped);
+    }
+    
+    _classCount = MKObjCIndexSort(_classes, _classCount);
+    _metaClassCount = MKObjCIndexSort(_metaClasses, _metaClassCount);
+    _categoryCount = MKObjCIndexSort(_categories, _categoryCount);
+    _protocolCount = MKObjCIndexSort(_protocols, _protocolCount);
+    _selectorCount = MKObjCIndexSort(_selectors, _selectorCount);
+    
+    for (NSUInteger i = 0; i < _sectionCount; i++) {
+        struct MKObjCIndexSection *section = &_sections[i];
+        
+        if (section->error) {
+            MK_PUSH_WARNING_WITH_ERROR(nil, MK_EINTERNAL_ERROR, section->error, @"Could not map section %@.", section->section.name);
+            [section->error release];
+            section->error = nil;
+        }
+        
+        section->section = nil;
+    }
+    
+    return self;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (instancetype)initWithParent:(MKNode*)parent error:(NSError**)error
+{ return [self initWithImage:parent.macho error:error]; }
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)dealloc
+{
+    free(_selectors);
+    free(_protocols);
+    free(_categories);
+    free(_metaClasses);
+    free(_classes);
+    for (NSUInteger i = 0; i < _sectionCount; i++) {
+        [_sections[i].span.owner release];
+        [_sections[i].error release];
+    }
+    free(_sections);
+    
+    [super dealloc];
+}
+
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+#pragma mark -  Index Contents
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+
+@synthesize classCount = _classCount;
+@synthesize metaClassCount = _metaClassCount;
+@synthesize categoryCount = _categoryCount;
+@synthesize protocolCount = _protocolCount;
+@synthesize selectorCount = _selectorCount;
+
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+#pragma mark -  Looking Up Metadata by Name
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (NSArray*)_nodesNamed:(NSString*)name inEntries:(const struct MKObjCIndexEntry *)entries count:(NSUInteger)count targetClass:(Class)targetClass limit:(NSUInteger)limit
+{
+    const char *utf8 = name.UTF8String;
+    if (utf8 == NULL || count == 0)
+        return @[];
+    
+    size_t length = strlen(utf8);
+    uint32_t hash = MKObjCIndexHash((const uint8_t*)utf8, length);
+    
+    // Find the first entry with a matching hash.
+    NSUInteger lo = 0, hi = count;
+    while (lo < hi) {
+        NSUInteger mid = lo + (hi - lo) / 2;
+        if (entries[mid].hash < hash)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    
+    MKMachOImage *image = self.macho;
+    NSMutableArray *nodes = [NSMutableArray array];
+    
+    for (NSUInteger i = lo; i < count && entries[i].hash == hash && nodes.count < limit; i++) {
+        if (entries[i].length != length)
+            continue;
+        
+        mk_vm_size_t available;
+        // The name was read while building the index, so its section is
+        // already mapped.
+        const uint8_t *bytes = MKObjCIndexBytesInSection(MKObjCIndexSectionContainingAddress(_sections, _sectionCount, entries[i].name), entries[i].name, &available);
+        if (bytes == NULL || available < length || memcmp(bytes, utf8, length) != 0)
+            continue;
+        
+        [nodes addObject:[image childNodeAtVMAddress:entries[i].node targetClass:targetClass]];
+    }
+    
+    return nodes;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (MKResult*)classNamed:(NSString*)name
+{ return [self _nodesNamed:name inEntries:_classes count:_classCount targetClass:MKObjCClass.class limit:1].firstObject ?: [MKResult result]; }
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (MKResult*)metaClassNamed:(NSString*)name
+{ return [self _nodesNamed:name inEntries:_metaClasses count:_metaClassCount targetClass:MKObjCClass.class limit:1].firstObject ?: [MKResult result]; }
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (NSArray*)categoriesNamed:(NSString*)name
+{ return [self _nodesNamed:name inEntries:_categories count:_categoryCount targetClass:MKObjCCategory.class limit:NSUIntegerMax]; }
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (MKResult*)protocolNamed:(NSString*)name
+{ return [self _nodesNamed:name inEntries:_protocols count:_protocolCount targetClass:MKObjCProtocol.class limit:1].firstObject ?: [MKResult result]; }
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (MKResult*)selectorReferenceNamed:(NSString*)name
+{ return [self _nodesNamed:name inEntries:_selectors count:_selectorCount targetClass:MKPointerNode.class limit:1].firstObject ?: [MKResult result]; }
+
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+#pragma mark -  MKNode
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (MKNodeDescription*)buildLayout
+{
+    MKNodeFieldBuilder *classCount = [MKNodeFieldBuilder
+        builderWithProperty:MK_PROPERTY(classCount)
+        type:MKNodeFieldTypeUnsignedQuadWord.sharedInstance
+    ];
+    classCount.description = @"Classes";
+    classCount.options = MKNodeFieldOptionDisplayAsDetail;
+    
+    MKNodeFieldBuilder *metaClassCount = [MKNodeFieldBuilder
+        builderWithProperty:MK_PROPERTY(metaClassCount)
+        type:MKNodeFieldTypeUnsignedQuadWord.sharedInstance
+    ];
+    metaClassCount.description = @"Metaclasses";
+    metaClassCount.options = MKNodeFieldOptionDisplayAsDetail;
+    
+    MKNodeFieldBuilder *categoryCount = [MKNodeFieldBuilder
+        builderWithProperty:MK_PROPERTY(categoryCount)
+        type:MKNodeFieldTypeUnsignedQuadWord.sharedInstance
+    ];
+    categoryCount.description = @"Categories";
+    categoryCount.options = MKNodeFieldOptionDisplayAsDetail;
+    
+    MKNodeFieldBuilder *protocolCount = [MKNodeFieldBuilder
+        builderWithProperty:MK_PROPERTY(protocolCount)
+        type:MKNodeFieldTypeUnsignedQuadWord.sharedInstance
+    ];
+    protocolCount.description = @"Protocols";
+    protocolCount.options = MKNodeFieldOptionDisplayAsDetail;
+    
+    MKNodeFieldBuilder *selectorCount = [MKNodeFieldBuilder
+        builderWithProperty:MK_PROPERTY(selectorCount)
+        type:MKNodeFieldTypeUnsignedQuadWord.sharedInstance
+    ];
+    selectorCount.description = @"Selector References";
+    selectorCount.options = MKNodeFieldOptionDisplayAsDetail;
+    
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
+        classCount.build,
+        metaClassCount.build,
+        categoryCount.build,
+        protocolCount.build,
+        selectorCount.build
+    ]];
+}
+
+@end
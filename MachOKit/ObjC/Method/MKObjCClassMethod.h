@@ -40,14 +40,22 @@ NS_ASSUME_NONNULL_BEGIN
     MKPointer *_name;
     MKPointer *_types;
     mk_vm_address_t _implementation;
+    BOOL _usesRelativeOffsets;
 }
 
-@property (nonatomic, readonly) MKPointer<MKCString*> *name;
+//! \c nil if the pointer could not be created, or if the selector
+//! reference of a relative method could not be found.
+@property (nonatomic, readonly, nullable) MKPointer<MKCString*> *name;
 
-@property (nonatomic, readonly) MKPointer<MKCString*> *types;
+@property (nonatomic, readonly, nullable) MKPointer<MKCString*> *types;
 
 @property (nonatomic, readonly) mk_vm_address_t implementation;
 
+//! Indicates whether the method is in the relative format.  Each field of
+//! a relative method is a 32-bit offset from the field.  The name field
+//! references a selector reference, which is followed to find the name.
+@property (nonatomic, readonly) BOOL usesRelativeOffsets;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -28,6 +28,10 @@
 #import "MKObjCClassMethod.h"
 #import "MKInternal.h"
 #import "MKPointer+Node.h"
+#import "MKPointerNode.h"
+#import "MKObjCClassMethodList.h"
+#import "MKMachO.h"
+#import "MKNode+MachO.h"
 
 struct objc_method_64 {
     uint64_t name;
@@ -41,6 +45,14 @@ struct objc_method_32 {
     uint32_t imp;
 };
 
+// Each field holds an offset from the address of the field.  The name field
+// references a selector reference, rather than the selector name.
+struct objc_method_relative {
+    int32_t name;
+    int32_t types;
+    int32_t imp;
+};
+
 //----------------------------------------------------------------------------//
 @implementation MKObjCClassMethod
 
@@ -53,7 +65,50 @@ struct objc_method_32 {
     MKDataModel* dataModel = self.dataModel;
     size_t pointerSize = dataModel.pointerSize;
     
-    if (pointerSize == 8)
+    _usesRelativeOffsets = [parent isKindOfClass:MKObjCClassMethodList.class] && [(MKObjCClassMethodList*)parent usesRelativeOffsets];
+    
+    if (_usesRelativeOffsets)
+    {
+        NSError *memoryMapError = nil;
+        
+        struct objc_method_relative var;
+        if ([self.memoryMap copyBytesAtOffset:offset fromAddress:parent.nodeContextAddress into:&var length:sizeof(var) requireFull:YES error:&memoryMapError] < sizeof(var)) {
+            MK_ERROR_OUT = [NSError mk_errorWithDomain:MKErrorDomain code:MK_EINTERNAL_ERROR underlyingError:memoryMapError description:@"Could not read relative objc_method."];
+            [self release]; return nil;
+        }
+        
+        MKSwapLValue32s(var.name, dataModel);
+        MKSwapLValue32s(var.types, dataModel);
+        MKSwapLValue32s(var.imp, dataModel);
+        
+        // Offsets are relative to the unslid address of each field, so the
+        // computed addresses already follow MKNodeVMAddress semantics.
+        mk_vm_address_t vmAddress = self.nodeVMAddress;
+        mk_vm_address_t selectorReference = vmAddress + offsetof(typeof(var), name) + (mk_vm_address_t)(int64_t)var.name;
+        mk_vm_address_t types = vmAddress + offsetof(typeof(var), types) + (mk_vm_address_t)(int64_t)var.types;
+        
+        NSDictionary *context = @{
+            MKInitializationContextTargetClass: MKCString.class
+        };
+        
+        MKPointerNode *reference = [self.macho childNodeAtVMAddress:selectorReference targetClass:MKPointerNode.class].value;
+        if (reference == nil) {
+            MK_PUSH_WARNING(name, MK_ENOT_FOUND, @"Could not find the selector reference at address [0x%" MK_VM_PRIxADDR "].", selectorReference);
+        } else {
+            NSError *nameError = nil;
+            _name = [[MKPointer alloc] initWithVMAddress:reference.address node:self context:context error:&nameError];
+            if (_name == nil)
+                MK_PUSH_WARNING_WITH_ERROR(name, MK_EINTERNAL_ERROR, nameError, @"Could not create a pointer to the name referenced from [0x%" MK_VM_PRIxADDR "].", selectorReference);
+        }
+        
+        NSError *typesError = nil;
+        _types = [[MKPointer alloc] initWithVMAddress:types node:self context:context error:&typesError];
+        if (_types == nil)
+            MK_PUSH_WARNING_WITH_ERROR(types, MK_EINTERNAL_ERROR, typesError, @"Could not create a pointer to the types at [0x%" MK_VM_PRIxADDR "].", types);
+        
+        _implementation = vmAddress + offsetof(typeof(var), imp) + (mk_vm_address_t)(int64_t)var.imp;
+    }
+    else if (pointerSize == 8)
     {
         NSError *memoryMapError = nil;
         
@@ -106,6 +161,7 @@ struct objc_method_32 {
 @synthesize name = _name;
 @synthesize types = _types;
 @synthesize implementation = _implementation;
+@synthesize usesRelativeOffsets = _usesRelativeOffsets;
 
 //◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
 #pragma mark -  MKNode
@@ -113,19 +169,30 @@ struct objc_method_32 {
 
 //|++++++++++++++++++++++++++++++++++++|//
 - (mk_vm_size_t)nodeSize
-{ return (self.dataModel.pointerSize == 8) ? sizeof(struct objc_method_64) : sizeof(struct objc_method_32); }
+{
+    if (_usesRelativeOffsets)
+        return sizeof(struct objc_method_relative);
+    
+    return (self.dataModel.pointerSize == 8) ? sizeof(struct objc_method_64) : sizeof(struct objc_method_32);
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (id)layoutKey
+{ return @[super.layoutKey ?: [NSNull null], @(self.usesRelativeOffsets)]; }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     struct objc_method_64 method64;
     struct objc_method_32 method32;
+    struct objc_method_relative methodRelative;
     
     size_t pointerSize = self.dataModel.pointerSize;
+    BOOL relative = self.usesRelativeOffsets;
     
-#define FIELD_TYPE(type64, type32) (pointerSize == 8 ? type64.sharedInstance : type32.sharedInstance)
-#define FIELD_OFFSET(field) (pointerSize == 8 ? offsetof(typeof(method64), field) : offsetof(typeof(method32), field))
-#define FIELD_SIZE(field) (pointerSize == 8 ? sizeof(method64.field) : sizeof(method32.field))
+#define FIELD_TYPE(type64, type32) (relative ? MKNodeFieldTypeDoubleWord.sharedInstance : pointerSize == 8 ? type64.sharedInstance : type32.sharedInstance)
+#define FIELD_OFFSET(field) (relative ? offsetof(typeof(methodRelative), field) : pointerSize == 8 ? offsetof(typeof(method64), field) : offsetof(typeof(method32), field))
+#define FIELD_SIZE(field) (relative ? sizeof(methodRelative.field) : pointerSize == 8 ? sizeof(method64.field) : sizeof(method32.field))
     
     MKNodeFieldBuilder *name = [MKNodeFieldBuilder
         builderWithProperty:MK_PROPERTY(name)
@@ -158,7 +225,7 @@ struct objc_method_32 {
 #undef FIELD_OFFSET
 #undef FIELD_TYPE
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         name.build,
         types.build,
         implementation.build
@@ -37,6 +37,10 @@ NS_ASSUME_NONNULL_BEGIN
 //----------------------------------------------------------------------------//
 @interface MKObjCClassMethodList : MKObjCElementList<MKObjCClassMethod*>
 
+//! Indicates whether the list contains methods in the relative format.
+//! Relative methods are 12 bytes, regardless of the pointer size.
+@property (nonatomic, readonly) BOOL usesRelativeOffsets;
+
 #ifdef __swift__
 + (Class)classForGenericArgumentAtIndex:(NSUInteger)index;
 #endif
@@ -28,6 +28,10 @@
 #import "MKObjCClassMethodList.h"
 #import "MKObjCClassMethod.h"
 
+// from https://opensource.apple.com/source/objc4/objc4-818.2/runtime/objc-runtime-new.h.auto.html
+#define METHOD_LIST_FLAGS_MASK              0xffff0003
+#define METHOD_LIST_USES_RELATIVE_OFFSETS   0x80000000
+
 //----------------------------------------------------------------------------//
 @implementation MKObjCClassMethodList
 
@@ -37,6 +41,14 @@
 
 //|++++++++++++++++++++++++++++++++++++|//
 + (uint32_t)flagsMask
-{ return 3; }
+{ return METHOD_LIST_FLAGS_MASK; }
+
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+#pragma mark -  List Values
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (BOOL)usesRelativeOffsets
+{ return !!(self.flags & METHOD_LIST_USES_RELATIVE_OFFSETS); }
 
 @end
@@ -111,7 +111,7 @@ struct objc_property_32 {
 { return (self.dataModel.pointerSize == 8) ? sizeof(struct objc_property_64) : sizeof(struct objc_property_32); }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     struct objc_property_64 prop64;
     struct objc_property_32 prop32;
@@ -144,7 +144,7 @@ struct objc_property_32 {
 #undef FIELD_OFFSET
 #undef FIELD_TYPE
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         name.build,
         attributes.build
     ]];
@@ -272,7 +272,7 @@ struct objc_protocol_32 {
 { return _size; }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     struct objc_protocol_64 proto64;
     struct objc_protocol_32 proto32;
@@ -404,7 +404,7 @@ struct objc_protocol_32 {
 #undef FIELD_OFFSET
 #undef FIELD_TYPE
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         isa.build,
         mangledName.build,
         protocols.build,
@@ -196,7 +196,7 @@ struct objc_protocollist_64 {
 @synthesize nodeSize = _nodeSize;
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     struct objc_protocollist_64 list64;
     struct objc_protocollist_32 list32;
@@ -227,7 +227,7 @@ struct objc_protocollist_64 {
 #undef FIELD_OFFSET
 #undef FIELD_TYPE
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         count.build,
         elements.build
     ]];
@@ -0,0 +1,118 @@
+//----------------------------------------------------------------------------//
+//|
+//|             MachOKit - A Lightweight Mach-O Parsing Library
+//|             _MKObjCElementArray.m
+//|
+//|             D.V.
+//|             Copyright (c) 2014-2015 D.V. All rights reserved.
+//|
+//| Permission is hereby granted, free of charge, to any person obtaining a
+//| copy of this software and associated documentation files (the "Software"),
+//| to deal in the Software without restriction, including without limitation
+//| the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//| and/or sell copies of the Software, and to permit persons to whom the
+//| Software is furnished to do so, subject to the following conditions:
+//|
+//| The above copyright notice and this permission notice shall be included
+//| in all copies or substantial portions of the Software.
+//|
+//| THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//| OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//| MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//| IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//| CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//| TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//| SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//----------------------------------------------------------------------------//
+
+
+#import "_MKObjCElementArray.h"
+#import "MKInternal.h"
+#import "MKObjCElementList.h"
+
+//----------------------------------------------------------------------------//
+@implementation _MKObjCElementArray
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (instancetype)initWithList:(MKObjCElementList*)list count:(NSUInteger)count offset:(mk_vm_offset_t)offset stride:(mk_vm_size_t)stride elementClass:(Class)elementClass
+{
+    self = [super init];
+    if (self == nil) return nil;
+    
+    _elements = calloc(count ?: 1, sizeof(*_elements));
+    if (_elements == NULL) {
+        [self release]; return nil;
+    }
+    
+    _list = [list retain];
+    _count = count;
+    _offset = offset;
+    _stride = stride;
+    _elementClass = elementClass;
+    pthread_mutex_init(&_lock, NULL);
+    
+    return self;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)dealloc
+{
+    // -init may have failed before allocating the elements.
+    if (_elements) {
+        for (NSUInteger i = 0; i < _count; i++)
+            [_elements[i] release];
+        
+        free(_elements);
+        pthread_mutex_destroy(&_lock);
+    }
+    
+    [_list release];
+    
+    [super dealloc];
+}
+
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+#pragma mark -  NSArray
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (NSUInteger)count
+{ return _count; }
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (MKOffsetNode*)objectAtIndex:(NSUInteger)index
+{
+    if (index >= _count) {
+        NSString *reason = [NSString stringWithFormat:@"Index [%lu] is beyond the bounds of the element list [0 .. %lu).", (unsigned long)index, (unsigned long)_count];
+        @throw [NSException exceptionWithName:NSRangeException reason:reason userInfo:nil];
+    }
+    
+    MKOffsetNode *element;
+    
+    pthread_mutex_lock(&_lock);
+    element = _elements[index];
+    pthread_mutex_unlock(&_lock);
+    
+    if (element)
+        return element;
+    
+    // The element is instantiated outside of the lock.  If another thread
+    // wins the race, its instance is returned instead.
+    // SAFE - The list verified that every element lies within its size.
+    NSError *elementError = nil;
+    MKOffsetNode *newElement = [[[_elementClass alloc] initWithOffset:_offset + index * _stride fromParent:_list error:&elementError] autorelease];
+    if (newElement == nil)
+        newElement = [_elementClass placeholderAtOffset:_offset + index * _stride fromParent:_list error:elementError];
+    
+    pthread_mutex_lock(&_lock);
+    element = _elements[index];
+    if (element == nil) {
+        _elements[index] = [newElement retain];
+        element = newElement;
+    }
+    pthread_mutex_unlock(&_lock);
+    
+    return element;
+}
+
+@end
@@ -132,7 +132,7 @@ struct objc_ivar_32 {
 { return (self.dataModel.pointerSize == 8) ? sizeof(struct objc_ivar_64) : sizeof(struct objc_ivar_32); }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     struct objc_ivar_64 ivar64;
     struct objc_ivar_32 ivar32;
@@ -192,7 +192,7 @@ struct objc_ivar_32 {
 #undef FIELD_OFFSET
 #undef FIELD_TYPE
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         offset.build,
         name.build,
         type.build,
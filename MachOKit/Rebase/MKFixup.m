@@ -45,6 +45,10 @@
 	
 	_nodeOffset = rebaseContext->actionStartOffset;
 	
+	// SAFE - _nodeOffset comes from the rebase commands, which are within the MKRebaseInfo.
+	_nodeContextAddress = [rebaseContext->info nodeAddress:MKNodeContextAddress] + _nodeOffset;
+	_nodeVMAddress = [rebaseContext->info nodeAddress:MKNodeVMAddress] + _nodeOffset;
+	
     _type = rebaseContext->type;
     _offset = rebaseContext->offset;
     
@@ -120,12 +124,18 @@
 //|++++++++++++++++++++++++++++++++++++|//
 - (mk_vm_address_t)nodeAddress:(MKNodeAddressType)type
 {
-	// SAFE - _nodeOffset comes from the rebase commands, which are within the MKRebaseInfo.
-	return [(MKBackedNode*)self.parent nodeAddress:type] + _nodeOffset;
+    switch (type) {
+        case MKNodeContextAddress:
+            return _nodeContextAddress;
+        case MKNodeVMAddress:
+            return _nodeVMAddress;
+        default:
+            @throw [NSException exceptionWithName:NSInvalidArgumentException reason:@"Unsupported node address type." userInfo:nil];
+    }
 }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     MKNodeFieldBuilder *segment = [MKNodeFieldBuilder
         builderWithProperty:MK_PROPERTY(segment)
@@ -155,7 +165,7 @@
     type.description = @"Type";
     type.options = MKNodeFieldOptionDisplayAsDetail;
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         segment.build,
         section.build,
         address.build,
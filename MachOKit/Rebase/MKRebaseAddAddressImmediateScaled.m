@@ -86,7 +86,7 @@
 { return 1; }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     MKNodeFieldBuilder *scale = [MKNodeFieldBuilder
         builderWithProperty:MK_PROPERTY(scale)
@@ -97,7 +97,7 @@
     scale.description = @"Scale";
     scale.options = MKNodeFieldOptionDisplayAsDetail;
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         scale.build
     ]];
 }
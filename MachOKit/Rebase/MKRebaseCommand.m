@@ -36,6 +36,18 @@
 + (id*)_subclassesCache
 { static NSSet *subclasses; return &subclasses; }
 
+//|++++++++++++++++++++++++++++++++++++|//
++ (id*)_dispatchTableCache
+{ static id table; return &table; }
+
+//|++++++++++++++++++++++++++++++++++++|//
++ (BOOL)rankingIsDeterminedByDispatchKeyForSubclass:(Class)subclass
+{
+#pragma unused (subclass)
+    // The opcode is the only input to +canInstantiateWithOpcode:.
+    return YES;
+}
+
 //|++++++++++++++++++++++++++++++++++++|//
 + (uint32_t)canInstantiateWithOpcode:(uint8_t)opcode
 {
@@ -48,7 +60,7 @@
 {
     // If we have one or more compatible subclasses, return the best match.
     {
-        Class subclass = [self bestSubclassWithRanking:^uint32_t(Class cls) {
+        Class subclass = [self bestSubclassForDispatchKey:@(opcode) withRanking:^uint32_t(Class cls) {
             return [cls canInstantiateWithOpcode:opcode];
         }];
         
@@ -146,7 +158,7 @@
 //◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     MKNodeFieldBuilder *opcode = [MKNodeFieldBuilder
         builderWithProperty:MK_PROPERTY(opcode)
@@ -157,7 +169,7 @@
     opcode.description = @"Opcode";
     opcode.options = MKNodeFieldOptionDisplayAsDetail;
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         opcode.build
     ]];
 }
@@ -144,7 +144,7 @@
 }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     MKNodeFieldBuilder *count = [MKNodeFieldBuilder
         builderWithProperty:MK_PROPERTY(count)
@@ -162,7 +162,7 @@
     skip.dataRecipe = MKNodeFieldDataOperationExtractDynamicSubrange.sharedInstance;
     skip.options = MKNodeFieldOptionDisplayAsDetail;
 	
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         count.build,
         skip.build
     ]];
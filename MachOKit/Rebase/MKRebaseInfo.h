@@ -29,9 +29,11 @@
 #import <Foundation/Foundation.h>
 
 #import <MachOKit/MKLinkEditNode.h>
+#import <MachOKit/MKRebaseFieldType.h>
 
 @class MKRebaseCommand;
 @class MKFixup;
+struct MKFixupTable;
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -40,17 +42,48 @@ NS_ASSUME_NONNULL_BEGIN
 @package
     NSArray<__kindof MKRebaseCommand*> *_commands;
     NSArray<MKFixup*> *_fixups;
+    struct MKFixupTable *_fixupTable;
 }
 
 //! Initializes the receiver with the provided Mach-O.
 - (nullable instancetype)initWithImage:(MKMachOImage*)image error:(NSError**)error;
 
-//! An array of rebasing commands.
+//! An array of rebasing commands.  The commands are instantiated on
+//! first access.
 @property (nonatomic, readonly) NSArray<__kindof MKRebaseCommand*> *commands;
 
-//! An array of fixups derived from the rebasing commands.
+//! An array of fixups derived from the rebasing commands.  The fixups are
+//! instantiated on first access.
 @property (nonatomic, readonly) NSArray<MKFixup*> *fixups;
 
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+#pragma mark -  Looking Up Fixups
+//! @name       Looking Up Fixups
+//!
+//! The rebase opcodes are decoded once, when the receiver is initialized,
+//! into a compact table.  These methods read the table without
+//! instantiating any \ref MKRebaseCommand or \ref MKFixup.  The fixup at
+//! a given index in the table is the fixup at the same index in
+//! \ref fixups.
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+
+//! The number of fixups.
+@property (nonatomic, readonly) NSUInteger fixupCount;
+
+//! Returns the VM address of the fixup location at \a index.
+- (mk_vm_address_t)addressOfFixupAtIndex:(NSUInteger)index;
+
+//! Returns the type of the fixup at \a index.
+- (MKRebaseType)typeOfFixupAtIndex:(NSUInteger)index;
+
+//! Returns the index of the fixup at \a address, or \c NSNotFound if no
+//! fixup applies to \a address.
+- (NSUInteger)indexOfFixupAtAddress:(mk_vm_address_t)address;
+
+//! Returns the fixup at \a address, or \c nil if no fixup applies to
+//! \a address.
+- (nullable MKFixup*)fixupAtAddress:(mk_vm_address_t)address;
+
 @end
 
 NS_ASSUME_NONNULL_END
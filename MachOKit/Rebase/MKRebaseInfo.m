@@ -31,13 +31,15 @@
 #import "MKLCDyldInfo.h"
 #import "MKRebaseCommand.h"
 #import "MKFixup.h"
+#import "MKMachO+Segments.h"
+#import "MKSegment.h"
+#import "_MKFixupTable.h"
+
+#include "_mach_trie.h"
 
 //----------------------------------------------------------------------------//
 @implementation MKRebaseInfo
 
-@synthesize commands = _commands;
-@synthesize fixups = _fixups;
-
 //|++++++++++++++++++++++++++++++++++++|//
 - (instancetype)initWithSize:(mk_vm_size_t)size offset:(mk_vm_offset_t)offset inImage:(MKMachOImage*)image error:(NSError**)error
 {
@@ -50,18 +52,206 @@
         [self release]; return nil;
     }
     
+    // Each rebase opcode is at least one byte.  Most produce one fixup.
+    _fixupTable = calloc(1, sizeof(*_fixupTable));
+    if (_fixupTable == NULL || !MKFixupTableInit(_fixupTable, (NSUInteger)self.nodeSize, false)) {
+        MK_ERROR_OUT = [NSError mk_errorWithDomain:MKErrorDomain code:MK_EINTERNAL_ERROR description:@"Could not allocate the fixup table."];
+        [self release]; return nil;
+    }
+    
     // A size of 0 is strange but valid.
-    if (self.nodeSize == 0) {
-        // Still need to assign a value to the commands and fixups array.
-        _commands = [@[] retain];
-		_fixups = [@[] retain];
-        return self;
+    if (self.nodeSize > 0)
+        [self _decodeFixups];
+    
+    MKFixupTableFinalize(_fixupTable);
+    
+    return self;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (instancetype)initWithImage:(MKMachOImage*)image error:(NSError**)error
+{
+    NSParameterAssert(image != nil);
+    
+    // Find LC_DYLD_INFO
+    MKLCDyldInfo *dyldInfoLoadCommand = nil;
+    {
+        NSMutableArray<MKLCDyldInfo*> *commands = [[NSMutableArray alloc] initWithCapacity:1];
+        
+        NSArray *dyldInfoCommands = [image loadCommandsOfType:LC_DYLD_INFO];
+        if (dyldInfoCommands) [commands addObjectsFromArray:dyldInfoCommands];
+        
+        NSArray *dyldInfoOnlyCommands = [image loadCommandsOfType:LC_DYLD_INFO_ONLY];
+        if (dyldInfoOnlyCommands) [commands addObjectsFromArray:dyldInfoOnlyCommands];
+        
+        if (commands.count > 1)
+            MK_PUSH_WARNING(nil, MK_EINVALID_DATA, @"Image contains multiple LC_DYLD_INFO load commands.  Ignoring %@.", commands.lastObject);
+        
+        if (commands.count == 0) {
+            MK_ERROR_OUT = [NSError mk_errorWithDomain:MKErrorDomain code:MK_ENOT_FOUND description:@"Image does not contain a LC_DYLD_INFO load command."];
+			[commands release];
+            [self release]; return nil;
+        }
+        
+        dyldInfoLoadCommand = [[commands.firstObject retain] autorelease];
+        [commands release];
     }
     
-    // Load Rebase Commands
-    @autoreleasepool
+    return [self initWithSize:dyldInfoLoadCommand.rebase_size offset:dyldInfoLoadCommand.rebase_off inImage:image error:error];
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (instancetype)initWithParent:(MKNode*)parent error:(NSError**)error
+{ return [self initWithImage:parent.macho error:error]; }
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)dealloc
+{
+    if (_fixupTable) {
+        MKFixupTableFree(_fixupTable);
+        free(_fixupTable);
+    }
+    
+    [_fixups release];
+    [_commands release];
+    
+    [super dealloc];
+}
+
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+#pragma mark -  Parsing
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)_decodeFixups
+{
+    NSError *memoryMapError = nil;
+    
+    [self.memoryMap adviseAccessPattern:MKMemoryMapAccessPatternSequential atOffset:0 fromAddress:self.nodeContextAddress length:self.nodeSize];
+    
+    MKMemorySpan span = [self.memoryMap spanAtOffset:0 fromAddress:self.nodeContextAddress length:self.nodeSize requireFull:YES error:&memoryMapError];
+    if (span.bytes == NULL) {
+        MK_PUSH_WARNING_WITH_ERROR(fixupCount, MK_EINTERNAL_ERROR, memoryMapError, @"Could not map the rebase info.");
+        return;
+    }
+    
+    const uint8_t *start = span.bytes;
+    const uint8_t *end = start + span.length;
+    const uint8_t *p = start;
+    const uint8_t *command = p;
+    
+    uint64_t pointerSize = self.dataModel.pointerSize;
+    mk_error_t err = MK_ESUCCESS;
+    bool done = false;
+    
+    // Initialize the rebase state to zero in order to match dyld's behavior.
+    uint8_t type = 0;
+    unsigned segmentIndex = 0;
+    mk_vm_offset_t offset = 0;
+    mk_vm_address_t segmentAddress = 0;
+    mk_vm_size_t segmentSize = 0;
+    BOOL haveSegment = NO;
+    
+    while (!done && err == MK_ESUCCESS && p < end)
     {
-        NSMutableArray<__kindof MKRebaseCommand*> *commands = [[NSMutableArray alloc] initWithCapacity:(NSUInteger)size/3];
+        command = p;
+        uint8_t opcode = *p & REBASE_OPCODE_MASK;
+        uint8_t immediate = *p & REBASE_IMMEDIATE_MASK;
+        uint64_t count = 0;
+        uint64_t skip = 0;
+        uint64_t value;
+        size_t size;
+        p++;
+        
+        switch (opcode) {
+            case REBASE_OPCODE_DONE:
+                done = true;
+                break;
+            case REBASE_OPCODE_SET_TYPE_IMM:
+                type = immediate;
+                break;
+            case REBASE_OPCODE_SET_SEGMENT_AND_OFFSET_ULEB:
+            {
+                if ((err = _mk_mach_trie_copy_uleb128(p, end, &offset, &size)))
+                    break;
+                p += size;
+                
+                segmentIndex = immediate;
+                MKSegment *segment = [self.macho segmentAtIndex:segmentIndex].value;
+                haveSegment = (segment != nil);
+                segmentAddress = segment.vmAddress;
+                segmentSize = segment.vmSize;
+                break;
+            }
+            case REBASE_OPCODE_ADD_ADDR_ULEB:
+                if ((err = _mk_mach_trie_copy_uleb128(p, end, &value, &size)))
+                    break;
+                p += size;
+                err = mk_vm_offset_add(offset, value, &offset);
+                break;
+            case REBASE_OPCODE_ADD_ADDR_IMM_SCALED:
+                err = mk_vm_offset_add(offset, immediate * pointerSize, &offset);
+                break;
+            case REBASE_OPCODE_DO_REBASE_IMM_TIMES:
+                count = immediate;
+                break;
+            case REBASE_OPCODE_DO_REBASE_ULEB_TIMES:
+                if ((err = _mk_mach_trie_copy_uleb128(p, end, &count, &size)))
+                    break;
+                p += size;
+                break;
+            case REBASE_OPCODE_DO_REBASE_ADD_ADDR_ULEB:
+                if ((err = _mk_mach_trie_copy_uleb128(p, end, &skip, &size)))
+                    break;
+                p += size;
+                count = 1;
+                break;
+            case REBASE_OPCODE_DO_REBASE_ULEB_TIMES_SKIPPING_ULEB:
+                if ((err = _mk_mach_trie_copy_uleb128(p, end, &count, &size)))
+                    break;
+                p += size;
+                if ((err = _mk_mach_trie_copy_uleb128(p, end, &skip, &size)))
+                    break;
+                p += size;
+                break;
+            default:
+                err = MK_EINVALID_DATA;
+                break;
+        }
+        
+        // Apply the fixups.  See -[MKFixup initWithContext:error:] for the
+        // checks.
+        for (uint64_t i = 0; i < count && err == MK_ESUCCESS; i++)
+        {
+            if (!haveSegment)
+                err = MK_ENOT_FOUND;
+            else if (offset >= segmentSize)
+                err = MK_EOUT_OF_RANGE;
+            else if (!MKFixupTableAppend(_fixupTable, segmentAddress + offset, MKFixupTableMakeInfo(type, 0, 0), 0, 0))
+                err = MK_EINTERNAL_ERROR;
+            else if (skip > UINT64_MAX - pointerSize)
+                err = MK_EOVERFLOW;
+            else
+                err = mk_vm_offset_add(offset, skip + pointerSize, &offset);
+        }
+    }
+    
+    if (err != MK_ESUCCESS)
+        MK_PUSH_WARNING(fixupCount, err, @"Could not decode rebase opcode at offset [%td] (segment index %u): %s.  Stopping after %lu fixups.", command - start, segmentIndex, mk_error_string(err), (unsigned long)_fixupTable->count);
+    else if (!done && span.length < self.nodeSize)
+        MK_PUSH_WARNING(fixupCount, MK_EINVALID_DATA, @"Only [%" MK_VM_PRIuSIZE "] of [%" MK_VM_PRIuSIZE "] bytes of the rebase info could be mapped.", span.length, self.nodeSize);
+}
+
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+#pragma mark -  Rebase Nodes
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (NSArray*)commands
+{
+    if (_commands == nil)
+    @autoreleasepool {
+        NSMutableArray<__kindof MKRebaseCommand*> *commands = [[NSMutableArray alloc] initWithCapacity:(NSUInteger)self.nodeSize/3];
         mk_vm_offset_t offset = 0;
         
         // Cast to mk_vm_size_t is safe; nodeSize can't be larger than UINT32_MAX.
@@ -71,7 +261,7 @@
             
             MKRebaseCommand *command = [MKRebaseCommand commandAtOffset:offset fromParent:self error:&rebaseCommandError];
             if (command == nil) {
-				MK_PUSH_WARNING_WITH_ERROR(commands, MK_EINTERNAL_ERROR, rebaseCommandError, @"Could not parse rebase command at offset [%" MK_VM_PRIuOFFSET "].", offset);
+                MK_PUSH_WARNING_WITH_ERROR(commands, MK_EINTERNAL_ERROR, rebaseCommandError, @"Could not parse rebase command at offset [%" MK_VM_PRIuOFFSET "].", offset);
                 break;
             }
             
@@ -90,18 +280,23 @@
         [commands release];
     }
     
-    // Determine the Fixup addresses
-    @autoreleasepool
-    {
-        NSMutableArray<MKFixup*> *fixups = [[NSMutableArray alloc] initWithCapacity:(NSUInteger)size/3];
+    return _commands;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (NSArray*)fixups
+{
+    if (_fixups == nil)
+    @autoreleasepool {
+        NSMutableArray<MKFixup*> *fixups = [[NSMutableArray alloc] initWithCapacity:_fixupTable->count];
         
         __block BOOL keepGoing = YES;
         __block NSError *rebaseError = nil;
-		// Initialize the rebase context to zero in order to match dyld's behavior.
-		__block struct MKRebaseContext context = { 0, .info = self };
-		
+        // Initialize the rebase context to zero in order to match dyld's behavior.
+        __block struct MKRebaseContext context = { 0, .info = self };
+        
         void (^doRebase)(void) = ^{
-			MKFixup *fixup = [[MKFixup alloc] initWithContext:&context error:&rebaseError];
+            MKFixup *fixup = [[MKFixup alloc] initWithContext:&context error:&rebaseError];
             
             if (fixup)
                 [fixups addObject:fixup];
@@ -111,20 +306,20 @@
             [fixup release];
         };
         
-        for (MKRebaseCommand *command in _commands) {
-			if (context.command == nil) {
-				context.actionStartOffset = command.nodeOffset;
-				context.actionSize = 0;
-			}
-			context.actionSize += command.nodeSize;
-			context.command = command;
-			
-			keepGoing &= [command rebase:doRebase withContext:&context error:&rebaseError];
+        for (MKRebaseCommand *command in self.commands) {
+            if (context.command == nil) {
+                context.actionStartOffset = command.nodeOffset;
+                context.actionSize = 0;
+            }
+            context.actionSize += command.nodeSize;
+            context.command = command;
+            
+            keepGoing &= [command rebase:doRebase withContext:&context error:&rebaseError];
             
             if (keepGoing == NO) {
-				if (rebaseError) {
-					MK_PUSH_WARNING_WITH_ERROR(fixups, MK_EINTERNAL_ERROR, rebaseError, @"Fixup list generation failed at command: %@.", context.command.compactDescription);
-				}
+                if (rebaseError) {
+                    MK_PUSH_WARNING_WITH_ERROR(fixups, MK_EINTERNAL_ERROR, rebaseError, @"Fixup list generation failed at command: %@.", context.command.compactDescription);
+                }
                 break;
             }
         }
@@ -133,52 +328,56 @@
         [fixups release];
     }
     
-    return self;
+    return _fixups;
 }
 
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+#pragma mark -  Looking Up Fixups
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+
 //|++++++++++++++++++++++++++++++++++++|//
-- (instancetype)initWithImage:(MKMachOImage*)image error:(NSError**)error
+- (NSUInteger)fixupCount
+{ return _fixupTable->count; }
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)_checkFixupIndex:(NSUInteger)index
 {
-    NSParameterAssert(image != nil);
-    
-    // Find LC_DYLD_INFO
-    MKLCDyldInfo *dyldInfoLoadCommand = nil;
-    {
-        NSMutableArray<MKLCDyldInfo*> *commands = [[NSMutableArray alloc] initWithCapacity:1];
-        
-        NSArray *dyldInfoCommands = [image loadCommandsOfType:LC_DYLD_INFO];
-        if (dyldInfoCommands) [commands addObjectsFromArray:dyldInfoCommands];
-        
-        NSArray *dyldInfoOnlyCommands = [image loadCommandsOfType:LC_DYLD_INFO_ONLY];
-        if (dyldInfoOnlyCommands) [commands addObjectsFromArray:dyldInfoOnlyCommands];
-        
-        if (commands.count > 1)
-            MK_PUSH_WARNING(nil, MK_EINVALID_DATA, @"Image contains multiple LC_DYLD_INFO load commands.  Ignoring %@.", commands.lastObject);
-        
-        if (commands.count == 0) {
-            MK_ERROR_OUT = [NSError mk_errorWithDomain:MKErrorDomain code:MK_ENOT_FOUND description:@"Image does not contain a LC_DYLD_INFO load command."];
-			[commands release];
-            [self release]; return nil;
-        }
-        
-        dyldInfoLoadCommand = [[commands.firstObject retain] autorelease];
-        [commands release];
+    if (index >= _fixupTable->count) {
+        NSString *reason = [NSString stringWithFormat:@"Index [%lu] is beyond the bounds of the fixup table [0 .. %lu).", (unsigned long)index, (unsigned long)_fixupTable->count];
+        @throw [NSException exceptionWithName:NSRangeException reason:reason userInfo:nil];
     }
-    
-    return [self initWithSize:dyldInfoLoadCommand.rebase_size offset:dyldInfoLoadCommand.rebase_off inImage:image error:error];
 }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (instancetype)initWithParent:(MKNode*)parent error:(NSError**)error
-{ return [self initWithImage:parent.macho error:error]; }
+- (mk_vm_address_t)addressOfFixupAtIndex:(NSUInteger)index
+{
+    [self _checkFixupIndex:index];
+    return _fixupTable->addresses[index];
+}
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (void)dealloc
+- (MKRebaseType)typeOfFixupAtIndex:(NSUInteger)index
 {
-    [_fixups release];
-    [_commands release];
+    [self _checkFixupIndex:index];
+    return MKFixupTableInfoType(_fixupTable->info[index]);
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (NSUInteger)indexOfFixupAtAddress:(mk_vm_address_t)address
+{ return MKFixupTableIndexOfAddress(_fixupTable, address); }
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (MKFixup*)fixupAtAddress:(mk_vm_address_t)address
+{
+    NSUInteger index = [self indexOfFixupAtAddress:address];
+    if (index == NSNotFound)
+        return nil;
     
-    [super dealloc];
+    NSArray<MKFixup*> *fixups = self.fixups;
+    if (index >= fixups.count)
+        return nil;
+    
+    return fixups[index];
 }
 
 //◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
@@ -186,7 +385,7 @@
 //◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     MKNodeFieldBuilder *commands = [MKNodeFieldBuilder
         builderWithProperty:MK_PROPERTY(commands)
@@ -202,7 +401,7 @@
     fixups.description = @"Fixups";
     fixups.options = MKNodeFieldOptionDisplayAsChild | MKNodeFieldOptionDisplayContainerContentsAsDetail;
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         commands.build,
         fixups.build
     ]];
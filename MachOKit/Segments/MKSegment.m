@@ -38,6 +38,10 @@
 + (id*)_subclassesCache
 { static NSSet *subclasses; return &subclasses; }
 
+//|++++++++++++++++++++++++++++++++++++|//
++ (id*)_dispatchTableCache
+{ static id table; return &table; }
+
 //|++++++++++++++++++++++++++++++++++++|//
 + (uint32_t)canInstantiateWithSegmentLoadCommand:(id<MKLCSegment>)segmentLoadCommand
 {
@@ -51,7 +55,10 @@
 //|++++++++++++++++++++++++++++++++++++|//
 + (Class)classForSegmentLoadCommand:(id<MKLCSegment>)segmentLoadCommand
 {
-    return [self bestSubclassWithRanking:^uint32_t(Class cls) {
+    // The segment subclasses in MachOKit rank a segment by its name.
+    NSString *key = segmentLoadCommand.segname ?: @"";
+    
+    return [self bestSubclassForDispatchKey:key withRanking:^uint32_t(Class cls) {
         return [cls canInstantiateWithSegmentLoadCommand:segmentLoadCommand];
     }];
 }
@@ -303,7 +310,7 @@
 }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     MKNodeFieldBuilder *name = [MKNodeFieldBuilder
         builderWithProperty:MK_PROPERTY(name)
@@ -368,7 +375,7 @@
     sections.description = @"Sections";
     sections.options = MKNodeFieldOptionDisplayAsChild;
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         name.build,
         fileOffset.build,
         fileSize.build,
@@ -26,6 +26,7 @@
 //----------------------------------------------------------------------------//
 
 #include <MachOKit/macho.h>
+#include <pthread.h>
 #import <Foundation/Foundation.h>
 
 #import <MachOKit/MKSection.h>
@@ -36,11 +37,23 @@ NS_ASSUME_NONNULL_BEGIN
 //----------------------------------------------------------------------------//
 @interface MKCStringSection : MKSection {
 @package
-    NSArray<MKCString*> *_strings;
+    // Not retained; see -strings.
+    /*__weak*/ NSArray<MKCString*> *_strings;
+    pthread_mutex_t _stringsLock;
+    NSUInteger _stringCount;
+    // The offset of each string, in ascending order.
+    uint32_t *_offsets;
 }
 
+//! The strings in the section, in order of their offset.  Each
+//! \ref MKCString is created when it is first accessed, and cached for as
+//! long as the returned array is alive.
 @property (nonatomic, readonly) NSArray<MKCString*> *strings;
 
+//! Returns the string whose range of VM addresses contains \a address, or
+//! \c nil if \a address is not within a string in the section.
+- (nullable MKCString*)stringAtAddress:(mk_vm_address_t)address;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -27,6 +27,84 @@
 
 #import "MKCStringSection.h"
 #import "MKInternal.h"
+#import "_MKCStringArray.h"
+
+#import <objc/runtime.h>
+
+// The NUL scan examines 16 bytes at a time where SSE2 or NEON is available.
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define MK_CSTRING_MASK_BITS 1
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define MK_CSTRING_MASK_BITS 4
+#endif
+
+//|++++++++++++++++++++++++++++++++++++|//
+#if defined(MK_CSTRING_MASK_BITS)
+//! Returns a mask of the NUL bytes in the 16 bytes at \a bytes.  Each byte
+//! is represented by \c MK_CSTRING_MASK_BITS bits of the mask.
+static inline uint64_t
+MKCStringSectionNULMask(const uint8_t *bytes)
+{
+#if defined(__SSE2__)
+    __m128i chunk = _mm_loadu_si128((const __m128i*)bytes);
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, _mm_setzero_si128()));
+#else
+    // NEON has no movemask.  Narrowing the comparison result leaves one
+    // nibble per byte.
+    uint8x16_t matches = vceqq_u8(vld1q_u8(bytes), vdupq_n_u8(0));
+    uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(matches), 4);
+    return vget_lane_u64(vreinterpret_u64_u8(nibbles), 0);
+#endif
+}
+#endif
+
+//|++++++++++++++++++++++++++++++++++++|//
+//! Finds the offset of each string in the \a length bytes at \a bytes.  If
+//! \a offsets is not \c NULL, the offsets are written to it.  Returns the
+//! number of strings.
+static size_t
+MKCStringSectionScan(const uint8_t *bytes, size_t length, uint32_t *offsets)
+{
+    size_t count = 0;
+    size_t i = 0;
+    
+    if (length == 0)
+        return 0;
+    
+    // The first string begins at the start of the section.  Every NUL that
+    // is not the last byte of the section begins another.
+    if (offsets) offsets[count] = 0;
+    count++;
+    
+#if defined(MK_CSTRING_MASK_BITS)
+    for (; i + 16 <= length; i += 16)
+    {
+        uint64_t mask = MKCStringSectionNULMask(bytes + i);
+        while (mask)
+        {
+            size_t lane = (size_t)__builtin_ctzll(mask) / MK_CSTRING_MASK_BITS;
+            mask &= ~(((1ULL << MK_CSTRING_MASK_BITS) - 1) << (lane * MK_CSTRING_MASK_BITS));
+            
+            if (i + lane + 1 < length) {
+                if (offsets) offsets[count] = (uint32_t)(i + lane + 1);
+                count++;
+            }
+        }
+    }
+#endif
+    
+    for (; i < length; i++)
+    {
+        if (bytes[i] == '\0' && i + 1 < length) {
+            if (offsets) offsets[count] = (uint32_t)(i + 1);
+            count++;
+        }
+    }
+    
+    return count;
+}
 
 //----------------------------------------------------------------------------//
 @implementation MKCStringSection
@@ -50,31 +128,30 @@
     self = [super initWithLoadCommand:sectionLoadCommand inSegment:segment error:error];
     if (self == nil) return nil;
     
-    // Load Strings
+    pthread_mutex_init(&_stringsLock, NULL);
+    
+    // Index the strings.  Only the offset of each string is recorded here;
+    // the string nodes are created as they are accessed.
     {
-        NSMutableArray<MKCString*> *strings = [[NSMutableArray alloc] init];
-        mk_vm_offset_t offset = 0;
+        size_t count = 0;
+        NSError *memoryMapError = nil;
         
-        // Cast to mk_vm_size_t is safe; nodeSize can't be larger than UINT32_MAX.
-        while ((mk_vm_size_t)offset < self.nodeSize)
-        {
-            NSError *stringError = nil;
-            
-            MKCString *string = [[MKCString alloc] initWithOffset:offset fromParent:self error:&stringError];
-            if (string == nil) {
-                MK_PUSH_WARNING_WITH_ERROR(strings, MK_EINTERNAL_ERROR, stringError, @"Could not parse string at offset [%" MK_VM_PRIuOFFSET "].", offset);
-                break;
+        MKMemorySpan span = [self.memoryMap spanAtOffset:0 fromAddress:self.nodeContextAddress length:self.nodeSize requireFull:YES error:&memoryMapError];
+        if (span.bytes == NULL) {
+            MK_PUSH_WARNING_WITH_ERROR(strings, MK_EINTERNAL_ERROR, memoryMapError, @"Could not map the string section.");
+        } else {
+            // Cast to size_t is safe; nodeSize can't be larger than UINT32_MAX.
+            count = MKCStringSectionScan(span.bytes, (size_t)span.length, NULL);
+            _offsets = malloc((count ?: 1) * sizeof(uint32_t));
+            if (_offsets == NULL) {
+                MK_PUSH_WARNING(strings, MK_EINTERNAL_ERROR, @"Could not allocate the offsets of [%zu] strings.", count);
+                count = 0;
+            } else {
+                MKCStringSectionScan(span.bytes, (size_t)span.length, _offsets);
             }
-            
-            [strings addObject:string];
-            [string release];
-            
-            // SAFE - All string nodes must be within the size of this node.
-            offset += string.nodeSize;
         }
         
-        _strings = [strings copy];
-        [strings release];
+        _stringCount = count;
     }
     
     return self;
@@ -83,7 +160,9 @@
 //|++++++++++++++++++++++++++++++++++++|//
 - (void)dealloc
 {
-    [_strings release];
+    objc_storeWeak(&_strings, nil);
+    pthread_mutex_destroy(&_stringsLock);
+    free(_offsets);
     
     [super dealloc];
 }
@@ -92,7 +171,56 @@
 #pragma mark -  Section Values
 //◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
 
-@synthesize strings = _strings;
+//|++++++++++++++++++++++++++++++++++++|//
+- (NSArray*)strings
+{
+    // The array retains the receiver, so only a weak reference to it is
+    // kept here.  A new array is created once the last one is released.
+    if (_stringCount == 0)
+        return @[];
+    
+    NSArray *strings;
+    
+    pthread_mutex_lock(&_stringsLock);
+    strings = objc_loadWeak(&_strings);
+    if (strings == nil) {
+        strings = [[[_MKCStringArray alloc] initWithSection:self offsets:_offsets count:_stringCount] autorelease];
+        objc_storeWeak(&_strings, strings);
+    }
+    pthread_mutex_unlock(&_stringsLock);
+    
+    return strings ?: @[];
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (MKCString*)stringAtAddress:(mk_vm_address_t)address
+{
+    mk_vm_address_t sectionAddress = self.nodeVMAddress;
+    if (address < sectionAddress || address - sectionAddress >= self.nodeSize)
+        return nil;
+    
+    mk_vm_offset_t offset = address - sectionAddress;
+    if (_stringCount == 0 || offset < _offsets[0])
+        return nil;
+    
+    // Find the last string that begins at or before the offset.
+    NSUInteger lo = 0;
+    NSUInteger hi = _stringCount;
+    while (hi - lo > 1) {
+        NSUInteger mid = lo + (hi - lo) / 2;
+        if (_offsets[mid] <= offset)
+            lo = mid;
+        else
+            hi = mid;
+    }
+    
+    // The last string may be followed by bytes that could not be mapped.
+    MKCString *string = self.strings[lo];
+    if (offset >= _offsets[lo] + string.nodeSize)
+        return nil;
+    
+    return string;
+}
 
 //◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
 #pragma mark -  MKPointer
@@ -101,9 +229,9 @@
 //|++++++++++++++++++++++++++++++++++++|//
 - (MKResult*)childNodeOccupyingVMAddress:(mk_vm_address_t)address targetClass:(Class)targetClass
 {
-    MKResult *child = [MKBackedNode childNodeOccupyingVMAddress:address targetClass:targetClass inSortedArray:(NSArray *)self.strings];
-    if (child.value)
-        return child;
+    MKCString *string = [self stringAtAddress:address];
+    if (string)
+        return [string childNodeOccupyingVMAddress:address targetClass:targetClass];
     
     return [super childNodeOccupyingVMAddress:address targetClass:targetClass];
 }
@@ -113,7 +241,7 @@
 //◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     MKNodeFieldBuilder *strings = [MKNodeFieldBuilder
         builderWithProperty:MK_PROPERTY(strings)
@@ -122,7 +250,7 @@
     strings.description = @"Strings";
     strings.options = MKNodeFieldOptionDisplayAsDetail | MKNodeFieldOptionMergeWithParent;
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         strings.build
     ]];
 }
@@ -26,6 +26,7 @@
 //----------------------------------------------------------------------------//
 
 #include <MachOKit/macho.h>
+#include <pthread.h>
 #import <Foundation/Foundation.h>
 
 #import <MachOKit/MKSection.h>
@@ -36,11 +37,30 @@ NS_ASSUME_NONNULL_BEGIN
 //----------------------------------------------------------------------------//
 @interface MKPointerListSection<Element> : MKSection {
 @package
-    NSArray<MKPointerNode*> *_pointerList;
+    // Not retained; see -elements.
+    /*__weak*/ NSArray<MKPointerNode*> *_pointerList;
+    pthread_mutex_t _pointerListLock;
+    NSUInteger _pointerCount;
+    NSDictionary<NSString*, id> *_pointerContext;
+    // The decoded pointers.
+    mk_vm_address_t *_addresses;
 }
 
+//! An array of \ref MKPointerNode instances, one for each pointer in the
+//! section, in order.
+//!
+//! The pointers are decoded when the section is initialized.  Each pointer
+//! node is instantiated when it is first accessed, and cached for as long
+//! as the returned array is alive.  Use \ref enumerateAddressesUsingBlock: to
+//! visit every pointer without instantiating any nodes.
 @property (nonatomic, readonly) NSArray<MKPointerNode<Element>*> *elements;
 
+//! Invokes \a block with the address referenced by each pointer in the
+//! section, in order, without instantiating any \ref MKPointerNode.  As for
+//! \ref -[MKPointerNode address], the addresses have been byte swapped and
+//! the slide of an image that was loaded from memory has been removed.
+- (void)enumerateAddressesUsingBlock:(void (NS_NOESCAPE ^)(mk_vm_address_t address, NSUInteger index, BOOL *stop))block;
+
 @end
 
 NS_ASSUME_NONNULL_END
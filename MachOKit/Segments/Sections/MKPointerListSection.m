@@ -28,8 +28,41 @@
 #import "MKPointerListSection.h"
 #import "MKInternal.h"
 #import "MKNodeDescription.h"
+#import "MKMachO.h"
+#import "MKNode+MachO.h"
+#import "_MKPointerArray.h"
 
 #include <objc/message.h>
+#include <objc/runtime.h>
+
+//|++++++++++++++++++++++++++++++++++++|//
+static void
+MKPointerListSectionDecode(mk_vm_address_t *addresses, const uint8_t *list, NSUInteger count, bool is64, bool swap)
+{
+    // The list is not guaranteed to be aligned.  Each combination of
+    // pointer size and byte order gets its own loop, free of branches.
+    if (is64 && !swap) {
+        memcpy(addresses, list, count * sizeof(uint64_t));
+    } else if (is64) {
+        for (NSUInteger i = 0; i < count; i++) {
+            uint64_t pointer;
+            memcpy(&pointer, list + i * sizeof(pointer), sizeof(pointer));
+            addresses[i] = __builtin_bswap64(pointer);
+        }
+    } else if (!swap) {
+        for (NSUInteger i = 0; i < count; i++) {
+            uint32_t pointer;
+            memcpy(&pointer, list + i * sizeof(pointer), sizeof(pointer));
+            addresses[i] = pointer;
+        }
+    } else {
+        for (NSUInteger i = 0; i < count; i++) {
+            uint32_t pointer;
+            memcpy(&pointer, list + i * sizeof(pointer), sizeof(pointer));
+            addresses[i] = __builtin_bswap32(pointer);
+        }
+    }
+}
 
 //----------------------------------------------------------------------------//
 @implementation MKPointerListSection
@@ -53,36 +86,68 @@
     self = [super initWithLoadCommand:sectionLoadCommand inSegment:segment error:error];
     if (self == nil) return nil;
     
-    // Load pointers
+    pthread_mutex_init(&_pointerListLock, NULL);
+    
+    // Remap the list once and decode every pointer up front.  Pointer nodes
+    // are instantiated on demand by the array, from these addresses.
     {
-        NSMutableArray<MKPointerNode*> *pointers = [[NSMutableArray alloc] init];
-        mk_vm_offset_t offset = 0;
-        
         Class targetClass = nil;
         // Hack Hack - The -classForGenericArgumentAtIndex: isn't defined in
         //             SDK headers, which causes warnings.
         if ([self.class respondsToSelector:sel_getUid("classForGenericArgumentAtIndex:")])
             targetClass = ((Class(*)(id, SEL, NSUInteger))objc_msgSend)(self.class, sel_getUid("classForGenericArgumentAtIndex:"), 0);
         
-        while (offset < self.nodeSize)
-        {
-            NSError *pointerError = nil;
+        if (targetClass) {
+            _pointerContext = [@{
+                MKInitializationContextTargetClass: targetClass
+            } retain];
+        }
+        
+        mk_vm_size_t pointerSize = self.dataModel.pointerSize;
+        bool is64 = (pointerSize == 8);
+        bool swap = (self.dataModel.byteOrder == &mk_byteorder_swapped);
+        NSUInteger count = (NSUInteger)(self.nodeSize / pointerSize);
+        __block NSError *remapError = nil;
+        
+        if (self.nodeSize % pointerSize != 0)
+            MK_PUSH_WARNING(elements, MK_EINVALID_DATA, @"Section size [%" MK_VM_PRIuSIZE "] is not a multiple of the pointer size [%" MK_VM_PRIuSIZE "].  Ignoring the trailing bytes.", self.nodeSize, pointerSize);
+        
+        _addresses = malloc((count ?: 1) * sizeof(mk_vm_address_t));
+        if (_addresses == NULL) {
+            MK_PUSH_WARNING(elements, MK_EINTERNAL_ERROR, @"Could not allocate storage for [%lu] pointers.", (unsigned long)count);
+            count = 0;
+        }
+        
+        if (count > 0) {
+            [self.memoryMap adviseAccessPattern:MKMemoryMapAccessPatternSequential atOffset:0 fromAddress:self.nodeContextAddress length:count * pointerSize];
             
-            MKPointerNode *pointer = [[MKPointerNode alloc] initWithOffset:offset fromParent:self targetClass:targetClass error:&pointerError];
-            if (pointer == nil) {
-                MK_PUSH_WARNING_WITH_ERROR(references, MK_EINTERNAL_ERROR, pointerError, @"Could not parse pointer at offset [%" MK_VM_PRIuOFFSET "].", offset);
-                break;
+            [self.memoryMap remapBytesAtOffset:0 fromAddress:self.nodeContextAddress length:count * pointerSize requireFull:YES withHandler:^(vm_address_t address, vm_size_t __unused length, NSError *error) {
+                if (error) { remapError = [error retain]; return; }
+                MKPointerListSectionDecode(_addresses, (const uint8_t*)address, count, is64, swap);
+            }];
+        }
+        
+        if (remapError) {
+            MK_PUSH_WARNING_WITH_ERROR(elements, MK_EINTERNAL_ERROR, remapError, @"Could not map the pointer list.");
+            [remapError release];
+            count = 0;
+        }
+        
+        // If the image has been processed by dyld, the pointers hold slid
+        // addresses.  Pointer nodes expect MKNodeVMAddress semantics.
+        MKMachOImage *image = self.macho;
+        if (image && image.isFromMemory) {
+            mk_vm_slide_t slide = image.slide;
+            for (NSUInteger i = 0; i < count; i++) {
+                if (mk_vm_address_remove_slide(_addresses[i], slide, &_addresses[i]) != MK_ESUCCESS) {
+                    MK_PUSH_WARNING(elements, MK_EINTERNAL_ERROR, @"Could not remove the slide from the pointer at offset [%" MK_VM_PRIuOFFSET "].", (mk_vm_offset_t)(i * pointerSize));
+                    count = i;
+                    break;
+                }
             }
-            
-            [pointers addObject:pointer];
-            [pointer release];
-            
-            // SAFE - All pointer nodes must be within the size of this node.
-            offset += pointer.nodeSize;
         }
         
-        _pointerList = [pointers copy];
-        [pointers release];
+        _pointerCount = count;
     }
     
     return self;
@@ -91,7 +156,10 @@
 //|++++++++++++++++++++++++++++++++++++|//
 - (void)dealloc
 {
-    [_pointerList release];
+    objc_storeWeak(&_pointerList, nil);
+    pthread_mutex_destroy(&_pointerListLock);
+    [_pointerContext release];
+    free(_addresses);
     
     [super dealloc];
 }
@@ -100,7 +168,39 @@
 #pragma mark -  Section Values
 //◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
 
-@synthesize elements = _pointerList;
+//|++++++++++++++++++++++++++++++++++++|//
+- (NSArray*)elements
+{
+    // Each pointer node retains the receiver through the array, which
+    // is therefore only referenced weakly here.
+    if (_pointerCount == 0)
+        return @[];
+    
+    NSArray *pointerList;
+    
+    pthread_mutex_lock(&_pointerListLock);
+    pointerList = objc_loadWeak(&_pointerList);
+    if (pointerList == nil) {
+        pointerList = [[[_MKPointerArray alloc] initWithSection:self count:_pointerCount pointerSize:self.dataModel.pointerSize context:_pointerContext] autorelease];
+        objc_storeWeak(&_pointerList, pointerList);
+    }
+    pthread_mutex_unlock(&_pointerListLock);
+    
+    return pointerList ?: @[];
+}
+
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+#pragma mark -  Enumerating Pointers
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)enumerateAddressesUsingBlock:(void (NS_NOESCAPE ^)(mk_vm_address_t address, NSUInteger index, BOOL *stop))block
+{
+    BOOL stop = NO;
+    
+    for (NSUInteger i = 0; i < _pointerCount && !stop; i++)
+        block(_addresses[i], i, &stop);
+}
 
 //◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
 #pragma mark -  MKPointer
@@ -109,9 +209,19 @@
 //|++++++++++++++++++++++++++++++++++++|//
 - (MKResult*)childNodeOccupyingVMAddress:(mk_vm_address_t)address targetClass:(Class)targetClass
 {
-    MKResult *child = [MKBackedNode childNodeOccupyingVMAddress:address targetClass:targetClass inSortedArray:(NSArray *)self.elements];
-    if (child.value)
-        return child;
+    // The pointers are contiguous and equally sized, so the index of the
+    // pointer occupying the address can be computed directly.
+    mk_vm_address_t vmAddress = self.nodeVMAddress;
+    
+    if (address >= vmAddress && _pointerCount > 0) {
+        mk_vm_offset_t index = (address - vmAddress) / self.dataModel.pointerSize;
+        
+        if (index < _pointerCount) {
+            MKResult *child = [self.elements[(NSUInteger)index] childNodeOccupyingVMAddress:address targetClass:targetClass];
+            if (child.value)
+                return child;
+        }
+    }
     
     return [super childNodeOccupyingVMAddress:address targetClass:targetClass];
 }
@@ -134,9 +244,9 @@
 }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         self.class._elementsFieldBuilder.build
     ]];
 }
@@ -102,6 +102,25 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, readonly) MKSectionUserAttributes userAttributes;
 @property (nonatomic, readonly) MKSectionSystemAttributes systemAttributes;
 
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+#pragma mark -  Relocations
+//! @name       Relocations
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+
+//! The number of relocation entries for this section, as specified in the
+//! load command.  Only sections in relocatable object files (\c MH_OBJECT)
+//! have relocation entries.
+@property (nonatomic, readonly) uint32_t relocationCount;
+
+//! Decodes the relocation entries of this section into a packed array of
+//! \c mk_relocation_t.  The entries are mapped once and decoded in a single
+//! pass; no node objects are created.
+//!
+//! @return
+//! An \c NSData containing \ref relocationCount \c mk_relocation_t, or
+//! \c nil if the entries could not be read.
+- (nullable NSData*)relocationsWithError:(NSError**)error;
+
 @end
 
 NS_ASSUME_NONNULL_END
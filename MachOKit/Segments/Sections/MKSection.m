@@ -39,6 +39,10 @@
 + (id*)_subclassesCache
 { static NSSet *subclasses; return &subclasses; }
 
+//|++++++++++++++++++++++++++++++++++++|//
++ (id*)_dispatchTableCache
+{ static id table; return &table; }
+
 //|++++++++++++++++++++++++++++++++++++|//
 + (uint32_t)canInstantiateWithSectionLoadCommand:(id<MKLCSection>)sectionLoadCommand inSegment:(MKSegment*)segment
 {
@@ -50,10 +54,31 @@
     return 10;
 }
 
+//|++++++++++++++++++++++++++++++++++++|//
+static void
+MKSectionDispatchKeyCopyName(char name[16], NSString *string)
+{
+    if (string)
+        [string getBytes:name maxLength:16 usedLength:NULL encoding:NSUTF8StringEncoding options:0 range:NSMakeRange(0, string.length) remainingRange:NULL];
+}
+
 //|++++++++++++++++++++++++++++++++++++|//
 + (Class)classForSectionLoadCommand:(id<MKLCSection>)sectionLoadCommand inSegment:(MKSegment*)segment;
 {
-    return [self bestSubclassWithRanking:^uint32_t(Class cls) {
+    // The section subclasses in MachOKit rank a section by its segment name,
+    // section name and flags.
+    struct MKSectionDispatchKey {
+        char segname[16];
+        char sectname[16];
+        uint32_t flags;
+    } key;
+    
+    memset(&key, 0, sizeof(key));
+    MKSectionDispatchKeyCopyName(key.segname, sectionLoadCommand.segname);
+    MKSectionDispatchKeyCopyName(key.sectname, sectionLoadCommand.sectname);
+    key.flags = sectionLoadCommand.flags;
+    
+    return [self bestSubclassForDispatchKeyBytes:&key length:sizeof(key) withRanking:^uint32_t(Class cls) {
         return [cls canInstantiateWithSectionLoadCommand:sectionLoadCommand inSegment:segment];
     }];
 }
@@ -195,6 +220,54 @@
 - (MKSectionSystemAttributes)systemAttributes
 { return _flags & SECTION_ATTRIBUTES_SYS; }
 
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+#pragma mark -  Relocations
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (uint32_t)relocationCount
+{ return _loadCommand.nreloc; }
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (NSData*)relocationsWithError:(NSError**)error
+{
+    uint32_t nreloc = _loadCommand.nreloc;
+    uint32_t reloff = _loadCommand.reloff;
+    NSError *memoryMapError = nil;
+    mk_error_t err;
+    
+    if (nreloc == 0)
+        return [NSData data];
+    
+    MKMachOImage *macho = self.macho;
+    
+    // The relocation entries are referenced by file offset.  Relocatable
+    // objects are never loaded by dyld so the offset is always relative to
+    // the start of the image.
+    mk_vm_address_t address;
+    if ((err = mk_vm_address_apply_offset(macho.nodeContextAddress, reloff, &address))) {
+        MK_ERROR_OUT = [NSError mk_errorWithDomain:MKErrorDomain code:MK_EINTERNAL_ERROR underlyingError:MK_MAKE_VM_ADDRESS_APPLY_OFFSET_ARITHMETIC_ERROR(err, macho.nodeContextAddress, reloff) description:@"Could not determine the address of the relocation entries."];
+        return nil;
+    }
+    
+    mk_vm_size_t length = (mk_vm_size_t)nreloc * sizeof(struct relocation_info);
+    
+    NSMutableData *relocations = [NSMutableData dataWithLength:(NSUInteger)nreloc * sizeof(mk_relocation_t)];
+    cpu_type_t cputype = macho.header.cputype;
+    const mk_byteorder_t *byteOrder = self.dataModel.byteOrder;
+    
+    // Map all of the entries at once and decode them in a single pass.
+    MKMemorySpan entries = [self.memoryMap spanAtOffset:0 fromAddress:address length:length requireFull:YES error:&memoryMapError];
+    if (entries.bytes == NULL) {
+        MK_ERROR_OUT = [NSError mk_errorWithDomain:MKErrorDomain code:MK_EBAD_ACCESS underlyingError:memoryMapError description:@"Could not read the relocation entries."];
+        return nil;
+    }
+    
+    mk_relocation_decode((const struct relocation_info*)entries.bytes, nreloc, cputype, byteOrder, relocations.mutableBytes);
+    
+    return relocations;
+}
+
 //◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
 #pragma mark -  MKNode
 //◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
@@ -219,7 +292,7 @@
 }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     MKNodeFieldBuilder *name = [MKNodeFieldBuilder
         builderWithProperty:MK_PROPERTY(name)
@@ -277,7 +350,7 @@
     systemAttributes.description = @"System Attributes";
     systemAttributes.options = MKNodeFieldOptionDisplayAsDetail;
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         name.build,
         alignment.build,
         fileOffset.build,
@@ -0,0 +1,59 @@
+//----------------------------------------------------------------------------//
+//|
+//|             MachOKit - A Lightweight Mach-O Parsing Library
+//! @file       _MKCStringArray.h
+//!
+//! @author     D.V.
+//! @copyright  Copyright (c) 2014-2015 D.V. All rights reserved.
+//|
+//| Permission is hereby granted, free of charge, to any person obtaining a
+//| copy of this software and associated documentation files (the "Software"),
+//| to deal in the Software without restriction, including without limitation
+//| the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//| and/or sell copies of the Software, and to permit persons to whom the
+//| Software is furnished to do so, subject to the following conditions:
+//|
+//| The above copyright notice and this permission notice shall be included
+//| in all copies or substantial portions of the Software.
+//|
+//| THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//| OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//| MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//| IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//| CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//| TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//| SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//----------------------------------------------------------------------------//
+
+
+#import <MachOKit/MKBase.h>
+#include <pthread.h>
+
+@class MKCString;
+@class MKCStringSection;
+
+NS_ASSUME_NONNULL_BEGIN
+
+//----------------------------------------------------------------------------//
+//! The array returned by \ref -[MKCStringSection strings].  The section
+//! records only the offset of each string.  An \ref MKCString is
+//! instantiated when its index is first accessed, and is retained by the
+//! array from then on.  A string that can not be read is returned as a
+//! placeholder which carries the error in its warnings.
+//
+@interface _MKCStringArray : NSArray<MKCString*> {
+@package
+    MKCStringSection *_section;
+    NSUInteger _count;
+    const uint32_t *_offsets;
+    MKCString **_strings;
+    pthread_mutex_t _lock;
+}
+
+//! \a offsets must be sorted, and is owned by \a section, which the
+//! receiver retains.
+- (nullable instancetype)initWithSection:(MKCStringSection*)section offsets:(const uint32_t*)offsets count:(NSUInteger)count;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,116 @@
+//----------------------------------------------------------------------------//
+//|
+//|             MachOKit - A Lightweight Mach-O Parsing Library
+//|             _MKCStringArray.m
+//|
+//|             D.V.
+//|             Copyright (c) 2014-2015 D.V. All rights reserved.
+//|
+//| Permission is hereby granted, free of charge, to any person obtaining a
+//| copy of this software and associated documentation files (the "Software"),
+//| to deal in the Software without restriction, including without limitation
+//| the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//| and/or sell copies of the Software, and to permit persons to whom the
+//| Software is furnished to do so, subject to the following conditions:
+//|
+//| The above copyright notice and this permission notice shall be included
+//| in all copies or substantial portions of the Software.
+//|
+//| THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//| OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//| MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//| IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//| CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//| TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//| SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//----------------------------------------------------------------------------//
+
+
+#import "_MKCStringArray.h"
+#import "MKInternal.h"
+#import "MKCString.h"
+#import "MKCStringSection.h"
+
+//----------------------------------------------------------------------------//
+@implementation _MKCStringArray
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (instancetype)initWithSection:(MKCStringSection*)section offsets:(const uint32_t*)offsets count:(NSUInteger)count
+{
+    self = [super init];
+    if (self == nil) return nil;
+    
+    _strings = calloc(count ?: 1, sizeof(*_strings));
+    if (_strings == NULL) {
+        [self release]; return nil;
+    }
+    
+    _section = [section retain];
+    _count = count;
+    _offsets = offsets;
+    pthread_mutex_init(&_lock, NULL);
+    
+    return self;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)dealloc
+{
+    // -init may have failed before allocating the strings.
+    if (_strings) {
+        for (NSUInteger i = 0; i < _count; i++)
+            [_strings[i] release];
+        
+        free(_strings);
+        pthread_mutex_destroy(&_lock);
+    }
+    
+    [_section release];
+    
+    [super dealloc];
+}
+
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+#pragma mark -  NSArray
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (NSUInteger)count
+{ return _count; }
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (MKCString*)objectAtIndex:(NSUInteger)index
+{
+    if (index >= _count) {
+        NSString *reason = [NSString stringWithFormat:@"Index [%lu] is beyond the bounds of the string section [0 .. %lu).", (unsigned long)index, (unsigned long)_count];
+        @throw [NSException exceptionWithName:NSRangeException reason:reason userInfo:nil];
+    }
+    
+    MKCString *string;
+    
+    pthread_mutex_lock(&_lock);
+    string = _strings[index];
+    pthread_mutex_unlock(&_lock);
+    
+    if (string)
+        return string;
+    
+    // The string is instantiated outside of the lock.  If another thread
+    // wins the race, its instance is returned instead.
+    NSError *stringError = nil;
+    MKCString *newString = [[[MKCString alloc] initWithOffset:_offsets[index] fromParent:_section error:&stringError] autorelease];
+    if (newString == nil)
+        newString = [MKCString placeholderAtOffset:_offsets[index] fromParent:_section error:stringError];
+    
+    pthread_mutex_lock(&_lock);
+    string = _strings[index];
+    if (string == nil) {
+        _strings[index] = [newString retain];
+        string = newString;
+    }
+    pthread_mutex_unlock(&_lock);
+    
+    return string;
+}
+
+@end
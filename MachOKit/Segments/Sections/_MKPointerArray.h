@@ -0,0 +1,59 @@
+//----------------------------------------------------------------------------//
+//|
+//|             MachOKit - A Lightweight Mach-O Parsing Library
+//! @file       _MKPointerArray.h
+//!
+//! @author     D.V.
+//! @copyright  Copyright (c) 2014-2015 D.V. All rights reserved.
+//|
+//| Permission is hereby granted, free of charge, to any person obtaining a
+//| copy of this software and associated documentation files (the "Software"),
+//| to deal in the Software without restriction, including without limitation
+//| the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//| and/or sell copies of the Software, and to permit persons to whom the
+//| Software is furnished to do so, subject to the following conditions:
+//|
+//| The above copyright notice and this permission notice shall be included
+//| in all copies or substantial portions of the Software.
+//|
+//| THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//| OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//| MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//| IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//| CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//| TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//| SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//----------------------------------------------------------------------------//
+
+
+#import <MachOKit/MKBase.h>
+#include <pthread.h>
+
+@class MKPointerNode;
+@class MKPointerListSection;
+
+NS_ASSUME_NONNULL_BEGIN
+
+//----------------------------------------------------------------------------//
+//! The array returned by \ref -[MKPointerListSection elements].  An
+//! \ref MKPointerNode is instantiated from the pointer decoded by the
+//! section when its index is first accessed, and is retained by the array
+//! from then on.  A pointer
+//! that can not be instantiated is returned as a placeholder which carries
+//! the error in its warnings.
+//
+@interface _MKPointerArray : NSArray<MKPointerNode*> {
+@package
+    MKPointerListSection *_section;
+    NSUInteger _count;
+    mk_vm_size_t _pointerSize;
+    NSDictionary<NSString*, id> *_context;
+    MKPointerNode **_pointers;
+    pthread_mutex_t _lock;
+}
+
+- (nullable instancetype)initWithSection:(MKPointerListSection*)section count:(NSUInteger)count pointerSize:(mk_vm_size_t)pointerSize context:(nullable NSDictionary<NSString*, id>*)context;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,118 @@
+//----------------------------------------------------------------------------//
+//|
+//|             MachOKit - A Lightweight Mach-O Parsing Library
+//|             _MKPointerArray.m
+//|
+//|             D.V.
+//|             Copyright (c) 2014-2015 D.V. All rights reserved.
+//|
+//| Permission is hereby granted, free of charge, to any person obtaining a
+//| copy of this software and associated documentation files (the "Software"),
+//| to deal in the Software without restriction, including without limitation
+//| the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//| and/or sell copies of the Software, and to permit persons to whom the
+//| Software is furnished to do so, subject to the following conditions:
+//|
+//| The above copyright notice and this permission notice shall be included
+//| in all copies or substantial portions of the Software.
+//|
+//| THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//| OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//| MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//| IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//| CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//| TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//| SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//----------------------------------------------------------------------------//
+
+
+#import "_MKPointerArray.h"
+#import "MKInternal.h"
+#import "MKPointerNode.h"
+#import "MKPointerListSection.h"
+
+//----------------------------------------------------------------------------//
+@implementation _MKPointerArray
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (instancetype)initWithSection:(MKPointerListSection*)section count:(NSUInteger)count pointerSize:(mk_vm_size_t)pointerSize context:(NSDictionary*)context
+{
+    self = [super init];
+    if (self == nil) return nil;
+    
+    _pointers = calloc(count ?: 1, sizeof(*_pointers));
+    if (_pointers == NULL) {
+        [self release]; return nil;
+    }
+    
+    _section = [section retain];
+    _count = count;
+    _pointerSize = pointerSize;
+    _context = [context copy];
+    pthread_mutex_init(&_lock, NULL);
+    
+    return self;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)dealloc
+{
+    // -init may have failed before allocating the pointers.
+    if (_pointers) {
+        for (NSUInteger i = 0; i < _count; i++)
+            [_pointers[i] release];
+        
+        free(_pointers);
+        pthread_mutex_destroy(&_lock);
+    }
+    
+    [_context release];
+    [_section release];
+    
+    [super dealloc];
+}
+
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+#pragma mark -  NSArray
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (NSUInteger)count
+{ return _count; }
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (MKPointerNode*)objectAtIndex:(NSUInteger)index
+{
+    if (index >= _count) {
+        NSString *reason = [NSString stringWithFormat:@"Index [%lu] is beyond the bounds of the pointer list [0 .. %lu).", (unsigned long)index, (unsigned long)_count];
+        @throw [NSException exceptionWithName:NSRangeException reason:reason userInfo:nil];
+    }
+    
+    MKPointerNode *pointer;
+    
+    pthread_mutex_lock(&_lock);
+    pointer = _pointers[index];
+    pthread_mutex_unlock(&_lock);
+    
+    if (pointer)
+        return pointer;
+    
+    // The pointer is instantiated outside of the lock.  If another thread
+    // wins the race, its instance is returned instead.
+    NSError *pointerError = nil;
+    MKPointerNode *newPointer = [[[MKPointerNode alloc] initWithOffset:(mk_vm_offset_t)(index * _pointerSize) fromParent:_section address:_section->_addresses[index] context:_context error:&pointerError] autorelease];
+    if (newPointer == nil)
+        newPointer = [MKPointerNode placeholderAtOffset:(mk_vm_offset_t)(index * _pointerSize) fromParent:_section error:pointerError];
+    
+    pthread_mutex_lock(&_lock);
+    pointer = _pointers[index];
+    if (pointer == nil) {
+        _pointers[index] = [newPointer retain];
+        pointer = newPointer;
+    }
+    pthread_mutex_unlock(&_lock);
+    
+    return pointer;
+}
+
+@end
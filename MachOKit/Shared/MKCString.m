@@ -70,30 +70,27 @@
     // parse it anyway.
     // <http://reverse.put.as/2012/01/31/anti-debug-trick-1-abusing-mach-o-to-crash-gdb/>
     
-    __block NSError *memoryMapError = nil;
+    NSError *memoryMapError = nil;
     
-    [parent.memoryMap remapBytesAtOffset:offset fromAddress:parent.nodeContextAddress length:_nodeSize requireFull:NO withHandler:^(vm_address_t address, vm_size_t length, NSError *e) {
-        if (address == 0x0) { memoryMapError = e; return; }
-        
-        _nodeSize = strnlen((const char*)address, length);
-        _string = [[NSString alloc] initWithBytes:(const void*)address length:(NSUInteger)_nodeSize encoding:NSUTF8StringEncoding];
-        
-        if (_string == nil)
-            MK_PUSH_WARNING(string, MK_EINVALID_DATA, @"Could not initialize NSString with bytes.");
-        
-        if (_nodeSize < length) {
-            // Account for the NULL byte.
-            _nodeSize = _nodeSize + 1;
-        } else {
-            MK_PUSH_WARNING(sring, MK_EINVALID_DATA, @"String may not be properly terminated.");
-        }
-    }];
-    
-    if (memoryMapError) {
+    MKMemorySpan span = [parent.memoryMap spanAtOffset:offset fromAddress:parent.nodeContextAddress length:_nodeSize requireFull:NO error:&memoryMapError];
+    if (span.bytes == NULL) {
         MK_ERROR_OUT = memoryMapError;
         [self release]; return nil;
     }
     
+    _nodeSize = strnlen((const char*)span.bytes, (size_t)span.length);
+    _string = [[NSString alloc] initWithBytes:span.bytes length:(NSUInteger)_nodeSize encoding:NSUTF8StringEncoding];
+    
+    if (_string == nil)
+        MK_PUSH_WARNING(string, MK_EINVALID_DATA, @"Could not initialize NSString with bytes.");
+    
+    if (_nodeSize < span.length) {
+        // Account for the NULL byte.
+        _nodeSize = _nodeSize + 1;
+    } else {
+        MK_PUSH_WARNING(sring, MK_EINVALID_DATA, @"String may not be properly terminated.");
+    }
+    
     return self;
 }
 
@@ -114,18 +111,23 @@
 { return _nodeSize; }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (mk_vm_size_t)stringFieldSize
+{ return _nodeSize; }
+- (mk_vm_offset_t)stringFieldOffset
+{ return 0; }
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (MKNodeDescription*)buildLayout
 {
     MKNodeFieldBuilder *string = [MKNodeFieldBuilder
         builderWithProperty:MK_PROPERTY(string)
         type:MKNodeFieldTypeString.sharedInstance
-        offset:0
-        size:_nodeSize
     ];
     string.description = @"String";
+    string.dataRecipe = MKNodeFieldDataOperationExtractDynamicSubrange.sharedInstance;
     string.options = MKNodeFieldOptionDisplayAsDetail | MKNodeFieldOptionMergeWithParent;
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         string.build
     ]];
 }
@@ -79,31 +79,26 @@ MKLEBRead(bool isSLEB, MKBackedNode *node, mk_vm_offset_t offset, void *LEBValue
 		}
 	}
     
-    __block boolean_t success = false;
+    MKMemorySpan span = [node.memoryMap spanAtOffset:0 fromAddress:address length:maxLength requireFull:NO error:error];
+    if (span.length == 0x0)
+        return false;
     
-    [node.memoryMap remapBytesAtOffset:0 fromAddress:address length:maxLength requireFull:NO withHandler:^(vm_address_t address, vm_size_t length, NSError *e) {
-        if (length == 0x0) { MK_ERROR_OUT = e; return; }
-        
-        mk_error_t err;
-        uint8_t *start = (uint8_t*)address;
-        uint8_t *end = (uint8_t*)(address + length);
-		
-		if (isSLEB) {
-			if ((err = _mk_mach_trie_copy_sleb128(start, end, LEBValue, ULEBSize))) {
-				MK_ERROR_OUT = [NSError mk_errorWithDomain:MKErrorDomain code:err description:@"Invalid sleb128 (err = %s).", mk_error_string(err)];
-				return;
-			}
-		} else {
-			if ((err = _mk_mach_trie_copy_uleb128(start, end, LEBValue, ULEBSize))) {
-				MK_ERROR_OUT = [NSError mk_errorWithDomain:MKErrorDomain code:err description:@"Invalid uleb128 (err = %s).", mk_error_string(err)];
-				return;
-			}
-		}
-        
-        success = true;
-    }];
+    uint8_t *start = (uint8_t*)span.bytes;
+    uint8_t *end = start + span.length;
+    
+    if (isSLEB) {
+        if ((err = _mk_mach_trie_copy_sleb128(start, end, LEBValue, ULEBSize))) {
+            MK_ERROR_OUT = [NSError mk_errorWithDomain:MKErrorDomain code:err description:@"Invalid sleb128 (err = %s).", mk_error_string(err)];
+            return false;
+        }
+    } else {
+        if ((err = _mk_mach_trie_copy_uleb128(start, end, LEBValue, ULEBSize))) {
+            MK_ERROR_OUT = [NSError mk_errorWithDomain:MKErrorDomain code:err description:@"Invalid uleb128 (err = %s).", mk_error_string(err)];
+            return false;
+        }
+    }
     
-    return success;
+    return true;
 }
 
 //|++++++++++++++++++++++++++++++++++++|//
@@ -45,6 +45,13 @@ NS_ASSUME_NONNULL_BEGIN
 
 - (nullable instancetype)initWithOffset:(mk_vm_offset_t)offset fromParent:(MKBackedNode*)parent mask:(mk_vm_address_t)mask context:(nullable NSDictionary<NSString*, id>*)context error:(NSError**)error NS_DESIGNATED_INITIALIZER;
 
+//! Initializes the receiver with a pointer value that the caller has
+//! already read, such as one of the pointers decoded in bulk by
+//! \ref MKPointerListSection.  The \a address must follow
+//! \c MKNodeVMAddress semantics; the slide of an image that was loaded from
+//! memory must already have been removed.
+- (nullable instancetype)initWithOffset:(mk_vm_offset_t)offset fromParent:(MKBackedNode*)parent address:(mk_vm_address_t)address context:(nullable NSDictionary<NSString*, id>*)context error:(NSError**)error NS_DESIGNATED_INITIALIZER;
+
 - (nullable instancetype)initWithOffset:(mk_vm_offset_t)offset fromParent:(MKBackedNode*)parent context:(nullable NSDictionary<NSString*, id>*)context error:(NSError**)error;
 
 - (nullable instancetype)initWithOffset:(mk_vm_offset_t)offset fromParent:(MKBackedNode*)parent mask:(mk_vm_address_t)mask targetClass:(nullable Class)targetClass error:(NSError**)error;
@@ -58,6 +58,19 @@
     return self;
 }
 
+//|++++++++++++++++++++++++++++++++++++|//
+- (instancetype)initWithOffset:(mk_vm_offset_t)offset fromParent:(MKBackedNode*)parent address:(mk_vm_address_t)address context:(NSDictionary*)context error:(NSError**)error
+{
+    self = [super initWithOffset:offset fromParent:parent error:error];
+    if (self == nil) return nil;
+    
+    if (MKPtrInitializeWithVMAddress(mk_ptr_struct(self), parent, address, context, error) == false) {
+        [self release]; return nil;
+    }
+    
+    return self;
+}
+
 //|++++++++++++++++++++++++++++++++++++|//
 - (instancetype)initWithOffset:(mk_vm_offset_t)offset fromParent:(MKBackedNode*)parent context:(NSDictionary*)context error:(NSError**)error
 { return [self initWithOffset:offset fromParent:parent mask:~(mk_vm_address_t)0 context:context error:error]; }
@@ -114,7 +127,7 @@
 { return self.dataModel.pointerSize; }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     MKNodeFieldBuilder *address = [MKNodeFieldBuilder
         builderWithProperty:MK_PROPERTY(address)
@@ -133,12 +146,16 @@
     pointee.description = @"Pointee";
     pointee.options = MKNodeFieldOptionHidden;
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         address.build,
         pointee.build
     ]];
 }
 
+//|++++++++++++++++++++++++++++++++++++|//
+- (id)layoutKey
+{ return @[super.layoutKey ?: [NSNull null], self.targetClass ?: [NSNull null]]; }
+
 //◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
 #pragma mark -  NSObject
 //◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
@@ -0,0 +1,94 @@
+//----------------------------------------------------------------------------//
+//|
+//|             MachOKit - A Lightweight Mach-O Parsing Library
+//! @file       _MKFixupTable.h
+//!
+//! @author     D.V.
+//! @copyright  Copyright (c) 2014-2015 D.V. All rights reserved.
+//|
+//| Permission is hereby granted, free of charge, to any person obtaining a
+//| copy of this software and associated documentation files (the "Software"),
+//| to deal in the Software without restriction, including without limitation
+//| the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//| and/or sell copies of the Software, and to permit persons to whom the
+//| Software is furnished to do so, subject to the following conditions:
+//|
+//| The above copyright notice and this permission notice shall be included
+//| in all copies or substantial portions of the Software.
+//|
+//| THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//| OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//| MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//| IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//| CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//| TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//| SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//----------------------------------------------------------------------------//
+
+
+#include <MachOKit/macho.h>
+#import <Foundation/Foundation.h>
+
+#import <MachOKit/MKBase.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+//----------------------------------------------------------------------------//
+//! Column storage for the fixups produced by a rebase or bind opcode
+//! stream.  Each fixup is one index into a set of parallel arrays.  The
+//! type, symbol flags and library ordinal of a fixup are packed into a
+//! single 32-bit word.  The addend array is only allocated once a fixup
+//! with a non-zero addend is appended, and the symbol offset array only
+//! for tables created with symbols.
+//
+struct MKFixupTable {
+    NSUInteger count;
+    NSUInteger capacity;
+    mk_vm_address_t *addresses;
+    uint32_t *info;
+    uint32_t * _Nullable symbolOffsets;
+    int64_t * _Nullable addends;
+    //! Fixup indexes in ascending order of address, or \c NULL if the
+    //! fixups were appended in ascending order of address.
+    uint32_t * _Nullable sortedIndexes;
+    //! \c true if the fixups are out of order but the address index could
+    //! not be allocated.
+    bool unsorted;
+};
+
+//! Packs a fixup type, symbol flags and library ordinal into an info word.
+#define MKFixupTableMakeInfo(TYPE, FLAGS, ORDINAL) \
+    ((uint32_t)(uint8_t)(TYPE) | ((uint32_t)(uint8_t)(FLAGS) << 8) | ((uint32_t)(uint16_t)(int16_t)(ORDINAL) << 16))
+#define MKFixupTableInfoType(INFO)              ((uint8_t)((INFO) & 0xFF))
+#define MKFixupTableInfoSymbolFlags(INFO)       ((uint8_t)(((INFO) >> 8) & 0xFF))
+#define MKFixupTableInfoLibraryOrdinal(INFO)    ((int64_t)(int16_t)(uint16_t)((INFO) >> 16))
+
+//! The symbol offset of a fixup that does not reference a symbol.
+#define MKFixupTableNoSymbol                    UINT32_MAX
+
+//! Returns \c true if \a ordinal can be stored in an info word.
+#define MKFixupTableCanPackOrdinal(ORDINAL)     ((ORDINAL) >= INT16_MIN && (ORDINAL) <= INT16_MAX)
+
+//! Initializes an empty \a table with room for \a capacity fixups.
+_mk_internal_extern bool
+MKFixupTableInit(struct MKFixupTable *table, NSUInteger capacity, bool withSymbols);
+
+//! Appends a fixup.  Returns \c false if the table could not grow.
+_mk_internal_extern bool
+MKFixupTableAppend(struct MKFixupTable *table, mk_vm_address_t address, uint32_t info, uint32_t symbolOffset, int64_t addend);
+
+//! Releases unused capacity and builds the address index.  No more fixups
+//! can be appended afterwards.
+_mk_internal_extern void
+MKFixupTableFinalize(struct MKFixupTable *table);
+
+//! Returns the index of the first fixup appended at \a address, or
+//! \c NSNotFound.
+_mk_internal_extern NSUInteger
+MKFixupTableIndexOfAddress(const struct MKFixupTable *table, mk_vm_address_t address);
+
+//!
+_mk_internal_extern void
+MKFixupTableFree(struct MKFixupTable *table);
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,202 @@
+//----------------------------------------------------------------------------//
+//|
+//|             MachOKit - A Lightweight Mach-O Parsing Library
+//|             _MKFixupTable.m
+//|
+//|             D.V.
+//|             Copyright (c) 2014-2015 D.V. All rights reserved.
+//|
+//| Permission is hereby granted, free of charge, to any person obtaining a
+//| copy of this software and associated documentation files (the "Software"),
+//| to deal in the Software without restriction, including without limitation
+//| the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//| and/or sell copies of the Software, and to permit persons to whom the
+//| Software is furnished to do so, subject to the following conditions:
+//|
+//| The above copyright notice and this permission notice shall be included
+//| in all copies or substantial portions of the Software.
+//|
+//| THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//| OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//| MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//| IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//| CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//| TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//| SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//----------------------------------------------------------------------------//
+
+
+#import "_MKFixupTable.h"
+
+struct MKFixupTableSortEntry {
+    mk_vm_address_t address;
+    uint32_t index;
+};
+
+//|++++++++++++++++++++++++++++++++++++|//
+static int
+MKFixupTableSortEntryCompare(const void *a, const void *b)
+{
+    const struct MKFixupTableSortEntry *lhs = a;
+    const struct MKFixupTableSortEntry *rhs = b;
+    
+    if (lhs->address != rhs->address)
+        return lhs->address < rhs->address ? -1 : 1;
+    // Keep fixups at the same address in the order they were appended.
+    if (lhs->index != rhs->index)
+        return lhs->index < rhs->index ? -1 : 1;
+    return 0;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+bool
+MKFixupTableInit(struct MKFixupTable *table, NSUInteger capacity, bool withSymbols)
+{
+    memset(table, 0, sizeof(*table));
+    
+    table->capacity = capacity ?: 1;
+    table->addresses = malloc(table->capacity * sizeof(*table->addresses));
+    table->info = malloc(table->capacity * sizeof(*table->info));
+    if (withSymbols)
+        table->symbolOffsets = malloc(table->capacity * sizeof(*table->symbolOffsets));
+    
+    if (table->addresses == NULL || table->info == NULL || (withSymbols && table->symbolOffsets == NULL)) {
+        MKFixupTableFree(table);
+        return false;
+    }
+    
+    return true;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+static bool
+MKFixupTableReserve(struct MKFixupTable *table, NSUInteger capacity)
+{
+    // The table is left intact if any of the columns can not be resized.
+    #define RESIZE(COLUMN) \
+        if (table->COLUMN) { \
+            void *column = realloc(table->COLUMN, capacity * sizeof(*table->COLUMN)); \
+            if (column == NULL) return false; \
+            table->COLUMN = column; \
+        }
+    
+    RESIZE(addresses)
+    RESIZE(info)
+    RESIZE(symbolOffsets)
+    RESIZE(addends)
+    
+    #undef RESIZE
+    
+    table->capacity = MAX(capacity, table->count);
+    return true;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+bool
+MKFixupTableAppend(struct MKFixupTable *table, mk_vm_address_t address, uint32_t info, uint32_t symbolOffset, int64_t addend)
+{
+    // Indexes are stored as 32-bit values in the address index.
+    if (table->count >= UINT32_MAX)
+        return false;
+    
+    if (table->count == table->capacity && !MKFixupTableReserve(table, table->capacity * 2))
+        return false;
+    
+    if (addend != 0 && table->addends == NULL) {
+        if ((table->addends = calloc(table->capacity, sizeof(*table->addends))) == NULL)
+            return false;
+    }
+    
+    NSUInteger index = table->count++;
+    
+    table->addresses[index] = address;
+    table->info[index] = info;
+    if (table->symbolOffsets)
+        table->symbolOffsets[index] = symbolOffset;
+    if (table->addends)
+        table->addends[index] = addend;
+    
+    return true;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+void
+MKFixupTableFinalize(struct MKFixupTable *table)
+{
+    if (table->count < table->capacity && table->count > 0)
+        MKFixupTableReserve(table, table->count);
+    
+    bool sorted = true;
+    for (NSUInteger i = 1; i < table->count && sorted; i++)
+        sorted = table->addresses[i - 1] <= table->addresses[i];
+    
+    if (sorted)
+        return;
+    
+    struct MKFixupTableSortEntry *entries = malloc(table->count * sizeof(*entries));
+    table->sortedIndexes = malloc(table->count * sizeof(*table->sortedIndexes));
+    if (entries == NULL || table->sortedIndexes == NULL) {
+        free(entries);
+        free(table->sortedIndexes); table->sortedIndexes = NULL;
+        // Lookups fall back to a linear scan.
+        table->unsorted = true;
+        return;
+    }
+    
+    for (NSUInteger i = 0; i < table->count; i++) {
+        entries[i].address = table->addresses[i];
+        entries[i].index = (uint32_t)i;
+    }
+    
+    qsort(entries, table->count, sizeof(*entries), MKFixupTableSortEntryCompare);
+    
+    for (NSUInteger i = 0; i < table->count; i++)
+        table->sortedIndexes[i] = entries[i].index;
+    
+    free(entries);
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+NSUInteger
+MKFixupTableIndexOfAddress(const struct MKFixupTable *table, mk_vm_address_t address)
+{
+    if (table->unsorted) {
+        for (NSUInteger i = 0; i < table->count; i++) {
+            if (table->addresses[i] == address)
+                return i;
+        }
+        return NSNotFound;
+    }
+    
+    #define ADDRESS_AT(I) table->addresses[table->sortedIndexes ? table->sortedIndexes[I] : (I)]
+    
+    // Find the first fixup whose address is not less than address.
+    NSUInteger lo = 0, hi = table->count;
+    while (lo < hi) {
+        NSUInteger mid = lo + (hi - lo) / 2;
+        if (ADDRESS_AT(mid) < address)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    
+    if (lo == table->count || ADDRESS_AT(lo) != address)
+        return NSNotFound;
+    
+    return table->sortedIndexes ? table->sortedIndexes[lo] : lo;
+    
+    #undef ADDRESS_AT
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+void
+MKFixupTableFree(struct MKFixupTable *table)
+{
+    free(table->sortedIndexes);
+    free(table->addends);
+    free(table->symbolOffsets);
+    free(table->info);
+    free(table->addresses);
+    
+    memset(table, 0, sizeof(*table));
+}
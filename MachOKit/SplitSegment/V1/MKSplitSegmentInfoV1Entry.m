@@ -146,7 +146,7 @@
 { return _nodeSize; }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     MKNodeFieldBuilder *opcode = [MKNodeFieldBuilder
         builderWithProperty:MK_PROPERTY(opcode)
@@ -169,7 +169,7 @@
     terminator.description = @"Terminator";
     terminator.options = MKNodeFieldOptionDisplayAsDetail | MKNodeFieldOptionMergeContainerContents;
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         opcode.build,
         offsets.build,
         terminator.build
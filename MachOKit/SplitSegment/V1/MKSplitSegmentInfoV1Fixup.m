@@ -85,7 +85,7 @@
 { return [(MKBackedNode*)self.parent nodeAddress:type]; }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     MKNodeFieldBuilder *address = [MKNodeFieldBuilder
         builderWithProperty:MK_PROPERTY(address)
@@ -108,7 +108,7 @@
     extra.description = @"Extra";
     extra.options = MKNodeFieldOptionDisplayAsDetail;
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         address.build,
         kind.build,
         extra.build
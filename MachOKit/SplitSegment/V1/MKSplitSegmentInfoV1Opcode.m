@@ -68,7 +68,7 @@
 { return sizeof(_kind); }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     MKNodeFieldBuilder *kind = [MKNodeFieldBuilder
         builderWithProperty:MK_PROPERTY(kind)
@@ -79,7 +79,7 @@
     kind.description = @"Kind";
     kind.options = MKNodeFieldOptionDisplayAsDetail;
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         kind.build
     ]];
 }
@@ -68,7 +68,7 @@
 { return sizeof(_terminatorValue); }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     MKNodeFieldBuilder *terminatorValue = [MKNodeFieldBuilder
         builderWithProperty:MK_PROPERTY(terminatorValue)
@@ -79,7 +79,7 @@
     terminatorValue.description = @"Terminator";
     terminatorValue.options = MKNodeFieldOptionDisplayAsDetail;
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         terminatorValue.build
     ]];
 }
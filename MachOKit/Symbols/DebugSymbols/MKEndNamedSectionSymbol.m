@@ -71,7 +71,7 @@
 }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     // TODO - Should we change the label to say "Length" when the value stores
     //        the named section length (see the note in the header).
@@ -83,7 +83,7 @@
     address.description = @"Address";
     address.options = MKNodeFieldOptionHidden;
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         address.build
     ]];
 }
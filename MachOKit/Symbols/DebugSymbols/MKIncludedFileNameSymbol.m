@@ -66,7 +66,7 @@
 }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     MKNodeFieldBuilder *address = [MKNodeFieldBuilder
         builderWithProperty:MK_PROPERTY(address)
@@ -75,7 +75,7 @@
     address.description = @"Address";
     address.options = MKNodeFieldOptionHidden;
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         address.build
     ]];
 }
@@ -91,7 +91,7 @@
 }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     MKNodeFieldBuilder *cpuSubType = [MKNodeFieldBuilder
         builderWithProperty:MK_PROPERTY(cpuSubType)
@@ -107,7 +107,7 @@
     modificationTime.description = @"Modification Time";
     modificationTime.options = MKNodeFieldOptionHidden;
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         cpuSubType.build,
         modificationTime.build
     ]];
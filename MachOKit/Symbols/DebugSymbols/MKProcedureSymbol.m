@@ -87,7 +87,7 @@
 }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     // TODO - Should we change the label to say "Procedure Length" when the
     //        value stores a procedure length (see the note in the header).
@@ -99,7 +99,7 @@
     address.description = @"Procedure Address";
     address.options = MKNodeFieldOptionHidden;
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         address.build
     ]];
 }
@@ -128,7 +128,7 @@
 }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     MKNodeFieldBuilder *targetName = [MKNodeFieldBuilder
         builderWithProperty:MK_PROPERTY(targetName)
@@ -137,7 +137,7 @@
     targetName.description = @"Target Symbol Name";
     targetName.options = MKNodeFieldOptionHidden | MKNodeFieldOptionIgnoreContainerContents | MKNodeFieldOptionHideAddressAndData;
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         targetName.build
     ]];
 }
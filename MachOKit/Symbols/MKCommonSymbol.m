@@ -98,7 +98,7 @@
 }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     MKNodeFieldBuilder *size = [MKNodeFieldBuilder
         builderWithProperty:MK_PROPERTY(size)
@@ -107,7 +107,7 @@
     size.description = @"Size";
     size.options = MKNodeFieldOptionHidden;
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         size.build
     ]];
 }
@@ -137,7 +137,7 @@
 { return sizeof(uint32_t); }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     MKNodeFieldBuilder *index;
     
@@ -182,13 +182,17 @@
     section.description = @"Section";
     section.options = MKNodeFieldOptionIgnoreContainerContents | MKNodeFieldOptionHideAddressAndData;
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         index.build,
         symbol.build,
         section.build
     ]];
 }
 
+//|++++++++++++++++++++++++++++++++++++|//
+- (id)layoutKey
+{ return @[super.layoutKey ?: [NSNull null], @(self.isLocal || self.isAbsolute)]; }
+
 //◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
 #pragma mark -  NSObject
 //◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
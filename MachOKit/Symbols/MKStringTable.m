@@ -53,6 +53,8 @@
     
     // Load Strings
     {
+        [self.memoryMap adviseAccessPattern:MKMemoryMapAccessPatternSequential atOffset:0 fromAddress:self.nodeContextAddress length:self.nodeSize];
+        
         NSMutableDictionary<NSNumber*, MKCString*> *strings = [NSMutableDictionary new];
         mk_vm_offset_t offset = 0;
         
@@ -136,7 +138,7 @@
 //◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     MKNodeFieldBuilder *strings = [MKNodeFieldBuilder
         builderWithProperty:MK_PROPERTY(strings)
@@ -145,7 +147,7 @@
     strings.description = @"Strings";
     strings.options = MKNodeFieldOptionDisplayAsDetail | MKNodeFieldOptionMergeContainerContents;
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         strings.build
     ]];
 }
@@ -41,6 +41,10 @@
 + (id*)_subclassesCache
 { static NSSet *subclasses; return &subclasses; }
 
+//|++++++++++++++++++++++++++++++++++++|//
++ (id*)_dispatchTableCache
+{ static id table; return &table; }
+
 //|++++++++++++++++++++++++++++++++++++|//
 + (uint32_t)canInstantiateWithEntry:(struct nlist_64)nlist
 {
@@ -51,7 +55,12 @@
 //|++++++++++++++++++++++++++++++++++++|//
 + (Class)classForEntry:(struct nlist_64)nlist
 {
-    return [self bestSubclassWithRanking:^(Class cls) {
+    // The symbol subclasses in MachOKit rank an entry by its n_type (which
+    // includes the stab type for debugging entries) and, for common
+    // symbols, whether n_value is non-zero.
+    uint32_t key = nlist.n_type | ((nlist.n_value != 0) << 8);
+    
+    return [self bestSubclassForDispatchKey:@(key) withRanking:^(Class cls) {
         return [cls canInstantiateWithEntry:nlist];
     }];
 }
@@ -68,11 +77,26 @@ bool ReadNList(struct nlist_64 *result, mk_vm_offset_t offset, MKBackedNode *nod
     MKDataModel* dataModel = node.dataModel;
     size_t pointerSize = dataModel.pointerSize;
     
-    if (pointerSize == 8)
+    // A symbol table keeps a byte swapped copy of each of its entries.
+    if ([node isKindOfClass:MKSymbolTable.class] && ((MKSymbolTable*)node)->_entries)
+    {
+        MKSymbolTable *symbolTable = (MKSymbolTable*)node;
+        mk_vm_offset_t index = offset / (pointerSize == 8 ? sizeof(struct nlist_64) : sizeof(struct nlist));
+        
+        if (index >= symbolTable->_symbolCount) {
+            MK_ERROR_OUT = [NSError mk_errorWithDomain:MKErrorDomain code:MK_EOUT_OF_RANGE description:@"Offset [%" MK_VM_PRIuOFFSET "] is beyond the end of %@.", offset, symbolTable.compactDescription];
+            return false;
+        }
+        
+        *result = symbolTable->_entries[index];
+    }
+    else if (pointerSize == 8)
     {
         struct nlist_64 entry;
-        if ([node.memoryMap copyBytesAtOffset:offset fromAddress:node.nodeContextAddress into:&entry length:sizeof(entry) requireFull:YES error:error] < sizeof(entry))
+        MKMemorySpan span = [node.memoryMap spanAtOffset:offset fromAddress:node.nodeContextAddress length:sizeof(entry) requireFull:YES error:error];
+        if (span.length < sizeof(entry))
             return false;
+        memcpy(&entry, span.bytes, sizeof(entry));
         
         result->n_un.n_strx = MKSwapLValue32(entry.n_un.n_strx, dataModel);
         result->n_type = entry.n_type;
@@ -83,8 +107,10 @@ bool ReadNList(struct nlist_64 *result, mk_vm_offset_t offset, MKBackedNode *nod
     else if (pointerSize == 4)
     {
         struct nlist entry;
-        if ([node.memoryMap copyBytesAtOffset:offset fromAddress:node.nodeContextAddress into:&entry length:sizeof(entry) requireFull:YES error:error] < sizeof(entry))
+        MKMemorySpan span = [node.memoryMap spanAtOffset:offset fromAddress:node.nodeContextAddress length:sizeof(entry) requireFull:YES error:error];
+        if (span.length < sizeof(entry))
             return false;
+        memcpy(&entry, span.bytes, sizeof(entry));
         
         result->n_un.n_strx = MKSwapLValue32(entry.n_un.n_strx, dataModel);
         result->n_type = entry.n_type;
@@ -296,9 +322,9 @@ bool ReadNList(struct nlist_64 *result, mk_vm_offset_t offset, MKBackedNode *nod
 }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         self.class._strxFieldBuilder.build,
         self.class._typeFieldBuilder.build,
         self.class._sectFieldBuilder.build,
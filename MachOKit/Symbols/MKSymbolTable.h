@@ -26,6 +26,7 @@
 //----------------------------------------------------------------------------//
 
 #include <MachOKit/macho.h>
+#include <pthread.h>
 #import <Foundation/Foundation.h>
 
 #import <MachOKit/MKLinkEditNode.h>
@@ -42,7 +43,14 @@ NS_ASSUME_NONNULL_BEGIN
 //
 @interface MKSymbolTable : MKLinkEditNode {
 @package
-    NSArray<MKSymbol*> *_symbols;
+    // The array of symbols is cached only while something else retains it,
+    // because it retains the receiver.
+    /*__weak*/ NSArray<MKSymbol*> *_symbols;
+    pthread_mutex_t _symbolsLock;
+    NSUInteger _symbolCount;
+    mk_vm_size_t _entrySize;
+    // The byte swapped entries, indexed like the symbols.
+    struct nlist_64 *_entries;
     NSRange _localSymbols;
     NSRange _externalSymbols;
     NSRange _undefinedSymbols;
@@ -54,8 +62,19 @@ NS_ASSUME_NONNULL_BEGIN
 //! An array of \ref MKSymbol instances, each corresponding to an entry in the
 //! symbol table.  The order of this array matches the ordering of the
 //! symbol structures in the Mach-O.
+//!
+//! Each symbol is instantiated when it is first accessed, and cached for
+//! as long as the returned array is alive.  Use \ref enumerateNListsUsingBlock:
+//! to visit every entry without instantiating any symbols.
 @property (nonatomic, readonly) NSArray<__kindof MKSymbol*> *symbols;
 
+//! Invokes \a block with each entry of the symbol table, in order, without
+//! instantiating any \ref MKSymbol.  As for
+//! \ref +[MKSymbol canInstantiateWithEntry:], the entries have been byte
+//! swapped and the \c n_value field has been converted to a \c uint64_t
+//! if necessary.
+- (void)enumerateNListsUsingBlock:(void (NS_NOESCAPE ^)(struct nlist_64 nlist, NSUInteger index, BOOL *stop))block;
+
 //! The range of indexes in the \ref symbols array which correspond to
 //! local symbols.  These symbols are typically included for debugging.
 @property (nonatomic, readonly) NSRange localSymbols;
@@ -31,14 +31,47 @@
 #import "MKLCSymtab.h"
 #import "MKLCDysymtab.h"
 #import "MKSymbol.h"
+#import "_MKSymbolArray.h"
+
+#import <objc/runtime.h>
 
 #include <mach-o/nlist.h>
 #include <mach-o/stab.h>
 
+//|++++++++++++++++++++++++++++++++++++|//
+static void
+MKSymbolTableCopyEntries(struct nlist_64 *entries, const uint8_t *table, NSUInteger count, bool is64, bool swap)
+{
+    if (is64 && !swap) {
+        memcpy(entries, table, count * sizeof(struct nlist_64));
+        return;
+    }
+    
+    // The table is not guaranteed to be aligned.
+    for (NSUInteger i = 0; i < count; i++) {
+        if (is64) {
+            struct nlist_64 entry;
+            memcpy(&entry, table + i * sizeof(entry), sizeof(entry));
+            entries[i].n_un.n_strx = __builtin_bswap32(entry.n_un.n_strx);
+            entries[i].n_type = entry.n_type;
+            entries[i].n_sect = entry.n_sect;
+            entries[i].n_desc = __builtin_bswap16(entry.n_desc);
+            entries[i].n_value = __builtin_bswap64(entry.n_value);
+        } else {
+            struct nlist entry;
+            memcpy(&entry, table + i * sizeof(entry), sizeof(entry));
+            entries[i].n_un.n_strx = swap ? __builtin_bswap32(entry.n_un.n_strx) : entry.n_un.n_strx;
+            entries[i].n_type = entry.n_type;
+            entries[i].n_sect = entry.n_sect;
+            entries[i].n_desc = swap ? __builtin_bswap16((uint16_t)entry.n_desc) : (uint16_t)entry.n_desc;
+            entries[i].n_value = swap ? __builtin_bswap32(entry.n_value) : entry.n_value;
+        }
+    }
+}
+
 //----------------------------------------------------------------------------//
 @implementation MKSymbolTable
 
-@synthesize symbols = _symbols;
 @synthesize localSymbols = _localSymbols;
 @synthesize externalSymbols = _externalSymbols;
 @synthesize undefinedSymbols = _undefinedSymbols;
@@ -49,6 +82,8 @@
     self = [super initWithSize:size offset:offset inImage:image error:error];
     if (self == nil) return nil;
     
+    pthread_mutex_init(&_symbolsLock, NULL);
+    
     // Find LC_DYSYMTAB
     {
         NSArray *commands = [image loadCommandsOfType:LC_DYSYMTAB];
@@ -70,37 +105,44 @@
     // A size of 0 is valid; but we don't need to do anything else.
     // TODO - What if the address/offset is 0?  Is that an error?  Does it
     // occur in valid Mach-O images?
-    if (self.nodeSize == 0) {
-        // Still need to assign a value to the symbols array.
-        _symbols = [@[] retain];
+    if (self.nodeSize == 0)
         return self;
-    }
     
-    // Load Symbols
-    @autoreleasepool
+    // Remap the table once and byte swap every entry up front.  Symbols
+    // are instantiated on demand by the array, from these entries.
     {
-        NSMutableArray<__kindof MKSymbol*> *symbols = [[NSMutableArray alloc] init];
-        mk_vm_offset_t offset = 0;
+        bool is64 = (self.dataModel.pointerSize == 8);
+        bool swap = (self.dataModel.byteOrder == &mk_byteorder_swapped);
+        mk_vm_size_t entrySize = is64 ? sizeof(struct nlist_64) : sizeof(struct nlist);
+        NSUInteger count = (NSUInteger)(self.nodeSize / entrySize);
+        __block NSError *remapError = nil;
         
-        // Cast to mk_vm_size_t is safe; nodeSize can't be larger than UINT32_MAX.
-        while ((mk_vm_size_t)offset < self.nodeSize)
-        {
-            NSError *symbolError = nil;
-            
-            MKSymbol *symbol = [MKSymbol symbolAtOffset:offset fromParent:self error:&symbolError];
-            if (symbol == nil) {
-                MK_PUSH_WARNING_WITH_ERROR(symbols, MK_EINTERNAL_ERROR, symbolError, @"Could not parse symbol at offset [%" MK_VM_PRIuOFFSET "].", offset);
-                break;
-            }
-            
-            [symbols addObject:symbol];
-            
-            // SAFE - All symbol nodes must be within the size of this node.
-            offset += symbol.nodeSize;
+        if (self.nodeSize % entrySize != 0)
+            MK_PUSH_WARNING(symbols, MK_EINVALID_DATA, @"Symbol table size [%" MK_VM_PRIuSIZE "] is not a multiple of the entry size [%" MK_VM_PRIuSIZE "].  Ignoring the trailing bytes.", self.nodeSize, entrySize);
+        
+        _entries = malloc((count ?: 1) * sizeof(struct nlist_64));
+        if (_entries == NULL) {
+            MK_PUSH_WARNING(symbols, MK_EINTERNAL_ERROR, @"Could not allocate a copy of [%lu] symbol table entries.", (unsigned long)count);
+            return self;
+        }
+        
+        [self.memoryMap adviseAccessPattern:MKMemoryMapAccessPatternSequential atOffset:0 fromAddress:self.nodeContextAddress length:count * entrySize];
+        
+        [self.memoryMap remapBytesAtOffset:0 fromAddress:self.nodeContextAddress length:count * entrySize requireFull:YES withHandler:^(vm_address_t address, vm_size_t __unused length, NSError *error) {
+            if (error) { remapError = [error retain]; return; }
+            MKSymbolTableCopyEntries(_entries, (const uint8_t*)address, count, is64, swap);
+        }];
+        
+        if (remapError) {
+            MK_PUSH_WARNING_WITH_ERROR(symbols, MK_EINTERNAL_ERROR, remapError, @"Could not map the symbol table entries.");
+            [remapError release];
+            free(_entries);
+            _entries = NULL;
+            count = 0;
         }
         
-        _symbols = [symbols copy];
-        [symbols release];
+        _symbolCount = count;
+        _entrySize = entrySize;
     }
     
     return self;
@@ -156,11 +198,50 @@
 //|++++++++++++++++++++++++++++++++++++|//
 - (void)dealloc
 {
-    [_symbols release];
+    objc_storeWeak(&_symbols, nil);
+    pthread_mutex_destroy(&_symbolsLock);
+    free(_entries);
     
     [super dealloc];
 }
 
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+#pragma mark -  Symbols
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (NSArray*)symbols
+{
+    if (_symbolCount == 0)
+        return @[];
+    
+    NSArray *symbols;
+    
+    pthread_mutex_lock(&_symbolsLock);
+    symbols = objc_loadWeak(&_symbols);
+    if (symbols == nil) {
+        symbols = [[[_MKSymbolArray alloc] initWithSymbolTable:self count:_symbolCount entrySize:_entrySize] autorelease];
+        objc_storeWeak(&_symbols, symbols);
+    }
+    pthread_mutex_unlock(&_symbolsLock);
+    
+    return symbols ?: @[];
+}
+
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+#pragma mark -  Enumerating Entries
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)enumerateNListsUsingBlock:(void (NS_NOESCAPE ^)(struct nlist_64 nlist, NSUInteger index, BOOL *stop))block
+{
+    NSUInteger count = _symbolCount;
+    BOOL stop = NO;
+    
+    for (NSUInteger i = 0; i < count && !stop; i++)
+        block(_entries[i], i, &stop);
+}
+
 //◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
 #pragma mark -  MKPointer
 //◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
@@ -168,9 +249,19 @@
 //|++++++++++++++++++++++++++++++++++++|//
 - (MKResult*)childNodeOccupyingVMAddress:(mk_vm_address_t)address targetClass:(Class)targetClass
 {
-    MKResult *child = [MKBackedNode childNodeOccupyingVMAddress:address targetClass:targetClass inSortedArray:(NSArray *)self.symbols];
-    if (child.value)
-        return child;
+    // The entries are contiguous and equally sized, so the index of the
+    // symbol occupying the address can be computed directly.
+    mk_vm_address_t vmAddress = self.nodeVMAddress;
+    
+    if (address >= vmAddress && _symbolCount > 0) {
+        mk_vm_offset_t index = (address - vmAddress) / _entrySize;
+        
+        if (index < _symbolCount) {
+            MKResult *child = [self.symbols[(NSUInteger)index] childNodeOccupyingVMAddress:address targetClass:targetClass];
+            if (child.value)
+                return child;
+        }
+    }
     
     return [super childNodeOccupyingVMAddress:address targetClass:targetClass];
 }
@@ -180,7 +271,7 @@
 //◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     MKNodeFieldBuilder *symbols = [MKNodeFieldBuilder
         builderWithProperty:MK_PROPERTY(symbols)
@@ -189,7 +280,7 @@
     symbols.description = @"Symbols";
     symbols.options = MKNodeFieldOptionDisplayAsDetail | MKNodeFieldOptionMergeContainerContents;
     
-    return [MKNodeDescription nodeDescriptionWithParentDescription:super.layout fields:@[
+    return [MKNodeDescription nodeDescriptionWithParentDescription:[super buildLayout] fields:@[
         symbols.build
     ]];
 }
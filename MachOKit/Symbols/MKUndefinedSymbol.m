@@ -138,7 +138,7 @@
 }
 
 //|++++++++++++++++++++++++++++++++++++|//
-- (MKNodeDescription*)layout
+- (MKNodeDescription*)buildLayout
 {
     MKNodeFieldBuilder *sourceLibrary = [MKNodeFieldBuilder
         builderWithProperty:MK_PROPERTY(sourceLibrary)
@@ -0,0 +1,116 @@
+//----------------------------------------------------------------------------//
+//|
+//|             MachOKit - A Lightweight Mach-O Parsing Library
+//|             _MKSymbolArray.m
+//|
+//|             D.V.
+//|             Copyright (c) 2014-2015 D.V. All rights reserved.
+//|
+//| Permission is hereby granted, free of charge, to any person obtaining a
+//| copy of this software and associated documentation files (the "Software"),
+//| to deal in the Software without restriction, including without limitation
+//| the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//| and/or sell copies of the Software, and to permit persons to whom the
+//| Software is furnished to do so, subject to the following conditions:
+//|
+//| The above copyright notice and this permission notice shall be included
+//| in all copies or substantial portions of the Software.
+//|
+//| THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//| OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//| MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//| IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//| CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//| TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//| SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//----------------------------------------------------------------------------//
+
+
+#import "_MKSymbolArray.h"
+#import "MKInternal.h"
+#import "MKSymbol.h"
+#import "MKSymbolTable.h"
+
+//----------------------------------------------------------------------------//
+@implementation _MKSymbolArray
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (instancetype)initWithSymbolTable:(MKSymbolTable*)symbolTable count:(NSUInteger)count entrySize:(mk_vm_size_t)entrySize
+{
+    self = [super init];
+    if (self == nil) return nil;
+    
+    _symbols = calloc(count ?: 1, sizeof(*_symbols));
+    if (_symbols == NULL) {
+        [self release]; return nil;
+    }
+    
+    _symbolTable = [symbolTable retain];
+    _count = count;
+    _entrySize = entrySize;
+    pthread_mutex_init(&_lock, NULL);
+    
+    return self;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (void)dealloc
+{
+    // -init may have failed before allocating the symbols.
+    if (_symbols) {
+        for (NSUInteger i = 0; i < _count; i++)
+            [_symbols[i] release];
+        
+        free(_symbols);
+        pthread_mutex_destroy(&_lock);
+    }
+    
+    [_symbolTable release];
+    
+    [super dealloc];
+}
+
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+#pragma mark -  NSArray
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (NSUInteger)count
+{ return _count; }
+
+//|++++++++++++++++++++++++++++++++++++|//
+- (MKSymbol*)objectAtIndex:(NSUInteger)index
+{
+    if (index >= _count) {
+        NSString *reason = [NSString stringWithFormat:@"Index [%lu] is beyond the bounds of the symbol table [0 .. %lu).", (unsigned long)index, (unsigned long)_count];
+        @throw [NSException exceptionWithName:NSRangeException reason:reason userInfo:nil];
+    }
+    
+    MKSymbol *symbol;
+    
+    pthread_mutex_lock(&_lock);
+    symbol = _symbols[index];
+    pthread_mutex_unlock(&_lock);
+    
+    if (symbol)
+        return symbol;
+    
+    // The symbol is instantiated outside of the lock.  If another thread
+    // wins the race, its instance is returned instead.
+    NSError *symbolError = nil;
+    MKSymbol *newSymbol = [MKSymbol symbolAtOffset:(mk_vm_offset_t)(index * _entrySize) fromParent:_symbolTable error:&symbolError];
+    if (newSymbol == nil)
+        newSymbol = [MKSymbol placeholderAtOffset:(mk_vm_offset_t)(index * _entrySize) fromParent:_symbolTable error:symbolError];
+    
+    pthread_mutex_lock(&_lock);
+    symbol = _symbols[index];
+    if (symbol == nil) {
+        _symbols[index] = [newSymbol retain];
+        symbol = newSymbol;
+    }
+    pthread_mutex_unlock(&_lock);
+    
+    return symbol;
+}
+
+@end
@@ -0,0 +1,234 @@
+//----------------------------------------------------------------------------//
+//|
+//|             MachOKit - A Lightweight Mach-O Parsing Library
+//|             MKImageInventorySpec.m
+//|
+//|             D.V.
+//|             Copyright (c) 2014-2015 D.V. All rights reserved.
+//|
+//| Permission is hereby granted, free of charge, to any person obtaining a
+//| copy of this software and associated documentation files (the "Software"),
+//| to deal in the Software without restriction, including without limitation
+//| the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//| and/or sell copies of the Software, and to permit persons to whom the
+//| Software is furnished to do so, subject to the following conditions:
+//|
+//| The above copyright notice and this permission notice shall be included
+//| in all copies or substantial portions of the Software.
+//|
+//| THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//| OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//| MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//| IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//| CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//| TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//| SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//----------------------------------------------------------------------------//
+
+
+#include <mach-o/fat.h>
+
+//|++++++++++++++++++++++++++++++++++++|//
+//! Returns a minimal 64-bit image with a single LC_UUID load command.
+static NSData*
+MKImageInventorySpecImage(uint8_t uuidByte)
+{
+    struct {
+        struct mach_header_64 header;
+        struct uuid_command uuid;
+    } image;
+    memset(&image, 0, sizeof(image));
+    
+    image.header.magic = MH_MAGIC_64;
+    image.header.cputype = CPU_TYPE_X86_64;
+    image.header.cpusubtype = CPU_SUBTYPE_X86_64_ALL;
+    image.header.filetype = MH_DYLIB;
+    image.header.ncmds = 1;
+    image.header.sizeofcmds = sizeof(image.uuid);
+    image.uuid.cmd = LC_UUID;
+    image.uuid.cmdsize = sizeof(image.uuid);
+    memset(image.uuid.uuid, uuidByte, sizeof(image.uuid.uuid));
+    
+    return [NSData dataWithBytes:&image length:sizeof(image)];
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+//! Writes \a data to a new file in the temporary directory.
+static NSURL*
+MKImageInventorySpecWrite(NSData *data)
+{
+    NSURL *url = [NSURL fileURLWithPath:[NSTemporaryDirectory() stringByAppendingPathComponent:NSUUID.UUID.UUIDString]];
+    [data writeToURL:url atomically:YES];
+    return url;
+}
+
+SpecBegin(MKImageInventory)
+
+describe(@"summarizing a file", ^{
+    NSData *slice0 = MKImageInventorySpecImage(0x11);
+    NSData *slice1 = MKImageInventorySpecImage(0x22);
+    
+    __block NSMutableArray<NSNumber*> *sliceIndexes;
+    __block NSMutableArray<NSNumber*> *uuidBytes;
+    MKImageInventoryHandler handler = ^(__unused NSURL *fileURL, uint32_t sliceIndex, const mk_macho_summary_t *summary) {
+        [sliceIndexes addObject:@(sliceIndex)];
+        [uuidBytes addObject:@(summary->has_uuid ? summary->uuid[0] : 0)];
+    };
+    
+    beforeEach(^{
+        sliceIndexes = [NSMutableArray array];
+        uuidBytes = [NSMutableArray array];
+    });
+    
+    it(@"should summarize a thin image", ^{
+        NSURL *url = MKImageInventorySpecWrite(slice0);
+        NSError *error = nil;
+        
+        expect([MKImageInventory summarizeFileAtURL:url withHandler:handler error:&error]).to.beTruthy();
+        expect(error).to.beNil();
+        expect(sliceIndexes).to.equal(@[@0]);
+        expect(uuidBytes).to.equal(@[@0x11]);
+        
+        [NSFileManager.defaultManager removeItemAtURL:url error:NULL];
+    });
+    
+    it(@"should summarize each slice of a FAT_MAGIC binary", ^{
+        NSMutableData *data = [NSMutableData data];
+        struct fat_header header = { OSSwapHostToBigInt32(FAT_MAGIC), OSSwapHostToBigInt32(2) };
+        struct fat_arch arches[2] = {
+            { OSSwapHostToBigInt32(CPU_TYPE_X86_64), 0, OSSwapHostToBigInt32(4096), OSSwapHostToBigInt32((uint32_t)slice0.length), OSSwapHostToBigInt32(12) },
+            { OSSwapHostToBigInt32(CPU_TYPE_X86_64), 0, OSSwapHostToBigInt32(8192), OSSwapHostToBigInt32((uint32_t)slice1.length), OSSwapHostToBigInt32(12) }
+        };
+        [data appendBytes:&header length:sizeof(header)];
+        [data appendBytes:arches length:sizeof(arches)];
+        data.length = 4096; [data appendData:slice0];
+        data.length = 8192; [data appendData:slice1];
+        
+        NSURL *url = MKImageInventorySpecWrite(data);
+        
+        expect([MKImageInventory summarizeFileAtURL:url withHandler:handler error:NULL]).to.beTruthy();
+        expect(sliceIndexes).to.equal(@[@0, @1]);
+        expect(uuidBytes).to.equal(@[@0x11, @0x22]);
+        
+        [NSFileManager.defaultManager removeItemAtURL:url error:NULL];
+    });
+    
+    it(@"should summarize each slice of a FAT_MAGIC_64 binary", ^{
+        NSMutableData *data = [NSMutableData data];
+        struct fat_header header = { OSSwapHostToBigInt32(FAT_MAGIC_64), OSSwapHostToBigInt32(2) };
+        struct fat_arch_64 arches[2] = {
+            { OSSwapHostToBigInt32(CPU_TYPE_X86_64), 0, OSSwapHostToBigInt64(4096), OSSwapHostToBigInt64(slice0.length), OSSwapHostToBigInt32(12), 0 },
+            { OSSwapHostToBigInt32(CPU_TYPE_X86_64), 0, OSSwapHostToBigInt64(8192), OSSwapHostToBigInt64(slice1.length), OSSwapHostToBigInt32(12), 0 }
+        };
+        [data appendBytes:&header length:sizeof(header)];
+        [data appendBytes:arches length:sizeof(arches)];
+        data.length = 4096; [data appendData:slice0];
+        data.length = 8192; [data appendData:slice1];
+        
+        NSURL *url = MKImageInventorySpecWrite(data);
+        
+        expect([MKImageInventory summarizeFileAtURL:url withHandler:handler error:NULL]).to.beTruthy();
+        expect(sliceIndexes).to.equal(@[@0, @1]);
+        expect(uuidBytes).to.equal(@[@0x11, @0x22]);
+        
+        [NSFileManager.defaultManager removeItemAtURL:url error:NULL];
+    });
+    
+    it(@"should skip a FAT header whose architectures do not fit in the file", ^{
+        NSMutableData *data = [NSMutableData data];
+        struct fat_header header = { OSSwapHostToBigInt32(FAT_MAGIC), OSSwapHostToBigInt32(UINT32_MAX) };
+        [data appendBytes:&header length:sizeof(header)];
+        [data appendData:slice0];
+        
+        NSURL *url = MKImageInventorySpecWrite(data);
+        NSError *error = nil;
+        
+        expect([MKImageInventory summarizeFileAtURL:url withHandler:handler error:&error]).to.beTruthy();
+        expect(error).to.beNil();
+        expect(sliceIndexes).to.haveCountOf(0);
+        
+        [NSFileManager.defaultManager removeItemAtURL:url error:NULL];
+    });
+    
+    it(@"should skip an image whose load commands extend past the end of the file", ^{
+        NSMutableData *data = [slice0 mutableCopy];
+        ((struct mach_header_64*)data.mutableBytes)->sizeofcmds = UINT32_MAX - sizeof(struct mach_header_64);
+        
+        NSURL *url = MKImageInventorySpecWrite(data);
+        NSError *error = nil;
+        
+        expect([MKImageInventory summarizeFileAtURL:url withHandler:handler error:&error]).to.beTruthy();
+        expect(error).to.beNil();
+        expect(sliceIndexes).to.haveCountOf(0);
+        
+        [NSFileManager.defaultManager removeItemAtURL:url error:NULL];
+        [data release];
+    });
+    
+    it(@"should report the magic of a byte-swapped image in host byte order", ^{
+        NSMutableData *data = [slice0 mutableCopy];
+        uint32_t *words = data.mutableBytes;
+        // The header and the LC_UUID command header are all 32-bit words.
+        for (NSUInteger i = 0; i < (sizeof(struct mach_header_64) + 8) / sizeof(uint32_t); i++)
+            words[i] = OSSwapInt32(words[i]);
+        
+        NSURL *url = MKImageInventorySpecWrite(data);
+        __block uint32_t magic = 0;
+        __block cpu_type_t cputype = 0;
+        
+        expect([MKImageInventory summarizeFileAtURL:url withHandler:^(__unused NSURL *fileURL, __unused uint32_t sliceIndex, const mk_macho_summary_t *summary) {
+            magic = summary->magic;
+            cputype = summary->cputype;
+        } error:NULL]).to.beTruthy();
+        expect(magic).to.equal(MH_MAGIC_64);
+        expect(cputype).to.equal(CPU_TYPE_X86_64);
+        
+        [NSFileManager.defaultManager removeItemAtURL:url error:NULL];
+        [data release];
+    });
+    
+    it(@"should skip files that are not Mach-O images", ^{
+        NSURL *url = MKImageInventorySpecWrite([@"Not a Mach-O image" dataUsingEncoding:NSUTF8StringEncoding]);
+        
+        expect([MKImageInventory summarizeFileAtURL:url withHandler:handler error:NULL]).to.beTruthy();
+        expect(sliceIndexes).to.haveCountOf(0);
+        
+        [NSFileManager.defaultManager removeItemAtURL:url error:NULL];
+    });
+    
+    it(@"should fail for a missing file", ^{
+        NSURL *url = [NSURL fileURLWithPath:[NSTemporaryDirectory() stringByAppendingPathComponent:NSUUID.UUID.UUIDString]];
+        NSError *error = nil;
+        
+        expect([MKImageInventory summarizeFileAtURL:url withHandler:handler error:&error]).to.beFalsy();
+        expect(error).toNot.beNil();
+        expect(sliceIndexes).to.haveCountOf(0);
+    });
+});
+
+describe(@"scanning a directory", ^{
+    it(@"should summarize every image in the directory", ^{
+        NSURL *directoryURL = [NSURL fileURLWithPath:[NSTemporaryDirectory() stringByAppendingPathComponent:NSUUID.UUID.UUIDString]];
+        [NSFileManager.defaultManager createDirectoryAtURL:[directoryURL URLByAppendingPathComponent:@"Nested"] withIntermediateDirectories:YES attributes:nil error:NULL];
+        
+        [MKImageInventorySpecImage(0x11) writeToURL:[directoryURL URLByAppendingPathComponent:@"a"] atomically:YES];
+        [MKImageInventorySpecImage(0x22) writeToURL:[directoryURL URLByAppendingPathComponent:@"Nested/b"] atomically:YES];
+        [[@"Not a Mach-O image" dataUsingEncoding:NSUTF8StringEncoding] writeToURL:[directoryURL URLByAppendingPathComponent:@"c"] atomically:YES];
+        
+        NSMutableSet<NSNumber*> *uuidBytes = [NSMutableSet set];
+        __block NSUInteger errorCount = 0;
+        
+        [MKImageInventory scanDirectoryAtURL:directoryURL maxConcurrentFiles:2 withHandler:^(__unused NSURL *fileURL, __unused uint32_t sliceIndex, const mk_macho_summary_t *summary) {
+            @synchronized (uuidBytes) { [uuidBytes addObject:@(summary->uuid[0])]; }
+        } errorHandler:^(__unused NSURL *fileURL, __unused NSError *error) {
+            @synchronized (uuidBytes) { errorCount++; }
+        }];
+        
+        expect(uuidBytes).to.equal([NSSet setWithObjects:@0x11, @0x22, nil]);
+        expect(errorCount).to.equal(0);
+        
+        [NSFileManager.defaultManager removeItemAtURL:directoryURL error:NULL];
+    });
+});
+
+SpecEnd
@@ -27,6 +27,93 @@
 
 #import <mach-o/dyld.h>
 
+//! Builds an arm64e executable whose binding info only contains threaded
+//! binds and rebases.  The first chain starts at offset 0x10 of __DATA and
+//! crosses a page boundary; the second holds a single rebase.
+static NSData* MKMachOSpecThreadedBindImage(void)
+{
+    const uint32_t dataFileOffset = 0x4000;
+    const uint32_t linkeditFileOffset = 0xC000;
+    NSMutableData *image = [NSMutableData dataWithLength:linkeditFileOffset + 0x100];
+    uint8_t *bytes = image.mutableBytes;
+    
+    // Binding info
+    const uint8_t bindInfo[] = {
+        BIND_OPCODE_THREADED | BIND_SUBOPCODE_THREADED_SET_BIND_ORDINAL_TABLE_SIZE_ULEB, 2,
+        BIND_OPCODE_SET_DYLIB_ORDINAL_IMM | 1,
+        BIND_OPCODE_SET_SYMBOL_TRAILING_FLAGS_IMM, '_', 'f', 'o', 'o', 0,
+        BIND_OPCODE_SET_TYPE_IMM | BIND_TYPE_POINTER,
+        BIND_OPCODE_DO_BIND,
+        BIND_OPCODE_SET_SYMBOL_TRAILING_FLAGS_IMM | BIND_SYMBOL_FLAGS_WEAK_IMPORT, '_', 'b', 'a', 'r', 0,
+        BIND_OPCODE_SET_ADDEND_SLEB, 16,
+        BIND_OPCODE_DO_BIND,
+        BIND_OPCODE_SET_SEGMENT_AND_OFFSET_ULEB | 1, 0x10,
+        BIND_OPCODE_THREADED | BIND_SUBOPCODE_THREADED_APPLY,
+        BIND_OPCODE_SET_SEGMENT_AND_OFFSET_ULEB | 1, 0x80, 0xC0, 0x01,
+        BIND_OPCODE_THREADED | BIND_SUBOPCODE_THREADED_APPLY,
+        BIND_OPCODE_DONE
+    };
+    memcpy(bytes + linkeditFileOffset, bindInfo, sizeof(bindInfo));
+    
+    // The chained pointers.  Bit 62 selects a bind, bits [51..61] hold the
+    // distance to the next element in pointer sized units and bits [0..15]
+    // hold the ordinal of a bind.
+    uint64_t *data = (uint64_t*)(bytes + dataFileOffset);
+    data[0x10/8] = (0x7FDULL << 51) | 0x1234;
+    data[0x3FF8/8] = (1ULL << 62) | (3ULL << 51) | 0;
+    data[0x4010/8] = (1ULL << 62) | (2ULL << 51) | 1;
+    data[0x4020/8] = 0x5678;
+    data[0x6000/8] = 0x9ABC;
+    
+    // Load commands
+    struct mach_header_64 *header = (struct mach_header_64*)bytes;
+    header->magic = MH_MAGIC_64;
+    header->cputype = CPU_TYPE_ARM64;
+    header->cpusubtype = CPU_SUBTYPE_ARM64E;
+    header->filetype = MH_EXECUTE;
+    header->flags = MH_DYLDLINK | MH_PIE;
+    
+    uint8_t *lc = bytes + sizeof(*header);
+    const struct { const char *name; uint64_t vmaddr; uint64_t vmsize; uint64_t fileoff; uint64_t filesize; } segments[] = {
+        { SEG_TEXT, 0x100000000, 0x4000, 0, dataFileOffset },
+        { SEG_DATA, 0x100004000, 0x8000, dataFileOffset, 0x8000 },
+        { SEG_LINKEDIT, 0x10000C000, 0x4000, linkeditFileOffset, 0x100 }
+    };
+    for (size_t i = 0; i < sizeof(segments)/sizeof(*segments); i++) {
+        struct segment_command_64 *segment = (struct segment_command_64*)lc;
+        segment->cmd = LC_SEGMENT_64;
+        segment->cmdsize = sizeof(*segment);
+        strncpy(segment->segname, segments[i].name, sizeof(segment->segname));
+        segment->vmaddr = segments[i].vmaddr;
+        segment->vmsize = segments[i].vmsize;
+        segment->fileoff = segments[i].fileoff;
+        segment->filesize = segments[i].filesize;
+        segment->maxprot = segment->initprot = (i == 1) ? (VM_PROT_READ | VM_PROT_WRITE) : VM_PROT_READ;
+        lc += segment->cmdsize;
+        header->ncmds++;
+    }
+    
+    const char *dylibName = "/usr/lib/libSystem.B.dylib";
+    struct dylib_command *dylib = (struct dylib_command*)lc;
+    dylib->cmd = LC_LOAD_DYLIB;
+    dylib->cmdsize = (uint32_t)(sizeof(*dylib) + 32);
+    dylib->dylib.name.offset = sizeof(*dylib);
+    strcpy((char*)lc + sizeof(*dylib), dylibName);
+    lc += dylib->cmdsize;
+    header->ncmds++;
+    
+    struct dyld_info_command *dyldInfo = (struct dyld_info_command*)lc;
+    dyldInfo->cmd = LC_DYLD_INFO_ONLY;
+    dyldInfo->cmdsize = sizeof(*dyldInfo);
+    dyldInfo->bind_off = linkeditFileOffset;
+    dyldInfo->bind_size = sizeof(bindInfo);
+    lc += dyldInfo->cmdsize;
+    header->ncmds++;
+    
+    header->sizeofcmds = (uint32_t)(lc - bytes - sizeof(*header));
+    return image;
+}
+
 SpecBegin(MKMachOImage)
 @autoreleasepool {
     NSArray *frameworks = [NSFileManager allExecutableURLs:MKFrameworkTypeAll];
@@ -202,6 +289,32 @@ SpecBegin(MKMachOImage)
                 });
             });
             
+            // The compact action table must agree with the instantiated actions.
+            void (^checkActionTable)(MKBindingsInfo*) = ^(MKBindingsInfo *bindingsInfo) {
+                it(@"should have a matching action table", ^{
+                    NSArray *actions = bindingsInfo.actions;
+                    expect(bindingsInfo.actionCount).to.equal(actions.count);
+                    
+                    for (NSUInteger i=0; i<MIN(actions.count, bindingsInfo.actionCount); i++) {
+                        MKBindAction *action = actions[i];
+                        
+                        expect([bindingsInfo addressOfActionAtIndex:i]).to.equal(action.address);
+                        expect([bindingsInfo typeOfActionAtIndex:i]).to.equal(action.type);
+                        if ([action isKindOfClass:MKBindActionBind.class]) {
+                            MKBindActionBind *binding = (MKBindActionBind*)action;
+                            expect([bindingsInfo symbolNameOfActionAtIndex:i]).to.equal(binding.symbolName);
+                            expect([bindingsInfo libraryOrdinalOfActionAtIndex:i]).to.equal(binding.sourceLibraryOrdinal);
+                            expect([bindingsInfo symbolFlagsOfActionAtIndex:i]).to.equal(binding.symbolFlags);
+                            expect([bindingsInfo addendOfActionAtIndex:i]).to.equal(binding.addend);
+                        }
+                        
+                        NSUInteger index = [bindingsInfo indexOfActionAtAddress:action.address];
+                        expect(index).to.beLessThanOrEqualTo(i);
+                        expect([bindingsInfo addressOfActionAtIndex:index]).to.equal(action.address);
+                    }
+                });
+            };
+            
             //----------------------------------------------------------------//
             describe(@"rebase commands", ^{
                 NSArray<NSString*> *dyldInfoRebaseCommands = otoolArchitecture.rebaseCommands;
@@ -248,6 +361,20 @@ SpecBegin(MKMachOImage)
                             expect([NSString stringWithFormat:@"0x%.8" MK_VM_PRIXADDR "", fixup.address]).to.equal(dyldInfoRebaseFixups[i][@"address"]);
                         }
                     });
+                    
+                    it(@"should have a matching fixup table", ^{
+                        expect(machoRebaseInfo.fixupCount).to.equal(machoRebaseFixups.count);
+                        
+                        for (NSUInteger i=0; i<MIN(machoRebaseFixups.count, machoRebaseInfo.fixupCount); i++) {
+                            MKFixup *fixup = machoRebaseFixups[i];
+                            
+                            expect([machoRebaseInfo addressOfFixupAtIndex:i]).to.equal(fixup.address);
+                            expect([machoRebaseInfo typeOfFixupAtIndex:i]).to.equal(fixup.type);
+                            expect([machoRebaseInfo fixupAtAddress:fixup.address].address).to.equal(fixup.address);
+                        }
+                        
+                        expect([machoRebaseInfo indexOfFixupAtAddress:0]).to.equal(NSNotFound);
+                    });
                 }
                 else if (dyldInfoRebaseCommands.count == 0 && dyldInfoRebaseFixups != 0)
                 {
@@ -296,6 +423,8 @@ SpecBegin(MKMachOImage)
                     expect(machoBindInfo.warnings).to.equal(@[]);
                 });
                 
+                checkActionTable(machoBindInfo);
+                
                 it(@"should have the correct number of bind commands", ^{
                     expect(machoBindCommands.count).to.equal(dyldInfoBindCommands.count);
                 });
@@ -349,6 +478,8 @@ SpecBegin(MKMachOImage)
                     expect(machoWeakBindInfo.warnings).to.equal(@[]);
                 });
                 
+                checkActionTable(machoWeakBindInfo);
+                
                 it(@"should have the correct number of commands", ^{
                     expect(machoWeakBindCommands.count).to.equal(dyldInfoWeakBindCommands.count);
                 });
@@ -401,6 +532,8 @@ SpecBegin(MKMachOImage)
                     expect(machoLazyBindInfo.warnings).to.equal(@[]);
                 });
                 
+                checkActionTable(machoLazyBindInfo);
+                
                 it(@"should have the correct number of commands", ^{
                     expect(machoLazyBindCommands.count).to.equal(dyldInfoLazyBindCommands.count);
                 });
@@ -446,6 +579,10 @@ SpecBegin(MKMachOImage)
                     expect(machoExports).toNot.beNil();
                 });
                 
+                it(@"should not parse the trie nodes until they are requested", ^{
+                    expect([machoExportsInfo valueForKey:@"_nodes"]).to.beNil();
+                });
+                
                 it(@"should have the correct number of exports", ^{
                     expect(machoExports.count).to.equal(dyldInfoExports.count);
                 });
@@ -458,6 +595,75 @@ SpecBegin(MKMachOImage)
                     }
                 });
                 
+                it(@"should have an export for each terminal trie node", ^{
+                    NSMutableSet<NSNumber*> *terminalAddresses = [NSMutableSet set];
+                    for (MKExportTrieNode *node in machoExportsInfo.nodes) {
+                        if ([node isKindOfClass:MKExportTrieTerminalNode.class])
+                            [terminalAddresses addObject:@(node.nodeContextAddress)];
+                    }
+                    
+                    expect(terminalAddresses.count).to.equal(machoExports.count);
+                    for (MKExport *export in machoExports)
+                        expect([terminalAddresses containsObject:@(export.nodeContextAddress)]).to.beTruthy();
+                });
+                
+                it(@"should find each export by name", ^{
+                    for (MKExport *export in machoExports) {
+                        MKExport *found = [machoExportsInfo exportForName:export.name];
+                        expect(found).toNot.beNil();
+                        expect(found.class).to.equal(export.class);
+                        expect(found.nodeVMAddress).to.equal(export.nodeVMAddress);
+                        expect(found.description).to.equal(export.description);
+                        expect([machoExportsInfo exportForName:export.name]).to.beIdenticalTo(found);
+                    }
+                });
+                
+                it(@"should not find names that are not exported", ^{
+                    for (MKExport *export in machoExports)
+                        expect([machoExportsInfo exportForName:[export.name stringByAppendingString:@"$MKNotExported"]]).to.beNil();
+                    expect([machoExportsInfo exportForName:@""]).to.beNil();
+                });
+                
+                it(@"should find the exports for a list of names", ^{
+                    MKExportsInfo *exportsInfo = [[MKExportsInfo alloc] initWithImage:macho error:nil];
+                    NSMutableArray<NSString*> *names = [NSMutableArray array];
+                    for (MKExport *export in machoExports) {
+                        [names addObject:export.name];
+                        [names addObject:[export.name stringByAppendingString:@"$MKNotExported"]];
+                    }
+                    
+                    NSDictionary<NSString*, MKExport*> *found = [exportsInfo exportsForNames:names];
+                    expect(found.count).to.equal([NSSet setWithArray:[machoExports valueForKey:@"name"]].count);
+                    for (MKExport *export in machoExports)
+                        expect(found[export.name]).to.beIdenticalTo([exportsInfo exportForName:export.name]);
+                    
+                    [exportsInfo release];
+                });
+                
+                it(@"should build the exports once when accessed concurrently", ^{
+                    MKExportsInfo *exportsInfo = [[MKExportsInfo alloc] initWithImage:macho error:nil];
+                    NSArray *warnings = exportsInfo.warnings;
+                    NSMutableArray *exportsResults = [NSMutableArray array];
+                    NSMutableArray *nodesResults = [NSMutableArray array];
+                    
+                    dispatch_apply(8, dispatch_get_global_queue(QOS_CLASS_DEFAULT, 0), ^(size_t i) {
+                        NSArray *result = (i % 2) ? exportsInfo.exports : exportsInfo.nodes;
+                        @synchronized (exportsResults) { [(i % 2) ? exportsResults : nodesResults addObject:result]; }
+                    });
+                    
+                    for (NSArray *result in exportsResults)
+                        expect(result).to.beIdenticalTo(exportsResults.firstObject);
+                    for (NSArray *result in nodesResults)
+                        expect(result).to.beIdenticalTo(nodesResults.firstObject);
+                    expect([exportsResults.firstObject count]).to.equal(machoExports.count);
+                    
+                    // The trie was validated when the exports info was
+                    // initialized.  Walking it again adds no warnings.
+                    NSArray *nodeWarnings = [exportsInfo.warnings filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"NOT (self IN %@)", warnings]];
+                    for (NSError *warning in nodeWarnings)
+                        expect(warning.userInfo[MKPropertyKey]).toNot.equal(@"exports");
+                });
+                
                 // -childNodeOccupyingVMAddress:targetClass:inSortedArray: relies
                 // on entires being sorted.
                 it(@"should sort the entires by address", ^{
@@ -496,6 +702,57 @@ SpecBegin(MKMachOImage)
                         expect(function.thumb).to.equal(dyldFunctionStarts[i][@"thumb"]);
                     }
                 });
+                
+                it(@"should look up the containing function", ^{
+                    expect(machoFunctionStarts.functionCount).to.equal(machoFunctions.count);
+                    
+                    NSUInteger count = machoFunctions.count;
+                    mk_vm_address_t *addresses = malloc((count * 2 + 1) * sizeof(*addresses));
+                    NSUInteger *indexes = malloc((count * 2 + 1) * sizeof(*indexes));
+                    
+                    for (NSUInteger i=0; i<count; i++) {
+                        MKFunction *function = machoFunctions[i];
+                        mk_vm_address_t address = function.address;
+                        
+                        expect([machoFunctionStarts addressOfFunctionAtIndex:i]).to.equal(address);
+                        expect([machoFunctionStarts indexOfFunctionContainingAddress:address]).to.equal(i);
+                        expect([machoFunctionStarts functionContainingAddress:address]).to.beIdenticalTo(function);
+                        
+                        // Functions are at least one byte long.
+                        if (i + 1 == count || [machoFunctionStarts addressOfFunctionAtIndex:i + 1] > address + 1)
+                            expect([machoFunctionStarts indexOfFunctionContainingAddress:address + 1]).to.equal(i);
+                        
+                        addresses[i * 2] = address;
+                        addresses[i * 2 + 1] = address + 1;
+                    }
+                    
+                    if (count > 0)
+                        expect([machoFunctionStarts indexOfFunctionContainingAddress:[machoFunctionStarts addressOfFunctionAtIndex:0] - 1]).to.equal(NSNotFound);
+                    
+                    // Trailing out of order address forces a restart of the search.
+                    addresses[count * 2] = count ? addresses[0] : 0;
+                    
+                    [machoFunctionStarts getIndexes:indexes ofFunctionsContainingAddresses:addresses count:count * 2 + 1];
+                    for (NSUInteger i=0; i<count * 2 + 1; i++)
+                        expect(indexes[i]).to.equal([machoFunctionStarts indexOfFunctionContainingAddress:addresses[i]]);
+                    
+                    free(indexes);
+                    free(addresses);
+                });
+                
+                it(@"should look up a function without instantiating the others", ^{
+                    MKFunctionStarts *functionStarts = [[MKFunctionStarts alloc] initWithImage:macho error:nil];
+                    
+                    for (NSUInteger i=0; i<machoFunctions.count; i++) {
+                        MKFunction *function = [functionStarts functionContainingAddress:machoFunctions[i].address];
+                        
+                        expect(function.address).to.equal(machoFunctions[i].address);
+                        expect(function.thumb).to.equal(machoFunctions[i].thumb);
+                    }
+                    
+                    expect([functionStarts valueForKey:@"_functions"]).to.beNil();
+                    expect([functionStarts valueForKey:@"_offsets"]).to.beNil();
+                });
             });
             
             //----------------------------------------------------------------//
@@ -538,6 +795,168 @@ SpecBegin(MKMachOImage)
                 });
             });
 
+            //----------------------------------------------------------------//
+            describe(@"cstrings", ^{
+                NSMutableArray<MKCStringSection*> *machoCStringSections = [NSMutableArray array];
+                for (MKSection *section in macho.sections.allValues) {
+                    if ([section isKindOfClass:MKCStringSection.class])
+                        [machoCStringSections addObject:(MKCStringSection*)section];
+                }
+                
+                it(@"should cover each section with strings", ^{
+                    for (MKCStringSection *section in machoCStringSections) {
+                        mk_vm_address_t address = section.nodeVMAddress;
+                        for (MKCString *string in section.strings) {
+                            expect(string.nodeVMAddress).to.equal(address);
+                            expect(string.nodeSize).to.beGreaterThan(0);
+                            address += string.nodeSize;
+                        }
+                        expect(address).to.equal(section.nodeVMAddress + section.nodeSize);
+                    }
+                });
+                
+                it(@"should find the string at each address", ^{
+                    for (MKCStringSection *section in machoCStringSections) {
+                        expect([section stringAtAddress:section.nodeVMAddress - 1]).to.beNil();
+                        expect([section stringAtAddress:section.nodeVMAddress + section.nodeSize]).to.beNil();
+                        
+                        for (MKCString *string in section.strings) {
+                            expect([section stringAtAddress:string.nodeVMAddress]).to.beIdenticalTo(string);
+                            expect([section stringAtAddress:string.nodeVMAddress + string.nodeSize - 1]).to.beIdenticalTo(string);
+                            expect([section childNodeOccupyingVMAddress:string.nodeVMAddress targetClass:MKCString.class].value).to.beIdenticalTo(string);
+                        }
+                    }
+                });
+                
+                it(@"should not keep strings that are no longer used", ^{
+                    for (MKCStringSection *section in machoCStringSections) {
+                        if (section.strings.count == 0) continue;
+                        
+                        __weak MKCString *weakString;
+                        @autoreleasepool {
+                            weakString = section.strings[0];
+                            expect(section.strings[0]).to.beIdenticalTo(weakString);
+                        }
+                        expect(weakString).to.beNil();
+                    }
+                });
+            });
+
+            //----------------------------------------------------------------//
+            describe(@"pointer lists", ^{
+                NSMutableArray<MKPointerListSection*> *machoPointerListSections = [NSMutableArray array];
+                for (MKSection *section in macho.sections.allValues) {
+                    if ([section isKindOfClass:MKPointerListSection.class])
+                        [machoPointerListSections addObject:(MKPointerListSection*)section];
+                }
+                
+                it(@"should decode the same addresses as the pointer nodes", ^{
+                    for (MKPointerListSection *section in machoPointerListSections) {
+                        NSArray<MKPointerNode*> *elements = section.elements;
+                        mk_vm_size_t pointerSize = section.dataModel.pointerSize;
+                        expect(elements.count).to.equal(section.nodeSize / pointerSize);
+                        
+                        __block NSUInteger count = 0;
+                        [section enumerateAddressesUsingBlock:^(mk_vm_address_t address, NSUInteger index, __unused BOOL *stop) {
+                            MKPointerNode *element = elements[index];
+                            expect(address).to.equal(element.address);
+                            expect(element.nodeVMAddress).to.equal(section.nodeVMAddress + index * pointerSize);
+                            
+                            NSError *error = nil;
+                            MKPointerNode *pointer = [[MKPointerNode alloc] initWithOffset:index * pointerSize fromParent:section targetClass:element.targetClass error:&error];
+                            expect(pointer.address).to.equal(address);
+                            count++;
+                        }];
+                        expect(count).to.equal(elements.count);
+                    }
+                });
+                
+                it(@"should find the pointer at each address", ^{
+                    for (MKPointerListSection *section in machoPointerListSections) {
+                        for (MKPointerNode *element in section.elements)
+                            expect([section childNodeOccupyingVMAddress:element.nodeVMAddress targetClass:MKPointerNode.class].value).to.beIdenticalTo(element);
+                    }
+                });
+            });
+            
+            //----------------------------------------------------------------//
+            describe(@"objc index", ^{
+                MKObjCIndex *objcIndex = macho.objcIndex.value;
+                
+                it(@"should exist", ^{
+                    expect(objcIndex).toNot.beNil();
+                });
+                
+                it(@"should find each listed class and metaclass by name", ^{
+                    for (MKSection *section in macho.sections.allValues) {
+                        if (![section isKindOfClass:MKObjCClassListSection.class])
+                            continue;
+                        
+                        for (MKPointerNode<MKObjCClass*> *element in [(MKObjCClassListSection*)section elements]) {
+                            MKObjCClass *cls = element.pointee.value;
+                            NSString *name = cls.classData.pointee.value.name.pointee.value.string;
+                            if (name == nil)
+                                continue;
+                            
+                            expect([objcIndex classNamed:name].value).to.beIdenticalTo(cls);
+                            expect([objcIndex metaClassNamed:name].value).to.beIdenticalTo(cls.metaClass.pointee.value);
+                        }
+                    }
+                });
+                
+                it(@"should find each listed category and protocol by name", ^{
+                    for (MKSection *section in macho.sections.allValues) {
+                        if ([section isKindOfClass:MKObjCCategoryListSection.class]) {
+                            for (MKPointerNode<MKObjCCategory*> *element in [(MKObjCCategoryListSection*)section elements]) {
+                                MKObjCCategory *category = element.pointee.value;
+                                NSString *name = category.name.pointee.value.string;
+                                if (name == nil)
+                                    continue;
+                                
+                                NSMutableArray *categories = [NSMutableArray array];
+                                for (MKResult *result in [objcIndex categoriesNamed:name])
+                                    [categories addObject:result.value];
+                                expect(categories).to.contain(category);
+                            }
+                        } else if ([section isKindOfClass:MKObjCProtocolListSection.class]) {
+                            for (MKPointerNode<MKObjCProtocol*> *element in [(MKObjCProtocolListSection*)section elements]) {
+                                MKObjCProtocol *protocol = element.pointee.value;
+                                NSString *name = protocol.mangledName.pointee.value.string;
+                                if (name == nil)
+                                    continue;
+                                
+                                expect([objcIndex protocolNamed:name].value.nodeVMAddress).to.equal(protocol.nodeVMAddress);
+                            }
+                        }
+                    }
+                });
+                
+                it(@"should find each selector reference by name", ^{
+                    for (MKSection *section in macho.sections.allValues) {
+                        if (![section isKindOfClass:MKObjCSelectorReferencesSection.class])
+                            continue;
+                        
+                        for (MKPointerNode<MKCString*> *element in [(MKObjCSelectorReferencesSection*)section elements]) {
+                            NSString *name = element.pointee.value.string;
+                            if (name == nil)
+                                continue;
+                            
+                            MKPointerNode *reference = [objcIndex selectorReferenceNamed:name].value;
+                            expect(reference.address).to.equal(element.address);
+                        }
+                    }
+                });
+                
+                it(@"should not find names that are not defined", ^{
+                    NSString *name = @"MKObjCIndexUndefinedName";
+                    expect([objcIndex classNamed:name].value).to.beNil();
+                    expect([objcIndex metaClassNamed:name].value).to.beNil();
+                    expect([objcIndex categoriesNamed:name]).to.haveCountOf(0);
+                    expect([objcIndex protocolNamed:name].value).to.beNil();
+                    expect([objcIndex selectorReferenceNamed:name].value).to.beNil();
+                });
+            });
+            
             //----------------------------------------------------------------//
             describe(@"Symbols", ^{
                 NSArray<NSDictionary*> *nmDarwinSymbols = otoolArchitecture.darwinSymbols;
@@ -611,6 +1030,39 @@ SpecBegin(MKMachOImage)
                         lastAddress = entryVMAddress;
                     }
                 });
+                
+                it(@"should return placeholders for symbols that can not be parsed", ^{
+                    NSError *parseError = [NSError mk_errorWithDomain:MKErrorDomain code:MK_EINVALID_DATA description:@"Test"];
+                    MKSymbol *placeholder = [MKSymbol placeholderAtOffset:0 fromParent:machoSymbolTable error:parseError];
+                    
+                    expect(placeholder).to.beKindOf(MKSymbol.class);
+                    expect(placeholder.parent).to.beIdenticalTo(machoSymbolTable);
+                    expect(placeholder.nodeOffset).to.equal(0);
+                    expect(placeholder.warnings).to.haveCountOf(1);
+                    expect(placeholder.warnings.firstObject.userInfo[NSUnderlyingErrorKey]).to.beIdenticalTo(parseError);
+                });
+                
+                it(@"should enumerate the same entries as the symbols", ^{
+                    __block NSUInteger count = 0;
+                    [machoSymbolTable enumerateNListsUsingBlock:^(struct nlist_64 nlist, NSUInteger index, __unused BOOL *stop) {
+                        MKSymbol *machoSymbol = machoSymbols[index];
+                        expect(nlist.n_un.n_strx).to.equal(machoSymbol.strx);
+                        expect(nlist.n_type).to.equal(machoSymbol.type);
+                        expect(nlist.n_sect).to.equal(machoSymbol.sect);
+                        expect(nlist.n_desc).to.equal(machoSymbol.desc);
+                        expect(nlist.n_value).to.equal(machoSymbol.value);
+                        count++;
+                    }];
+                    expect(count).to.equal(machoSymbols.count);
+                });
+                
+                it(@"should return the same symbol for each access", ^{
+                    if (machoSymbols.count == 0) return;
+                    
+                    MKSymbol *first = machoSymbols.firstObject;
+                    expect(machoSymbols[0]).to.beIdenticalTo(first);
+                    expect([machoSymbolTable childNodeOccupyingVMAddress:first.nodeVMAddress targetClass:nil].value).to.beIdenticalTo(first);
+                });
             });
             
             //----------------------------------------------------------------//
@@ -655,6 +1107,112 @@ SpecBegin(MKMachOImage)
                 });
             });
             
+            //----------------------------------------------------------------//
+            describe(@"image index", ^{
+                NSError *indexError = nil;
+                NSData *indexData = [MKImageIndex indexDataForImage:macho error:&indexError];
+                MKImageIndex *index = indexData ? [[MKImageIndex alloc] initWithData:indexData error:&indexError] : nil;
+                
+                it(@"should round trip", ^{
+                    expect(index).toNot.beNil();
+                    expect(indexError).to.beNil();
+                });
+                if (index == nil) return;
+                
+                it(@"should be valid for the image", ^{
+                    expect([index isValidForImage:macho]).to.beTruthy();
+                    expect([index isValidForFileAtURL:frameworkURL]).to.beTruthy();
+                });
+                
+                it(@"should find symbols by name and address", ^{
+                    const mk_image_index_t *idx = index.index;
+                    for (uint32_t i = 0; i < idx->header->symbols.count; i++) {
+                        const mk_image_index_symbol_t *symbol = &idx->symbols[i];
+                        const char *name = mk_image_index_get_string(idx, symbol->name);
+                        if (name[0] == '\0') continue;
+                        
+                        const mk_image_index_symbol_t *found = mk_image_index_find_symbol_named(idx, name);
+                        expect(found).toNot.beNull();
+                        if (found) expect(strcmp(mk_image_index_get_string(idx, found->name), name)).to.equal(0);
+                        
+                        expect(mk_image_index_find_symbol_for_address(idx, symbol->address)->address).to.equal(symbol->address);
+                    }
+                });
+                
+                it(@"should find exports by name", ^{
+                    for (MKExport *anExport in macho.exportsInfo.value.exports)
+                        expect(mk_image_index_find_export_named(index.index, anExport.name.UTF8String)).toNot.beNull();
+                });
+                
+                it(@"should only index symbols defined in a section", ^{
+                    const mk_image_index_t *idx = index.index;
+                    for (uint32_t i = 0; i < idx->header->symbols.count; i++) {
+                        expect(idx->symbols[i].type & N_STAB).to.equal(0);
+                        expect(idx->symbols[i].type & N_TYPE).to.equal(N_SECT);
+                    }
+                });
+                
+                it(@"should write an index that can be opened", ^{
+                    NSURL *indexURL = [NSURL fileURLWithPath:[NSTemporaryDirectory() stringByAppendingPathComponent:NSUUID.UUID.UUIDString]];
+                    NSError *writeError = nil;
+                    
+                    expect([MKImageIndex writeIndexForImage:macho toURL:indexURL error:&writeError]).to.beTruthy();
+                    expect(writeError).to.beNil();
+                    expect([NSData dataWithContentsOfURL:indexURL]).to.equal(indexData);
+                    
+                    mk_image_index_t opened;
+                    expect(mk_image_index_open(indexURL.fileSystemRepresentation, &opened)).to.equal(MK_ESUCCESS);
+                    expect(opened.mapped).to.beTruthy();
+                    expect(opened.header->symbols.count).to.equal(index.index->header->symbols.count);
+                    expect(opened.header->exports.count).to.equal(index.index->header->exports.count);
+                    mk_image_index_close(&opened);
+                    expect(opened.header).to.beNull();
+                    
+                    MKImageIndex *loaded = [[MKImageIndex alloc] initWithContentsOfURL:indexURL error:&writeError];
+                    expect(loaded).toNot.beNil();
+                    expect([loaded isValidForImage:macho]).to.beTruthy();
+                    loaded = nil;
+                    
+                    [NSFileManager.defaultManager removeItemAtURL:indexURL error:NULL];
+                });
+                
+                it(@"should not open a missing or invalid index", ^{
+                    NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:NSUUID.UUID.UUIDString];
+                    mk_image_index_t opened;
+                    
+                    expect(mk_image_index_open(path.fileSystemRepresentation, &opened)).to.equal(MK_ENOT_FOUND);
+                    expect(mk_image_index_open(NSTemporaryDirectory().fileSystemRepresentation, &opened)).to.equal(MK_EINVAL);
+                    
+                    [[NSData dataWithBytes:"MKII" length:4] writeToFile:path atomically:YES];
+                    expect(mk_image_index_open(path.fileSystemRepresentation, &opened)).to.equal(MK_ESIZE);
+                    
+                    NSMutableData *corrupt = [indexData mutableCopy];
+                    ((mk_image_index_header_t*)corrupt.mutableBytes)->magic = 0;
+                    [corrupt writeToFile:path atomically:YES];
+                    expect(mk_image_index_open(path.fileSystemRepresentation, &opened)).to.equal(MK_EINVALID_DATA);
+                    
+                    NSError *openError = nil;
+                    expect([[MKImageIndex alloc] initWithContentsOfURL:[NSURL fileURLWithPath:path] error:&openError]).to.beNil();
+                    expect(openError.code).to.equal(MK_EINVALID_DATA);
+                    
+                    [NSFileManager.defaultManager removeItemAtPath:path error:NULL];
+                });
+                
+                it(@"should not be valid for an image with a different UUID", ^{
+                    NSMutableData *mismatched = [indexData mutableCopy];
+                    ((mk_image_index_header_t*)mismatched.mutableBytes)->uuid[0] ^= 0xFF;
+                    MKImageIndex *mismatchedIndex = [[MKImageIndex alloc] initWithData:mismatched error:NULL];
+                    
+                    expect(mismatchedIndex).toNot.beNil();
+                    expect([mismatchedIndex isValidForImage:macho]).to.beFalsy();
+                    expect([mismatchedIndex isValidForFileAtURL:frameworkURL]).to.beFalsy();
+                    
+                    const mk_image_index_header_t *header = mismatchedIndex.index->header;
+                    expect(mk_image_index_matches(mismatchedIndex.index, header->uuid, header->cputype + 1, header->cpusubtype)).to.beFalsy();
+                    expect(mk_image_index_matches(mismatchedIndex.index, header->uuid, header->cputype, header->cpusubtype)).to.beTruthy();
+                });
+            });
+            
             //----------------------------------------------------------------//
             describe(@"_objc", ^{
                 // Skip images that use legacy OBJC ABI.
@@ -826,6 +1384,18 @@ SpecBegin(MKMachOImage)
                                                 }
                                             });
                                             
+                                            it(@"should place the elements at a stride of the entity size", ^{
+                                                // The elements follow the 8 byte list header.
+                                                mk_vm_address_t elementsAddress = elementList.nodeVMAddress + 8;
+                                                NSArray *elements = elementList.elements;
+                                                for (NSUInteger j = 0; j < elements.count; j++) {
+                                                    MKBackedNode *entry = elements[j];
+                                                    expect(entry.nodeVMAddress).to.equal(elementsAddress + j * elementList.entsize);
+                                                    expect(entry).to.beIdenticalTo(elements[j]);
+                                                    expect([elementList childNodeOccupyingVMAddress:entry.nodeVMAddress targetClass:entry.class].value).to.beIdenticalTo(entry);
+                                                }
+                                            });
+                                            
                                             NSArray *otoolElements = otoolElementList[@"elements"];
                                             
                                             for (NSUInteger i = 0; i < MIN(elementList.elements.count, otoolElements.count); i++)
@@ -975,5 +1545,542 @@ SpecBegin(MKMachOImage)
         
         
     });
+    
+    describe(@"the largest executable", ^{
+        __block MKMachOImage *macho;
+        
+        beforeAll(^{
+            NSURL *url = [NSFileManager largestExecutableURL:MKFrameworkTypeOSX];
+            Architecture *architecture = [[Binary binaryAtURL:url] architectures].firstObject;
+            if (architecture == nil) return;
+            MKMemoryMap *map = [MKMemoryMap memoryMapWithContentsOfFile:url error:NULL];
+            macho = [[MKMachOImage alloc] initWithName:url.lastPathComponent.UTF8String flags:0 atAddress:architecture.offset inMapping:map error:NULL];
+        });
+        
+        afterAll(^{
+            [macho release];
+            macho = nil;
+        });
+        
+        //--------------------------------------------------------------------//
+        describe(@"symbol table", ^{
+            
+            it(@"should keep the symbol table alive while its symbols are in use", ^{
+                MKSymbolTable *symbolTable = [[MKSymbolTable alloc] initWithImage:macho error:NULL];
+                expect(symbolTable).toNot.beNil();
+                
+                NSArray<MKSymbol*> *symbols = [symbolTable.symbols retain];
+                expect(symbols.count).to.beGreaterThan(0);
+                [symbolTable release];
+                
+                MKSymbol *last = symbols.lastObject;
+                expect(last.parent).toNot.beNil();
+                expect(symbols.lastObject).to.beIdenticalTo(last);
+                [symbols release];
+            });
+            
+            it(@"should instantiate a symbol without instantiating the others", ^{
+                mk_vm_size_t entrySize = (macho.dataModel.pointerSize == 8) ? sizeof(struct nlist_64) : sizeof(struct nlist);
+                [SPTCurrentSpec measureBlock:^{
+                    @autoreleasepool {
+                        MKSymbolTable *symbolTable = [[MKSymbolTable alloc] initWithImage:macho error:NULL];
+                        NSArray<MKSymbol*> *symbols = symbolTable.symbols;
+                        MKSymbol *symbol = symbols[symbols.count / 2];
+                        
+                        expect(symbol.nodeOffset).to.equal((symbols.count / 2) * entrySize);
+                        [symbolTable release];
+                    }
+                }];
+            });
+            
+            it(@"should load the entries of a large symbol table in bulk", ^{
+                [SPTCurrentSpec measureBlock:^{
+                    @autoreleasepool {
+                        MKSymbolTable *symbolTable = [[MKSymbolTable alloc] initWithImage:macho error:NULL];
+                        expect(symbolTable.warnings).to.haveCountOf(0);
+                        
+                        // Instantiate every symbol from the bulk loaded entries.
+                        __block NSUInteger mismatches = 0;
+                        NSArray<MKSymbol*> *symbols = symbolTable.symbols;
+                        [symbolTable enumerateNListsUsingBlock:^(struct nlist_64 nlist, NSUInteger index, __unused BOOL *stop) {
+                            MKSymbol *symbol = symbols[index];
+                            if (symbol.strx != nlist.n_un.n_strx || symbol.type != nlist.n_type || symbol.value != nlist.n_value)
+                                mismatches++;
+                        }];
+                        
+                        expect(mismatches).to.equal(0);
+                        [symbolTable release];
+                    }
+                }];
+            });
+            
+            it(@"should find the symbol occupying an address when the table has trailing bytes", ^{
+                MKLCSymtab *symtab = [macho loadCommandsOfType:LC_SYMTAB].firstObject;
+                mk_vm_size_t entrySize = (macho.dataModel.pointerSize == 8) ? sizeof(struct nlist_64) : sizeof(struct nlist);
+                
+                // Two entries, followed by a partial entry.
+                MKSymbolTable *symbolTable = [[MKSymbolTable alloc] initWithSize:3 * entrySize - 1 offset:symtab.symoff inImage:macho error:NULL];
+                NSArray<MKSymbol*> *symbols = symbolTable.symbols;
+                expect(symbols).to.haveCountOf(2);
+                expect(symbolTable.warnings).to.haveCountOf(1);
+                
+                MKSymbol *second = symbols.lastObject;
+                expect([symbolTable childNodeOccupyingVMAddress:second.nodeVMAddress targetClass:nil].value).to.beIdenticalTo(second);
+                [symbolTable release];
+            });
+            
+        });
+        
+        //--------------------------------------------------------------------//
+        describe(@"exports info", ^{
+            
+            it(@"should find the trie node occupying an address", ^{
+                NSArray<MKExportTrieNode*> *nodes = macho.exportsInfo.value.nodes;
+                if (nodes.count == 0) return;
+                MKExportTrieNode *last = nodes.lastObject;
+                
+                [SPTCurrentSpec measureBlock:^{
+                    @autoreleasepool {
+                        MKExportsInfo *exportsInfo = [[MKExportsInfo alloc] initWithImage:macho error:NULL];
+                        MKExportTrieNode *node = [exportsInfo childNodeOccupyingVMAddress:last.nodeVMAddress targetClass:MKExportTrieNode.class].value;
+                        
+                        expect(node.nodeOffset).to.equal(last.nodeOffset);
+                        expect(node.nodeSize).to.equal(last.nodeSize);
+                        [exportsInfo release];
+                    }
+                }];
+            });
+            
+            it(@"should find exports by name without walking the whole trie", ^{
+                NSArray<MKExport*> *exports = macho.exportsInfo.value.exports;
+                NSMutableArray<NSString*> *names = [NSMutableArray array];
+                for (NSUInteger i = 0; i < exports.count; i += MAX(exports.count / 64, (NSUInteger)1))
+                    [names addObject:exports[i].name];
+                
+                [SPTCurrentSpec measureBlock:^{
+                    @autoreleasepool {
+                        MKExportsInfo *exportsInfo = [[MKExportsInfo alloc] initWithImage:macho error:NULL];
+                        NSDictionary<NSString*, MKExport*> *found = [exportsInfo exportsForNames:names];
+                        
+                        expect(found.count).to.equal([NSSet setWithArray:names].count);
+                        [exportsInfo release];
+                    }
+                }];
+            });
+            
+            it(@"should validate the exports without creating them", ^{
+                [SPTCurrentSpec measureBlock:^{
+                    @autoreleasepool {
+                        MKExportsInfo *exportsInfo = [[MKExportsInfo alloc] initWithImage:macho error:NULL];
+                        expect(exportsInfo.warnings).to.haveCountOf(0);
+                        [exportsInfo release];
+                    }
+                }];
+            });
+            
+        });
+        
+        //--------------------------------------------------------------------//
+        describe(@"cstring section", ^{
+            __block MKCStringSection *section;
+            
+            beforeAll(^{
+                for (MKSection *candidate in macho.sections.allValues) {
+                    if ([candidate isKindOfClass:MKCStringSection.class] && candidate.nodeSize > section.nodeSize)
+                        section = (MKCStringSection*)candidate;
+                }
+            });
+            
+            it(@"should keep the section alive while its strings are in use", ^{
+                MKCStringSection *copy = [[MKCStringSection alloc] initWithLoadCommand:section.loadCommand inSegment:(MKSegment*)section.parent error:NULL];
+                NSArray<MKCString*> *strings = [copy.strings retain];
+                expect(strings.count).to.equal(section.strings.count);
+                [copy release];
+                
+                MKCString *last = strings.lastObject;
+                expect(last.parent).toNot.beNil();
+                expect(strings.lastObject).to.beIdenticalTo(last);
+                [strings release];
+            });
+            
+            it(@"should index a large string section without creating its strings", ^{
+                NSUInteger count = section.strings.count;
+                expect(count).to.beGreaterThan(1000);
+                
+                [SPTCurrentSpec measureBlock:^{
+                    @autoreleasepool {
+                        MKCStringSection *copy = [[MKCStringSection alloc] initWithLoadCommand:section.loadCommand inSegment:(MKSegment*)section.parent error:NULL];
+                        expect(copy.strings.count).to.equal(count);
+                        [copy release];
+                    }
+                }];
+            });
+            
+            it(@"should find strings by address", ^{
+                [SPTCurrentSpec measureBlock:^{
+                    @autoreleasepool {
+                        NSUInteger found = 0;
+                        mk_vm_address_t end = section.nodeVMAddress + section.nodeSize;
+                        for (mk_vm_address_t address = section.nodeVMAddress; address < end; address += 64) {
+                            if ([section stringAtAddress:address])
+                                found++;
+                        }
+                        expect(found).to.beGreaterThan(0);
+                    }
+                }];
+            });
+            
+        });
+        
+        //--------------------------------------------------------------------//
+        describe(@"pointer list sections", ^{
+            __block NSMutableArray<MKPointerListSection*> *sections;
+            
+            beforeAll(^{
+                sections = [[NSMutableArray alloc] init];
+                for (MKSection *section in macho.sections.allValues) {
+                    if ([section isKindOfClass:MKPointerListSection.class])
+                        [sections addObject:(MKPointerListSection*)section];
+                }
+            });
+            
+            afterAll(^{
+                [sections release];
+                sections = nil;
+            });
+            
+            it(@"should keep the section alive while its pointers are in use", ^{
+                MKPointerListSection *section = sections.firstObject;
+                if (section == nil) return;
+                
+                MKPointerListSection *copy = [[section.class alloc] initWithLoadCommand:section.loadCommand inSegment:(MKSegment*)section.parent error:NULL];
+                NSArray<MKPointerNode*> *elements = [copy.elements retain];
+                [copy release];
+                
+                MKPointerNode *last = elements.lastObject;
+                expect(last.parent).toNot.beNil();
+                expect(elements.lastObject).to.beIdenticalTo(last);
+                [elements release];
+            });
+            
+            it(@"should decode pointers without creating pointer nodes", ^{
+                [SPTCurrentSpec measureBlock:^{
+                    @autoreleasepool {
+                        __block NSUInteger count = 0;
+                        for (MKPointerListSection *section in sections) {
+                            MKPointerListSection *copy = [[section.class alloc] initWithLoadCommand:section.loadCommand inSegment:(MKSegment*)section.parent error:NULL];
+                            [copy enumerateAddressesUsingBlock:^(__unused mk_vm_address_t address, __unused NSUInteger index, __unused BOOL *stop) {
+                                count++;
+                            }];
+                            [copy release];
+                        }
+                        
+                        expect(count).to.beGreaterThan(1000);
+                    }
+                }];
+            });
+            
+        });
+        
+        //--------------------------------------------------------------------//
+        describe(@"objc index", ^{
+            __block NSMutableArray<NSString*> *classNames;
+            
+            beforeAll(^{
+                classNames = [[NSMutableArray alloc] init];
+                for (MKSection *section in macho.sections.allValues) {
+                    if (![section isKindOfClass:MKObjCClassListSection.class])
+                        continue;
+                    for (MKPointerNode<MKObjCClass*> *element in [(MKObjCClassListSection*)section elements]) {
+                        NSString *name = element.pointee.value.classData.pointee.value.name.pointee.value.string;
+                        if (name) [classNames addObject:name];
+                    }
+                }
+            });
+            
+            afterAll(^{
+                [classNames release];
+                classNames = nil;
+            });
+            
+            it(@"should build the index without instantiating any classes", ^{
+                // A class listed in both __objc_classlist and __objc_nlclslist
+                // is indexed once.
+                NSUInteger classCount = [NSSet setWithArray:classNames].count;
+                
+                [SPTCurrentSpec measureBlock:^{
+                    @autoreleasepool {
+                        MKObjCIndex *objcIndex = [[MKObjCIndex alloc] initWithImage:macho error:NULL];
+                        expect(objcIndex.classCount).to.equal(classCount);
+                        [objcIndex release];
+                    }
+                }];
+            });
+            
+            it(@"should look up classes by name without walking the class list", ^{
+                MKObjCIndex *objcIndex = [[MKObjCIndex alloc] initWithImage:macho error:NULL];
+                
+                [SPTCurrentSpec measureBlock:^{
+                    @autoreleasepool {
+                        NSUInteger found = 0;
+                        for (NSString *name in classNames) {
+                            if ([objcIndex classNamed:name].value)
+                                found++;
+                        }
+                        expect(found).to.equal(classNames.count);
+                    }
+                }];
+                
+                [objcIndex release];
+            });
+            
+        });
+        
+        //--------------------------------------------------------------------//
+        describe(@"objc element lists", ^{
+            __block NSMutableArray<MKObjCClassMethodList*> *methodLists;
+            
+            beforeAll(^{
+                methodLists = [[NSMutableArray alloc] init];
+                for (MKSection *section in macho.sections.allValues) {
+                    if (![section isKindOfClass:MKObjCClassListSection.class])
+                        continue;
+                    for (MKPointerNode<MKObjCClass*> *element in [(MKObjCClassListSection*)section elements]) {
+                        MKObjCClassMethodList *methods = element.pointee.value.classData.pointee.value.methods.pointee.value;
+                        if (methods) [methodLists addObject:methods];
+                    }
+                }
+            });
+            
+            afterAll(^{
+                [methodLists release];
+                methodLists = nil;
+            });
+            
+            it(@"should keep the list alive while its methods are in use", ^{
+                MKObjCClassMethodList *list = methodLists.firstObject;
+                if (list == nil) return;
+                
+                MKObjCClassMethodList *copy = [[MKObjCClassMethodList alloc] initWithOffset:list.nodeOffset fromParent:(MKBackedNode*)list.parent error:NULL];
+                NSArray<MKObjCClassMethod*> *methods = [copy.elements retain];
+                expect(methods.count).to.equal(list.elements.count);
+                [copy release];
+                
+                MKObjCClassMethod *last = methods.lastObject;
+                expect(last.parent).toNot.beNil();
+                expect(methods.lastObject).to.beIdenticalTo(last);
+                [methods release];
+            });
+            
+            it(@"should count methods without instantiating them", ^{
+                NSUInteger expected = 0;
+                for (MKObjCClassMethodList *list in methodLists)
+                    expected += list.elements.count;
+                
+                [SPTCurrentSpec measureBlock:^{
+                    @autoreleasepool {
+                        NSUInteger count = 0;
+                        for (MKObjCClassMethodList *list in methodLists) {
+                            MKObjCClassMethodList *copy = [[MKObjCClassMethodList alloc] initWithOffset:list.nodeOffset fromParent:(MKBackedNode*)list.parent error:NULL];
+                            count += copy.elements.count;
+                            [copy release];
+                        }
+                        expect(count).to.equal(expected);
+                    }
+                }];
+            });
+            
+            it(@"should name every method", ^{
+                for (MKObjCClassMethodList *list in methodLists) {
+                    for (MKObjCClassMethod *method in list.elements) {
+                        expect(method.nodeSize).to.equal(list.entsize);
+                        expect(method.name.pointee.value.string).toNot.beNil();
+                    }
+                }
+            });
+            
+        });
+        
+        //--------------------------------------------------------------------//
+        describe(@"function starts", ^{
+            __block MKFunctionStarts *functionStarts;
+            __block mk_vm_address_t *addresses;
+            __block NSUInteger count;
+            
+            beforeAll(^{
+                functionStarts = [macho.functionStarts.value retain];
+                count = functionStarts.functionCount;
+                
+                // Probe one address in the middle of every function.
+                addresses = malloc((count ?: 1) * sizeof(*addresses));
+                for (NSUInteger i = 0; i < count; i++) {
+                    mk_vm_address_t address = [functionStarts addressOfFunctionAtIndex:i];
+                    mk_vm_address_t next = (i + 1 < count) ? [functionStarts addressOfFunctionAtIndex:i + 1] : address + 2;
+                    addresses[i] = address + (next - address) / 2;
+                }
+            });
+            
+            afterAll(^{
+                free(addresses);
+                addresses = NULL;
+                [functionStarts release];
+                functionStarts = nil;
+            });
+            
+            it(@"should decode the function starts without instantiating them", ^{
+                expect(count).to.beGreaterThan(1000);
+                
+                [SPTCurrentSpec measureBlock:^{
+                    @autoreleasepool {
+                        MKFunctionStarts *decoded = [[MKFunctionStarts alloc] initWithParent:macho error:NULL];
+                        expect(decoded.functionCount).to.equal(count);
+                        [decoded release];
+                    }
+                }];
+            });
+            
+            it(@"should find the function containing each address", ^{
+                [SPTCurrentSpec measureBlock:^{
+                    NSUInteger mismatches = 0;
+                    for (NSUInteger i = 0; i < count; i++) {
+                        if ([functionStarts indexOfFunctionContainingAddress:addresses[i]] != i)
+                            mismatches++;
+                    }
+                    expect(mismatches).to.equal(0);
+                }];
+            });
+            
+            it(@"should find the functions containing a sorted batch of addresses", ^{
+                NSUInteger *indexes = malloc((count ?: 1) * sizeof(*indexes));
+                
+                [SPTCurrentSpec measureBlock:^{
+                    [functionStarts getIndexes:indexes ofFunctionsContainingAddresses:addresses count:count];
+                }];
+                
+                NSUInteger mismatches = 0;
+                for (NSUInteger i = 0; i < count; i++) {
+                    if (indexes[i] != i)
+                        mismatches++;
+                }
+                expect(mismatches).to.equal(0);
+                free(indexes);
+            });
+            
+        });
+        
+        //--------------------------------------------------------------------//
+        describe(@"fixup tables", ^{
+            
+            it(@"should decode the rebase fixups without instantiating them", ^{
+                // Images linked with chained fixups do not have LC_DYLD_INFO.
+                NSUInteger fixupCount = macho.rebaseInfo.value.fixupCount;
+                if (fixupCount == 0) return;
+                
+                [SPTCurrentSpec measureBlock:^{
+                    @autoreleasepool {
+                        MKRebaseInfo *rebaseInfo = [[MKRebaseInfo alloc] initWithImage:macho error:NULL];
+                        expect(rebaseInfo.fixupCount).to.equal(fixupCount);
+                        [rebaseInfo release];
+                    }
+                }];
+            });
+            
+            it(@"should decode the bind actions without instantiating them", ^{
+                NSUInteger actionCount = macho.bindingsInfo.value.actionCount;
+                if (actionCount == 0) return;
+                
+                [SPTCurrentSpec measureBlock:^{
+                    @autoreleasepool {
+                        MKBindingsInfo *bindingsInfo = [[MKBindingsInfo alloc] initWithImage:macho error:NULL];
+                        expect(bindingsInfo.actionCount).to.equal(actionCount);
+                        [bindingsInfo release];
+                    }
+                }];
+            });
+            
+            it(@"should find each fixup by address", ^{
+                MKRebaseInfo *rebaseInfo = macho.rebaseInfo.value;
+                MKBindingsInfo *bindingsInfo = macho.bindingsInfo.value;
+                NSUInteger fixupCount = rebaseInfo.fixupCount + bindingsInfo.actionCount;
+                if (fixupCount == 0) return;
+                
+                [SPTCurrentSpec measureBlock:^{
+                    NSUInteger found = 0;
+                    for (NSUInteger i = 0; i < rebaseInfo.fixupCount; i++)
+                        found += [rebaseInfo indexOfFixupAtAddress:[rebaseInfo addressOfFixupAtIndex:i]] != NSNotFound;
+                    for (NSUInteger i = 0; i < bindingsInfo.actionCount; i++)
+                        found += [bindingsInfo indexOfActionAtAddress:[bindingsInfo addressOfActionAtIndex:i]] != NSNotFound;
+                    expect(found).to.equal(fixupCount);
+                }];
+            });
+            
+            it(@"should instantiate a fixup for each decoded entry", ^{
+                MKRebaseInfo *rebaseInfo = macho.rebaseInfo.value;
+                MKBindingsInfo *bindingsInfo = macho.bindingsInfo.value;
+                
+                expect(rebaseInfo.fixups.count).to.equal(rebaseInfo.fixupCount);
+                expect(bindingsInfo.actions.count).to.equal(bindingsInfo.actionCount);
+            });
+            
+        });
+        
+    });
+    
+    describe(@"a synthetic arm64e image", ^{
+        __block MKMachOImage *macho;
+        __block NSURL *imageURL;
+        
+        beforeAll(^{
+            imageURL = [NSURL fileURLWithPath:[NSTemporaryDirectory() stringByAppendingPathComponent:NSUUID.UUID.UUIDString]];
+            [MKMachOSpecThreadedBindImage() writeToURL:imageURL atomically:YES];
+            
+            NSError *error = nil;
+            MKMemoryMap *map = [MKMemoryMap memoryMapWithContentsOfFile:imageURL error:&error];
+            macho = [[MKMachOImage alloc] initWithName:"threaded" flags:0 atAddress:0 inMapping:map error:&error];
+        });
+        
+        afterAll(^{
+            [[NSFileManager defaultManager] removeItemAtURL:imageURL error:NULL];
+        });
+        
+        it(@"should decode the threaded binds and rebases", ^{
+            MKBindingsInfo *bindingsInfo = macho.bindingsInfo.value;
+            expect(bindingsInfo).toNot.beNil();
+            expect(bindingsInfo.warnings).to.haveCountOf(0);
+            expect(bindingsInfo.actionCount).to.equal(5);
+            
+            const mk_vm_address_t addresses[] = { 0x100004010, 0x100007FF8, 0x100008010, 0x100008020, 0x10000A000 };
+            const uint8_t types[] = { BIND_TYPE_THREADED_REBASE, BIND_TYPE_THREADED_BIND, BIND_TYPE_THREADED_BIND, BIND_TYPE_THREADED_REBASE, BIND_TYPE_THREADED_REBASE };
+            for (NSUInteger i = 0; i < MIN(bindingsInfo.actionCount, (NSUInteger)5); i++) {
+                expect([bindingsInfo addressOfActionAtIndex:i]).to.equal(addresses[i]);
+                expect([bindingsInfo typeOfActionAtIndex:i]).to.equal(types[i]);
+                expect([bindingsInfo indexOfActionAtAddress:addresses[i]]).to.equal(i);
+            }
+            
+            expect([bindingsInfo symbolNameOfActionAtIndex:0]).to.beNil();
+            expect([bindingsInfo symbolNameOfActionAtIndex:1]).to.equal(@"_foo");
+            expect([bindingsInfo libraryOrdinalOfActionAtIndex:1]).to.equal(1);
+            expect([bindingsInfo addendOfActionAtIndex:1]).to.equal(0);
+            expect([bindingsInfo symbolNameOfActionAtIndex:2]).to.equal(@"_bar");
+            expect([bindingsInfo symbolFlagsOfActionAtIndex:2]).to.equal(BIND_SYMBOL_FLAGS_WEAK_IMPORT);
+            expect([bindingsInfo addendOfActionAtIndex:2]).to.equal(16);
+        });
+        
+        it(@"should match the bind actions", ^{
+            MKBindingsInfo *bindingsInfo = macho.bindingsInfo.value;
+            NSArray *actions = bindingsInfo.actions;
+            expect(actions).to.haveCountOf(bindingsInfo.actionCount);
+            
+            for (NSUInteger i = 0; i < MIN(actions.count, bindingsInfo.actionCount); i++) {
+                MKBindAction *action = actions[i];
+                expect([bindingsInfo addressOfActionAtIndex:i]).to.equal(action.address);
+                expect([bindingsInfo typeOfActionAtIndex:i]).to.equal(action.type);
+                if ([action isKindOfClass:MKBindActionThreadedBind.class])
+                    expect([bindingsInfo symbolNameOfActionAtIndex:i]).to.equal(((MKBindActionThreadedBind*)action).symbolName);
+                else
+                    expect(action).to.beKindOf(MKBindActionThreadedRebase.class);
+            }
+        });
+    });
 }
 SpecEnd
@@ -27,6 +27,33 @@
 
 #include <malloc/malloc.h>
 
+// Private to MachOKit.
+@protocol _MKTaskMemoryReader <NSObject>
+- (mk_vm_size_t)readBytesAtAddress:(mk_vm_address_t)address length:(mk_vm_size_t)length into:(void*)buffer error:(NSError**)error;
+@end
+
+@interface MKMemoryMap (MKTaskMemoryReader)
+- (instancetype)initWithTask:(mach_port_t)task reader:(id<_MKTaskMemoryReader>)reader error:(NSError**)error;
+@end
+
+//! Reads the memory of the current process, counting the reads.
+@interface MKCountingMemoryReader : NSObject <_MKTaskMemoryReader>
+@property (nonatomic) NSUInteger readCount;
+//! Pages below this address are treated as unreadable.
+@property (nonatomic) mk_vm_address_t unreadableBelow;
+@end
+
+@implementation MKCountingMemoryReader
+- (mk_vm_size_t)readBytesAtAddress:(mk_vm_address_t)address length:(mk_vm_size_t)length into:(void*)buffer error:(NSError**)error
+{
+    self.readCount++;
+    if (address < self.unreadableBelow)
+        return 0;
+    memcpy(buffer, (void*)address, (size_t)length);
+    return length;
+}
+@end
+
 SpecBegin(MKMemoryMap)
 
 describe(@"a file memory map", ^{
@@ -71,6 +98,63 @@ describe(@"a file memory map", ^{
     it(@"should report that it has valid mappings", ^{
         expect([map hasMappingAtOffset:4096 fromAddress:0 length:5484640]).to.beTruthy();
     });
+    
+    it(@"should return spans that borrow the file contents", ^{
+        NSError *error = nil;
+        MKMemorySpan span = [map spanAtOffset:4096 fromAddress:0 length:64 requireFull:YES error:&error];
+        expect(error).to.beNil();
+        expect(span.bytes == (const uint8_t*)fileData.bytes + 4096).to.beTruthy();
+        expect(span.length).to.equal(64);
+        expect(span.owner).to.beIdenticalTo(fileData);
+    });
+    
+    it(@"should truncate spans that do not require the full range", ^{
+        NSError *error = nil;
+        MKMemorySpan span = [map spanAtOffset:fileData.length - 16 fromAddress:0 length:MK_VM_SIZE_MAX requireFull:NO error:&error];
+        expect(error).to.beNil();
+        expect(span.length).to.equal(16);
+        
+        span = [map spanAtOffset:fileData.length - 16 fromAddress:0 length:MK_VM_SIZE_MAX requireFull:YES error:&error];
+        expect(span.bytes == NULL).to.beTruthy();
+        expect(error).toNot.beNil();
+    });
+    
+    it(@"should keep the bytes of a span valid after the map is deallocated", ^{
+        NSURL *foundationURL = [NSURL fileURLWithPath:@"/System/Library/Frameworks/Foundation.framework/Foundation"];
+        MKMemorySpan span;
+        
+        @autoreleasepool {
+            MKMemoryMap *localMap = [MKMemoryMap memoryMapWithContentsOfFile:foundationURL error:NULL];
+            span = [localMap spanAtOffset:4096 fromAddress:0 length:64 requireFull:YES error:NULL];
+            [span.owner retain];
+        }
+        
+        expect(span.length).to.equal(64);
+        expect(memcmp(span.bytes, (const uint8_t*)fileData.bytes + 4096, 64)).to.equal(0);
+        [span.owner release];
+    });
+});
+
+describe(@"a file memory map of a special file", ^{
+    it(@"should map an empty file with no mappings", ^{
+        NSURL *emptyURL = [NSURL fileURLWithPath:[NSTemporaryDirectory() stringByAppendingPathComponent:@"MKMemoryMapSpec.empty"]];
+        [[NSData data] writeToURL:emptyURL atomically:YES];
+        
+        NSError *error;
+        MKMemoryMap *map = [MKMemoryMap memoryMapWithContentsOfFile:emptyURL error:&error];
+        expect(map).toNot.beNil();
+        expect(error).to.beNil();
+        expect([map hasMappingAtOffset:0 fromAddress:0 length:1]).to.beFalsy();
+        
+        [[NSFileManager defaultManager] removeItemAtURL:emptyURL error:NULL];
+    });
+    
+    it(@"should refuse to map a directory", ^{
+        NSError *error;
+        MKMemoryMap *map = [MKMemoryMap memoryMapWithContentsOfFile:[NSURL fileURLWithPath:NSTemporaryDirectory()] error:&error];
+        expect(map).to.beNil();
+        expect(error).toNot.beNil();
+    });
 });
 
 
@@ -116,6 +200,145 @@ describe(@"a task memory map", ^{
         free(allocation);
     });
     
+    it(@"should return spans of a valid, non-page aligned address", ^{
+        void *allocation = valloc(vm_page_size * 5);
+        size_t allocationSize = malloc_size(allocation);
+        memset(allocation, 0xDD, allocationSize);
+        
+        NSError *error = nil;
+        MKMemorySpan span = [map spanAtOffset:46 fromAddress:(mach_vm_address_t)allocation length:vm_page_size * 2 requireFull:YES error:&error];
+        expect(error).to.beNil();
+        expect(span.length).to.equal(vm_page_size * 2);
+        expect( memcmp(span.bytes, (uint8_t*)allocation + 46, (size_t)span.length) ).to.equal(0);
+        
+        // A second span inside the first is served from the same region.
+        MKMemorySpan inner = [map spanAtOffset:146 fromAddress:(mach_vm_address_t)allocation length:64 requireFull:YES error:&error];
+        expect(error).to.beNil();
+        expect(inner.bytes == (const uint8_t*)span.bytes + 100).to.beTruthy();
+        
+        free(allocation);
+    });
+    
+    it(@"should not truncate large spans", ^{
+        size_t allocationSize = vm_page_size * 32;
+        uint8_t *allocation = valloc(allocationSize);
+        memset(allocation, 0x5A, allocationSize);
+        
+        NSError *error = nil;
+        MKMemorySpan span = [map spanAtOffset:0 fromAddress:(mach_vm_address_t)allocation length:allocationSize requireFull:NO error:&error];
+        expect(error).to.beNil();
+        expect(span.length).to.equal(allocationSize);
+        expect( memcmp(span.bytes, allocation, allocationSize) ).to.equal(0);
+        
+        // Any range within the mapped region is served from it, not only
+        // ranges in its first page.
+        MKMemorySpan inner = [map spanAtOffset:vm_page_size * 20 + 8 fromAddress:(mach_vm_address_t)allocation length:vm_page_size * 4 requireFull:YES error:&error];
+        expect(error).to.beNil();
+        expect(inner.bytes == (const uint8_t*)span.bytes + vm_page_size * 20 + 8).to.beTruthy();
+        
+        free(allocation);
+    });
+    
+    it(@"should keep the bytes of a retained span after invalidation", ^{
+        NSError *error;
+        MKMemoryMap *spanMap = [MKMemoryMap memoryMapWithTask:mach_task_self() error:&error];
+        uint8_t *allocation = valloc(vm_page_size);
+        memset(allocation, 0x3C, vm_page_size);
+        
+        MKMemorySpan span = [spanMap spanAtOffset:0 fromAddress:(mach_vm_address_t)allocation length:vm_page_size requireFull:YES error:&error];
+        expect(span.bytes != NULL).to.beTruthy();
+        // A strong reference to the owner keeps the bytes mapped after the
+        // map drops its regions.
+        id owner = span.owner;
+        @autoreleasepool {
+            [spanMap invalidate];
+        }
+        expect(owner).toNot.beNil();
+        expect(((const uint8_t*)span.bytes)[vm_page_size - 1]).to.equal(0x3C);
+        
+        free(allocation);
+    });
+    
+    it(@"should fail when asked for a span of an invalid range", ^{
+        NSError *error = nil;
+        MKMemorySpan span = [map spanAtOffset:0 fromAddress:0 length:vm_page_size requireFull:YES error:&error];
+        expect(span.bytes == NULL).to.beTruthy();
+        expect(error).toNot.beNil();
+    });
+    
+    it(@"should cache small reads", ^{
+        MKCountingMemoryReader *reader = [MKCountingMemoryReader new];
+        NSError *error;
+        MKMemoryMap *cachingMap = [[NSClassFromString(@"_MKTaskMemoryMap") alloc] initWithTask:mach_task_self() reader:reader error:&error];
+        expect(cachingMap).toNot.beNil();
+        
+        // The chunk size is 64KB.
+        size_t chunkSize = 64 * 1024;
+        size_t chunkCount = 257;
+        uint8_t *allocation = valloc(chunkSize * (chunkCount + 1));
+        uint8_t *chunks = (uint8_t*)(((uintptr_t)allocation + chunkSize - 1) & ~(chunkSize - 1));
+        memset(chunks, 0xEE, chunkSize * chunkCount);
+        
+        // Adjacent reads in the same chunk are coalesced into one read.
+        for (size_t i = 0; i < 64; i++) {
+            uint32_t word = [cachingMap readDoubleWordAtOffset:i * 4 fromAddress:(mk_vm_address_t)chunks withDataModel:nil error:&error];
+            expect(word).to.equal(0xEEEEEEEE);
+        }
+        expect(reader.readCount).to.equal(1);
+        
+        // Invalidating the map discards the cached chunk.
+        chunks[0] = 0x11;
+        expect([cachingMap readByteAtOffset:0 fromAddress:(mk_vm_address_t)chunks withDataModel:nil error:&error]).to.equal(0xEE);
+        [cachingMap invalidate];
+        expect([cachingMap readByteAtOffset:0 fromAddress:(mk_vm_address_t)chunks withDataModel:nil error:&error]).to.equal(0x11);
+        expect(reader.readCount).to.equal(2);
+        
+        // Reading more chunks than the cache holds evicts the least recently
+        // used chunk.
+        for (size_t i = 0; i < chunkCount; i++)
+            [cachingMap readByteAtOffset:i * chunkSize fromAddress:(mk_vm_address_t)chunks withDataModel:nil error:&error];
+        expect(reader.readCount).to.equal(chunkCount + 1);
+        
+        [cachingMap readByteAtOffset:chunkSize * (chunkCount - 1) fromAddress:(mk_vm_address_t)chunks withDataModel:nil error:&error];
+        expect(reader.readCount).to.equal(chunkCount + 1);
+        [cachingMap readByteAtOffset:0 fromAddress:(mk_vm_address_t)chunks withDataModel:nil error:&error];
+        expect(reader.readCount).to.equal(chunkCount + 2);
+        
+        free(allocation);
+    });
+    
+    it(@"should read around unreadable leading pages of a chunk", ^{
+        MKCountingMemoryReader *reader = [MKCountingMemoryReader new];
+        NSError *error = nil;
+        MKMemoryMap *cachingMap = [[NSClassFromString(@"_MKTaskMemoryMap") alloc] initWithTask:mach_task_self() reader:reader error:&error];
+        
+        size_t chunkSize = 64 * 1024;
+        uint8_t *allocation = valloc(chunkSize * 2);
+        uint8_t *chunk = (uint8_t*)(((uintptr_t)allocation + chunkSize - 1) & ~(chunkSize - 1));
+        memset(chunk, 0x77, chunkSize);
+        
+        // The first two pages of the chunk are unreadable.
+        reader.unreadableBelow = (mk_vm_address_t)chunk + vm_page_size * 2;
+        
+        uint8_t byte = [cachingMap readByteAtOffset:vm_page_size * 2 + 8 fromAddress:(mk_vm_address_t)chunk withDataModel:nil error:&error];
+        expect(error).to.beNil();
+        expect(byte).to.equal(0x77);
+        expect(reader.readCount).to.equal(2);
+        
+        // Later reads of the readable pages are served from the cache.
+        MKMemorySpan span = [cachingMap spanAtOffset:vm_page_size * 3 fromAddress:(mk_vm_address_t)chunk length:64 requireFull:YES error:&error];
+        expect(span.bytes != NULL).to.beTruthy();
+        expect(((const uint8_t*)span.bytes)[63]).to.equal(0x77);
+        expect(reader.readCount).to.equal(2);
+        
+        // The unreadable pages still fail.
+        error = nil;
+        [cachingMap readByteAtOffset:vm_page_size fromAddress:(mk_vm_address_t)chunk withDataModel:nil error:&error];
+        expect(error).toNot.beNil();
+        
+        free(allocation);
+    });
+    
     it(@"should fail when asked to remap an invalid range", ^{
         [map remapBytesAtOffset:0 fromAddress:0 length:vm_page_size requireFull:YES withHandler:^(vm_address_t __unused address, vm_size_t __unused length, NSError *error) {
             expect(error).toNot.beNil();
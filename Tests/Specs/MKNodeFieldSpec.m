@@ -0,0 +1,148 @@
+//----------------------------------------------------------------------------//
+//|
+//|             MachOKit - A Lightweight Mach-O Parsing Library
+//|             MKNodeFieldSpec.m
+//|
+//|             D.V.
+//|             Copyright (c) 2014-2015 D.V. All rights reserved.
+//|
+//| Permission is hereby granted, free of charge, to any person obtaining a
+//| copy of this software and associated documentation files (the "Software"),
+//| to deal in the Software without restriction, including without limitation
+//| the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//| and/or sell copies of the Software, and to permit persons to whom the
+//| Software is furnished to do so, subject to the following conditions:
+//|
+//| The above copyright notice and this permission notice shall be included
+//| in all copies or substantial portions of the Software.
+//|
+//| THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//| OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//| MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//| IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//| CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//| TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//| SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//----------------------------------------------------------------------------//
+
+
+//----------------------------------------------------------------------------//
+//! An object whose fields exercise each kind of compiled accessor.
+@interface MKNodeFieldSpecObject : NSObject {
+    int _hidden;
+}
+@property (nonatomic) uint16_t width;
+@property (nonatomic, getter=isEnabled) BOOL enabled;
+@property (nonatomic, retain) MKNodeFieldSpecObject *child;
+@end
+
+@implementation MKNodeFieldSpecObject
+
+- (void)dealloc
+{
+    [_child release];
+    [super dealloc];
+}
+
+@end
+
+//|++++++++++++++++++++++++++++++++++++|//
+//! Reads \a keyPath from \a object with a compiled accessor.
+static id
+MKNodeFieldSpecRead(id object, NSString *keyPath)
+{
+    MKNodeFieldOperationReadKeyPath *recipe = [[[MKNodeFieldOperationReadKeyPath alloc] initWithKeyPath:keyPath] autorelease];
+    MKNodeField *field = [[[MKNodeField alloc] initWithName:keyPath description:nil type:nil value:recipe data:nil formatter:nil options:0] autorelease];
+    return [recipe valueForField:field ofNode:object].value;
+}
+
+SpecBegin(MKNodeField)
+
+describe(@"key path accessors", ^{
+    
+    it(@"should read getters, instance variables and key paths", ^{
+        MKNodeFieldSpecObject *object = [[MKNodeFieldSpecObject new] autorelease];
+        object.width = 0xBEEF;
+        object.enabled = YES;
+        object.child = [[MKNodeFieldSpecObject new] autorelease];
+        object.child.width = 7;
+        [object setValue:@42 forKey:@"hidden"];
+        
+        for (NSString *keyPath in @[@"width", @"enabled", @"isEnabled", @"hidden", @"child", @"child.width", @"child.child", @"child.child.width", @"description"])
+            expect(MKNodeFieldSpecRead(object, keyPath)).to.equal([object valueForKeyPath:keyPath]);
+        
+        expect(MKNodeFieldSpecRead(object, @"width")).to.equal(@0xBEEF);
+        expect(MKNodeFieldSpecRead(object, @"hidden")).to.equal(@42);
+        expect(MKNodeFieldSpecRead(object, @"child.width")).to.equal(@7);
+        expect(MKNodeFieldSpecRead(@[object, object.child], @"width")).to.equal(@[@0xBEEF, @7]);
+    });
+    
+});
+
+describe(@"the fields of the largest executable", ^{
+    __block MKMachOImage *macho;
+    __block NSMutableArray<MKNodeField*> *fields;
+    __block NSMutableArray<NSString*> *keyPaths;
+    __block NSMutableArray<MKSymbol*> *nodes;
+    
+    beforeAll(^{
+        NSURL *url = [NSFileManager largestExecutableURL:MKFrameworkTypeOSX];
+        Architecture *architecture = [[Binary binaryAtURL:url] architectures].firstObject;
+        if (architecture == nil) return;
+        MKMemoryMap *map = [MKMemoryMap memoryMapWithContentsOfFile:url error:NULL];
+        macho = [[MKMachOImage alloc] initWithName:url.lastPathComponent.UTF8String flags:0 atAddress:architecture.offset inMapping:map error:NULL];
+        
+        // Collect the fields of every symbol that are read with a key path.
+        fields = [[NSMutableArray alloc] init];
+        keyPaths = [[NSMutableArray alloc] init];
+        nodes = [[NSMutableArray alloc] init];
+        for (MKSymbol *symbol in macho.symbolTable.value.symbols) {
+            for (MKNodeField *field in symbol.layout.allFields) {
+                if ([field.valueRecipe isKindOfClass:MKNodeFieldOperationReadKeyPath.class] == NO)
+                    continue;
+                [fields addObject:field];
+                [keyPaths addObject:[(id)field.valueRecipe valueForKey:@"_keyPath"] ?: field.name];
+                [nodes addObject:symbol];
+            }
+        }
+    });
+    
+    afterAll(^{
+        [nodes release];
+        [keyPaths release];
+        [fields release];
+        [macho release];
+        macho = nil;
+    });
+    
+    it(@"should read every field of every symbol as key-value coding does", ^{
+        expect(fields.count).to.beGreaterThan(0);
+        
+        for (NSUInteger i = 0; i < fields.count; i++) @autoreleasepool {
+            id value = [fields[i].valueRecipe valueForField:fields[i] ofNode:nodes[i]].value;
+            id expected = [nodes[i] valueForKeyPath:keyPaths[i]];
+            if ([expected isKindOfClass:MKResult.class])
+                expected = [expected value];
+            
+            expect(value).to.equal(expected);
+        }
+    });
+    
+    it(@"should render every field of every symbol quickly", ^{
+        [SPTCurrentSpec measureBlock:^{
+            @autoreleasepool {
+                NSUInteger rendered = 0;
+                for (NSUInteger i = 0; i < fields.count; i++) {
+                    id value = [fields[i].valueRecipe valueForField:fields[i] ofNode:nodes[i]].value;
+                    NSFormatter *formatter = fields[i].valueFormatter;
+                    if ((formatter ? [formatter stringForObjectValue:value] : [value description]) != nil)
+                        rendered++;
+                }
+                expect(rendered).to.beGreaterThan(0);
+            }
+        }];
+    });
+    
+});
+
+SpecEnd
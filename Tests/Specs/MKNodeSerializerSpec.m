@@ -0,0 +1,179 @@
+//----------------------------------------------------------------------------//
+//|
+//|             MachOKit - A Lightweight Mach-O Parsing Library
+//|             MKNodeSerializerSpec.m
+//|
+//|             D.V.
+//|             Copyright (c) 2014-2015 D.V. All rights reserved.
+//|
+//| Permission is hereby granted, free of charge, to any person obtaining a
+//| copy of this software and associated documentation files (the "Software"),
+//| to deal in the Software without restriction, including without limitation
+//| the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//| and/or sell copies of the Software, and to permit persons to whom the
+//| Software is furnished to do so, subject to the following conditions:
+//|
+//| The above copyright notice and this permission notice shall be included
+//| in all copies or substantial portions of the Software.
+//|
+//| THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//| OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//| MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//| IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//| CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//| TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//| SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//----------------------------------------------------------------------------//
+
+
+//|++++++++++++++++++++++++++++++++++++|//
+//! Returns a minimal 64-bit image with a single LC_UUID load command.
+static NSData*
+MKNodeSerializerSpecImage(void)
+{
+    struct {
+        struct mach_header_64 header;
+        struct uuid_command uuid;
+    } image;
+    memset(&image, 0, sizeof(image));
+    
+    image.header.magic = MH_MAGIC_64;
+    image.header.cputype = CPU_TYPE_X86_64;
+    image.header.cpusubtype = CPU_SUBTYPE_X86_64_ALL;
+    image.header.filetype = MH_EXECUTE;
+    image.header.ncmds = 1;
+    image.header.sizeofcmds = sizeof(image.uuid);
+    image.uuid.cmd = LC_UUID;
+    image.uuid.cmdsize = sizeof(image.uuid);
+    memset(image.uuid.uuid, 0x11, sizeof(image.uuid.uuid));
+    
+    return [NSData dataWithBytes:&image length:sizeof(image)];
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+//! Serializes \a node with a sink of class \a sinkClass, returning the
+//! output.
+static NSData*
+MKNodeSerializerSpecSerialize(Class sinkClass, MKNode *node, NSUInteger traversalDepth)
+{
+    NSOutputStream *stream = [NSOutputStream outputStreamToMemory];
+    id<MKNodeSerializerSink> sink = [[[sinkClass alloc] initWithOutputStream:stream] autorelease];
+    MKNodeSerializer *serializer = [[[MKNodeSerializer alloc] initWithSink:sink] autorelease];
+    
+    NSError *error = nil;
+    expect([serializer serializeNode:node traversalDepth:traversalDepth error:&error]).to.beTruthy();
+    expect(error).to.beNil();
+    
+    return [stream propertyForKey:NSStreamDataWrittenToMemoryStreamKey];
+}
+
+SpecBegin(MKNodeSerializer)
+
+describe(@"a text sink", ^{
+    __block MKMachOImage *macho;
+    __block NSURL *imageURL;
+    
+    beforeAll(^{
+        imageURL = [[NSURL fileURLWithPath:[NSTemporaryDirectory() stringByAppendingPathComponent:NSUUID.UUID.UUIDString]] retain];
+        [MKNodeSerializerSpecImage() writeToURL:imageURL atomically:YES];
+        
+        MKMemoryMap *map = [MKMemoryMap memoryMapWithContentsOfFile:imageURL error:NULL];
+        macho = [[MKMachOImage alloc] initWithName:"uuid" flags:0 atAddress:0 inMapping:map error:NULL];
+    });
+    
+    afterAll(^{
+        [macho release];
+        macho = nil;
+        [[NSFileManager defaultManager] removeItemAtURL:imageURL error:NULL];
+        [imageURL release];
+    });
+    
+    it(@"should write the textual description", ^{
+        MKLoadCommand *uuid = [macho loadCommandsOfType:LC_UUID].firstObject;
+        expect(uuid).toNot.beNil();
+        
+        // Captured from the formatter that preceded MKNodeSerializer, which
+        // printed the address of the node description instead of the node.
+        NSString *golden = [NSString stringWithFormat:
+            @"<MKLCUUID %p; contextAddress = 0x20; size = 24> {\n"
+            @"\tcmd = LC_UUID\n"
+            @"\tcmdSize = 24\n"
+            @"\tuuid = 11111111-1111-1111-1111-111111111111\n"
+            @"}", uuid];
+        
+        NSData *text = MKNodeSerializerSpecSerialize(MKNodeTextSink.class, uuid, 0);
+        expect([[[NSString alloc] initWithData:text encoding:NSUTF8StringEncoding] autorelease]).to.equal(golden);
+        expect([uuid.layout textualDescriptionForNode:uuid traversalDepth:0]).to.equal(golden);
+    });
+    
+});
+
+describe(@"the largest executable", ^{
+    __block MKMachOImage *macho;
+    
+    beforeAll(^{
+        NSURL *url = [NSFileManager largestExecutableURL:MKFrameworkTypeOSX];
+        Architecture *architecture = [[Binary binaryAtURL:url] architectures].firstObject;
+        if (architecture == nil) return;
+        MKMemoryMap *map = [MKMemoryMap memoryMapWithContentsOfFile:url error:NULL];
+        macho = [[MKMachOImage alloc] initWithName:url.lastPathComponent.UTF8String flags:0 atAddress:architecture.offset inMapping:map error:NULL];
+    });
+    
+    afterAll(^{
+        [macho release];
+        macho = nil;
+    });
+    
+    it(@"should write JSON", ^{
+        MKSymbolTable *symbolTable = macho.symbolTable.value;
+        NSArray<MKSymbol*> *symbols = symbolTable.symbols;
+        NSData *json = MKNodeSerializerSpecSerialize(MKNodeJSONSink.class, symbolTable, 1);
+        
+        NSError *error = nil;
+        NSDictionary *object = [NSJSONSerialization JSONObjectWithData:json options:0 error:&error];
+        expect(error).to.beNil();
+        expect(object[@"$class"]).to.equal(NSStringFromClass(symbolTable.class));
+        expect([object[@"symbols"] count]).to.equal(symbols.count);
+        expect([object[@"symbols"] firstObject][@"$class"]).to.equal(NSStringFromClass(symbols.firstObject.class));
+        expect([object[@"symbols"] firstObject][@"strx"]).to.equal(@(symbols.firstObject.strx));
+    });
+    
+    it(@"should write CBOR", ^{
+        NSData *cbor = MKNodeSerializerSpecSerialize(MKNodeCBORSink.class, macho.symbolTable.value, 1);
+        const uint8_t *bytes = cbor.bytes;
+        
+        // An indefinite length map, whose first key is "$class".
+        expect(cbor.length).to.beGreaterThan(8);
+        expect(bytes[0]).to.equal(0xBF);
+        expect(bytes[1]).to.equal(0x66);
+        expect(memcmp(bytes + 2, "$class", 6)).to.equal(0);
+        expect(bytes[cbor.length - 1]).to.equal(0xFF);
+    });
+    
+    it(@"should stream an image to a file", ^{
+        NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:NSUUID.UUID.UUIDString];
+        
+        [SPTCurrentSpec measureBlock:^{
+            @autoreleasepool {
+                NSOutputStream *stream = [NSOutputStream outputStreamToFileAtPath:path append:NO];
+                MKNodeJSONSink *sink = [[[MKNodeJSONSink alloc] initWithOutputStream:stream] autorelease];
+                MKNodeSerializer *serializer = [[[MKNodeSerializer alloc] initWithSink:sink] autorelease];
+                
+                NSError *error = nil;
+                expect([serializer serializeNode:macho traversalDepth:NSUIntegerMax error:&error]).to.beTruthy();
+                expect(error).to.beNil();
+                [stream close];
+            }
+        }];
+        
+        NSError *error = nil;
+        NSData *json = [NSData dataWithContentsOfFile:path options:NSDataReadingMappedIfSafe error:NULL];
+        expect([NSJSONSerialization JSONObjectWithData:json options:0 error:&error]).toNot.beNil();
+        expect(error).to.beNil();
+        
+        [[NSFileManager defaultManager] removeItemAtPath:path error:NULL];
+    });
+    
+});
+
+SpecEnd
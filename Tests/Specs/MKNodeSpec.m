@@ -0,0 +1,385 @@
+//----------------------------------------------------------------------------//
+//|
+//|             MachOKit - A Lightweight Mach-O Parsing Library
+//|             MKNodeSpec.m
+//|
+//|             D.V.
+//|             Copyright (c) 2014-2015 D.V. All rights reserved.
+//|
+//| Permission is hereby granted, free of charge, to any person obtaining a
+//| copy of this software and associated documentation files (the "Software"),
+//| to deal in the Software without restriction, including without limitation
+//| the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//| and/or sell copies of the Software, and to permit persons to whom the
+//| Software is furnished to do so, subject to the following conditions:
+//|
+//| The above copyright notice and this permission notice shall be included
+//| in all copies or substantial portions of the Software.
+//|
+//| THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//| OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//| MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//| IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//| CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//| TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//| SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//----------------------------------------------------------------------------//
+
+#import <objc/runtime.h>
+
+//----------------------------------------------------------------------------//
+//! A symbol subclass outside of MachOKit whose ranking depends on fields
+//! that are not part of the symbol dispatch key.
+@interface MKNodeSpecSymbol : MKSymbol
+@end
+
+@implementation MKNodeSpecSymbol
+
++ (void)load
+{ [MKNode registerSubclass:self]; }
+
++ (uint32_t)canInstantiateWithEntry:(struct nlist_64)nlist
+{
+    if (self != MKNodeSpecSymbol.class)
+        return 0;
+    
+    return (nlist.n_sect == 0xEE && nlist.n_desc == 0xBEEF) ? 100 : 0;
+}
+
+@end
+
+//----------------------------------------------------------------------------//
+//! A load command subclass outside of MachOKit that is not registered.
+//! It is found by the scan that runs when none of the known subclasses
+//! claim a load command.
+@interface MKNodeSpecUnregisteredLoadCommand : MKLoadCommand
+@end
+
+@implementation MKNodeSpecUnregisteredLoadCommand
+
++ (uint32_t)ID
+{ return 0x7EEE0001; }
+
++ (uint32_t)canInstantiateWithLoadCommandID:(uint32_t)commandID
+{
+    if (self != MKNodeSpecUnregisteredLoadCommand.class)
+        return 0;
+    
+    return commandID == self.ID ? 100 : 0;
+}
+
+@end
+
+//----------------------------------------------------------------------------//
+//! Returns the subclasses of \a baseClass found by examining every class
+//! loaded from an image.  Classes created at runtime must be registered.
+static NSSet* MKNodeSpecScanForSubclasses(Class baseClass)
+{
+    NSMutableSet *subclasses = [NSMutableSet set];
+    
+    unsigned classCount;
+    Class *classes = objc_copyClassList(&classCount);
+    for (unsigned i = 0; i < classCount; i++) {
+        if (class_getImageName(classes[i]) == NULL)
+            continue;
+        
+        for (Class s = class_getSuperclass(classes[i]); s != nil; s = class_getSuperclass(s)) {
+            if (s == baseClass)
+                [subclasses addObject:classes[i]];
+        }
+    }
+    free(classes);
+    
+    return subclasses;
+}
+
+SpecBegin(MKNode)
+
+// The largest of the executables examined by the other specs.
+__block MKMachOImage *macho;
+
+beforeAll(^{
+    NSURL *url = [NSFileManager largestExecutableURL:MKFrameworkTypeOSX];
+    Architecture *architecture = [[Binary binaryAtURL:url] architectures].firstObject;
+    if (architecture == nil)
+        return;
+    
+    MKMemoryMap *map = [MKMemoryMap memoryMapWithContentsOfFile:url error:NULL];
+    macho = [[MKMachOImage alloc] initWithName:url.lastPathComponent.UTF8String flags:0 atAddress:architecture.offset inMapping:map error:NULL];
+});
+
+afterAll(^{
+    [macho release];
+    macho = nil;
+});
+
+describe(@"subclass registry", ^{
+    
+    it(@"should find the same subclasses as a scan of every class", ^{
+        // No known subclass claims this load command, which scans the
+        // loaded images for subclasses that were not registered.
+        [MKLoadCommand classForCommandID:0x7EEE0001];
+        
+        NSSet *expected = MKNodeSpecScanForSubclasses(MKLoadCommand.class);
+        expect(expected).to.contain(MKNodeSpecUnregisteredLoadCommand.class);
+        expect([MKLoadCommand subclasses]).to.equal(expected);
+        
+        expected = MKNodeSpecScanForSubclasses(MKSymbol.class);
+        expect(expected).to.contain(MKNodeSpecSymbol.class);
+        expect([MKSymbol subclasses]).to.equal(expected);
+        
+        expect([MKSection subclasses]).to.equal(MKNodeSpecScanForSubclasses(MKSection.class));
+        expect([MKNode subclasses]).to.equal(MKNodeSpecScanForSubclasses(MKNode.class));
+    });
+    
+    it(@"should select a subclass from another image that was not registered", ^{
+        expect([MKLoadCommand bestSubclassWithRanking:^(Class cls) {
+            return [cls canInstantiateWithLoadCommandID:0x7EEE0001];
+        }]).to.equal(MKNodeSpecUnregisteredLoadCommand.class);
+        expect([MKLoadCommand classForCommandID:0x7EEE0001]).to.equal(MKNodeSpecUnregisteredLoadCommand.class);
+    });
+    
+    it(@"should select a subclass once it is registered", ^{
+        // A class created at runtime does not belong to any image, so only
+        // registering it makes it known.
+        Class cls = objc_allocateClassPair(MKSymbol.class, "MKNodeSpecRuntimeSymbol", 0);
+        Method rankingMethod = class_getClassMethod(MKSymbol.class, @selector(canInstantiateWithEntry:));
+        IMP ranking = imp_implementationWithBlock(^uint32_t(Class receiver, struct nlist_64 entry) {
+            return (receiver == cls && entry.n_sect == 0xEC && entry.n_desc == 0xF00D) ? 100 : 0;
+        });
+        class_addMethod(object_getClass(cls), @selector(canInstantiateWithEntry:), ranking, method_getTypeEncoding(rankingMethod));
+        objc_registerClassPair(cls);
+        
+        struct nlist_64 nlist = { .n_type = N_SECT, .n_sect = 0xEC, .n_desc = 0xF00D };
+        expect([MKSymbol subclasses]).toNot.contain(cls);
+        expect([MKSymbol classForEntry:nlist]).to.equal(MKSectionSymbol.class);
+        
+        [MKNode registerSubclass:cls];
+        
+        expect([MKSymbol subclasses]).to.contain(cls);
+        expect([MKSymbol classForEntry:nlist]).to.equal(cls);
+    });
+    
+    it(@"should discover subclasses from the registry quickly", ^{
+        // The subclass set is cached weakly, so each pass rebuilds it from
+        // the registry.
+        [SPTCurrentSpec measureBlock:^{
+            @autoreleasepool {
+                expect([MKNode subclasses]).to.contain(MKNodeSpecSymbol.class);
+            }
+        }];
+    });
+    
+    it(@"should discover subclasses by scanning every class", ^{
+        // The scan +subclasses performed before the registry, for comparison.
+        [SPTCurrentSpec measureBlock:^{
+            @autoreleasepool {
+                expect(MKNodeSpecScanForSubclasses(MKNode.class)).to.contain(MKNodeSpecSymbol.class);
+            }
+        }];
+    });
+    
+});
+
+describe(@"dispatch tables", ^{
+    
+    it(@"should select the same symbol class as the ranking", ^{
+        for (uint32_t type = 0; type <= UINT8_MAX; type++)
+        for (uint64_t value = 0; value <= 1; value++) {
+            struct nlist_64 nlist = { .n_type = (uint8_t)type, .n_value = value };
+            Class expected = [MKSymbol bestSubclassWithRanking:^(Class cls) {
+                return [cls canInstantiateWithEntry:nlist];
+            }];
+            
+            expect([MKSymbol classForEntry:nlist]).to.equal(expected);
+        }
+    });
+    
+    it(@"should select the same load command class as the ranking", ^{
+        for (uint32_t cmd = 0; cmd < 0x60; cmd++) {
+            uint32_t commandID = cmd | ((cmd & 1) ? LC_REQ_DYLD : 0);
+            Class expected = [MKLoadCommand bestSubclassWithRanking:^(Class cls) {
+                return [cls canInstantiateWithLoadCommandID:commandID];
+            }];
+            
+            if (expected != MKLoadCommand.class)
+                expect([MKLoadCommand classForCommandID:commandID]).to.equal(expected);
+        }
+    });
+    
+    it(@"should select the same section class as the ranking", ^{
+        for (MKSection *section in macho.sections.allValues) {
+            id<MKLCSection> loadCommand = section.loadCommand;
+            MKSegment *segment = (MKSegment*)section.parent;
+            Class expected = [MKSection bestSubclassWithRanking:^(Class cls) {
+                return [cls canInstantiateWithSectionLoadCommand:loadCommand inSegment:segment];
+            }];
+            
+            expect([MKSection classForSectionLoadCommand:loadCommand inSegment:segment]).to.equal(expected);
+            expect(section.class).to.equal(expected);
+        }
+    });
+    
+    it(@"should rank subclasses from other images on every lookup", ^{
+        expect([MKSymbol rankingIsDeterminedByDispatchKeyForSubclass:MKNodeSpecSymbol.class]).to.beFalsy();
+        expect([MKSymbol rankingIsDeterminedByDispatchKeyForSubclass:MKRegularSymbol.class]).to.beTruthy();
+        
+        struct nlist_64 nlist = { .n_type = N_SECT, .n_sect = 0xEE, .n_desc = 0xBEEF };
+        expect([MKSymbol classForEntry:nlist]).to.equal(MKNodeSpecSymbol.class);
+        
+        nlist.n_desc = 0;
+        expect([MKSymbol classForEntry:nlist]).to.equal(MKSectionSymbol.class);
+    });
+    
+});
+
+describe(@"cached node state", ^{
+    __block NSMutableArray<MKBackedNode*> *nodes;
+    
+    // The exports and every ObjC method, including the methods of each
+    // metaclass.
+    NSMutableArray<MKBackedNode*>* (^collectNodes)(void) = ^{
+        NSMutableArray *collected = [NSMutableArray array];
+        [collected addObjectsFromArray:macho.exportsInfo.value.exports ?: @[]];
+        
+        for (MKObjCClassListSection *classList in [macho sectionsWithName:@"__objc_classlist" inSegment:nil]) {
+            for (MKPointerNode<MKObjCClass*> *ptr in classList.elements) {
+                MKObjCClass *cls = ptr.pointee.value;
+                MKObjCClass *metaClass = cls.metaClass.pointee.value;
+                [collected addObjectsFromArray:cls.classData.pointee.value.methods.pointee.value.elements ?: @[]];
+                [collected addObjectsFromArray:metaClass.classData.pointee.value.methods.pointee.value.elements ?: @[]];
+            }
+        }
+        return collected;
+    };
+    
+    beforeAll(^{
+        nodes = [collectNodes() retain];
+    });
+    
+    afterAll(^{
+        [nodes release];
+        nodes = nil;
+    });
+    
+    it(@"should find exports and methods", ^{
+        expect(macho).toNot.beNil();
+        expect(nodes.count).to.beGreaterThan(0);
+    });
+    
+    it(@"should match the addresses computed from the parent", ^{
+        for (MKBackedNode *node in nodes) {
+            if ([node isKindOfClass:MKOffsetNode.class] == NO) continue;
+            MKBackedNode *parent = (MKBackedNode*)node.parent;
+            mk_vm_offset_t offset = ((MKOffsetNode*)node).nodeOffset;
+            
+            expect(node.nodeContextAddress).to.equal(parent.nodeContextAddress + offset);
+            expect(node.nodeVMAddress).to.equal(parent.nodeVMAddress + offset);
+            expect(node.memoryMap).to.equal(parent.memoryMap);
+            expect(node.dataModel).to.equal(parent.dataModel);
+            expect(node.macho).to.equal(macho);
+        }
+    });
+    
+    it(@"should walk all exports and methods quickly", ^{
+        [SPTCurrentSpec measureBlock:^{
+            @autoreleasepool {
+                NSMutableArray<MKBackedNode*> *walked = collectNodes();
+                for (MKBackedNode *node in walked) {
+                    expect(node.nodeContextAddress).toNot.equal(0);
+                    expect(node.nodeVMAddress).toNot.equal(0);
+                    expect(node.memoryMap).to.equal(macho.memoryMap);
+                    expect(node.macho).to.equal(macho);
+                }
+                expect(walked.count).to.equal(nodes.count);
+            }
+        }];
+    });
+    
+});
+
+describe(@"layouts", ^{
+    __block NSArray<MKSymbol*> *symbols;
+    
+    beforeAll(^{
+        symbols = [macho.symbolTable.value.symbols retain];
+    });
+    
+    afterAll(^{
+        [symbols release];
+        symbols = nil;
+    });
+    
+    it(@"should share one layout between nodes of the same class", ^{
+        expect(symbols.count).to.beGreaterThan(0);
+        
+        NSMutableDictionary<NSString*, MKNodeDescription*> *layouts = [NSMutableDictionary dictionary];
+        for (MKSymbol *symbol in symbols) {
+            NSString *className = NSStringFromClass(symbol.class);
+            MKNodeDescription *layout = layouts[className];
+            if (layout == nil) {
+                layout = layouts[className] = symbol.layout;
+                
+                NSArray<MKNodeField*> *built = symbol.buildLayout.allFields;
+                expect(layout.allFields.count).to.equal(built.count);
+                for (NSUInteger i = 0; i < built.count; i++)
+                    expect(layout.allFields[i].name).to.equal(built[i].name);
+            }
+            
+            expect(symbol.layout).to.beIdenticalTo(layout);
+        }
+    });
+    
+    it(@"should read variable length fields from each node", ^{
+        MKCStringSection *section = nil;
+        for (MKSection *candidate in macho.sections.allValues) {
+            if ([candidate isKindOfClass:MKCStringSection.class]) {
+                section = (MKCStringSection*)candidate;
+                break;
+            }
+        }
+        expect(section).toNot.beNil();
+        
+        NSArray<MKCString*> *strings = section.strings;
+        expect(strings.count).to.beGreaterThan(0);
+        
+        for (MKCString *string in [strings subarrayWithRange:NSMakeRange(0, MIN(strings.count, (NSUInteger)100))]) {
+            expect(string.layout).to.beIdenticalTo(strings.firstObject.layout);
+            
+            MKNodeField *field = string.layout.fields.firstObject;
+            expect([field.dataRecipe sizeOfField:field ofNode:string]).to.equal(@(string.nodeSize));
+        }
+    });
+    
+    it(@"should describe 100k symbols without building their layouts", ^{
+        const NSUInteger describeCount = 100000;
+        
+        // Count the fields that building a layout for each description
+        // would allocate, against the fields of the shared layouts.
+        NSUInteger builtFieldCount = 0;
+        NSHashTable *sharedLayouts = [NSHashTable hashTableWithOptions:NSPointerFunctionsObjectPointerPersonality];
+        for (NSUInteger i = 0; i < describeCount; i++) {
+            MKSymbol *symbol = symbols[i % symbols.count];
+            builtFieldCount += symbol.layout.allFields.count;
+            [sharedLayouts addObject:symbol.layout];
+        }
+        NSUInteger sharedFieldCount = 0;
+        for (MKNodeDescription *layout in sharedLayouts)
+            sharedFieldCount += layout.allFields.count;
+        
+        expect(sharedLayouts.count).to.beLessThan(50);
+        expect(sharedFieldCount * 1000).to.beLessThan(builtFieldCount);
+        
+        [SPTCurrentSpec measureBlock:^{
+            @autoreleasepool {
+                for (NSUInteger i = 0; i < describeCount; i++) {
+                    MKSymbol *symbol = symbols[i % symbols.count];
+                    expect([symbol.layout textualDescriptionForNode:symbol traversalDepth:0]).toNot.beNil();
+                }
+            }
+        }];
+    });
+    
+});
+
+SpecEnd
@@ -0,0 +1,310 @@
+//----------------------------------------------------------------------------//
+//|
+//|             MachOKit - A Lightweight Mach-O Parsing Library
+//|             macho_cxx_spec.mm
+//|
+//|             D.V.
+//|             Copyright (c) 2014-2015 D.V. All rights reserved.
+//|
+//| Permission is hereby granted, free of charge, to any person obtaining a
+//| copy of this software and associated documentation files (the "Software"),
+//| to deal in the Software without restriction, including without limitation
+//| the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//| and/or sell copies of the Software, and to permit persons to whom the
+//| Software is furnished to do so, subject to the following conditions:
+//|
+//| The above copyright notice and this permission notice shall be included
+//| in all copies or substantial portions of the Software.
+//|
+//| THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//| OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//| MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//| IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//| CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//| TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//| SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//----------------------------------------------------------------------------//
+
+
+#include <dlfcn.h>
+#include <mach-o/dyld.h>
+#include <MachOKit/macho.hpp>
+
+//|++++++++++++++++++++++++++++++++++++|//
+//! Walks the symbol table of the loaded image at \a index using the C API,
+//! returning the sum of the symbol values.
+static uint64_t
+SumSymbolsWithCAPI(mk_memory_map_self_t *memory_map, uint32_t index, uint32_t *count)
+{
+    uint64_t sum = 0;
+    *count = 0;
+    
+    mk_memory_map_ref map;
+    map.memory_map_self = memory_map;
+    
+    mk_macho_t macho;
+    mk_macho_ref image;
+    image.macho = &macho;
+    if (mk_macho_init_with_slide(NULL, _dyld_get_image_name(index), _dyld_get_image_vmaddr_slide(index), (mk_vm_address_t)_dyld_get_image_header(index), map, &macho) != MK_ESUCCESS)
+        return 0;
+    
+    // Find the __LINKEDIT
+    uint32_t segment_command = mk_macho_is_64_bit(image) ? LC_SEGMENT_64 : LC_SEGMENT;
+    mk_segment_t linkedit;
+    mk_segment_ref segment;
+    segment.segment = &linkedit;
+    bool found = false;
+    
+    struct load_command *mach_load_command = NULL;
+    while ((mach_load_command = mk_macho_next_command_type(image, mach_load_command, segment_command, NULL))) {
+        // segname is at the same offset in segment_command and segment_command_64.
+        if (strncmp(((struct segment_command*)mach_load_command)->segname, SEG_LINKEDIT, 16))
+            continue;
+        
+        mk_macho_segment_load_command_ptr lc;
+        lc.any = mach_load_command;
+        found = (mk_segment_init_with_mach_load_command(image, lc, &linkedit) == MK_ESUCCESS);
+        break;
+    }
+    
+    mk_symbol_table_t symbol_table;
+    mk_symbol_table_ref table;
+    table.symbol_table = &symbol_table;
+    if (found && mk_symbol_table_init_with_segment(segment, &symbol_table) == MK_ESUCCESS) {
+        bool is64 = mk_macho_is_64_bit(image);
+        mk_macho_nlist_ptr symbol;
+        symbol.any = NULL;
+        while ((symbol = mk_symbol_table_next_mach_symbol(table, symbol, NULL, NULL)).any) {
+            sum += is64 ? symbol.nlist_64->n_value : symbol.nlist->n_value;
+            (*count)++;
+        }
+        mk_symbol_table_free(table);
+    }
+    
+    if (found)
+        mk_segment_free(segment);
+    mk_macho_free(image);
+    return sum;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+//! Walks the symbol table of the loaded image at \a index using macho.hpp,
+//! returning the sum of the symbol values.
+static uint64_t
+SumSymbolsWithCXX(uint32_t index, uint32_t *count)
+{
+    uint64_t sum = 0;
+    *count = 0;
+    
+    const struct mach_header *header = _dyld_get_image_header(index);
+    size_t length = sizeof(struct mach_header_64) + header->sizeofcmds;
+    
+    macho::visit(header, length, true, [&](const auto &image) {
+        for (auto symbol : image.symbols()) {
+            sum += symbol.value();
+            (*count)++;
+        }
+    });
+    
+    return sum;
+}
+
+SpecBegin(macho_cxx)
+
+describe(@"macho::image", ^{
+    __block mk_memory_map_self_t *memory_map;
+    
+    beforeAll(^{
+        memory_map = (mk_memory_map_self_t*)malloc(sizeof(*memory_map));
+        expect(mk_memory_map_self_init(NULL, memory_map)).to.equal(MK_ESUCCESS);
+    });
+    
+    it(@"should find the segments and sections of each loaded image", ^{
+        for (uint32_t i = 0; i < _dyld_image_count(); i++) {
+            const struct mach_header *header = _dyld_get_image_header(i);
+            size_t length = sizeof(struct mach_header_64) + header->sizeofcmds;
+            uint32_t ncmds = 0, segments = 0, mismatchedSections = 0;
+            
+            BOOL visited = macho::visit(header, length, true, [&](const auto &image) {
+                ncmds = image.ncmds();
+                for (auto segment : image.segments()) {
+                    segments++;
+                    for (auto section : segment.sections())
+                        if (section.segment_name() != segment.name())
+                            mismatchedSections++;
+                }
+            });
+            
+            expect(visited).to.beTruthy();
+            expect(ncmds).to.equal(header->ncmds);
+            expect(segments).to.beGreaterThan(0);
+            expect(mismatchedSections).to.equal(0);
+        }
+    });
+    
+    it(@"should find the same symbols as the C API", ^{
+        for (uint32_t i = 0; i < _dyld_image_count(); i++) {
+            uint32_t cCount, cxxCount;
+            uint64_t cSum = SumSymbolsWithCAPI(memory_map, i, &cCount);
+            uint64_t cxxSum = SumSymbolsWithCXX(i, &cxxCount);
+            
+            expect(cxxCount).to.equal(cCount);
+            expect(cxxSum).to.equal(cSum);
+        }
+    });
+    
+    it(@"should find exports", ^{
+        Dl_info info;
+        expect(dladdr((const void*)&NSLog, &info)).toNot.equal(0);
+        
+        const struct mach_header *header = (const struct mach_header*)info.dli_fbase;
+        size_t length = sizeof(struct mach_header_64) + header->sizeofcmds;
+        uintptr_t address = 0;
+        
+        macho::visit(header, length, true, [&](const auto &image) {
+            for (auto &entry : image.exports())
+                if (entry.name == "_NSLog")
+                    address = (uintptr_t)header + (uintptr_t)entry.address;
+        });
+        
+        expect(address).to.equal((uintptr_t)&NSLog);
+    });
+    
+    it(@"should find the strings of the string table", ^{
+        Dl_info info;
+        expect(dladdr((const void*)&NSLog, &info)).toNot.equal(0);
+        
+        const struct mach_header *header = (const struct mach_header*)info.dli_fbase;
+        size_t length = sizeof(struct mach_header_64) + header->sizeofcmds;
+        size_t tableSize = 0, consumed = 0;
+        uint32_t misplacedStrings = 0, mismatchedNames = 0;
+        bool foundNSLog = false;
+        
+        macho::visit(header, length, true, [&](const auto &image) {
+            std::string_view table = image.string_table();
+            tableSize = table.size();
+            
+            // Each string starts after the terminator of the previous one.
+            for (auto string : image.strings()) {
+                if (string.data() != table.data() + consumed)
+                    misplacedStrings++;
+                consumed += string.size() + 1;
+            }
+            
+            for (auto symbol : image.symbols()) {
+                uint32_t strx = symbol.strx();
+                if (strx >= table.size())
+                    continue;
+                std::string_view expected(table.data() + strx, strnlen(table.data() + strx, table.size() - strx));
+                if (image.name_of(symbol) != expected)
+                    mismatchedNames++;
+                if (expected == "_NSLog")
+                    foundNSLog = true;
+            }
+        });
+        
+        expect(tableSize).to.beGreaterThan(0);
+        expect(consumed).to.beGreaterThanOrEqualTo(tableSize);
+        expect(misplacedStrings).to.equal(0);
+        expect(mismatchedNames).to.equal(0);
+        expect(foundNSLog).to.beTruthy();
+    });
+    
+    it(@"should visit each node of a cyclic exports trie once", ^{
+        // The root has two edges that lead back to itself, and a child
+        // with a terminal that points at its own offset.
+        const uint8_t trie[] = {
+            0x00, 0x03, 'a', 0, 0x00, 'b', 0, 0x00, '_', 'f', 0, 0x0C,
+            0x02, 0x00, 0x20, 0x01, 'x', 0, 0x0C
+        };
+        size_t count = 0;
+        std::string_view name;
+        
+        for (macho::export_iterator it(trie, trie + sizeof(trie)), end; it != end && count < 16; ++it, ++count)
+            name = it->name;
+        
+        expect(count).to.equal(1);
+        expect(name == "_f").to.beTruthy();
+    });
+    
+    it(@"should stop walking an exports trie whose edges share nodes", ^{
+        // Each node has two edges to the next node, so a walk that entered
+        // every path would visit the terminal 2^15 times.
+        enum { nodeCount = 15, nodeSize = 8 };
+        uint8_t trie[nodeCount * nodeSize + 4];
+        for (uint8_t i = 0; i < nodeCount; i++) {
+            uint8_t next = (uint8_t)((i + 1) * nodeSize);
+            const uint8_t node[nodeSize] = { 0x00, 0x02, 'a', 0, next, 'b', 0, next };
+            memcpy(trie + i * nodeSize, node, nodeSize);
+        }
+        const uint8_t terminal[4] = { 0x02, 0x00, 0x10, 0x00 };
+        memcpy(trie + nodeCount * nodeSize, terminal, sizeof(terminal));
+        
+        size_t count = 0;
+        for (macho::export_iterator it(trie, trie + sizeof(trie)), end; it != end; ++it)
+            count++;
+        
+        expect(count).to.beGreaterThan(0);
+        expect(count).to.beLessThanOrEqualTo(sizeof(trie) / 2);
+    });
+    
+    it(@"should iterate an empty string table", ^{
+        const char table[1] = { 0 };
+        macho::string_iterator begin(table, table), end(table, table);
+        
+        expect(begin == end).to.beTruthy();
+        expect((*begin).size()).to.equal(0);
+    });
+    
+    it(@"should iterate symbols with the C API", ^{
+        uint64_t expectedSum = 0;
+        uint32_t expectedTotal = 0;
+        for (uint32_t i = 0; i < _dyld_image_count(); i++) {
+            uint32_t count;
+            expectedSum += SumSymbolsWithCXX(i, &count);
+            expectedTotal += count;
+        }
+        
+        [SPTCurrentSpec measureBlock:^{
+            uint64_t sum = 0;
+            uint32_t total = 0;
+            for (uint32_t i = 0; i < _dyld_image_count(); i++) {
+                uint32_t count;
+                sum += SumSymbolsWithCAPI(memory_map, i, &count);
+                total += count;
+            }
+            
+            expect(total).to.equal(expectedTotal);
+            expect(sum).to.equal(expectedSum);
+        }];
+    });
+    
+    it(@"should iterate symbols with macho.hpp", ^{
+        uint64_t expectedSum = 0;
+        uint32_t expectedTotal = 0;
+        for (uint32_t i = 0; i < _dyld_image_count(); i++) {
+            uint32_t count;
+            expectedSum += SumSymbolsWithCAPI(memory_map, i, &count);
+            expectedTotal += count;
+        }
+        
+        [SPTCurrentSpec measureBlock:^{
+            uint64_t sum = 0;
+            uint32_t total = 0;
+            for (uint32_t i = 0; i < _dyld_image_count(); i++) {
+                uint32_t count;
+                sum += SumSymbolsWithCXX(i, &count);
+                total += count;
+            }
+            
+            expect(total).to.equal(expectedTotal);
+            expect(sum).to.equal(expectedSum);
+        }];
+    });
+    
+    afterAll(^{
+        free(memory_map);
+    });
+});
+
+SpecEnd
@@ -135,6 +135,59 @@ SpecBegin(macho_image)
                 expect(uuid_load_command->cmd).to.equal(LC_UUID);
             });
             
+            //----------------------------------------------------------------//
+            describe(@"summary", ^{
+                mk_macho_summary_t *summary = malloc(sizeof(*summary));
+                afterAll(^{
+                    free(summary);
+                });
+                
+                mk_error_t err = mk_macho_summarize(memory_map, loadAddress, summary);
+                it(@"should summarize", ^{
+                    expect(err).to.equal(MK_ESUCCESS);
+                });
+                if (err != MK_ESUCCESS) return;
+                
+                it(@"should match the header", ^{
+                    expect(summary->cputype).to.equal(mk_macho_get_cpu_type(image));
+                    expect(summary->filetype).to.equal(mk_macho_get_filetype(image));
+                    expect(summary->ncmds).to.equal(mk_macho_get_ncmds(image));
+                    expect(summary->sizeofcmds).to.equal(mk_macho_get_sizeofcmds(image));
+                });
+                
+                it(@"should have the correct UUID", ^{
+                    struct uuid_command *uuid_load_command = (struct uuid_command*)mk_macho_find_command(image, LC_UUID, NULL);
+                    expect(summary->has_uuid).to.beTruthy();
+                    if (uuid_load_command == NULL) return;
+                    expect(memcmp(summary->uuid, uuid_load_command->uuid, 16)).to.equal(0);
+                });
+                
+                it(@"should have the correct number of dependent libraries", ^{
+                    uint32_t count = 0;
+                    struct load_command *previous = NULL;
+                    while ((previous = mk_macho_next_command(image, previous, NULL))) {
+                        switch (previous->cmd) {
+                            case LC_LOAD_DYLIB:
+                            case LC_LOAD_WEAK_DYLIB:
+                            case LC_REEXPORT_DYLIB:
+                            case LC_LAZY_LOAD_DYLIB:
+                            case LC_LOAD_UPWARD_DYLIB:
+                                count++;
+                            default:
+                                break;
+                        }
+                    }
+                    
+                    expect(summary->dylib_count).to.equal(count);
+                });
+                
+                it(@"should have the install name of the image", ^{
+                    if (mk_macho_get_filetype(image) != MH_DYLIB) return;
+                    expect(summary->has_id_dylib).to.beTruthy();
+                    expect(strlen(mk_macho_summary_get_string(summary, summary->id_dylib.name))).to.beGreaterThan(0);
+                });
+            });
+            
             describe(@"load command", ^{
                 uint32_t count = 0;
                 struct load_command *mach_load_command = NULL;
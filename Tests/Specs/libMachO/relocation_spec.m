@@ -0,0 +1,192 @@
+//----------------------------------------------------------------------------//
+//|
+//|             MachOKit - A Lightweight Mach-O Parsing Library
+//|             relocation_spec.m
+//|
+//|             D.V.
+//|             Copyright (c) 2014-2015 D.V. All rights reserved.
+//|
+//| Permission is hereby granted, free of charge, to any person obtaining a
+//| copy of this software and associated documentation files (the "Software"),
+//| to deal in the Software without restriction, including without limitation
+//| the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//| and/or sell copies of the Software, and to permit persons to whom the
+//| Software is furnished to do so, subject to the following conditions:
+//|
+//| The above copyright notice and this permission notice shall be included
+//| in all copies or substantial portions of the Software.
+//|
+//| THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//| OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//| MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//| IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//| CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//| TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//| SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//----------------------------------------------------------------------------//
+
+
+#include <TargetConditionals.h>
+#include <libkern/OSByteOrder.h>
+#include <mach-o/x86_64/reloc.h>
+
+SpecBegin(relocation)
+
+describe(@"mk_relocation_decode", ^{
+    
+    it(@"should decode an x86_64 extern branch relocation", ^{
+        // r_address = 0x11, r_symbolnum = 3, r_pcrel = 1, r_length = 2,
+        // r_extern = 1, r_type = X86_64_RELOC_BRANCH (2)
+        uint32_t raw[2] = { 0x11, (2U << 28) | (1U << 27) | (2U << 25) | (1U << 24) | 3 };
+        mk_relocation_t reloc;
+        
+        mk_relocation_decode((struct relocation_info*)raw, 1, CPU_TYPE_X86_64, &mk_byteorder_direct, &reloc);
+        
+        expect(reloc.address).to.equal(@(0x11));
+        expect(reloc.symbol_or_section).to.equal(@(3));
+        expect(reloc.type).to.equal(@(2));
+        expect(reloc.length).to.equal(@(2));
+        expect((uint8_t)reloc.pcrel).to.equal(@(1));
+        expect((uint8_t)reloc.is_extern).to.equal(@(1));
+        expect((uint8_t)reloc.is_scattered).to.equal(@(0));
+    });
+    
+    it(@"should decode an arm64 local page relocation", ^{
+        // r_address = 0x40, r_symbolnum = 1 (section ordinal), r_pcrel = 1,
+        // r_length = 2, r_extern = 0, r_type = ARM64_RELOC_PAGE21 (3)
+        uint32_t raw[2] = { 0x40, (3U << 28) | (2U << 25) | (1U << 24) | 1 };
+        mk_relocation_t reloc;
+        
+        mk_relocation_decode((struct relocation_info*)raw, 1, CPU_TYPE_ARM64, &mk_byteorder_direct, &reloc);
+        
+        expect(reloc.address).to.equal(@(0x40));
+        expect(reloc.symbol_or_section).to.equal(@(1));
+        expect(reloc.type).to.equal(@(3));
+        expect((uint8_t)reloc.is_extern).to.equal(@(0));
+    });
+    
+    it(@"should decode a scattered i386 relocation", ^{
+        uint32_t raw[2] = { R_SCATTERED | (1U << 30) | (2U << 28) | (1U << 24) | 0x20, 0x1000 };
+        mk_relocation_t reloc;
+        
+        mk_relocation_decode((struct relocation_info*)raw, 1, CPU_TYPE_I386, &mk_byteorder_direct, &reloc);
+        
+        expect((uint8_t)reloc.is_scattered).to.equal(@(1));
+        expect(reloc.address).to.equal(@(0x20));
+        expect(reloc.type).to.equal(@(1));
+        expect(reloc.length).to.equal(@(2));
+        expect((uint8_t)reloc.pcrel).to.equal(@(1));
+        expect(reloc.symbol_or_section).to.equal(@(0x1000));
+    });
+    
+    it(@"should not treat the high bit as scattered on 64-bit architectures", ^{
+        uint32_t raw[2] = { 0x80000000, 0 };
+        mk_relocation_t reloc;
+        
+        mk_relocation_decode((struct relocation_info*)raw, 1, CPU_TYPE_X86_64, &mk_byteorder_direct, &reloc);
+        
+        expect((uint8_t)reloc.is_scattered).to.equal(@(0));
+        expect(reloc.address).to.equal(@(0x80000000));
+    });
+    
+    it(@"should decode relocations from a byte-swapped image", ^{
+        // The same fields as the x86_64 branch relocation, in the big-endian
+        // bitfield layout and byte order.
+        uint32_t raw[2] = { OSSwapInt32(0x11), OSSwapInt32((3U << 8) | (1U << 7) | (2U << 5) | (1U << 4) | 2) };
+        mk_relocation_t reloc;
+        
+        mk_relocation_decode((struct relocation_info*)raw, 1, CPU_TYPE_POWERPC64, &mk_byteorder_swapped, &reloc);
+        
+        expect(reloc.address).to.equal(@(0x11));
+        expect(reloc.symbol_or_section).to.equal(@(3));
+        expect(reloc.type).to.equal(@(2));
+        expect(reloc.length).to.equal(@(2));
+        expect((uint8_t)reloc.pcrel).to.equal(@(1));
+        expect((uint8_t)reloc.is_extern).to.equal(@(1));
+        expect((uint8_t)reloc.is_scattered).to.equal(@(0));
+    });
+});
+
+describe(@"mk_section_copy_relocations", ^{
+    mk_memory_map_self_t *memory_map = malloc(sizeof(*memory_map));
+    if (mk_memory_map_self_init(NULL, memory_map) != MK_ESUCCESS) return;
+    
+    // A relocatable object with a single __TEXT,__text section that has two
+    // relocation entries.
+    struct _dummy {
+        struct mach_header_64 header;
+        struct segment_command_64 segment;
+        struct section_64 section;
+        uint8_t text[16];
+        uint32_t relocations[4];
+    };
+    struct _dummy *dummy = calloc(1, sizeof(*dummy));
+    
+    dummy->header.magic = MH_MAGIC_64;
+    dummy->header.cputype = CPU_TYPE_X86_64;
+    dummy->header.filetype = MH_OBJECT;
+    dummy->header.ncmds = 1;
+    dummy->header.sizeofcmds = sizeof(dummy->segment) + sizeof(dummy->section);
+    
+    // Objects are never loaded by dyld.  The segment starts at address zero
+    // and the image is slid to wherever the dummy lives in memory.
+    dummy->segment.cmd = LC_SEGMENT_64;
+    dummy->segment.cmdsize = sizeof(dummy->segment) + sizeof(dummy->section);
+    dummy->segment.vmsize = sizeof(*dummy);
+    dummy->segment.filesize = sizeof(*dummy);
+    dummy->segment.nsects = 1;
+    
+    strncpy(dummy->section.sectname, SECT_TEXT, sizeof(dummy->section.sectname));
+    strncpy(dummy->section.segname, SEG_TEXT, sizeof(dummy->section.segname));
+    dummy->section.addr = offsetof(struct _dummy, text);
+    dummy->section.size = sizeof(dummy->text);
+    dummy->section.offset = offsetof(struct _dummy, text);
+    dummy->section.reloff = offsetof(struct _dummy, relocations);
+    dummy->section.nreloc = 2;
+    
+    // X86_64_RELOC_BRANCH to symbol 3, then X86_64_RELOC_UNSIGNED against
+    // section 1.
+    dummy->relocations[0] = 0x1;
+    dummy->relocations[1] = (X86_64_RELOC_BRANCH << 28) | (1U << 27) | (2U << 25) | (1U << 24) | 3;
+    dummy->relocations[2] = 0x8;
+    dummy->relocations[3] = (X86_64_RELOC_UNSIGNED << 28) | (3U << 25) | 1;
+    
+    mk_macho_t *macho = malloc(sizeof(*macho));
+    NSParameterAssert(mk_macho_init_with_slide(NULL, "Test", (mk_vm_slide_t)dummy, (mk_vm_address_t)dummy, memory_map, macho) == MK_ESUCCESS);
+    mk_segment_t *segment = malloc(sizeof(*segment));
+    NSParameterAssert(mk_segment_init_with_mach_load_command(macho, &dummy->segment, segment) == MK_ESUCCESS);
+    mk_section_t *section = malloc(sizeof(*section));
+    NSParameterAssert(mk_section_init_wih_mach_section_command(segment, &dummy->section, section) == MK_ESUCCESS);
+    
+    it(@"should decode every entry of an MH_OBJECT section", ^{
+        mk_relocation_t relocations[4];
+        mk_error_t err = MK_EINTERNAL_ERROR;
+        
+        uint32_t count = mk_section_copy_relocations(section, 0, relocations, 4, &err);
+        expect(err).to.equal(MK_ESUCCESS);
+        expect(count).to.equal(2);
+        
+        expect(relocations[0].address).to.equal(@(0x1));
+        expect(relocations[0].symbol_or_section).to.equal(@(3));
+        expect(relocations[0].type).to.equal(@(X86_64_RELOC_BRANCH));
+        expect((uint8_t)relocations[0].pcrel).to.equal(@(1));
+        expect((uint8_t)relocations[0].is_extern).to.equal(@(1));
+        
+        expect(relocations[1].address).to.equal(@(0x8));
+        expect(relocations[1].symbol_or_section).to.equal(@(1));
+        expect(relocations[1].type).to.equal(@(X86_64_RELOC_UNSIGNED));
+        expect(relocations[1].length).to.equal(@(3));
+        expect((uint8_t)relocations[1].is_extern).to.equal(@(0));
+    });
+    
+    it(@"should start at the requested index", ^{
+        mk_relocation_t relocation;
+        mk_error_t err = MK_EINTERNAL_ERROR;
+        
+        expect(mk_section_copy_relocations(section, 1, &relocation, 1, &err)).to.equal(1);
+        expect(err).to.equal(MK_ESUCCESS);
+        expect(relocation.address).to.equal(@(0x8));
+    });
+});
+
+SpecEnd
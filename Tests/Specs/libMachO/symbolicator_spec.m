@@ -0,0 +1,187 @@
+//----------------------------------------------------------------------------//
+//|
+//|             MachOKit - A Lightweight Mach-O Parsing Library
+//|             symbolicator_spec.m
+//|
+//|             D.V.
+//|             Copyright (c) 2014-2015 D.V. All rights reserved.
+//|
+//| Permission is hereby granted, free of charge, to any person obtaining a
+//| copy of this software and associated documentation files (the "Software"),
+//| to deal in the Software without restriction, including without limitation
+//| the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//| and/or sell copies of the Software, and to permit persons to whom the
+//| Software is furnished to do so, subject to the following conditions:
+//|
+//| The above copyright notice and this permission notice shall be included
+//| in all copies or substantial portions of the Software.
+//|
+//| THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//| OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//| MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//| IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//| CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//| TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//| SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//----------------------------------------------------------------------------//
+
+
+SpecBegin(symbolicator)
+
+describe(@"mk_symbolicate", ^{
+    __block MKMachOImage *macho;
+    __block MKImageIndex *index;
+    
+    beforeAll(^{
+        NSURL *url = [NSFileManager largestExecutableURL:MKFrameworkTypeOSX];
+        Architecture *architecture = [[Binary binaryAtURL:url] architectures].firstObject;
+        
+        NSError *error = nil;
+        MKMemoryMap *map = [MKMemoryMap memoryMapWithContentsOfFile:url error:&error];
+        macho = [[MKMachOImage alloc] initWithName:url.lastPathComponent.UTF8String flags:0 atAddress:architecture.offset inMapping:map error:&error];
+        index = [[MKImageIndex alloc] initWithData:[MKImageIndex indexDataForImage:macho error:&error] error:&error];
+        expect(index).toNot.beNil();
+    });
+    
+    afterAll(^{
+        [index release];
+        index = nil;
+        [macho release];
+        macho = nil;
+    });
+    
+    it(@"should match a lookup of each symbol", ^{
+        const mk_image_index_t *idx = index.index;
+        uint64_t slide = 0x10000;
+        mk_symbolicator_image_t image = { idx, idx->header->vmaddr + slide };
+        mk_symbolicator_t symbolicator;
+        uint32_t imageOrder[2];
+        expect(mk_symbolicator_init(&symbolicator, &image, 1, imageOrder)).to.equal(MK_ESUCCESS);
+        
+        uint32_t count = MIN(idx->header->function_starts.count, (uint32_t)1024);
+        mk_symbolicator_frame_t *frames = calloc(count, sizeof(*frames));
+        mk_symbolication_result_t *results = calloc(count, sizeof(*results));
+        uint32_t *scratch = calloc(count, sizeof(*scratch));
+        
+        // Frames in reverse order, one byte past the start of each function.
+        for (uint32_t i = 0; i < count; i++) {
+            frames[i].address = idx->function_starts[count - 1 - i] + slide + 1;
+            frames[i].image_load_address = image.load_address;
+        }
+        
+        expect(mk_symbolicate(&symbolicator, frames, count, results, scratch)).to.equal(MK_ESUCCESS);
+        
+        for (uint32_t i = 0; i < count; i++) {
+            expect(results[i].image).to.equal(0);
+            expect(results[i].unslid_address).to.equal(frames[i].address - slide);
+            expect(results[i].symbol_address).to.equal(idx->function_starts[count - 1 - i]);
+            if (results[i].source == MK_SYMBOLICATION_SOURCE_SYMBOL_TABLE)
+                expect(mk_image_index_find_symbol_for_address(idx, results[i].unslid_address)->address).to.equal(results[i].symbol_address);
+        }
+        
+        free(scratch);
+        free(results);
+        free(frames);
+    });
+    
+    it(@"should not resolve frames in unknown images", ^{
+        mk_symbolicator_image_t image = { index.index, 0x1000 };
+        mk_symbolicator_frame_t frame = { .address = 0x2000, .image_load_address = 0x5000 };
+        mk_symbolication_result_t result;
+        mk_symbolicator_t symbolicator;
+        uint32_t imageOrder[2];
+        uint32_t scratch;
+        
+        expect(mk_symbolicator_init(&symbolicator, &image, 1, imageOrder)).to.equal(MK_ESUCCESS);
+        expect(mk_symbolicate(&symbolicator, &frame, 1, &result, &scratch)).to.equal(MK_ESUCCESS);
+        expect(result.image).to.equal(UINT32_MAX);
+        expect(result.source).to.equal(MK_SYMBOLICATION_SOURCE_NONE);
+        
+        frame.has_uuid = true;
+        memset(frame.image_uuid, 0xFF, sizeof(frame.image_uuid));
+        expect(mk_symbolicate(&symbolicator, &frame, 1, &result, &scratch)).to.equal(MK_ESUCCESS);
+        expect(result.image).to.equal(UINT32_MAX);
+    });
+    
+    it(@"should find the image of each frame by UUID or load address", ^{
+        enum { imageCount = 64 };
+        mk_symbolicator_image_t images[imageCount];
+        uint32_t imageOrder[2 * imageCount];
+        mk_symbolicator_t symbolicator;
+        
+        // The images are loaded in descending order.
+        for (uint32_t i = 0; i < imageCount; i++)
+            images[i] = (mk_symbolicator_image_t){ index.index, 0x100000000ULL * (imageCount - i) };
+        
+        expect(mk_symbolicator_init(&symbolicator, images, imageCount, imageOrder)).to.equal(MK_ESUCCESS);
+        
+        mk_symbolicator_frame_t frames[imageCount];
+        mk_symbolication_result_t results[imageCount];
+        uint32_t scratch[imageCount];
+        
+        for (uint32_t i = 0; i < imageCount; i++)
+            frames[i] = (mk_symbolicator_frame_t){ .address = images[i].load_address, .image_load_address = images[i].load_address };
+        
+        expect(mk_symbolicate(&symbolicator, frames, imageCount, results, scratch)).to.equal(MK_ESUCCESS);
+        for (uint32_t i = 0; i < imageCount; i++)
+            expect(results[i].image).to.equal(i);
+        
+        // Every image has the same UUID; the first is found.
+        frames[0].has_uuid = true;
+        memcpy(frames[0].image_uuid, index.index->header->uuid, sizeof(frames[0].image_uuid));
+        expect(mk_symbolicate(&symbolicator, frames, 1, results, scratch)).to.equal(MK_ESUCCESS);
+        expect(results[0].image).to.equal(0);
+    });
+    
+    it(@"should only walk exports with an address in the image", ^{
+        const mk_image_index_t *idx = index.index;
+        
+        for (uint32_t i = 0; i < idx->header->exports_by_address.count; i++) {
+            uint32_t flags = idx->exports[idx->exports_by_address[i]].flags;
+            expect(flags & EXPORT_SYMBOL_FLAGS_REEXPORT).to.equal(0);
+            expect(flags & EXPORT_SYMBOL_FLAGS_KIND_MASK).to.equal(EXPORT_SYMBOL_FLAGS_KIND_REGULAR);
+        }
+    });
+    
+    it(@"should symbolicate frames quickly", ^{
+        const mk_image_index_t *idx = index.index;
+        mk_symbolicator_image_t image = { idx, idx->header->vmaddr };
+        mk_symbolicator_t symbolicator;
+        uint32_t imageOrder[2];
+        expect(mk_symbolicator_init(&symbolicator, &image, 1, imageOrder)).to.equal(MK_ESUCCESS);
+        
+        const uint32_t count = 512;
+        const uint32_t iterations = 2000;
+        mk_symbolicator_frame_t *frames = calloc(count, sizeof(*frames));
+        mk_symbolication_result_t *results = calloc(count, sizeof(*results));
+        uint32_t *scratch = calloc(count, sizeof(*scratch));
+        
+        uint64_t textSize = idx->header->segments.count ? idx->segments[0].vmsize : 0;
+        for (uint32_t i = 0; i < count; i++) {
+            frames[i].address = idx->header->vmaddr + (textSize ? arc4random_uniform((uint32_t)MIN(textSize, UINT32_MAX)) : 0);
+            frames[i].image_load_address = image.load_address;
+        }
+        
+        __block uint64_t fastest = UINT64_MAX;
+        [SPTCurrentSpec measureBlock:^{
+            uint64_t start = clock_gettime_nsec_np(CLOCK_UPTIME_RAW);
+            for (uint32_t i = 0; i < iterations; i++)
+                mk_symbolicate(&symbolicator, frames, count, results, scratch);
+            fastest = MIN(fastest, clock_gettime_nsec_np(CLOCK_UPTIME_RAW) - start);
+        }];
+        
+        NSLog(@"Symbolicated %.0f frames/sec in %@", (double)count * iterations * NSEC_PER_SEC / MAX(fastest, (uint64_t)1), macho.name);
+        
+        for (uint32_t i = 0; i < count; i++) {
+            expect(results[i].image).to.equal(0);
+            expect(results[i].source).toNot.equal(MK_SYMBOLICATION_SOURCE_NONE);
+            expect(results[i].symbol_address).to.beLessThanOrEqualTo(results[i].unslid_address);
+        }
+        
+        free(scratch);
+        free(results);
+        free(frames);
+    });
+});
+
+SpecEnd
@@ -42,6 +42,10 @@ typedef NS_OPTIONS(NSUInteger, MKExecutableType) {
 
 + (NSArray*)allExecutableURLs:(MKExecutableType)type;
 
+//! The largest of \ref allExecutableURLs:, for specs that measure
+//! performance.
++ (NSURL*)largestExecutableURL:(MKExecutableType)type;
+
 + (NSArray*)sharedCachesInDirectoryAtURL:(NSURL*)directoryURL;
 
 @end
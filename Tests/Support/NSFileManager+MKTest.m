@@ -103,6 +103,23 @@
     return retValue;
 }
 
+//|++++++++++++++++++++++++++++++++++++|//
++ (NSURL*)largestExecutableURL:(MKExecutableType)type
+{
+    NSURL *retValue = nil;
+    unsigned long long largestSize = 0;
+    
+    for (NSURL *url in [self allExecutableURLs:type]) {
+        NSNumber *size = nil;
+        if ([url getResourceValue:&size forKey:NSURLFileSizeKey error:NULL] && size.unsignedLongLongValue > largestSize) {
+            largestSize = size.unsignedLongLongValue;
+            retValue = url;
+        }
+    }
+    
+    return retValue;
+}
+
 //|++++++++++++++++++++++++++++++++++++|//
 + (NSArray*)sharedCachesInDirectoryAtURL:(NSURL*)directoryURL
 {
@@ -0,0 +1,135 @@
+//----------------------------------------------------------------------------//
+//|
+//|             MachOKit - A Lightweight Mach-O Parsing Library
+//|             relocation.c
+//|
+//|             D.V.
+//|             Copyright (c) 2014-2015 D.V. All rights reserved.
+//|
+//| Permission is hereby granted, free of charge, to any person obtaining a
+//| copy of this software and associated documentation files (the "Software"),
+//| to deal in the Software without restriction, including without limitation
+//| the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//| and/or sell copies of the Software, and to permit persons to whom the
+//| Software is furnished to do so, subject to the following conditions:
+//|
+//| The above copyright notice and this permission notice shall be included
+//| in all copies or substantial portions of the Software.
+//|
+//| THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//| OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//| MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//| IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//| CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//| TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//| SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//----------------------------------------------------------------------------//
+
+
+#include "macho_abi_internal.h"
+
+//----------------------------------------------------------------------------//
+#pragma mark -  Decoding Relocation Entries
+//----------------------------------------------------------------------------//
+
+//|++++++++++++++++++++++++++++++++++++|//
+void
+mk_relocation_decode(const struct relocation_info *entries, uint32_t count, cpu_type_t cpu_type, const mk_byteorder_t *byte_order, mk_relocation_t *output)
+{
+    // Scattered relocations are only used by 32-bit architectures.  On 64-bit
+    // architectures the high bit of r_address is never set.
+    bool scattered_allowed = !(cpu_type & CPU_ARCH_ABI64)
+#ifdef CPU_TYPE_ARM64_32
+                             && cpu_type != CPU_TYPE_ARM64_32
+#endif
+                             ;
+    
+    // The bitfields of the second word are laid out in the byte order of the
+    // image.  Resolve which layout applies once, outside the loop.
+#if TARGET_RT_BIG_ENDIAN
+    bool big_endian = (byte_order != &mk_byteorder_swapped);
+#else
+    bool big_endian = (byte_order == &mk_byteorder_swapped);
+#endif
+    
+    const uint32_t *words = (const uint32_t*)entries;
+    
+    for (uint32_t i = 0; i < count; i++, words += 2, output++) {
+        uint32_t w0 = byte_order->swap32(words[0]);
+        uint32_t w1 = byte_order->swap32(words[1]);
+        
+        if (scattered_allowed && (w0 & R_SCATTERED)) {
+            output->address = w0 & 0x00ffffff;
+            output->type = (uint8_t)((w0 >> 24) & 0xf);
+            output->length = (uint8_t)((w0 >> 28) & 0x3);
+            output->pcrel = (w0 >> 30) & 0x1;
+            output->is_extern = 0;
+            output->is_scattered = 1;
+            output->symbol_or_section = w1;
+        } else if (big_endian) {
+            output->address = w0;
+            output->symbol_or_section = w1 >> 8;
+            output->pcrel = (w1 >> 7) & 0x1;
+            output->length = (uint8_t)((w1 >> 5) & 0x3);
+            output->is_extern = (w1 >> 4) & 0x1;
+            output->type = (uint8_t)(w1 & 0xf);
+            output->is_scattered = 0;
+        } else {
+            output->address = w0;
+            output->symbol_or_section = w1 & 0x00ffffff;
+            output->pcrel = (w1 >> 24) & 0x1;
+            output->length = (uint8_t)((w1 >> 25) & 0x3);
+            output->is_extern = (w1 >> 27) & 0x1;
+            output->type = (uint8_t)((w1 >> 28) & 0xf);
+            output->is_scattered = 0;
+        }
+    }
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+uint32_t
+mk_section_copy_relocations(mk_section_ref section, uint32_t index, mk_relocation_t *relocations, uint32_t count, mk_error_t *error)
+{
+    mk_error_t err;
+    mk_macho_ref image = mk_segment_get_macho(section.section->segment);
+    mk_memory_map_ref memory_map = mk_macho_get_memory_map(image);
+    
+    uint32_t nreloc = mk_section_get_nreloc(section);
+    uint32_t reloff = mk_section_get_reloff(section);
+    
+    if (nreloc == 0 || reloff == 0) {
+        MK_ERROR_OUT = MK_ENOT_FOUND;
+        return 0;
+    }
+    
+    if (index >= nreloc || relocations == NULL || count == 0) {
+        MK_ERROR_OUT = MK_ESUCCESS;
+        return 0;
+    }
+    
+    count = MIN(count, nreloc - index);
+    
+    // The relocation entries are referenced by file offset.  Relocatable
+    // objects are never loaded by dyld so the file offset is relative to the
+    // start of the header.
+    mk_vm_address_t address = mk_macho_get_address(image);
+    if ((err = mk_vm_address_apply_offset(address, (mk_vm_offset_t)reloff + (mk_vm_offset_t)index * sizeof(struct relocation_info), &address))) {
+        MK_ERROR_OUT = err;
+        return 0;
+    }
+    
+    // Map all of the requested entries at once and decode them in a single
+    // pass.
+    mk_memory_object_t mobj;
+    if ((err = mk_memory_map_init_object(memory_map, 0, address, (mk_vm_size_t)count * sizeof(struct relocation_info), true, &mobj))) {
+        MK_ERROR_OUT = err;
+        return 0;
+    }
+    
+    mk_relocation_decode((const struct relocation_info*)mk_memory_object_address(&mobj), count, mk_macho_get_cpu_type(image), mk_macho_get_byte_order(image), relocations);
+    
+    mk_memory_map_free_object(memory_map, &mobj);
+    
+    MK_ERROR_OUT = MK_ESUCCESS;
+    return count;
+}
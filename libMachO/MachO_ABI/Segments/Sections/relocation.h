@@ -0,0 +1,112 @@
+//----------------------------------------------------------------------------//
+//|
+//|             MachOKit - A Lightweight Mach-O Parsing Library
+//! @file       relocation.h
+//!
+//! @author     D.V.
+//! @copyright  Copyright (c) 2014-2015 D.V. All rights reserved.
+//|
+//| Permission is hereby granted, free of charge, to any person obtaining a
+//| copy of this software and associated documentation files (the "Software"),
+//| to deal in the Software without restriction, including without limitation
+//| the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//| and/or sell copies of the Software, and to permit persons to whom the
+//| Software is furnished to do so, subject to the following conditions:
+//|
+//| The above copyright notice and this permission notice shall be included
+//| in all copies or substantial portions of the Software.
+//|
+//| THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//| OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//| MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//| IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//| CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//| TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//| SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//----------------------------------------------------------------------------//
+
+
+//----------------------------------------------------------------------------//
+//! @defgroup RELOCATIONS Relocations
+//! @ingroup SECTIONS
+//!
+//! Parsers for the relocation entries of a section in a relocatable object
+//! file (MH_OBJECT).
+//----------------------------------------------------------------------------//
+
+#ifndef _relocation_h
+#define _relocation_h
+
+#include <mach-o/reloc.h>
+
+//! @addtogroup RELOCATIONS
+//! @{
+//!
+
+//----------------------------------------------------------------------------//
+#pragma mark -  Types
+//! @name       Types
+//----------------------------------------------------------------------------//
+
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+//! A decoded \c relocation_info or \c scattered_relocation_info entry.  All
+//! values have been byte-swapped (if needed) for the current process.
+//
+typedef struct mk_relocation_s {
+    //! Offset from the start of the section to the item containing the
+    //! address requiring relocation.
+    uint32_t address;
+    //! If \c is_extern is set, the index of the symbol in the symbol table.
+    //! Otherwise the (1-based) ordinal of the section.  For scattered
+    //! relocations, the address of the relocatable expression.
+    uint32_t symbol_or_section;
+    //! Architecture specific relocation type.  See the \c reloc_type_* enums
+    //! in <mach-o/x86_64/reloc.h> and <mach-o/arm64/reloc.h>.
+    uint8_t type;
+    //! Log2 of the size of the item being relocated (0=byte, 1=word,
+    //! 2=long, 3=quad).
+    uint8_t length;
+    //! Item containing the address is relocated PC-relative.
+    uint8_t pcrel : 1;
+    //! \c symbol_or_section is a symbol index.
+    uint8_t is_extern : 1;
+    //! The entry was a \c scattered_relocation_info.
+    uint8_t is_scattered : 1;
+} mk_relocation_t;
+
+
+//----------------------------------------------------------------------------//
+#pragma mark -  Decoding Relocation Entries
+//! @name       Decoding Relocation Entries
+//----------------------------------------------------------------------------//
+
+//! Decodes \a count raw relocation entries from \a entries into \a output.
+//!
+//! @param  entries
+//!         A buffer containing \a count 8-byte relocation entries, as they
+//!         appear in the Mach-O.
+//! @param  cpu_type
+//!         The CPU type of the Mach-O.  Scattered relocations are only
+//!         recognized for 32-bit architectures.
+//! @param  byte_order
+//!         The byte order of the Mach-O.
+//! @param  output
+//!         A buffer large enough to hold \a count \ref mk_relocation_t.
+_mk_export void
+mk_relocation_decode(const struct relocation_info *entries, uint32_t count, cpu_type_t cpu_type, const mk_byteorder_t *byte_order, mk_relocation_t *output);
+
+//! Copies up to \a count decoded relocation entries of \a section, starting
+//! at \a index, into \a relocations.  The section's relocation entries are
+//! mapped once and decoded in a single pass.
+//!
+//! @return
+//! The number of entries written to \a relocations.  If \a section has no
+//! relocation entries, returns \c 0 and sets \a error to
+//! \ref MK_ENOT_FOUND.
+_mk_export uint32_t
+mk_section_copy_relocations(mk_section_ref section, uint32_t index, mk_relocation_t *relocations, uint32_t count, mk_error_t *error);
+
+
+//! @} RELOCATIONS !//
+
+#endif /* _relocation_h */
@@ -165,6 +165,13 @@ _mk_export uint32_t
 mk_section_get_reserved2(mk_section_ref section);
 
 
+//----------------------------------------------------------------------------//
+#pragma mark -  Includes
+//----------------------------------------------------------------------------//
+
+#include "relocation.h"
+
+
 //! @} SECTIONS !//
 
 #endif /* _section_h */
@@ -0,0 +1,313 @@
+//----------------------------------------------------------------------------//
+//|
+//|             MachOKit - A Lightweight Mach-O Parsing Library
+//|             image_index.c
+//|
+//|             D.V.
+//|             Copyright (c) 2014-2015 D.V. All rights reserved.
+//|
+//| Permission is hereby granted, free of charge, to any person obtaining a
+//| copy of this software and associated documentation files (the "Software"),
+//| to deal in the Software without restriction, including without limitation
+//| the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//| and/or sell copies of the Software, and to permit persons to whom the
+//| Software is furnished to do so, subject to the following conditions:
+//|
+//| The above copyright notice and this permission notice shall be included
+//| in all copies or substantial portions of the Software.
+//|
+//| THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//| OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//| MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//| IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//| CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//| TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//| SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//----------------------------------------------------------------------------//
+
+
+#include "macho_abi_internal.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+//----------------------------------------------------------------------------//
+#pragma mark -  Loading an Image Index
+//----------------------------------------------------------------------------//
+
+//|++++++++++++++++++++++++++++++++++++|//
+static const void*
+__mk_image_index_get_table(const mk_image_index_header_t *header, size_t length, mk_image_index_table_t table, size_t entry_size, size_t alignment)
+{
+    if (table.count == 0)
+        return NULL;
+    
+    if (table.offset % alignment != 0 || table.offset < sizeof(*header) || table.offset > length)
+        return NULL;
+    
+    // Count is at most UINT32_MAX and entry_size is small; this can not
+    // overflow a 64-bit size_t.
+    if ((uint64_t)table.count * entry_size > length - table.offset)
+        return NULL;
+    
+    return (const uint8_t*)header + table.offset;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+mk_error_t
+mk_image_index_init_with_bytes(const void *bytes, size_t length, mk_image_index_t *index)
+{
+    if (bytes == NULL) return MK_EINVAL;
+    if (index == NULL) return MK_EINVAL;
+    
+    if (length < sizeof(mk_image_index_header_t))
+        return MK_ESIZE;
+    
+    const mk_image_index_header_t *header = bytes;
+    
+    if (header->magic != MK_IMAGE_INDEX_MAGIC || header->version != MK_IMAGE_INDEX_VERSION)
+        return MK_EINVALID_DATA;
+    if (header->size > length)
+        return MK_ESIZE;
+    
+    length = header->size;
+    memset(index, 0, sizeof(*index));
+    
+    index->header = header;
+    index->length = length;
+    
+#define LOAD_TABLE(FIELD, TYPE, SIZE, ALIGN) \
+    index->FIELD = (TYPE)__mk_image_index_get_table(header, length, header->FIELD, SIZE, ALIGN); \
+    if (index->FIELD == NULL && header->FIELD.count != 0) return MK_EINVALID_DATA;
+    
+    LOAD_TABLE(segments, const mk_image_index_segment_t*, sizeof(mk_image_index_segment_t), 8)
+    LOAD_TABLE(sections, const mk_image_index_section_t*, sizeof(mk_image_index_section_t), 8)
+    LOAD_TABLE(symbols, const mk_image_index_symbol_t*, sizeof(mk_image_index_symbol_t), 8)
+    LOAD_TABLE(symbol_names, const uint32_t*, sizeof(uint32_t), 4)
+    LOAD_TABLE(exports, const mk_image_index_export_t*, sizeof(mk_image_index_export_t), 8)
+    LOAD_TABLE(exports_by_address, const uint32_t*, sizeof(uint32_t), 4)
+    LOAD_TABLE(function_starts, const uint64_t*, sizeof(uint64_t), 8)
+    LOAD_TABLE(strings, const char*, 1, 1)
+    
+#undef LOAD_TABLE
+    
+    // The string table must begin with the empty string and end with a
+    // terminator so that every lookup is bounded.
+    if (index->strings == NULL || index->strings[0] != '\0' || index->strings[header->strings.count - 1] != '\0')
+        return MK_EINVALID_DATA;
+    
+    // The name hash is probed with a mask.
+    if (header->symbol_names.count & (header->symbol_names.count - 1))
+        return MK_EINVALID_DATA;
+    
+    // Entries are not validated here, to keep loading independent of the
+    // size of the index.  Consumers bounds check the export indexes.
+    if (header->exports_by_address.count > header->exports.count)
+        return MK_EINVALID_DATA;
+    
+    return MK_ESUCCESS;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+mk_error_t
+mk_image_index_open(const char *path, mk_image_index_t *index)
+{
+    if (path == NULL) return MK_EINVAL;
+    if (index == NULL) return MK_EINVAL;
+    
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        switch (errno) {
+            case ENOENT:
+            case ENOTDIR:
+                return MK_ENOT_FOUND;
+            case EACCES:
+            case EPERM:
+                return MK_EBAD_ACCESS;
+            default:
+                return MK_EUNAVAILABLE;
+        }
+    }
+    
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return MK_EUNAVAILABLE;
+    }
+    
+    if (!S_ISREG(st.st_mode)) {
+        close(fd);
+        return MK_EINVAL;
+    }
+    
+    if (st.st_size < (off_t)sizeof(mk_image_index_header_t)) {
+        close(fd);
+        return MK_ESIZE;
+    }
+    
+    void *bytes = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    
+    if (bytes == MAP_FAILED)
+        return MK_EINTERNAL_ERROR;
+    
+    mk_error_t err = mk_image_index_init_with_bytes(bytes, (size_t)st.st_size, index);
+    if (err != MK_ESUCCESS) {
+        munmap(bytes, (size_t)st.st_size);
+        return err;
+    }
+    
+    // Unmap the full file, not just the validated length.
+    index->length = (size_t)st.st_size;
+    index->mapped = true;
+    return MK_ESUCCESS;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+void
+mk_image_index_close(mk_image_index_t *index)
+{
+    if (index == NULL || index->header == NULL)
+        return;
+    
+    if (index->mapped)
+        munmap((void*)index->header, index->length);
+    
+    memset(index, 0, sizeof(*index));
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+bool
+mk_image_index_matches(const mk_image_index_t *index, const uint8_t uuid[16], cpu_type_t cputype, cpu_subtype_t cpusubtype)
+{
+    const mk_image_index_header_t *header = index->header;
+    
+    return header->cputype == cputype &&
+           (header->cpusubtype & ~CPU_SUBTYPE_MASK) == (cpusubtype & ~CPU_SUBTYPE_MASK) &&
+           memcmp(header->uuid, uuid, sizeof(header->uuid)) == 0;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+bool
+mk_image_index_matches_summary(const mk_image_index_t *index, const mk_macho_summary_t *summary)
+{
+    if (!summary->has_uuid)
+        return false;
+    
+    return mk_image_index_matches(index, summary->uuid, summary->cputype, summary->cpusubtype);
+}
+
+//----------------------------------------------------------------------------//
+#pragma mark -  Querying an Image Index
+//----------------------------------------------------------------------------//
+
+//|++++++++++++++++++++++++++++++++++++|//
+uint32_t
+mk_image_index_hash_name(const char *name)
+{
+    // FNV-1a
+    uint32_t hash = 2166136261U;
+    for (const uint8_t *c = (const uint8_t*)name; *c; c++) {
+        hash ^= *c;
+        hash *= 16777619U;
+    }
+    return hash;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+const char*
+mk_image_index_get_string(const mk_image_index_t *index, uint32_t offset)
+{
+    if (offset >= index->header->strings.count)
+        return index->strings;
+    
+    return index->strings + offset;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+const mk_image_index_symbol_t*
+mk_image_index_find_symbol_for_address(const mk_image_index_t *index, uint64_t address)
+{
+    uint32_t low = 0;
+    uint32_t high = index->header->symbols.count;
+    
+    // Find the first symbol with an address greater than the target.
+    while (low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        if (index->symbols[mid].address <= address)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    
+    return (low == 0) ? NULL : &index->symbols[low - 1];
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+const mk_image_index_symbol_t*
+mk_image_index_find_symbol_named(const mk_image_index_t *index, const char *name)
+{
+    uint32_t bucket_count = index->header->symbol_names.count;
+    uint32_t symbol_count = index->header->symbols.count;
+    
+    if (bucket_count == 0)
+        return NULL;
+    
+    uint32_t mask = bucket_count - 1;
+    uint32_t bucket = mk_image_index_hash_name(name) & mask;
+    
+    for (uint32_t probes = 0; probes < bucket_count; probes++, bucket = (bucket + 1) & mask) {
+        uint32_t entry = index->symbol_names[bucket];
+        if (entry == 0)
+            return NULL;
+        if (entry > symbol_count)
+            continue;
+        
+        const mk_image_index_symbol_t *symbol = &index->symbols[entry - 1];
+        if (strcmp(mk_image_index_get_string(index, symbol->name), name) == 0)
+            return symbol;
+    }
+    
+    return NULL;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+const mk_image_index_export_t*
+mk_image_index_find_export_named(const mk_image_index_t *index, const char *name)
+{
+    uint32_t low = 0;
+    uint32_t high = index->header->exports.count;
+    
+    while (low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        int order = strcmp(mk_image_index_get_string(index, index->exports[mid].name), name);
+        if (order == 0)
+            return &index->exports[mid];
+        else if (order < 0)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    
+    return NULL;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+uint64_t
+mk_image_index_find_function_start(const mk_image_index_t *index, uint64_t address)
+{
+    uint32_t low = 0;
+    uint32_t high = index->header->function_starts.count;
+    
+    while (low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        if (index->function_starts[mid] <= address)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    
+    return (low == 0) ? 0 : index->function_starts[low - 1];
+}
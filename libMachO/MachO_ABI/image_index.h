@@ -0,0 +1,260 @@
+//----------------------------------------------------------------------------//
+//|
+//|             MachOKit - A Lightweight Mach-O Parsing Library
+//! @file       image_index.h
+//!
+//! @author     D.V.
+//! @copyright  Copyright (c) 2014-2015 D.V. All rights reserved.
+//|
+//| Permission is hereby granted, free of charge, to any person obtaining a
+//| copy of this software and associated documentation files (the "Software"),
+//| to deal in the Software without restriction, including without limitation
+//| the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//| and/or sell copies of the Software, and to permit persons to whom the
+//| Software is furnished to do so, subject to the following conditions:
+//|
+//| The above copyright notice and this permission notice shall be included
+//| in all copies or substantial portions of the Software.
+//|
+//| THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//| OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//| MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//| IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//| CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//| TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//| SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//----------------------------------------------------------------------------//
+
+
+//----------------------------------------------------------------------------//
+//! @defgroup IMAGE_INDEX Image Index
+//! @ingroup MACH
+//!
+//! A persistent, position-independent index of a parsed Mach-O image.
+//!
+//! An image index is written once, after the image has been fully parsed,
+//! and is loaded with a single \c mmap.  All references within the index are
+//! offsets from the start of the index; nothing is deserialized on load.
+//! An index is keyed by the \c LC_UUID and architecture of the image it was
+//! built from.
+//!
+//! All values are stored in the byte order of the process which wrote the
+//! index.  An index written by a process with a different byte order fails
+//! to load with \ref MK_EINVALID_DATA.
+//----------------------------------------------------------------------------//
+
+#ifndef _image_index_h
+#define _image_index_h
+
+//! @addtogroup IMAGE_INDEX
+//! @{
+//!
+
+//----------------------------------------------------------------------------//
+#pragma mark -  On-Disk Format
+//! @name       On-Disk Format
+//----------------------------------------------------------------------------//
+
+//! The magic value at the start of every image index ('MKIX').
+#define MK_IMAGE_INDEX_MAGIC        0x4D4B4958
+//! The current version of the image index format.  Indexes with a different
+//! version are rejected.
+#define MK_IMAGE_INDEX_VERSION      2
+
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+//! The location of a table within the index.
+//
+typedef struct mk_image_index_table_s {
+    //! Offset of the first entry from the start of the index.
+    uint32_t offset;
+    //! Number of entries (or bytes, for the string table).
+    uint32_t count;
+} mk_image_index_table_t;
+
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+//! The header of an image index.
+//
+typedef struct mk_image_index_header_s {
+    uint32_t magic;
+    uint32_t version;
+    //! The total size of the index, in bytes.
+    uint32_t size;
+    uint32_t reserved;
+    //! The \c LC_UUID of the image.
+    uint8_t uuid[16];
+    cpu_type_t cputype;
+    cpu_subtype_t cpusubtype;
+    //! The preferred load address of the image (the \c vmaddr of its first
+    //! segment).  Addresses in the index are unslid.
+    uint64_t vmaddr;
+    //! \ref mk_image_index_segment_t
+    mk_image_index_table_t segments;
+    //! \ref mk_image_index_section_t
+    mk_image_index_table_t sections;
+    //! \ref mk_image_index_symbol_t, sorted by address.
+    mk_image_index_table_t symbols;
+    //! Open-addressed hash table of \c uint32_t symbol indexes, plus one.
+    //! The number of buckets is always a power of two.
+    mk_image_index_table_t symbol_names;
+    //! \ref mk_image_index_export_t, sorted by name.
+    mk_image_index_table_t exports;
+    //! \c uint32_t indexes into \c exports of the exports which have an
+    //! address (regular and stub-resolver exports), sorted by address.
+    mk_image_index_table_t exports_by_address;
+    //! \c uint64_t function start addresses, sorted.
+    mk_image_index_table_t function_starts;
+    //! NULL-terminated strings, referenced by offset from the start of the
+    //! table.  Offset \c 0 is always the empty string.
+    mk_image_index_table_t strings;
+} mk_image_index_header_t;
+
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+typedef struct mk_image_index_segment_s {
+    char name[16];
+    uint64_t vmaddr;
+    uint64_t vmsize;
+    uint64_t fileoff;
+    uint64_t filesize;
+    uint32_t maxprot;
+    uint32_t initprot;
+    //! Index of the segment's first section in the section table.
+    uint32_t first_section;
+    uint32_t nsects;
+} mk_image_index_segment_t;
+
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+typedef struct mk_image_index_section_s {
+    char segname[16];
+    char sectname[16];
+    uint64_t addr;
+    uint64_t size;
+    uint32_t offset;
+    uint32_t flags;
+} mk_image_index_section_t;
+
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+typedef struct mk_image_index_symbol_s {
+    uint64_t address;
+    //! Offset of the symbol name in the string table.
+    uint32_t name;
+    uint8_t type;
+    uint8_t sect;
+    uint16_t desc;
+} mk_image_index_symbol_t;
+
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+typedef struct mk_image_index_export_s {
+    //! Offset of the export name in the string table.
+    uint32_t name;
+    //! The \c EXPORT_SYMBOL_FLAGS_* of the export.
+    uint32_t flags;
+    //! For regular exports, the offset of the symbol from the start of the
+    //! image.  For re-exports, the library ordinal.
+    uint64_t value;
+    //! For stub-resolver exports, the offset of the resolver from the start
+    //! of the image.
+    uint64_t resolver;
+    //! For re-exports, offset of the imported name in the string table.
+    uint32_t imported_name;
+    uint32_t reserved;
+} mk_image_index_export_t;
+
+
+//----------------------------------------------------------------------------//
+#pragma mark -  Types
+//! @name       Types
+//----------------------------------------------------------------------------//
+
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+//! A loaded image index.  The tables point directly into the index.
+//
+typedef struct mk_image_index_s {
+    const mk_image_index_header_t *header;
+    size_t length;
+    const mk_image_index_segment_t *segments;
+    const mk_image_index_section_t *sections;
+    const mk_image_index_symbol_t *symbols;
+    const uint32_t *symbol_names;
+    const mk_image_index_export_t *exports;
+    const uint32_t *exports_by_address;
+    const uint64_t *function_starts;
+    const char *strings;
+    //! Set if the index was mapped by \ref mk_image_index_open.
+    bool mapped;
+} mk_image_index_t;
+
+
+//----------------------------------------------------------------------------//
+#pragma mark -  Loading an Image Index
+//! @name       Loading an Image Index
+//----------------------------------------------------------------------------//
+
+//! Initializes \a index with an image index in memory.  The header and the
+//! bounds of every table are validated; entries are not copied.  \a bytes
+//! must remain valid for the lifetime of \a index.
+_mk_export mk_error_t
+mk_image_index_init_with_bytes(const void *bytes, size_t length, mk_image_index_t *index);
+
+//! Maps the image index at \a path with a single \c mmap and initializes
+//! \a index with it.  The index must be released with
+//! \ref mk_image_index_close.
+//!
+//! Returns \ref MK_ENOT_FOUND if there is no file at \a path,
+//! \ref MK_EBAD_ACCESS if the file could not be opened for reading,
+//! \ref MK_EINVAL if \a path is not a regular file, \ref MK_ESIZE if the
+//! file is too small, \ref MK_EINTERNAL_ERROR if the file could not be
+//! mapped, and \ref MK_EINVALID_DATA if the file is not a valid image
+//! index.
+_mk_export mk_error_t
+mk_image_index_open(const char *path, mk_image_index_t *index);
+
+//! Unmaps an index opened by \ref mk_image_index_open.
+_mk_export void
+mk_image_index_close(mk_image_index_t *index);
+
+//! Returns \c true if \a index was built from an image with the provided
+//! UUID and architecture.
+_mk_export bool
+mk_image_index_matches(const mk_image_index_t *index, const uint8_t uuid[16], cpu_type_t cputype, cpu_subtype_t cpusubtype);
+
+//! Returns \c true if \a index was built from the image described by
+//! \a summary.
+_mk_export bool
+mk_image_index_matches_summary(const mk_image_index_t *index, const mk_macho_summary_t *summary);
+
+
+//----------------------------------------------------------------------------//
+#pragma mark -  Querying an Image Index
+//! @name       Querying an Image Index
+//----------------------------------------------------------------------------//
+
+//! The hash function used for the symbol name table.
+_mk_export uint32_t
+mk_image_index_hash_name(const char *name);
+
+//! Returns the string at \a offset in the index's string table.
+_mk_export const char*
+mk_image_index_get_string(const mk_image_index_t *index, uint32_t offset);
+
+//! Returns the symbol with the greatest address that is less than or equal
+//! to \a address, or \c NULL.
+_mk_export const mk_image_index_symbol_t*
+mk_image_index_find_symbol_for_address(const mk_image_index_t *index, uint64_t address);
+
+//! Returns the first symbol named \a name, or \c NULL.
+_mk_export const mk_image_index_symbol_t*
+mk_image_index_find_symbol_named(const mk_image_index_t *index, const char *name);
+
+//! Returns the export named \a name, or \c NULL.
+_mk_export const mk_image_index_export_t*
+mk_image_index_find_export_named(const mk_image_index_t *index, const char *name);
+
+//! Returns the greatest function start that is less than or equal to
+//! \a address, or \c 0 if there is none.
+_mk_export uint64_t
+mk_image_index_find_function_start(const mk_image_index_t *index, uint64_t address);
+
+
+//! @} IMAGE_INDEX !//
+
+#endif /* _image_index_h */
@@ -39,6 +39,7 @@
 #include "architecture.h"
 
 #include "macho_image.h"
+#include "macho_summary.h"
 
 #include "load_command.h"
 #include "segment.h"
@@ -46,5 +47,7 @@
 #include "exports_trie.h"
 #include "symbol_table.h"
 #include "indirect_symbol_table.h"
+#include "image_index.h"
+#include "symbolicator.h"
 
 #endif /* _macho_abi_h */
@@ -97,6 +97,7 @@ mk_macho_init_with_slide(mk_context_t *ctx, const char *name, mk_vm_slide_t slid
     
     // Only support a subset of the MachO types at this time
     switch (header.filetype) {
+        case MH_OBJECT:
         case MH_EXECUTE:
         case MH_DYLIB:
         case MH_DYLINKER:
@@ -0,0 +1,275 @@
+//----------------------------------------------------------------------------//
+//|
+//|             MachOKit - A Lightweight Mach-O Parsing Library
+//|             macho_summary.c
+//|
+//|             D.V.
+//|             Copyright (c) 2014-2015 D.V. All rights reserved.
+//|
+//| Permission is hereby granted, free of charge, to any person obtaining a
+//| copy of this software and associated documentation files (the "Software"),
+//| to deal in the Software without restriction, including without limitation
+//| the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//| and/or sell copies of the Software, and to permit persons to whom the
+//| Software is furnished to do so, subject to the following conditions:
+//|
+//| The above copyright notice and this permission notice shall be included
+//| in all copies or substantial portions of the Software.
+//|
+//| THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//| OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//| MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//| IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//| CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//| TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//| SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//----------------------------------------------------------------------------//
+
+
+#include "macho_abi_internal.h"
+
+//----------------------------------------------------------------------------//
+#pragma mark -  Helpers
+//----------------------------------------------------------------------------//
+
+//|++++++++++++++++++++++++++++++++++++|//
+static uint32_t
+__mk_macho_summary_add_string(mk_macho_summary_t *summary, const char *cmd_bytes, uint32_t cmdsize, uint32_t str_offset)
+{
+    if (str_offset >= cmdsize)
+        return 0;
+    
+    const char *str = cmd_bytes + str_offset;
+    size_t max_len = cmdsize - str_offset;
+    size_t len = strnlen(str, max_len);
+    
+    if (len == 0)
+        return 0;
+    
+    // Need room for the terminator.
+    if (len >= (size_t)(MK_MACHO_SUMMARY_STRING_STORAGE_SIZE - summary->strings_length)) {
+        summary->truncated = true;
+        return 0;
+    }
+    
+    uint32_t offset = summary->strings_length;
+    memcpy(summary->strings + offset, str, len);
+    summary->strings[offset + len] = '\0';
+    summary->strings_length += (uint32_t)len + 1;
+    
+    return offset;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+static const mk_byteorder_t*
+__mk_macho_summary_byte_order(uint32_t magic, size_t *header_size)
+{
+    switch (magic) {
+        case MH_MAGIC:
+            *header_size = sizeof(struct mach_header);
+            return &mk_byteorder_direct;
+        case MH_MAGIC_64:
+            *header_size = sizeof(struct mach_header_64);
+            return &mk_byteorder_direct;
+        case MH_CIGAM:
+            *header_size = sizeof(struct mach_header);
+            return &mk_byteorder_swapped;
+        case MH_CIGAM_64:
+            *header_size = sizeof(struct mach_header_64);
+            return &mk_byteorder_swapped;
+        default:
+            return NULL;
+    }
+}
+
+//----------------------------------------------------------------------------//
+#pragma mark -  Summarizing Mach-O Images
+//----------------------------------------------------------------------------//
+
+//|++++++++++++++++++++++++++++++++++++|//
+size_t
+mk_macho_summary_get_required_length(const void *bytes, size_t length)
+{
+    const struct mach_header *header = bytes;
+    size_t header_size;
+    
+    if (bytes == NULL || length < sizeof(struct mach_header))
+        return 0;
+    
+    const mk_byteorder_t *byte_order = __mk_macho_summary_byte_order(header->magic, &header_size);
+    if (byte_order == NULL)
+        return 0;
+    
+    return header_size + byte_order->swap32(header->sizeofcmds);
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+mk_error_t
+mk_macho_summarize_bytes(const void *bytes, size_t length, mk_macho_summary_t *summary)
+{
+    if (bytes == NULL) return MK_EINVAL;
+    if (summary == NULL) return MK_EINVAL;
+    
+    if (length < sizeof(struct mach_header))
+        return MK_ESIZE;
+    
+    const struct mach_header *header = bytes;
+    size_t header_size;
+    
+    const mk_byteorder_t *byte_order = __mk_macho_summary_byte_order(header->magic, &header_size);
+    if (byte_order == NULL)
+        return MK_EINVALID_DATA;
+    
+    if (length < header_size + byte_order->swap32(header->sizeofcmds))
+        return MK_ESIZE;
+    
+    // Only the fixed-size portion needs to be cleared.  The string storage
+    // is written sequentially.
+    memset(summary, 0, offsetof(mk_macho_summary_t, strings));
+    summary->strings[0] = '\0';
+    summary->strings_length = 1;
+    
+    summary->magic = byte_order->swap32(header->magic);
+    summary->cputype = (cpu_type_t)byte_order->swap32((uint32_t)header->cputype);
+    summary->cpusubtype = (cpu_subtype_t)byte_order->swap32((uint32_t)header->cpusubtype);
+    summary->filetype = byte_order->swap32(header->filetype);
+    summary->ncmds = byte_order->swap32(header->ncmds);
+    summary->sizeofcmds = byte_order->swap32(header->sizeofcmds);
+    summary->flags = byte_order->swap32(header->flags);
+    
+    const uint8_t *cmd_bytes = (const uint8_t*)bytes + header_size;
+    const uint8_t *cmds_end = cmd_bytes + summary->sizeofcmds;
+    
+    for (uint32_t i = 0; i < summary->ncmds; i++)
+    {
+        if ((size_t)(cmds_end - cmd_bytes) < sizeof(struct load_command))
+            return MK_EINVALID_DATA;
+        
+        const struct load_command *lc = (const struct load_command*)cmd_bytes;
+        uint32_t cmd = byte_order->swap32(lc->cmd);
+        uint32_t cmdsize = byte_order->swap32(lc->cmdsize);
+        
+        if (cmdsize < sizeof(struct load_command) || cmdsize > (size_t)(cmds_end - cmd_bytes))
+            return MK_EINVALID_DATA;
+        
+        switch (cmd) {
+            case LC_UUID:
+            {
+                if (cmdsize < sizeof(struct uuid_command))
+                    break;
+                
+                summary->has_uuid = true;
+                memcpy(summary->uuid, ((const struct uuid_command*)lc)->uuid, sizeof(summary->uuid));
+                break;
+            }
+            case LC_BUILD_VERSION:
+            {
+                if (cmdsize < sizeof(struct build_version_command))
+                    break;
+                
+                // LC_BUILD_VERSION takes precedence over LC_VERSION_MIN_*.
+                const struct build_version_command *bvc = (const struct build_version_command*)lc;
+                summary->platform = byte_order->swap32(bvc->platform);
+                summary->minos = byte_order->swap32(bvc->minos);
+                summary->sdk = byte_order->swap32(bvc->sdk);
+                break;
+            }
+            case LC_VERSION_MIN_MACOSX:
+            case LC_VERSION_MIN_IPHONEOS:
+            case LC_VERSION_MIN_TVOS:
+            case LC_VERSION_MIN_WATCHOS:
+            {
+                if (cmdsize < sizeof(struct version_min_command) || summary->platform != 0)
+                    break;
+                
+                const struct version_min_command *vmc = (const struct version_min_command*)lc;
+                summary->minos = byte_order->swap32(vmc->version);
+                summary->sdk = byte_order->swap32(vmc->sdk);
+                
+                if (cmd == LC_VERSION_MIN_MACOSX)
+                    summary->platform = PLATFORM_MACOS;
+                else if (cmd == LC_VERSION_MIN_IPHONEOS)
+                    summary->platform = PLATFORM_IOS;
+                else if (cmd == LC_VERSION_MIN_TVOS)
+                    summary->platform = PLATFORM_TVOS;
+                else
+                    summary->platform = PLATFORM_WATCHOS;
+                break;
+            }
+            case LC_ID_DYLIB:
+            case LC_LOAD_DYLIB:
+            case LC_LOAD_WEAK_DYLIB:
+            case LC_REEXPORT_DYLIB:
+            case LC_LAZY_LOAD_DYLIB:
+            case LC_LOAD_UPWARD_DYLIB:
+            {
+                if (cmdsize < sizeof(struct dylib_command))
+                    break;
+                
+                const struct dylib_command *dc = (const struct dylib_command*)lc;
+                mk_macho_summary_dylib_t *dylib;
+                
+                if (cmd == LC_ID_DYLIB) {
+                    summary->has_id_dylib = true;
+                    dylib = &summary->id_dylib;
+                } else if (summary->dylib_count++ < MK_MACHO_SUMMARY_MAX_DYLIBS) {
+                    dylib = &summary->dylibs[summary->dylib_count - 1];
+                } else {
+                    summary->truncated = true;
+                    break;
+                }
+                
+                dylib->cmd = cmd;
+                dylib->current_version = byte_order->swap32(dc->dylib.current_version);
+                dylib->compatibility_version = byte_order->swap32(dc->dylib.compatibility_version);
+                dylib->name = __mk_macho_summary_add_string(summary, (const char*)dc, cmdsize, byte_order->swap32(dc->dylib.name.offset));
+                break;
+            }
+            default:
+                break;
+        }
+        
+        cmd_bytes += cmdsize;
+    }
+    
+    return MK_ESUCCESS;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+mk_error_t
+mk_macho_summarize(mk_memory_map_ref memory_map, mk_vm_address_t address, mk_macho_summary_t *summary)
+{
+    if (memory_map.memory_map == NULL) return MK_EINVAL;
+    if (summary == NULL) return MK_EINVAL;
+    
+    mk_error_t err;
+    
+    struct mach_header header;
+    if (mk_memory_map_copy_bytes(memory_map, 0, address, &header, sizeof(header), true, &err) < sizeof(header))
+        return err;
+    
+    size_t length = mk_macho_summary_get_required_length(&header, sizeof(header));
+    if (length == 0)
+        return MK_EINVALID_DATA;
+    
+    // Map the header and load commands together.  Nothing else in the image
+    // is touched.
+    mk_memory_object_t mobj;
+    if ((err = mk_memory_map_init_object(memory_map, 0, address, (mk_vm_size_t)length, true, &mobj)))
+        return err;
+    
+    err = mk_macho_summarize_bytes((const void*)mk_memory_object_address(&mobj), length, summary);
+    
+    mk_memory_map_free_object(memory_map, &mobj);
+    return err;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+const char*
+mk_macho_summary_get_string(const mk_macho_summary_t *summary, uint32_t offset)
+{
+    if (offset >= summary->strings_length)
+        return summary->strings;
+    
+    return summary->strings + offset;
+}
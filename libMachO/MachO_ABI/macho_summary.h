@@ -0,0 +1,150 @@
+//----------------------------------------------------------------------------//
+//|
+//|             MachOKit - A Lightweight Mach-O Parsing Library
+//! @file       macho_summary.h
+//!
+//! @author     D.V.
+//! @copyright  Copyright (c) 2014-2015 D.V. All rights reserved.
+//|
+//| Permission is hereby granted, free of charge, to any person obtaining a
+//| copy of this software and associated documentation files (the "Software"),
+//| to deal in the Software without restriction, including without limitation
+//| the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//| and/or sell copies of the Software, and to permit persons to whom the
+//| Software is furnished to do so, subject to the following conditions:
+//|
+//| The above copyright notice and this permission notice shall be included
+//| in all copies or substantial portions of the Software.
+//|
+//| THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//| OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//| MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//| IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//| CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//| TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//| SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//----------------------------------------------------------------------------//
+
+
+#ifndef _macho_summary_h
+#define _macho_summary_h
+
+//! @addtogroup MACH
+//! @{
+//!
+
+//----------------------------------------------------------------------------//
+#pragma mark -  Types
+//! @name       Types
+//----------------------------------------------------------------------------//
+
+//! The maximum number of dependent libraries recorded in a
+//! \ref mk_macho_summary_t.  Additional libraries are counted but not
+//! recorded.
+#define MK_MACHO_SUMMARY_MAX_DYLIBS             128
+
+//! The size of the inline string storage in a \ref mk_macho_summary_t.
+#define MK_MACHO_SUMMARY_STRING_STORAGE_SIZE    8192
+
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+//! A dependent library recorded in a \ref mk_macho_summary_t.
+//
+typedef struct mk_macho_summary_dylib_s {
+    //! The load command that referenced the library.  One of
+    //! \c LC_LOAD_DYLIB, \c LC_LOAD_WEAK_DYLIB, \c LC_REEXPORT_DYLIB,
+    //! \c LC_LAZY_LOAD_DYLIB or \c LC_LOAD_UPWARD_DYLIB.
+    uint32_t cmd;
+    uint32_t current_version;
+    uint32_t compatibility_version;
+    //! Offset of the library name in the summary's string storage.
+    uint32_t name;
+} mk_macho_summary_dylib_t;
+
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+//! A flat, fixed-size summary of a Mach-O image, produced by a single pass
+//! over its load commands.  The summary contains no pointers and may be
+//! copied freely.  All values have been byte-swapped (if needed) for the
+//! current process.
+//!
+//! Strings are stored inline in \c strings and referenced by offset.  An
+//! offset of \c 0 refers to the empty string.  Strings that do not fit in
+//! the remaining storage are recorded as the empty string and
+//! \c truncated is set.
+//
+typedef struct mk_macho_summary_s {
+    //! The \c mach_header.  \c magic is \c MH_MAGIC or \c MH_MAGIC_64, in
+    //! host byte order, even if the image is byte-swapped.
+    uint32_t magic;
+    cpu_type_t cputype;
+    cpu_subtype_t cpusubtype;
+    uint32_t filetype;
+    uint32_t ncmds;
+    uint32_t sizeofcmds;
+    uint32_t flags;
+    //! \c LC_UUID
+    bool has_uuid;
+    uint8_t uuid[16];
+    //! The platform from \c LC_BUILD_VERSION, or the platform implied by
+    //! an \c LC_VERSION_MIN_* command.  \c 0 if neither is present.
+    uint32_t platform;
+    //! The minimum OS version, encoded as \c xxxx.yy.zz.
+    uint32_t minos;
+    //! The SDK version, encoded as \c xxxx.yy.zz.
+    uint32_t sdk;
+    //! \c LC_ID_DYLIB
+    bool has_id_dylib;
+    mk_macho_summary_dylib_t id_dylib;
+    //! The total number of dependent libraries, including any that did not
+    //! fit in \c dylibs.
+    uint32_t dylib_count;
+    mk_macho_summary_dylib_t dylibs[MK_MACHO_SUMMARY_MAX_DYLIBS];
+    //! Set if a library or string did not fit in the summary.
+    bool truncated;
+    //! The number of bytes of \c strings in use.
+    uint32_t strings_length;
+    char strings[MK_MACHO_SUMMARY_STRING_STORAGE_SIZE];
+} mk_macho_summary_t;
+
+
+//----------------------------------------------------------------------------//
+#pragma mark -  Summarizing Mach-O Images
+//! @name       Summarizing Mach-O Images
+//----------------------------------------------------------------------------//
+
+//! Summarizes the Mach-O image whose header and load commands are in the
+//! provided buffer.  Unlike \ref mk_macho_init, no parser state is created
+//! and no memory outside of \a bytes is accessed.
+//!
+//! @param  bytes
+//!         A buffer beginning with a \c mach_header or \c mach_header_64.
+//! @param  length
+//!         The length of \a bytes.  Must be at least the size of the header
+//!         plus \c sizeofcmds.
+//! @param  summary
+//!         A \ref mk_macho_summary_t to populate.
+//! @return
+//! \ref MK_ESIZE if \a bytes does not contain all of the load commands.
+//! Call again with a buffer of at least
+//! \ref mk_macho_summary_get_required_length bytes.
+_mk_export mk_error_t
+mk_macho_summarize_bytes(const void *bytes, size_t length, mk_macho_summary_t *summary);
+
+//! Summarizes the Mach-O image at \a address in \a memory_map.  Only the
+//! header and load commands are mapped.
+_mk_export mk_error_t
+mk_macho_summarize(mk_memory_map_ref memory_map, mk_vm_address_t address, mk_macho_summary_t *summary);
+
+//! Returns the number of bytes needed to hold the header and load commands
+//! of the Mach-O image beginning with the provided header, or \c 0 if
+//! \a bytes does not begin with a valid Mach-O header.
+_mk_export size_t
+mk_macho_summary_get_required_length(const void *bytes, size_t length);
+
+//! Returns the string at \a offset in the string storage of \a summary.
+_mk_export const char*
+mk_macho_summary_get_string(const mk_macho_summary_t *summary, uint32_t offset);
+
+
+//! @} MACH !//
+
+#endif /* _macho_summary_h */
@@ -0,0 +1,329 @@
+//----------------------------------------------------------------------------//
+//|
+//|             MachOKit - A Lightweight Mach-O Parsing Library
+//|             symbolicator.c
+//|
+//|             D.V.
+//|             Copyright (c) 2014-2015 D.V. All rights reserved.
+//|
+//| Permission is hereby granted, free of charge, to any person obtaining a
+//| copy of this software and associated documentation files (the "Software"),
+//| to deal in the Software without restriction, including without limitation
+//| the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//| and/or sell copies of the Software, and to permit persons to whom the
+//| Software is furnished to do so, subject to the following conditions:
+//|
+//| The above copyright notice and this permission notice shall be included
+//| in all copies or substantial portions of the Software.
+//|
+//| THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//| OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//| MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//| IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//| CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//| TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//| SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//----------------------------------------------------------------------------//
+
+
+#include "macho_abi_internal.h"
+
+//----------------------------------------------------------------------------//
+#pragma mark -  Helpers
+//----------------------------------------------------------------------------//
+
+//! Returns \c true if element \a lhs should be ordered before \a rhs.
+typedef bool (*__mk_symbolicator_order_t)(const void *context, uint32_t lhs, uint32_t rhs);
+
+//|++++++++++++++++++++++++++++++++++++|//
+static void
+__mk_symbolicator_sift_down(uint32_t *order, uint32_t start, uint32_t count, __mk_symbolicator_order_t before, const void *context)
+{
+    uint32_t root = start;
+    
+    while (2 * (uint64_t)root + 1 < count) {
+        uint32_t child = 2 * root + 1;
+        uint32_t swap = root;
+        
+        if (before(context, order[swap], order[child]))
+            swap = child;
+        if (child + 1 < count && before(context, order[swap], order[child + 1]))
+            swap = child + 1;
+        if (swap == root)
+            return;
+        
+        uint32_t tmp = order[root];
+        order[root] = order[swap];
+        order[swap] = tmp;
+        root = swap;
+    }
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+//! Heap sort.  Allocation free, which qsort is not guaranteed to be.
+static void
+__mk_symbolicator_sort(uint32_t *order, uint32_t count, __mk_symbolicator_order_t before, const void *context)
+{
+    if (count < 2)
+        return;
+    
+    for (uint32_t start = count / 2; start-- > 0; )
+        __mk_symbolicator_sift_down(order, start, count, before, context);
+    
+    for (uint32_t end = count - 1; end > 0; end--) {
+        uint32_t tmp = order[0];
+        order[0] = order[end];
+        order[end] = tmp;
+        __mk_symbolicator_sift_down(order, 0, end, before, context);
+    }
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+static bool
+__mk_symbolicator_result_before(const void *context, uint32_t lhs, uint32_t rhs)
+{
+    const mk_symbolication_result_t *results = context;
+    
+    if (results[lhs].image != results[rhs].image)
+        return results[lhs].image < results[rhs].image;
+    return results[lhs].unslid_address < results[rhs].unslid_address;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+//! Orders images by UUID.  Ties are broken by position so that a lookup
+//! finds the first of several images with the same UUID.
+static bool
+__mk_symbolicator_uuid_before(const void *context, uint32_t lhs, uint32_t rhs)
+{
+    const mk_symbolicator_image_t *images = context;
+    int order = memcmp(images[lhs].index->header->uuid, images[rhs].index->header->uuid, sizeof(images[lhs].index->header->uuid));
+    
+    if (order != 0)
+        return order < 0;
+    return lhs < rhs;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+static bool
+__mk_symbolicator_load_address_before(const void *context, uint32_t lhs, uint32_t rhs)
+{
+    const mk_symbolicator_image_t *images = context;
+    
+    if (images[lhs].load_address != images[rhs].load_address)
+        return images[lhs].load_address < images[rhs].load_address;
+    return lhs < rhs;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+static uint32_t
+__mk_symbolicator_find_image(const mk_symbolicator_t *symbolicator, const mk_symbolicator_frame_t *frame)
+{
+    const mk_symbolicator_image_t *images = symbolicator->images;
+    const uint32_t *order = frame->has_uuid ? symbolicator->images_by_uuid : symbolicator->images_by_load_address;
+    uint32_t low = 0;
+    uint32_t high = symbolicator->image_count;
+    
+    // Find the first image that is not ordered before the frame's image.
+    while (low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        const mk_symbolicator_image_t *image = &images[order[mid]];
+        bool before;
+        
+        if (frame->has_uuid)
+            before = memcmp(image->index->header->uuid, frame->image_uuid, sizeof(frame->image_uuid)) < 0;
+        else
+            before = image->load_address < frame->image_load_address;
+        
+        if (before)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    
+    if (low == symbolicator->image_count)
+        return UINT32_MAX;
+    
+    const mk_symbolicator_image_t *image = &images[order[low]];
+    
+    if (frame->has_uuid) {
+        if (memcmp(image->index->header->uuid, frame->image_uuid, sizeof(frame->image_uuid)) == 0)
+            return order[low];
+    } else if (image->load_address == frame->image_load_address) {
+        return order[low];
+    }
+    
+    return UINT32_MAX;
+}
+
+//|++++++++++++++++++++++++++++++++++++|//
+static inline bool
+__mk_symbolicator_export_has_address(const mk_image_index_export_t *export)
+{ return (export->flags & EXPORT_SYMBOL_FLAGS_REEXPORT) == 0 && (export->flags & EXPORT_SYMBOL_FLAGS_KIND_MASK) == EXPORT_SYMBOL_FLAGS_KIND_REGULAR; }
+
+//|++++++++++++++++++++++++++++++++++++|//
+static inline bool
+__mk_symbolicator_symbol_is_defined(const mk_image_index_symbol_t *symbol)
+{ return (symbol->type & N_STAB) == 0 && (symbol->type & N_TYPE) == N_SECT; }
+
+//----------------------------------------------------------------------------//
+#pragma mark -  Creating a Symbolicator
+//----------------------------------------------------------------------------//
+
+//|++++++++++++++++++++++++++++++++++++|//
+mk_error_t
+mk_symbolicator_init(mk_symbolicator_t *symbolicator, const mk_symbolicator_image_t *images, uint32_t image_count, uint32_t *image_order)
+{
+    if (symbolicator == NULL) return MK_EINVAL;
+    if (image_count != 0 && (images == NULL || image_order == NULL)) return MK_EINVAL;
+    if (image_count > UINT32_MAX / 2) return MK_ESIZE;
+    
+    symbolicator->images = images;
+    symbolicator->image_count = image_count;
+    symbolicator->images_by_uuid = image_order;
+    symbolicator->images_by_load_address = image_order + image_count;
+    
+    for (uint32_t i = 0; i < image_count; i++) {
+        symbolicator->images_by_uuid[i] = i;
+        symbolicator->images_by_load_address[i] = i;
+    }
+    
+    __mk_symbolicator_sort(symbolicator->images_by_uuid, image_count, __mk_symbolicator_uuid_before, images);
+    __mk_symbolicator_sort(symbolicator->images_by_load_address, image_count, __mk_symbolicator_load_address_before, images);
+    
+    return MK_ESUCCESS;
+}
+
+//----------------------------------------------------------------------------//
+#pragma mark -  Symbolicating Addresses
+//----------------------------------------------------------------------------//
+
+//|++++++++++++++++++++++++++++++++++++|//
+mk_error_t
+mk_symbolicate(const mk_symbolicator_t *symbolicator,
+               const mk_symbolicator_frame_t *frames, uint32_t frame_count,
+               mk_symbolication_result_t *results, uint32_t *scratch)
+{
+    if (symbolicator == NULL) return MK_EINVAL;
+    if (frame_count == 0) return MK_ESUCCESS;
+    if (frames == NULL || results == NULL || scratch == NULL) return MK_EINVAL;
+    
+    const mk_symbolicator_image_t *images = symbolicator->images;
+    
+    // Resolve the image of each frame and remove the slide.
+    for (uint32_t i = 0; i < frame_count; i++)
+    {
+        mk_symbolication_result_t *result = &results[i];
+        uint32_t image = __mk_symbolicator_find_image(symbolicator, &frames[i]);
+        
+        result->image = image;
+        result->source = MK_SYMBOLICATION_SOURCE_NONE;
+        result->symbol_address = 0;
+        result->name = NULL;
+        result->unslid_address = frames[i].address;
+        
+        if (image != UINT32_MAX) {
+            // The slide may be negative; modular arithmetic gives the
+            // correct unslid address either way.
+            uint64_t slide = images[image].load_address - images[image].index->header->vmaddr;
+            result->unslid_address = frames[i].address - slide;
+        }
+        
+        scratch[i] = i;
+    }
+    
+    __mk_symbolicator_sort(scratch, frame_count, __mk_symbolicator_result_before, results);
+    
+    // Walk each group of frames belonging to the same image.
+    uint32_t group_start = 0;
+    while (group_start < frame_count)
+    {
+        uint32_t image = results[scratch[group_start]].image;
+        uint32_t group_end = group_start + 1;
+        while (group_end < frame_count && results[scratch[group_end]].image == image)
+            group_end++;
+        
+        if (image == UINT32_MAX) {
+            group_start = group_end;
+            continue;
+        }
+        
+        const mk_image_index_t *index = images[image].index;
+        const mk_image_index_header_t *header = index->header;
+        
+        // Cursors into each address-sorted table.  Because the frames are
+        // sorted, the cursors only move forward.
+        uint32_t symbol_cursor = 0;
+        const mk_image_index_symbol_t *best_symbol = NULL;
+        uint32_t function_cursor = 0;
+        uint64_t best_function = 0;
+        bool have_function = false;
+        uint32_t export_cursor = 0;
+        const mk_image_index_export_t *best_export = NULL;
+        
+        for (uint32_t i = group_start; i < group_end; i++)
+        {
+            mk_symbolication_result_t *result = &results[scratch[i]];
+            uint64_t address = result->unslid_address;
+            
+            while (symbol_cursor < header->symbols.count && index->symbols[symbol_cursor].address <= address) {
+                const mk_image_index_symbol_t *symbol = &index->symbols[symbol_cursor++];
+                if (__mk_symbolicator_symbol_is_defined(symbol))
+                    best_symbol = symbol;
+            }
+            
+            while (function_cursor < header->function_starts.count && index->function_starts[function_cursor] <= address) {
+                best_function = index->function_starts[function_cursor++];
+                have_function = true;
+            }
+            
+            while (export_cursor < header->exports_by_address.count) {
+                uint32_t export_index = index->exports_by_address[export_cursor];
+                if (export_index >= header->exports.count) { export_cursor++; continue; }
+                
+                const mk_image_index_export_t *export = &index->exports[export_index];
+                if (!__mk_symbolicator_export_has_address(export)) { export_cursor++; continue; }
+                if (header->vmaddr + export->value > address)
+                    break;
+                
+                best_export = export;
+                export_cursor++;
+            }
+            
+            // Prefer the symbol table over the exports when both precede the
+            // address by the same amount.
+            uint64_t named_address = 0;
+            const char *name = NULL;
+            mk_symbolication_source_t source = MK_SYMBOLICATION_SOURCE_IMAGE;
+            
+            if (best_symbol) {
+                named_address = best_symbol->address;
+                name = mk_image_index_get_string(index, best_symbol->name);
+                source = MK_SYMBOLICATION_SOURCE_SYMBOL_TABLE;
+            }
+            if (best_export && (name == NULL || header->vmaddr + best_export->value > named_address)) {
+                named_address = header->vmaddr + best_export->value;
+                name = mk_image_index_get_string(index, best_export->name);
+                source = MK_SYMBOLICATION_SOURCE_EXPORTS;
+            }
+            
+            // A function start between the named symbol and the address means
+            // the address is in an unnamed function.
+            if (have_function && (name == NULL || best_function > named_address)) {
+                named_address = best_function;
+                name = NULL;
+                source = MK_SYMBOLICATION_SOURCE_FUNCTION_STARTS;
+            }
+            
+            if (source == MK_SYMBOLICATION_SOURCE_IMAGE)
+                named_address = header->vmaddr;
+            
+            result->source = source;
+            result->symbol_address = named_address;
+            result->name = name;
+        }
+        
+        group_start = group_end;
+    }
+    
+    return MK_ESUCCESS;
+}
@@ -0,0 +1,168 @@
+//----------------------------------------------------------------------------//
+//|
+//|             MachOKit - A Lightweight Mach-O Parsing Library
+//! @file       symbolicator.h
+//!
+//! @author     D.V.
+//! @copyright  Copyright (c) 2014-2015 D.V. All rights reserved.
+//|
+//| Permission is hereby granted, free of charge, to any person obtaining a
+//| copy of this software and associated documentation files (the "Software"),
+//| to deal in the Software without restriction, including without limitation
+//| the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//| and/or sell copies of the Software, and to permit persons to whom the
+//| Software is furnished to do so, subject to the following conditions:
+//|
+//| The above copyright notice and this permission notice shall be included
+//| in all copies or substantial portions of the Software.
+//|
+//| THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//| OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//| MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//| IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//| CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//| TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//| SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//----------------------------------------------------------------------------//
+
+
+//----------------------------------------------------------------------------//
+//! @defgroup SYMBOLICATOR Symbolicator
+//! @ingroup IMAGE_INDEX
+//!
+//! Batch symbolication of addresses against a set of image indexes.
+//----------------------------------------------------------------------------//
+
+#ifndef _symbolicator_h
+#define _symbolicator_h
+
+//! @addtogroup SYMBOLICATOR
+//! @{
+//!
+
+//----------------------------------------------------------------------------//
+#pragma mark -  Types
+//! @name       Types
+//----------------------------------------------------------------------------//
+
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+//! An image available to the symbolicator.
+//
+typedef struct mk_symbolicator_image_s {
+    //! The index of the image.
+    const mk_image_index_t *index;
+    //! The address at which the image's header was loaded.
+    uint64_t load_address;
+} mk_symbolicator_image_t;
+
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+//! A set of images, ordered by UUID and by load address so that the image
+//! of each frame is found with a binary search.  Initialized by
+//! \ref mk_symbolicator_init.
+//
+typedef struct mk_symbolicator_s {
+    const mk_symbolicator_image_t *images;
+    uint32_t image_count;
+    //! Indexes into \c images, sorted by UUID.
+    uint32_t *images_by_uuid;
+    //! Indexes into \c images, sorted by load address.
+    uint32_t *images_by_load_address;
+} mk_symbolicator_t;
+
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+//! An address to symbolicate.  The image containing \c address is identified
+//! by its UUID if \c has_uuid is set, or by its load address otherwise.
+//
+typedef struct mk_symbolicator_frame_s {
+    uint64_t address;
+    uint64_t image_load_address;
+    uint8_t image_uuid[16];
+    bool has_uuid;
+} mk_symbolicator_frame_t;
+
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+//! The source of a symbolication result.
+//
+typedef enum {
+    //! No image or symbol was found for the address.
+    MK_SYMBOLICATION_SOURCE_NONE = 0,
+    //! The image was found but no symbol precedes the address.
+    MK_SYMBOLICATION_SOURCE_IMAGE,
+    //! The nearest preceding symbol table entry.
+    MK_SYMBOLICATION_SOURCE_SYMBOL_TABLE,
+    //! The nearest preceding export.  Used for stripped images.
+    MK_SYMBOLICATION_SOURCE_EXPORTS,
+    //! The nearest preceding function start, which has no name.  Returned
+    //! when a function start lies between the address and the nearest
+    //! named symbol, indicating that the named symbol does not contain the
+    //! address.
+    MK_SYMBOLICATION_SOURCE_FUNCTION_STARTS
+} mk_symbolication_source_t;
+
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+//! The result of symbolicating a single frame.
+//
+typedef struct mk_symbolication_result_s {
+    //! The index of the image in the \c images array, or \c UINT32_MAX.
+    uint32_t image;
+    mk_symbolication_source_t source;
+    //! The unslid address of the frame.
+    uint64_t unslid_address;
+    //! The unslid start address of the symbol, function, or image.
+    uint64_t symbol_address;
+    //! The name of the symbol.  Points into the image index; \c NULL if the
+    //! symbol is unnamed.
+    const char *name;
+} mk_symbolication_result_t;
+
+
+//----------------------------------------------------------------------------//
+#pragma mark -  Creating a Symbolicator
+//! @name       Creating a Symbolicator
+//----------------------------------------------------------------------------//
+
+//! Initializes \a symbolicator with \a image_count images.  The images are
+//! sorted once, here, and the symbolicator may then be used for any number
+//! of calls to \ref mk_symbolicate.  No memory is allocated.
+//!
+//! @param  images
+//!         The images to symbolicate against.  Must remain valid for the
+//!         lifetime of \a symbolicator.
+//! @param  image_order
+//!         A caller-owned array of (2 * \a image_count) \c uint32_t.  Must
+//!         remain valid for the lifetime of \a symbolicator.
+_mk_export mk_error_t
+mk_symbolicator_init(mk_symbolicator_t *symbolicator, const mk_symbolicator_image_t *images, uint32_t image_count, uint32_t *image_order);
+
+
+//----------------------------------------------------------------------------//
+#pragma mark -  Symbolicating Addresses
+//! @name       Symbolicating Addresses
+//----------------------------------------------------------------------------//
+
+//! Symbolicates \a frame_count frames.
+//!
+//! The image of each frame is found with a binary search.  The frames are
+//! then grouped by image and sorted by address.  Each group is answered by
+//! a single forward walk over the image's address-sorted symbol table,
+//! function starts and exports.  No memory is allocated.
+//!
+//! @param  symbolicator
+//!         The images to symbolicate against.
+//! @param  frames
+//!         The frames to symbolicate.
+//! @param  results
+//!         A caller-owned array of \a frame_count results.  Results are
+//!         written at the same index as their frame.
+//! @param  scratch
+//!         A caller-owned array of \a frame_count \c uint32_t, used to sort
+//!         the frames.
+_mk_export mk_error_t
+mk_symbolicate(const mk_symbolicator_t *symbolicator,
+               const mk_symbolicator_frame_t *frames, uint32_t frame_count,
+               mk_symbolication_result_t *results, uint32_t *scratch);
+
+
+//! @} SYMBOLICATOR !//
+
+#endif /* _symbolicator_h */
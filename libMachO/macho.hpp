@@ -0,0 +1,987 @@
+//----------------------------------------------------------------------------//
+//|
+//|             MachOKit - A Lightweight Mach-O Parsing Library
+//! @file       macho.hpp
+//!
+//! @author     D.V.
+//! @copyright  Copyright (c) 2014-2015 D.V. All rights reserved.
+//!
+//! @brief
+//! Header-only C++17 interface to in-memory Mach-O images.
+//|
+//| Permission is hereby granted, free of charge, to any person obtaining a
+//| copy of this software and associated documentation files (the "Software"),
+//| to deal in the Software without restriction, including without limitation
+//| the rights to use, copy, modify, merge, publish, distribute, sublicense,
+//| and/or sell copies of the Software, and to permit persons to whom the
+//| Software is furnished to do so, subject to the following conditions:
+//|
+//| The above copyright notice and this permission notice shall be included
+//| in all copies or substantial portions of the Software.
+//|
+//| THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+//| OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+//| MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+//| IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+//| CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+//| TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+//| SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//----------------------------------------------------------------------------//
+
+
+//----------------------------------------------------------------------------//
+//! @defgroup CXX C++ Interface
+//!
+//! A header-only C++17 layer over Mach-O images that are directly addressable
+//! by the current process, either loaded by dyld or read into a buffer.
+//!
+//! Unlike the C API, which consults \c mk_macho_is_64_bit() and the image's
+//! byte order on every access, \c macho::image is parameterized on the word
+//! size and byte order of the image.  The magic is examined once by
+//! \c macho::visit() and every accessor thereafter compiles down to a direct
+//! (and, if required, byte swapped) load of the underlying structure.
+//!
+//! @code
+//! macho::visit(header, length, true, [&](auto& image) {
+//!     for (auto segment : image.segments())
+//!         for (auto section : segment.sections())
+//!             ...;
+//!     for (auto symbol : image.symbols())
+//!         image.string_at(symbol.strx());
+//! });
+//! @endcode
+//!
+//! Like the rest of libMachO, this layer performs no dynamic memory
+//! allocation.  Offsets read from the image are bounds checked against the
+//! provided length (or, for loaded images, the __LINKEDIT segment) but the
+//! image itself must remain mapped for the lifetime of any range or value
+//! vended by it.
+//----------------------------------------------------------------------------//
+
+#ifndef _macho_hpp
+#define _macho_hpp
+
+#if !defined(__cplusplus) || __cplusplus < 201703L
+    #error "macho.hpp requires C++17."
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <string_view>
+
+#include <mach-o/loader.h>
+#include <mach-o/nlist.h>
+
+#ifndef LC_DYLD_EXPORTS_TRIE
+    #define LC_DYLD_EXPORTS_TRIE (0x33 | LC_REQ_DYLD)
+#endif
+
+//! @addtogroup CXX
+//! @{
+//!
+
+namespace macho {
+
+//! The byte order of an image, relative to the current process.
+enum class endian { native, swapped };
+
+namespace detail {
+
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+#pragma mark -  Byte Order
+
+template <endian E>
+constexpr uint8_t swap(uint8_t value) noexcept
+{ return value; }
+
+template <endian E>
+constexpr uint16_t swap(uint16_t value) noexcept
+{
+    if constexpr (E == endian::swapped) return __builtin_bswap16(value);
+    else return value;
+}
+
+template <endian E>
+constexpr uint32_t swap(uint32_t value) noexcept
+{
+    if constexpr (E == endian::swapped) return __builtin_bswap32(value);
+    else return value;
+}
+
+template <endian E>
+constexpr uint64_t swap(uint64_t value) noexcept
+{
+    if constexpr (E == endian::swapped) return __builtin_bswap64(value);
+    else return value;
+}
+
+template <endian E>
+constexpr int32_t swap(int32_t value) noexcept
+{ return (int32_t)swap<E>((uint32_t)value); }
+
+template <endian E>
+constexpr int16_t swap(int16_t value) noexcept
+{ return (int16_t)swap<E>((uint16_t)value); }
+
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+#pragma mark -  Layout
+
+template <unsigned Bits> struct layout;
+
+template <> struct layout<32> {
+    using header_type = struct mach_header;
+    using segment_type = struct segment_command;
+    using section_type = struct section;
+    using nlist_type = struct nlist;
+    using address_type = uint32_t;
+    static constexpr uint32_t magic = MH_MAGIC;
+    static constexpr uint32_t segment_cmd = LC_SEGMENT;
+};
+
+template <> struct layout<64> {
+    using header_type = struct mach_header_64;
+    using segment_type = struct segment_command_64;
+    using section_type = struct section_64;
+    using nlist_type = struct nlist_64;
+    using address_type = uint64_t;
+    static constexpr uint32_t magic = MH_MAGIC_64;
+    static constexpr uint32_t segment_cmd = LC_SEGMENT_64;
+};
+
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+#pragma mark -  Helpers
+
+//! Returns a view of a fixed-length, possibly unterminated, name field.
+inline std::string_view fixed_name(const char *name, size_t max_len) noexcept
+{ return std::string_view(name, strnlen(name, max_len)); }
+
+//! Decodes a ULEB128 value.  Returns \c nullptr if the value runs past
+//! \a end or does not fit in 64 bits.
+inline const uint8_t* read_uleb128(const uint8_t *p, const uint8_t *end, uint64_t &out) noexcept
+{
+    uint64_t result = 0;
+    unsigned shift = 0;
+    while (p < end) {
+        uint8_t byte = *p++;
+        if (shift >= 64 || (shift == 63 && (byte & 0x7E)))
+            return nullptr;
+        result |= (uint64_t)(byte & 0x7F) << shift;
+        shift += 7;
+        if ((byte & 0x80) == 0) {
+            out = result;
+            return p;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace detail
+
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+#pragma mark -  Range
+
+//! A begin/end iterator pair usable with range-based for loops.
+template <typename Iterator>
+class range {
+public:
+    constexpr range(Iterator first, Iterator last) noexcept : _begin(first), _end(last) {}
+    constexpr Iterator begin() const noexcept { return _begin; }
+    constexpr Iterator end() const noexcept { return _end; }
+    constexpr bool empty() const noexcept { return !(_begin != _end); }
+private:
+    Iterator _begin;
+    Iterator _end;
+};
+
+//! An iterator over a contiguous array of fixed-size Mach-O structures
+//! that produces a byte-order aware value type for each element.
+template <typename Value, typename Raw>
+class array_iterator {
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = Value;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = Value;
+    
+    constexpr array_iterator() noexcept : _p(nullptr) {}
+    constexpr explicit array_iterator(const Raw *p) noexcept : _p(p) {}
+    
+    constexpr Value operator*() const noexcept { return Value(_p); }
+    constexpr Value operator[](difference_type n) const noexcept { return Value(_p + n); }
+    
+    constexpr array_iterator& operator++() noexcept { ++_p; return *this; }
+    constexpr array_iterator operator++(int) noexcept { array_iterator tmp = *this; ++_p; return tmp; }
+    constexpr array_iterator& operator--() noexcept { --_p; return *this; }
+    constexpr array_iterator operator--(int) noexcept { array_iterator tmp = *this; --_p; return tmp; }
+    constexpr array_iterator& operator+=(difference_type n) noexcept { _p += n; return *this; }
+    constexpr array_iterator& operator-=(difference_type n) noexcept { _p -= n; return *this; }
+    constexpr array_iterator operator+(difference_type n) const noexcept { return array_iterator(_p + n); }
+    constexpr array_iterator operator-(difference_type n) const noexcept { return array_iterator(_p - n); }
+    constexpr difference_type operator-(const array_iterator &other) const noexcept { return _p - other._p; }
+    
+    constexpr bool operator==(const array_iterator &other) const noexcept { return _p == other._p; }
+    constexpr bool operator!=(const array_iterator &other) const noexcept { return _p != other._p; }
+    constexpr bool operator<(const array_iterator &other) const noexcept { return _p < other._p; }
+    
+private:
+    const Raw *_p;
+};
+
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+#pragma mark -  Load Commands
+
+//! A load command in an image with byte order \a E.
+template <endian E>
+class load_command {
+public:
+    constexpr explicit load_command(const ::load_command *lc) noexcept : _lc(lc) {}
+    
+    uint32_t cmd() const noexcept { return detail::swap<E>(_lc->cmd); }
+    uint32_t cmdsize() const noexcept { return detail::swap<E>(_lc->cmdsize); }
+    
+    //! Returns the load command as a pointer to the Mach-O structure \a T.
+    //! Fields of the returned structure are in the byte order of the image.
+    template <typename T>
+    const T* as() const noexcept
+    { return cmdsize() >= sizeof(T) ? reinterpret_cast<const T*>(_lc) : nullptr; }
+    
+    const ::load_command* raw() const noexcept { return _lc; }
+    
+private:
+    const ::load_command *_lc;
+};
+
+//! A forward iterator over the load commands of an image.  Iteration stops
+//! early if a load command is smaller than a \c load_command structure or
+//! extends beyond the end of the load commands.
+template <endian E>
+class load_command_iterator {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = load_command<E>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = value_type;
+    
+    constexpr load_command_iterator() noexcept : _p(nullptr), _end(nullptr), _remaining(0) {}
+    
+    load_command_iterator(const uint8_t *p, const uint8_t *end, uint32_t count) noexcept
+    : _p(p), _end(end), _remaining(count)
+    { validate(); }
+    
+    value_type operator*() const noexcept
+    { return value_type(reinterpret_cast<const ::load_command*>(_p)); }
+    
+    load_command_iterator& operator++() noexcept
+    {
+        _p += detail::swap<E>(reinterpret_cast<const ::load_command*>(_p)->cmdsize);
+        _remaining--;
+        validate();
+        return *this;
+    }
+    
+    load_command_iterator operator++(int) noexcept
+    { load_command_iterator tmp = *this; ++*this; return tmp; }
+    
+    bool operator==(const load_command_iterator &other) const noexcept
+    { return _remaining == other._remaining && (_remaining == 0 || _p == other._p); }
+    bool operator!=(const load_command_iterator &other) const noexcept
+    { return !(*this == other); }
+    
+private:
+    void validate() noexcept
+    {
+        if (_remaining == 0)
+            return;
+        
+        if ((size_t)(_end - _p) < sizeof(::load_command)) {
+            _remaining = 0;
+            return;
+        }
+        
+        uint32_t cmdsize = detail::swap<E>(reinterpret_cast<const ::load_command*>(_p)->cmdsize);
+        if (cmdsize < sizeof(::load_command) || cmdsize > (size_t)(_end - _p))
+            _remaining = 0;
+    }
+    
+    const uint8_t *_p;
+    const uint8_t *_end;
+    uint32_t _remaining;
+};
+
+//! A forward iterator over the load commands of an image that have a
+//! specific \c cmd value, producing a \a Value for each.
+template <endian E, typename Value>
+class filtered_load_command_iterator {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Value;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = Value;
+    
+    filtered_load_command_iterator() noexcept : _cmd(0) {}
+    
+    filtered_load_command_iterator(load_command_iterator<E> it, load_command_iterator<E> end, uint32_t cmd) noexcept
+    : _it(it), _end(end), _cmd(cmd)
+    { skip(); }
+    
+    Value operator*() const noexcept
+    { return Value((*_it).template as<typename Value::raw_type>()); }
+    
+    filtered_load_command_iterator& operator++() noexcept
+    { ++_it; skip(); return *this; }
+    
+    filtered_load_command_iterator operator++(int) noexcept
+    { filtered_load_command_iterator tmp = *this; ++*this; return tmp; }
+    
+    bool operator==(const filtered_load_command_iterator &other) const noexcept
+    { return _it == other._it; }
+    bool operator!=(const filtered_load_command_iterator &other) const noexcept
+    { return _it != other._it; }
+    
+private:
+    void skip() noexcept
+    {
+        while (_it != _end) {
+            auto lc = *_it;
+            if (lc.cmd() == _cmd && lc.template as<typename Value::raw_type>())
+                break;
+            ++_it;
+        }
+    }
+    
+    load_command_iterator<E> _it;
+    load_command_iterator<E> _end;
+    uint32_t _cmd;
+};
+
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+#pragma mark -  Sections
+
+//! A section in an image with word size \a Bits and byte order \a E.
+template <unsigned Bits, endian E>
+class section {
+public:
+    using raw_type = typename detail::layout<Bits>::section_type;
+    using address_type = typename detail::layout<Bits>::address_type;
+    
+    constexpr explicit section(const raw_type *sect) noexcept : _sect(sect) {}
+    
+    std::string_view name() const noexcept { return detail::fixed_name(_sect->sectname, sizeof(_sect->sectname)); }
+    std::string_view segment_name() const noexcept { return detail::fixed_name(_sect->segname, sizeof(_sect->segname)); }
+    address_type addr() const noexcept { return detail::swap<E>(_sect->addr); }
+    address_type size() const noexcept { return detail::swap<E>(_sect->size); }
+    uint32_t offset() const noexcept { return detail::swap<E>(_sect->offset); }
+    uint32_t align() const noexcept { return detail::swap<E>(_sect->align); }
+    uint32_t reloff() const noexcept { return detail::swap<E>(_sect->reloff); }
+    uint32_t nreloc() const noexcept { return detail::swap<E>(_sect->nreloc); }
+    uint32_t flags() const noexcept { return detail::swap<E>(_sect->flags); }
+    uint32_t type() const noexcept { return flags() & SECTION_TYPE; }
+    uint32_t reserved1() const noexcept { return detail::swap<E>(_sect->reserved1); }
+    uint32_t reserved2() const noexcept { return detail::swap<E>(_sect->reserved2); }
+    
+    const raw_type* raw() const noexcept { return _sect; }
+    
+private:
+    const raw_type *_sect;
+};
+
+template <unsigned Bits, endian E>
+using section_iterator = array_iterator<section<Bits, E>, typename detail::layout<Bits>::section_type>;
+
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+#pragma mark -  Segments
+
+//! A segment in an image with word size \a Bits and byte order \a E.
+template <unsigned Bits, endian E>
+class segment {
+public:
+    using raw_type = typename detail::layout<Bits>::segment_type;
+    using address_type = typename detail::layout<Bits>::address_type;
+    
+    constexpr explicit segment(const raw_type *seg) noexcept : _seg(seg) {}
+    
+    std::string_view name() const noexcept { return detail::fixed_name(_seg->segname, sizeof(_seg->segname)); }
+    address_type vmaddr() const noexcept { return detail::swap<E>(_seg->vmaddr); }
+    address_type vmsize() const noexcept { return detail::swap<E>(_seg->vmsize); }
+    address_type fileoff() const noexcept { return detail::swap<E>(_seg->fileoff); }
+    address_type filesize() const noexcept { return detail::swap<E>(_seg->filesize); }
+    vm_prot_t maxprot() const noexcept { return detail::swap<E>(_seg->maxprot); }
+    vm_prot_t initprot() const noexcept { return detail::swap<E>(_seg->initprot); }
+    uint32_t nsects() const noexcept { return detail::swap<E>(_seg->nsects); }
+    uint32_t flags() const noexcept { return detail::swap<E>(_seg->flags); }
+    
+    //! Returns the sections of this segment.  The range is truncated to the
+    //! number of sections that fit within the segment load command.
+    range<section_iterator<Bits, E>> sections() const noexcept
+    {
+        using section_type = typename detail::layout<Bits>::section_type;
+        uint32_t cmdsize = detail::swap<E>(_seg->cmdsize);
+        uint32_t count = nsects();
+        uint32_t max = (uint32_t)((cmdsize - sizeof(raw_type)) / sizeof(section_type));
+        if (count > max) count = max;
+        
+        auto first = reinterpret_cast<const section_type*>(_seg + 1);
+        return { section_iterator<Bits, E>(first), section_iterator<Bits, E>(first + count) };
+    }
+    
+    const raw_type* raw() const noexcept { return _seg; }
+    
+private:
+    const raw_type *_seg;
+};
+
+template <unsigned Bits, endian E>
+using segment_iterator = filtered_load_command_iterator<E, segment<Bits, E>>;
+
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+#pragma mark -  Symbols
+
+//! An entry in the symbol table of an image with word size \a Bits and byte
+//! order \a E.
+template <unsigned Bits, endian E>
+class symbol {
+public:
+    using raw_type = typename detail::layout<Bits>::nlist_type;
+    using address_type = typename detail::layout<Bits>::address_type;
+    
+    constexpr explicit symbol(const raw_type *nl) noexcept : _nl(nl) {}
+    
+    uint32_t strx() const noexcept { return detail::swap<E>(_nl->n_un.n_strx); }
+    uint8_t type() const noexcept { return _nl->n_type; }
+    uint8_t sect() const noexcept { return _nl->n_sect; }
+    uint16_t desc() const noexcept { return detail::swap<E>((uint16_t)_nl->n_desc); }
+    address_type value() const noexcept { return detail::swap<E>(_nl->n_value); }
+    
+    bool is_stab() const noexcept { return (type() & N_STAB) != 0; }
+    bool is_external() const noexcept { return (type() & N_EXT) != 0; }
+    bool is_defined() const noexcept { return !is_stab() && (type() & N_TYPE) != N_UNDF; }
+    
+    const raw_type* raw() const noexcept { return _nl; }
+    
+private:
+    const raw_type *_nl;
+};
+
+template <unsigned Bits, endian E>
+using symbol_iterator = array_iterator<symbol<Bits, E>, typename detail::layout<Bits>::nlist_type>;
+
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+#pragma mark -  Strings
+
+//! A forward iterator over the NUL-terminated strings of a string table.
+//! The final string is truncated at the end of the table if it is not
+//! terminated.
+class string_iterator {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::string_view;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = value_type;
+    
+    constexpr string_iterator() noexcept : _p(nullptr), _end(nullptr), _len(0) {}
+    
+    string_iterator(const char *p, const char *end) noexcept : _p(p), _end(end), _len(0)
+    { measure(); }
+    
+    value_type operator*() const noexcept { return value_type(_p, _len); }
+    
+    //! Returns the offset of the current string from \a table.
+    uint32_t offset(const char *table) const noexcept { return (uint32_t)(_p - table); }
+    
+    string_iterator& operator++() noexcept
+    {
+        _p += _len;
+        if (_p < _end) _p++;
+        measure();
+        return *this;
+    }
+    
+    string_iterator operator++(int) noexcept
+    { string_iterator tmp = *this; ++*this; return tmp; }
+    
+    bool operator==(const string_iterator &other) const noexcept { return _p == other._p; }
+    bool operator!=(const string_iterator &other) const noexcept { return _p != other._p; }
+    
+private:
+    void measure() noexcept
+    {
+        if (_p == _end) {
+            _len = 0;
+            return;
+        }
+        const void *nul = memchr(_p, 0, (size_t)(_end - _p));
+        _len = nul ? (size_t)((const char*)nul - _p) : (size_t)(_end - _p);
+    }
+    
+    const char *_p;
+    const char *_end;
+    size_t _len;
+};
+
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+#pragma mark -  Exports
+
+//! A terminal node in an exports trie.
+struct export_entry {
+    //! The full symbol name.  Only valid until the iterator that produced
+    //! this entry is advanced.
+    std::string_view name;
+    //! The \c EXPORT_SYMBOL_FLAGS_* of the export.
+    uint64_t flags;
+    //! The address of the export, relative to the image header.  Zero for
+    //! re-exports.
+    uint64_t address;
+    //! The resolver function offset of a stub-and-resolver export.
+    uint64_t resolver;
+    //! The library ordinal of a re-export.
+    uint64_t ordinal;
+    //! The name of the symbol in the re-exported library, or empty if the
+    //! re-export uses the same name.
+    std::string_view imported_name;
+    
+    bool is_reexport() const noexcept { return (flags & EXPORT_SYMBOL_FLAGS_REEXPORT) != 0; }
+    bool is_stub_and_resolver() const noexcept { return (flags & EXPORT_SYMBOL_FLAGS_STUB_AND_RESOLVER) != 0; }
+};
+
+//! An input iterator that walks an exports trie depth first, producing an
+//! \c export_entry for every terminal node.  The walk uses a fixed-size
+//! stack and name buffer; subtrees that are nested deeper than
+//! \c max_depth or whose names exceed \c max_name_length are skipped, as
+//! are nodes that fall outside of the trie.  Edges that lead back to a node
+//! on the current path are skipped, and the walk ends after entering as
+//! many nodes as a trie of its size can hold, so malformed tries terminate.
+class export_iterator {
+public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = export_entry;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const export_entry*;
+    using reference = const export_entry&;
+    
+    static constexpr size_t max_depth = 128;
+    static constexpr size_t max_name_length = 4096;
+    
+    export_iterator() noexcept : _start(nullptr), _end(nullptr), _depth(0), _remaining_nodes(0), _done(true) {}
+    
+    export_iterator(const uint8_t *start, const uint8_t *end) noexcept
+    : _start(start), _end(end), _depth(0), _done(false)
+    {
+        // Every node is at least two bytes: its terminal size and its
+        // child count.
+        _remaining_nodes = (_start != nullptr && _start < _end) ? (size_t)(_end - _start) / 2 : 0;
+        if (_start == nullptr || _start >= _end || !enter(0, 0))
+            advance();
+    }
+    
+    // The current entry references _name, which must not be shared between
+    // copies.
+    export_iterator(const export_iterator &other) noexcept { *this = other; }
+    export_iterator& operator=(const export_iterator &other) noexcept
+    {
+        if (this == &other) return *this;
+        _start = other._start; _end = other._end;
+        _depth = other._depth; _done = other._done;
+        _remaining_nodes = other._remaining_nodes;
+        memcpy(_stack, other._stack, sizeof(_stack[0]) * _depth);
+        memcpy(_name, other._name, other._current.name.size());
+        _current = other._current;
+        _current.name = std::string_view(_name, other._current.name.size());
+        return *this;
+    }
+    
+    reference operator*() const noexcept { return _current; }
+    pointer operator->() const noexcept { return &_current; }
+    
+    export_iterator& operator++() noexcept { advance(); return *this; }
+    
+    bool operator==(const export_iterator &other) const noexcept
+    { return _done && other._done; }
+    bool operator!=(const export_iterator &other) const noexcept
+    { return !(*this == other); }
+    
+private:
+    struct frame {
+        const uint8_t *next_edge;
+        uint64_t offset;
+        uint32_t remaining_edges;
+        uint32_t name_length;
+    };
+    
+    //! Visits the node at \a offset, whose name is the first \a name_length
+    //! bytes of _name.  Returns \c true if the node is a terminal.
+    bool enter(uint64_t offset, size_t name_length) noexcept
+    {
+        if (offset >= (uint64_t)(_end - _start) || _depth >= max_depth || _remaining_nodes == 0)
+            return false;
+        
+        for (size_t i = 0; i < _depth; i++)
+            if (_stack[i].offset == offset)
+                return false;
+        _remaining_nodes--;
+        
+        const uint8_t *p = _start + offset;
+        uint64_t terminal_size;
+        if ((p = detail::read_uleb128(p, _end, terminal_size)) == nullptr)
+            return false;
+        if (terminal_size >= (uint64_t)(_end - p))
+            return false;
+        
+        const uint8_t *terminal = p;
+        const uint8_t *children = p + terminal_size;
+        _stack[_depth++] = { children + 1, offset, *children, (uint32_t)name_length };
+        
+        if (terminal_size == 0)
+            return false;
+        
+        const uint8_t *terminal_end = children;
+        export_entry entry = {};
+        if ((terminal = detail::read_uleb128(terminal, terminal_end, entry.flags)) == nullptr)
+            return false;
+        
+        if (entry.flags & EXPORT_SYMBOL_FLAGS_REEXPORT) {
+            if ((terminal = detail::read_uleb128(terminal, terminal_end, entry.ordinal)) == nullptr)
+                return false;
+            entry.imported_name = detail::fixed_name((const char*)terminal, (size_t)(terminal_end - terminal));
+        } else {
+            if ((terminal = detail::read_uleb128(terminal, terminal_end, entry.address)) == nullptr)
+                return false;
+            if ((entry.flags & EXPORT_SYMBOL_FLAGS_STUB_AND_RESOLVER) &&
+                detail::read_uleb128(terminal, terminal_end, entry.resolver) == nullptr)
+                return false;
+        }
+        
+        entry.name = std::string_view(_name, name_length);
+        _current = entry;
+        return true;
+    }
+    
+    void advance() noexcept
+    {
+        while (_depth > 0) {
+            frame &f = _stack[_depth - 1];
+            if (f.remaining_edges == 0 || f.next_edge >= _end) {
+                _depth--;
+                continue;
+            }
+            f.remaining_edges--;
+            
+            const char *label = (const char*)f.next_edge;
+            const void *nul = memchr(label, 0, (size_t)(_end - f.next_edge));
+            if (nul == nullptr) {
+                _depth--;
+                continue;
+            }
+            size_t label_length = (size_t)((const char*)nul - label);
+            
+            uint64_t child;
+            const uint8_t *p = detail::read_uleb128((const uint8_t*)nul + 1, _end, child);
+            if (p == nullptr) {
+                _depth--;
+                continue;
+            }
+            f.next_edge = p;
+            
+            size_t name_length = f.name_length + label_length;
+            if (name_length > max_name_length)
+                continue;
+            memcpy(_name + f.name_length, label, label_length);
+            
+            if (enter(child, name_length))
+                return;
+        }
+        
+        _done = true;
+    }
+    
+    const uint8_t *_start;
+    const uint8_t *_end;
+    frame _stack[max_depth];
+    size_t _depth;
+    size_t _remaining_nodes;
+    char _name[max_name_length];
+    export_entry _current;
+    bool _done;
+};
+
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+#pragma mark -  Image
+
+//! A Mach-O image with word size \a Bits (32 or 64) and byte order \a E.
+//!
+//! The constructor performs a single pass over the load commands to locate
+//! the __LINKEDIT segment and the commands describing the symbol table and
+//! exports trie.  The remaining accessors do not re-walk the load commands.
+template <unsigned Bits, endian E>
+class image {
+public:
+    using layout_type = detail::layout<Bits>;
+    using header_type = typename layout_type::header_type;
+    using address_type = typename layout_type::address_type;
+    
+    static constexpr unsigned bits = Bits;
+    static constexpr endian byte_order = E;
+    
+    //! Creates an image for the Mach-O header at \a base.
+    //!
+    //! @param  base
+    //!         The address of the Mach-O header.
+    //! @param  length
+    //!         The number of bytes that are readable starting at \a base.
+    //!         For a loaded image, this only needs to cover the header and
+    //!         load commands.
+    //! @param  loaded
+    //!         \c true if the image was mapped by dyld (segments are at
+    //!         their VM offsets from \a base), \c false if it is a flat
+    //!         copy of the file (segments are at their file offsets).
+    image(const void *base, size_t length, bool loaded) noexcept
+    : _base((const uint8_t*)base), _length(length), _loaded(loaded),
+      _linkedit(nullptr), _linkedit_base(nullptr), _linkedit_start(0), _linkedit_end(0),
+      _symtab(nullptr), _exports_trie(nullptr)
+    {
+        if (_length < sizeof(header_type) || detail::swap<E>(header()->magic) != layout_type::magic) {
+            _length = 0;
+            return;
+        }
+        
+        address_type text_vmaddr = 0;
+        bool has_text = false;
+        
+        for (auto lc : load_commands()) {
+            switch (lc.cmd()) {
+                case layout_type::segment_cmd:
+                {
+                    auto seg = lc.template as<typename layout_type::segment_type>();
+                    if (seg == nullptr) break;
+                    segment<Bits, E> s(seg);
+                    if (!has_text && s.fileoff() == 0 && s.filesize() != 0) {
+                        text_vmaddr = s.vmaddr();
+                        has_text = true;
+                    }
+                    if (s.name() == SEG_LINKEDIT)
+                        _linkedit = seg;
+                    break;
+                }
+                case LC_SYMTAB:
+                    _symtab = lc.template as<struct symtab_command>();
+                    break;
+                case LC_DYLD_INFO:
+                case LC_DYLD_INFO_ONLY:
+                {
+                    auto info = lc.template as<struct dyld_info_command>();
+                    if (info && _exports_trie == nullptr) {
+                        _exports_offset = detail::swap<E>(info->export_off);
+                        _exports_size = detail::swap<E>(info->export_size);
+                        _exports_trie = info;
+                    }
+                    break;
+                }
+                case LC_DYLD_EXPORTS_TRIE:
+                {
+                    auto trie = lc.template as<struct linkedit_data_command>();
+                    if (trie) {
+                        _exports_offset = detail::swap<E>(trie->dataoff);
+                        _exports_size = detail::swap<E>(trie->datasize);
+                        _exports_trie = trie;
+                    }
+                    break;
+                }
+                default:
+                    break;
+            }
+        }
+        
+        if (_loaded) {
+            // The __LINKEDIT data of a loaded image is found at the segment's
+            // VM offset from the header.  Offsets into __LINKEDIT are file
+            // offsets, which are rebased using the segment's fileoff.
+            if (_linkedit && has_text) {
+                segment<Bits, E> s(_linkedit);
+                _linkedit_base = _base + (s.vmaddr() - text_vmaddr) - s.fileoff();
+                _linkedit_start = s.fileoff();
+                _linkedit_end = (uint64_t)s.fileoff() + s.filesize();
+            }
+        } else {
+            _linkedit_base = _base;
+            _linkedit_start = 0;
+            _linkedit_end = _length;
+        }
+    }
+    
+    //! Returns \c false if the header did not have the magic for this
+    //! word size and byte order.
+    explicit operator bool() const noexcept { return _length != 0; }
+    
+    const header_type* header() const noexcept { return reinterpret_cast<const header_type*>(_base); }
+    
+    cpu_type_t cputype() const noexcept { return detail::swap<E>(header()->cputype); }
+    cpu_subtype_t cpusubtype() const noexcept { return detail::swap<E>(header()->cpusubtype); }
+    uint32_t filetype() const noexcept { return detail::swap<E>(header()->filetype); }
+    uint32_t ncmds() const noexcept { return detail::swap<E>(header()->ncmds); }
+    uint32_t sizeofcmds() const noexcept { return detail::swap<E>(header()->sizeofcmds); }
+    uint32_t flags() const noexcept { return detail::swap<E>(header()->flags); }
+    
+    //! Returns the load commands of the image.
+    range<load_command_iterator<E>> load_commands() const noexcept
+    {
+        if (_length == 0)
+            return { {}, {} };
+        
+        const uint8_t *first = _base + sizeof(header_type);
+        size_t available = _length - sizeof(header_type);
+        size_t size = sizeofcmds();
+        const uint8_t *last = first + (size < available ? size : available);
+        return { load_command_iterator<E>(first, last, ncmds()), load_command_iterator<E>() };
+    }
+    
+    //! Returns the segment load commands of the image.
+    range<segment_iterator<Bits, E>> segments() const noexcept
+    {
+        auto commands = load_commands();
+        return { segment_iterator<Bits, E>(commands.begin(), commands.end(), layout_type::segment_cmd),
+                 segment_iterator<Bits, E>(commands.end(), commands.end(), layout_type::segment_cmd) };
+    }
+    
+    //! Returns a pointer to \a size bytes at \a offset in the __LINKEDIT
+    //! segment, or \c nullptr if the range is not within the segment.
+    const uint8_t* linkedit_data(uint64_t offset, uint64_t size) const noexcept
+    {
+        if (_linkedit_base == nullptr)
+            return nullptr;
+        if (offset < _linkedit_start || offset > _linkedit_end || size > _linkedit_end - offset)
+            return nullptr;
+        return _linkedit_base + offset;
+    }
+    
+    //! Returns the entries of the symbol table.
+    range<symbol_iterator<Bits, E>> symbols() const noexcept
+    {
+        using nlist_type = typename layout_type::nlist_type;
+        const nlist_type *first = nullptr;
+        uint32_t count = 0;
+        if (_symtab) {
+            count = detail::swap<E>(_symtab->nsyms);
+            first = reinterpret_cast<const nlist_type*>(linkedit_data(detail::swap<E>(_symtab->symoff), (uint64_t)count * sizeof(nlist_type)));
+            if (first == nullptr) count = 0;
+        }
+        return { symbol_iterator<Bits, E>(first), symbol_iterator<Bits, E>(first + count) };
+    }
+    
+    //! Returns the string table.
+    std::string_view string_table() const noexcept
+    {
+        if (_symtab == nullptr)
+            return {};
+        uint32_t size = detail::swap<E>(_symtab->strsize);
+        const char *table = (const char*)linkedit_data(detail::swap<E>(_symtab->stroff), size);
+        return table ? std::string_view(table, size) : std::string_view();
+    }
+    
+    //! Returns the strings in the string table.
+    range<string_iterator> strings() const noexcept
+    {
+        std::string_view table = string_table();
+        return { string_iterator(table.data(), table.data() + table.size()),
+                 string_iterator(table.data() + table.size(), table.data() + table.size()) };
+    }
+    
+    //! Returns the string at \a strx in the string table, or an empty view
+    //! if \a strx is out of range.
+    std::string_view string_at(uint32_t strx) const noexcept
+    {
+        std::string_view table = string_table();
+        if (strx >= table.size())
+            return {};
+        return detail::fixed_name(table.data() + strx, table.size() - strx);
+    }
+    
+    //! Returns the name of \a sym.
+    std::string_view name_of(const symbol<Bits, E> &sym) const noexcept
+    { return string_at(sym.strx()); }
+    
+    //! Returns the exports trie entries of the image.
+    range<export_iterator> exports() const
+    {
+        const uint8_t *trie = _exports_trie ? linkedit_data(_exports_offset, _exports_size) : nullptr;
+        if (trie == nullptr || _exports_size == 0)
+            return { export_iterator(), export_iterator() };
+        return { export_iterator(trie, trie + _exports_size), export_iterator() };
+    }
+    
+    //! Returns the __LINKEDIT segment, or a null segment if the image does
+    //! not have one.
+    const typename layout_type::segment_type* linkedit() const noexcept { return _linkedit; }
+    
+private:
+    const uint8_t *_base;
+    size_t _length;
+    bool _loaded;
+    const typename layout_type::segment_type *_linkedit;
+    const uint8_t *_linkedit_base;
+    uint64_t _linkedit_start;
+    uint64_t _linkedit_end;
+    const struct symtab_command *_symtab;
+    const void *_exports_trie;
+    uint32_t _exports_offset = 0;
+    uint32_t _exports_size = 0;
+};
+
+//◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦◦//
+#pragma mark -  Dispatch
+
+//! Examines the magic of the Mach-O header at \a base and invokes \a visitor
+//! with the matching \c image specialization.  Returns \c false, without
+//! invoking \a visitor, if \a base is not a thin Mach-O header.
+template <typename Visitor>
+bool visit(const void *base, size_t length, bool loaded, Visitor &&visitor)
+{
+    if (base == nullptr || length < sizeof(uint32_t))
+        return false;
+    
+    uint32_t magic;
+    memcpy(&magic, base, sizeof(magic));
+    
+    switch (magic) {
+        case MH_MAGIC_64:
+        {
+            image<64, endian::native> i(base, length, loaded);
+            if (!i) return false;
+            visitor(i);
+            return true;
+        }
+        case MH_CIGAM_64:
+        {
+            image<64, endian::swapped> i(base, length, loaded);
+            if (!i) return false;
+            visitor(i);
+            return true;
+        }
+        case MH_MAGIC:
+        {
+            image<32, endian::native> i(base, length, loaded);
+            if (!i) return false;
+            visitor(i);
+            return true;
+        }
+        case MH_CIGAM:
+        {
+            image<32, endian::swapped> i(base, length, loaded);
+            if (!i) return false;
+            visitor(i);
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+} // namespace macho
+
+//! @} CXX !//
+
+#endif /* _macho_hpp */